@@ -152,8 +152,8 @@ if (LITE_WITH_ARM)
 endif()
 
 if (LITE_WITH_CV)
-    if(NOT LITE_WITH_ARM)
-        message(FATAL_ERROR "CV functions uses the ARM instructions, so LITE_WITH_ARM must be turned on")
+    if(NOT LITE_WITH_ARM AND NOT LITE_WITH_X86)
+        message(FATAL_ERROR "CV functions uses the ARM or x86 instructions, so LITE_WITH_ARM or LITE_WITH_X86 must be turned on")
     endif()
     add_definitions("-DLITE_WITH_CV")
 endif()
@@ -240,6 +240,9 @@ if (LITE_WITH_NNADAPTER)
     if (NNADAPTER_WITH_AMLOGIC_NPU)
       add_definitions("-DNNADAPTER_WITH_AMLOGIC_NPU")
     endif()
+    if (NNADAPTER_WITH_X86_REFERENCE)
+      add_definitions("-DNNADAPTER_WITH_X86_REFERENCE")
+    endif()
   endif()
 endif()
 
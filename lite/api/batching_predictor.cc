@@ -0,0 +1,410 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/batching_predictor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+namespace {
+
+size_t BatchingElementSize(PrecisionType precision) {
+  return precision == PrecisionType::kBool ? sizeof(bool)
+                                           : PrecisionTypeLength(precision);
+}
+
+int64_t BatchingRowNumel(const shape_t &shape) {
+  int64_t numel = 1;
+  for (size_t i = 1; i < shape.size(); i++) {
+    numel *= shape[i];
+  }
+  return numel;
+}
+
+// The samples of a tensor are the sequences of the level 0 LoD, or the rows.
+int64_t BatchingSamples(const BatchingTensor &tensor) {
+  return tensor.lod.empty() ? tensor.shape[0]
+                            : static_cast<int64_t>(tensor.lod[0].size()) - 1;
+}
+
+void *BatchingMutableData(Tensor *tensor, PrecisionType precision) {
+  switch (precision) {
+    case PrecisionType::kFloat:
+      return tensor->mutable_data<float>();
+    case PrecisionType::kFP64:
+      return tensor->mutable_data<double>();
+    case PrecisionType::kInt8:
+      return tensor->mutable_data<int8_t>();
+    case PrecisionType::kUInt8:
+      return tensor->mutable_data<uint8_t>();
+    case PrecisionType::kInt16:
+      return tensor->mutable_data<int16_t>();
+    case PrecisionType::kInt32:
+      return tensor->mutable_data<int>();
+    case PrecisionType::kInt64:
+      return tensor->mutable_data<int64_t>();
+    case PrecisionType::kBool:
+      return tensor->mutable_data<bool>();
+    default:
+      LOG(FATAL) << "Unsupported precision of the batching input: "
+                 << PrecisionToStr(precision);
+  }
+  return nullptr;
+}
+
+// Slice the sequences [begin, end) of the level 0 of the LoD, the offsets of
+// the slice start from 0, and the rows of the slice are [*row_begin,
+// *row_end).
+lod_t SliceBatchingLoD(const lod_t &lod,
+                       uint64_t begin,
+                       uint64_t end,
+                       uint64_t *row_begin,
+                       uint64_t *row_end) {
+  lod_t slice(lod.size());
+  for (size_t level = 0; level < lod.size(); level++) {
+    const auto &offsets = lod[level];
+    for (uint64_t i = begin; i <= end; i++) {
+      slice[level].push_back(offsets[i] - offsets[begin]);
+    }
+    begin = offsets[begin];
+    end = offsets[end];
+  }
+  *row_begin = begin;
+  *row_end = end;
+  return slice;
+}
+
+struct BatchingRequest {
+  std::vector<BatchingTensor> inputs;
+  int64_t samples{0};
+  std::chrono::steady_clock::time_point arrival;
+  std::promise<std::vector<BatchingTensor>> promise;
+};
+
+using BatchingRequests = std::vector<std::unique_ptr<BatchingRequest>>;
+
+}  // namespace
+
+class BatchingPredictor::Impl {
+ public:
+  Impl(std::shared_ptr<PaddlePredictor> predictor,
+       const BatchingConfig &config)
+      : config_(config) {
+    CHECK(predictor) << "The predictor of BatchingPredictor is null.";
+    CHECK_GT(config.max_batch_size, 0);
+    CHECK_GE(config.max_wait_us, 0);
+    CHECK_GT(config.num_predictors, 0);
+    num_inputs_ = predictor->GetInputNames().size();
+    num_outputs_ = predictor->GetOutputNames().size();
+    std::vector<std::shared_ptr<PaddlePredictor>> predictors{predictor};
+    for (int i = 1; i < config.num_predictors; i++) {
+      predictors.push_back(predictor->Clone());
+    }
+    for (auto &worker_predictor : predictors) {
+      workers_.emplace_back(&Impl::Work, this, worker_predictor);
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::future<std::vector<BatchingTensor>> Run(
+      std::vector<BatchingTensor> &&inputs) {
+    CHECK_EQ(inputs.size(), num_inputs_)
+        << "The request has " << inputs.size() << " inputs, but the model has "
+        << num_inputs_;
+    CHECK(!inputs.empty());
+    for (auto &input : inputs) {
+      CHECK(!input.shape.empty()) << "The batching input has no dim 0.";
+      CHECK_EQ(input.data.size(),
+               input.shape[0] * BatchingRowNumel(input.shape) *
+                   BatchingElementSize(input.precision))
+          << "The data size of the batching input doesn't match its shape.";
+      if (!input.lod.empty()) {
+        CHECK_EQ(input.lod.back().back(), static_cast<uint64_t>(input.shape[0]))
+            << "The LoD of the batching input doesn't match its shape.";
+      }
+    }
+    std::unique_ptr<BatchingRequest> request(new BatchingRequest);
+    request->samples = BatchingSamples(inputs[0]);
+    request->inputs = std::move(inputs);
+    request->arrival = std::chrono::steady_clock::now();
+    auto future = request->promise.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      CHECK(!stop_);
+      queue_.push_back(std::move(request));
+    }
+    cv_.notify_one();
+    return future;
+  }
+
+ private:
+  void Work(std::shared_ptr<PaddlePredictor> predictor) {
+    BatchingRequests batch;
+    while (NextBatch(&batch)) {
+      if (!TryRunBatch(predictor.get(), batch)) {
+        // The outputs don't follow the batch, e.g. a batch-independent
+        // output, so the requests of the model are run alone from now on.
+        LOG(WARNING) << "The outputs of the model can't be split into the "
+                        "requests, BatchingPredictor runs them unbatched.";
+        batchable_ = false;
+        for (auto &request : batch) {
+          BatchingRequests single;
+          single.push_back(std::move(request));
+          TryRunBatch(predictor.get(), single);
+        }
+      }
+      batch.clear();
+    }
+  }
+
+  // Run the batch and fulfill the promises of the requests, return false if
+  // the outputs can't be split into the requests, which is never the case
+  // for a batch of one request.
+  bool TryRunBatch(PaddlePredictor *predictor, const BatchingRequests &batch) {
+#ifdef LITE_WITH_EXCEPTION
+    try {
+      return RunBatch(predictor, batch);
+    } catch (...) {
+      for (auto &request : batch) {
+        request->promise.set_exception(std::current_exception());
+      }
+    }
+    return true;
+#else
+    return RunBatch(predictor, batch);
+#endif
+  }
+
+  // Whether the request can be appended to the batch.
+  bool Fits(const BatchingRequests &batch,
+            int64_t samples,
+            const BatchingRequest &request) const {
+    if (batch.empty()) {
+      return true;
+    }
+    if (!batchable_ ||
+        samples + request.samples > config_.max_batch_size) {
+      return false;
+    }
+    const auto &inputs = batch.front()->inputs;
+    for (size_t i = 0; i < num_inputs_; i++) {
+      const auto &a = inputs[i];
+      const auto &b = request.inputs[i];
+      if (a.precision != b.precision || a.shape.size() != b.shape.size() ||
+          a.lod.size() != b.lod.size() ||
+          !std::equal(
+              a.shape.begin() + 1, a.shape.end(), b.shape.begin() + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Pop the requests of the next batch, return false if it's stopped and all
+  // the requests are done.
+  bool NextBatch(BatchingRequests *batch) {
+    // Only one worker collects a batch at a time, so the requests are not
+    // spread over the idle workers.
+    std::lock_guard<std::mutex> collect_lock(collect_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return false;
+    }
+    auto deadline = queue_.front()->arrival +
+                    std::chrono::microseconds(config_.max_wait_us);
+    int64_t samples = 0;
+    while (true) {
+      while (!queue_.empty() && Fits(*batch, samples, *queue_.front())) {
+        samples += queue_.front()->samples;
+        batch->push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+      // The batch is closed once it's full or the next request doesn't fit.
+      if (samples >= config_.max_batch_size || !queue_.empty() || stop_ ||
+          std::chrono::steady_clock::now() >= deadline) {
+        break;
+      }
+      cv_.wait_until(lock, deadline);
+    }
+    return true;
+  }
+
+  bool RunBatch(PaddlePredictor *predictor, const BatchingRequests &batch) {
+    // Concatenate the inputs along dim 0 and the LoD.
+    for (size_t i = 0; i < num_inputs_; i++) {
+      const auto &first = batch.front()->inputs[i];
+      shape_t shape = first.shape;
+      lod_t lod = first.lod;
+      for (size_t r = 1; r < batch.size(); r++) {
+        const auto &input = batch[r]->inputs[i];
+        shape[0] += input.shape[0];
+        for (size_t level = 0; level < lod.size(); level++) {
+          uint64_t base = lod[level].back();
+          for (size_t k = 1; k < input.lod[level].size(); k++) {
+            lod[level].push_back(base + input.lod[level][k]);
+          }
+        }
+      }
+      auto tensor = predictor->GetInput(i);
+      tensor->Resize(shape);
+      auto *dst = static_cast<char *>(
+          BatchingMutableData(tensor.get(), first.precision));
+      for (auto &request : batch) {
+        const auto &data = request->inputs[i].data;
+        std::memcpy(dst, data.data(), data.size());
+        dst += data.size();
+      }
+      tensor->SetLoD(lod);
+    }
+
+    predictor->Run();
+
+    std::vector<std::vector<BatchingTensor>> outputs(
+        batch.size(), std::vector<BatchingTensor>(num_outputs_));
+    for (size_t j = 0; j < num_outputs_; j++) {
+      if (!SplitOutput(*predictor->GetOutput(j), j, batch, &outputs)) {
+        return false;
+      }
+    }
+    for (size_t r = 0; r < batch.size(); r++) {
+      batch[r]->promise.set_value(std::move(outputs[r]));
+    }
+    return true;
+  }
+
+  // Split the output j of the batch by the requests. It's split by the level
+  // 0 LoD if any, otherwise by the samples or the input rows of the requests
+  // whichever matches its dim 0. The output of a batch of one request is
+  // taken as a whole. Return false if the output can't be split.
+  bool SplitOutput(const Tensor &tensor,
+                   size_t j,
+                   const BatchingRequests &batch,
+                   std::vector<std::vector<BatchingTensor>> *outputs) const {
+    shape_t shape = tensor.shape();
+    lod_t lod = tensor.lod();
+    PrecisionType precision = tensor.precision();
+    TargetType target = tensor.target();
+    CHECK(target == TargetType::kHost || target == TargetType::kX86 ||
+          target == TargetType::kARM)
+        << "The output " << j << " of BatchingPredictor is not on the host.";
+    if (batch.size() == 1) {
+      auto &output = (*outputs)[0][j];
+      output.shape = shape;
+      output.lod = lod;
+      output.precision = precision;
+      const char *src = static_cast<const char *>(tensor.data<void>());
+      int64_t numel = 1;
+      for (auto dim : shape) {
+        numel *= dim;
+      }
+      output.data.assign(src, src + numel * BatchingElementSize(precision));
+      return true;
+    }
+    if (shape.empty()) {
+      return false;
+    }
+    int64_t samples = 0;
+    int64_t rows = 0;
+    for (auto &request : batch) {
+      samples += request->samples;
+      rows += request->inputs[0].shape[0];
+    }
+    bool by_samples = shape[0] == samples;
+    bool by_rows = shape[0] == rows;
+    bool splittable =
+        lod.empty() ? by_samples || by_rows
+                    : static_cast<int64_t>(lod[0].size()) - 1 == samples;
+    if (!splittable) {
+      VLOG(3) << "The output " << j << " of " << shape[0]
+              << " rows can't be split into the requests of " << samples
+              << " samples.";
+      return false;
+    }
+
+    const size_t row_bytes =
+        BatchingRowNumel(shape) * BatchingElementSize(precision);
+    const char *src = static_cast<const char *>(tensor.data<void>());
+    uint64_t begin = 0;
+    for (size_t r = 0; r < batch.size(); r++) {
+      const auto &request = *batch[r];
+      auto &output = (*outputs)[r][j];
+      uint64_t row_begin = begin;
+      uint64_t row_end = begin;
+      if (!lod.empty()) {
+        output.lod = SliceBatchingLoD(
+            lod, begin, begin + request.samples, &row_begin, &row_end);
+        begin += request.samples;
+      } else {
+        uint64_t count =
+            by_samples ? request.samples : request.inputs[0].shape[0];
+        row_end = begin + count;
+        begin += count;
+      }
+      output.precision = precision;
+      output.shape = shape;
+      output.shape[0] = row_end - row_begin;
+      output.data.assign(src + row_begin * row_bytes,
+                         src + row_end * row_bytes);
+    }
+    return true;
+  }
+
+  BatchingConfig config_;
+  size_t num_inputs_{0};
+  size_t num_outputs_{0};
+  std::mutex collect_mutex_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<BatchingRequest>> queue_;
+  bool stop_{false};
+  // Whether the outputs of the model can be split into the requests.
+  std::atomic<bool> batchable_{true};
+  std::vector<std::thread> workers_;
+};
+
+BatchingPredictor::BatchingPredictor(std::shared_ptr<PaddlePredictor> predictor,
+                                     const BatchingConfig &config)
+    : impl_(new Impl(std::move(predictor), config)) {}
+
+BatchingPredictor::~BatchingPredictor() = default;
+
+std::future<std::vector<BatchingTensor>> BatchingPredictor::Run(
+    std::vector<BatchingTensor> inputs) {
+  return impl_->Run(std::move(inputs));
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,83 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <future>  // NOLINT
+#include <memory>
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite_api {
+
+/// A host tensor of the requests of BatchingPredictor, data holds the raw
+/// bytes of the elements in the row-major order.
+struct LITE_API BatchingTensor {
+  shape_t shape;
+  lod_t lod;
+  PrecisionType precision{PrecisionType::kFloat};
+  std::vector<char> data;
+};
+
+struct LITE_API BatchingConfig {
+  /// The max number of the samples of a batch, a sample is a row of dim 0,
+  /// or a sequence of the level 0 LoD of the sequence inputs. A request
+  /// larger than it runs alone.
+  int max_batch_size{16};
+  /// The max time a request waits for the others to fill the batch, in
+  /// microseconds, i.e. the latency added by batching.
+  int max_wait_us{2000};
+  /// The number of the predictors running the batches at the same time, the
+  /// extra ones are cloned from the given predictor, so a batch is collected
+  /// while the previous one is running.
+  int num_predictors{2};
+};
+
+/// BatchingPredictor coalesces the concurrent requests of small batches into
+/// a larger batch, which makes a better use of the kernels than running the
+/// requests one by one.
+///
+/// The requests are queued, and the compatible ones, i.e. the inputs having
+/// the same precisions, the same dims except dim 0 and the same LoD levels,
+/// are concatenated along dim 0 (and the LoD) until max_batch_size samples
+/// are collected or the first one has waited for max_wait_us. The outputs of
+/// the batch are split back by the samples (or the input rows) of the
+/// requests, or the LoD of the sequence outputs. If an output can't be split,
+/// e.g. an output independent of the batch, the requests of the model are
+/// run unbatched.
+///
+/// Usage:
+///   BatchingPredictor batching(CreatePaddlePredictor(config), {});
+///   // In the threads of the requests.
+///   std::vector<BatchingTensor> outputs = batching.Run(inputs).get();
+class LITE_API BatchingPredictor {
+ public:
+  BatchingPredictor(std::shared_ptr<PaddlePredictor> predictor,
+                    const BatchingConfig& config);
+  /// Run the queued requests and stop.
+  ~BatchingPredictor();
+
+  /// Queue a request, inputs[i] is the input i of the predictor, and the
+  /// outputs of the predictor are returned by the future.
+  std::future<std::vector<BatchingTensor>> Run(
+      std::vector<BatchingTensor> inputs);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,243 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>  // NOLINT
+#include "lite/api/batching_predictor.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite_api {
+
+// The predictor of y = 2 * x and the sum of x of every sample, and the sum
+// of all x which is independent of the batch if with_total is true.
+class DoublePredictor : public PaddlePredictor {
+ public:
+  DoublePredictor(std::atomic<int>* runs,
+                  std::atomic<int>* max_samples,
+                  bool with_total = false)
+      : runs_(runs), max_samples_(max_samples), with_total_(with_total) {}
+
+  std::unique_ptr<Tensor> GetInput(int i) override {
+    return std::unique_ptr<Tensor>(new Tensor(&x_));
+  }
+  std::unique_ptr<const Tensor> GetOutput(int i) const override {
+    const lite::Tensor* outputs[] = {&y_, &sum_, &total_};
+    return std::unique_ptr<const Tensor>(new Tensor(outputs[i]));
+  }
+
+  void Run() override {
+    runs_->fetch_add(1);
+    y_.Resize(x_.dims());
+    y_.set_lod(x_.lod());
+    const float* x = x_.data<float>();
+    float* y = y_.mutable_data<float>();
+    for (int64_t i = 0; i < x_.numel(); i++) {
+      y[i] = 2 * x[i];
+    }
+    std::vector<uint64_t> offsets;
+    int64_t width = x_.numel() / x_.dims()[0];
+    if (x_.lod().empty()) {
+      for (int64_t i = 0; i <= x_.dims()[0]; i++) {
+        offsets.push_back(i);
+      }
+    } else {
+      offsets = x_.lod()[0];
+    }
+    int samples = static_cast<int>(offsets.size()) - 1;
+    sum_.Resize({samples, 1});
+    float* sum = sum_.mutable_data<float>();
+    for (int i = 0; i < samples; i++) {
+      sum[i] = 0;
+      for (auto k = offsets[i] * width; k < offsets[i + 1] * width; k++) {
+        sum[i] += x[k];
+      }
+    }
+    total_.Resize({1});
+    float* total = total_.mutable_data<float>();
+    total[0] = 0;
+    for (int64_t i = 0; i < x_.numel(); i++) {
+      total[0] += x[i];
+    }
+    int max_samples = max_samples_->load();
+    while (samples > max_samples &&
+           !max_samples_->compare_exchange_weak(max_samples, samples)) {
+    }
+  }
+
+  std::shared_ptr<PaddlePredictor> Clone() override {
+    return std::make_shared<DoublePredictor>(runs_, max_samples_, with_total_);
+  }
+  std::shared_ptr<PaddlePredictor> Clone(
+      const std::vector<std::string>& var_names) override {
+    return Clone();
+  }
+  std::string GetVersion() const override { return ""; }
+  std::vector<std::string> GetInputNames() override { return {"x"}; }
+  std::vector<std::string> GetOutputNames() override {
+    if (with_total_) {
+      return {"y", "sum", "total"};
+    }
+    return {"y", "sum"};
+  }
+  bool TryShrinkMemory() override { return true; }
+  std::unique_ptr<Tensor> GetInputByName(const std::string& name) override {
+    return GetInput(0);
+  }
+  std::unique_ptr<const Tensor> GetTensor(
+      const std::string& name) const override {
+    return nullptr;
+  }
+
+ private:
+  std::atomic<int>* runs_;
+  std::atomic<int>* max_samples_;
+  bool with_total_;
+  lite::Tensor x_;
+  lite::Tensor y_;
+  lite::Tensor sum_;
+  lite::Tensor total_;
+};
+
+static BatchingTensor MakeInput(const std::vector<float>& values,
+                                int64_t width,
+                                const lod_t& lod = {}) {
+  BatchingTensor tensor;
+  tensor.shape = {static_cast<int64_t>(values.size()) / width, width};
+  tensor.lod = lod;
+  tensor.data.resize(values.size() * sizeof(float));
+  std::memcpy(tensor.data.data(), values.data(), tensor.data.size());
+  return tensor;
+}
+
+static std::vector<float> Values(const BatchingTensor& tensor) {
+  std::vector<float> values(tensor.data.size() / sizeof(float));
+  std::memcpy(values.data(), tensor.data.data(), tensor.data.size());
+  return values;
+}
+
+TEST(BatchingPredictor, coalesce_requests) {
+  std::atomic<int> runs{0};
+  std::atomic<int> max_samples{0};
+  BatchingConfig config;
+  config.max_batch_size = 8;
+  config.max_wait_us = 50000;
+  config.num_predictors = 2;
+  const int num_threads = 8;
+  const int num_requests = 4;
+  {
+    BatchingPredictor batching(
+        std::make_shared<DoublePredictor>(&runs, &max_samples), config);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+      threads.emplace_back([&, t] {
+        for (int r = 0; r < num_requests; r++) {
+          int rows = (t + r) % 3 + 1;
+          std::vector<float> x(rows * 2);
+          for (size_t i = 0; i < x.size(); i++) {
+            x[i] = t * 100 + r * 10 + i;
+          }
+          auto outputs = batching.Run({MakeInput(x, 2)}).get();
+          ASSERT_EQ(outputs.size(), 2UL);
+          EXPECT_EQ(outputs[0].shape, shape_t({rows, 2}));
+          EXPECT_EQ(outputs[1].shape, shape_t({rows, 1}));
+          auto y = Values(outputs[0]);
+          auto sum = Values(outputs[1]);
+          for (int i = 0; i < rows; i++) {
+            EXPECT_EQ(y[2 * i], 2 * x[2 * i]);
+            EXPECT_EQ(y[2 * i + 1], 2 * x[2 * i + 1]);
+            EXPECT_EQ(sum[i], x[2 * i] + x[2 * i + 1]);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  EXPECT_LT(runs.load(), num_threads * num_requests);
+  EXPECT_LE(max_samples.load(), config.max_batch_size);
+  EXPECT_GT(max_samples.load(), 3);
+}
+
+TEST(BatchingPredictor, coalesce_sequences) {
+  std::atomic<int> runs{0};
+  std::atomic<int> max_samples{0};
+  BatchingConfig config;
+  config.max_batch_size = 4;
+  config.max_wait_us = 20000;
+  config.num_predictors = 1;
+  BatchingPredictor batching(
+      std::make_shared<DoublePredictor>(&runs, &max_samples), config);
+  // The requests of 2 sequences of 1 and 2 rows, and 1 sequence of 3 rows.
+  auto first = batching.Run({MakeInput({1, 2, 3}, 1, {{0, 1, 3}})});
+  auto second = batching.Run({MakeInput({4, 5, 6}, 1, {{0, 3}})});
+  auto first_outputs = first.get();
+  auto second_outputs = second.get();
+  EXPECT_EQ(runs.load(), 1);
+  EXPECT_EQ(max_samples.load(), 3);
+
+  EXPECT_EQ(first_outputs[0].lod, lod_t({{0, 1, 3}}));
+  EXPECT_EQ(Values(first_outputs[0]), std::vector<float>({2, 4, 6}));
+  EXPECT_EQ(Values(first_outputs[1]), std::vector<float>({1, 5}));
+  EXPECT_EQ(second_outputs[0].lod, lod_t({{0, 3}}));
+  EXPECT_EQ(Values(second_outputs[0]), std::vector<float>({8, 10, 12}));
+  EXPECT_EQ(Values(second_outputs[1]), std::vector<float>({15}));
+}
+
+TEST(BatchingPredictor, run_unsplittable_outputs_unbatched) {
+  std::atomic<int> runs{0};
+  std::atomic<int> max_samples{0};
+  BatchingConfig config;
+  config.max_batch_size = 8;
+  config.max_wait_us = 20000;
+  config.num_predictors = 1;
+  BatchingPredictor batching(
+      std::make_shared<DoublePredictor>(&runs, &max_samples, true), config);
+  // The first two requests are batched, but the total can't be split, so
+  // they are run again one by one, and so are the following requests.
+  std::vector<std::vector<float>> xs{{1, 2}, {3, 4, 5, 6}, {7, 8}, {9, 10}};
+  std::vector<std::future<std::vector<BatchingTensor>>> futures;
+  for (size_t r = 0; r < 2; r++) {
+    futures.push_back(batching.Run({MakeInput(xs[r], 2)}));
+  }
+  for (size_t r = 0; r < 2; r++) {
+    futures[r].wait();
+  }
+  EXPECT_EQ(runs.load(), 3);
+  for (size_t r = 2; r < xs.size(); r++) {
+    futures.push_back(batching.Run({MakeInput(xs[r], 2)}));
+  }
+  for (size_t r = 0; r < xs.size(); r++) {
+    auto outputs = futures[r].get();
+    ASSERT_EQ(outputs.size(), 3UL);
+    int64_t rows = xs[r].size() / 2;
+    EXPECT_EQ(outputs[0].shape, shape_t({rows, 2}));
+    EXPECT_EQ(outputs[2].shape, shape_t({1}));
+    float total = 0;
+    for (size_t i = 0; i < xs[r].size(); i++) {
+      EXPECT_EQ(Values(outputs[0])[i], 2 * xs[r][i]);
+      total += xs[r][i];
+    }
+    EXPECT_EQ(Values(outputs[2]), std::vector<float>({total}));
+  }
+  EXPECT_EQ(runs.load(), 5);
+  EXPECT_EQ(max_samples.load(), 3);
+}
+
+}  // namespace lite_api
+}  // namespace paddle
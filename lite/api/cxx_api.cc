@@ -358,6 +358,14 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
   }
 
   if (IsQuantizedMode(program_desc_)) {
+    bool with_x86 = std::any_of(
+        inner_places.begin(), inner_places.end(), [](const Place &place) {
+          return place.target == TARGET(kX86);
+        });
+    if (with_x86) {
+      inner_places.insert(inner_places.begin(),
+                          Place{TARGET(kX86), PRECISION(kInt8)});
+    }
     inner_places.insert(inner_places.begin(),
                         Place{TARGET(kARM), PRECISION(kInt8)});
   }
@@ -374,6 +382,7 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
 
   program_ =
       RunDefaultOptimizer(std::move(program), inner_places, factor, passes);
+  program_->set_runtime_profiler(&runtime_profiler_);
 
   PrepareFeedFetch();
   // Verify if the ops version of current runtime program is
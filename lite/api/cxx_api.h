@@ -75,6 +75,7 @@ class LITE_API Predictor {
     // step3. Create the RuntimeProgram.
     program_.reset(
         new RuntimeProgram(program_desc_, exec_scope_, kRootBlockIdx));
+    program_->set_runtime_profiler(&runtime_profiler_);
     program_generated_ = true;
   }
 
@@ -206,6 +207,11 @@ class LITE_API Predictor {
   const lite::Tensor* GetTensor(const std::string& name) const;
   const RuntimeProgram& runtime_program() const;
   Scope* scope() { return scope_.get(); }
+  profile::RuntimeProfiler* runtime_profiler() { return &runtime_profiler_; }
+  // Run the independent ops concurrently on the x86 math threads.
+  void SetInterOpParallel(bool enable) {
+    if (program_) program_->set_inter_op_parallel(enable);
+  }
 
   // This method is disabled in mobile, for unnecessary dependencies required.
   void SaveModel(
@@ -245,6 +251,7 @@ class LITE_API Predictor {
   std::vector<std::string> output_names_;
   std::vector<Place> valid_places_;
   std::vector<PrecisionType> input_precisions_;
+  profile::RuntimeProfiler runtime_profiler_;
 };
 
 class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
@@ -303,6 +310,14 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
       bool record_info = false) override;
 
+  void EnableProfiling(
+      int sample_interval = 1,
+      int max_records = lite_api::kDefaultMaxProfileRecords) override;
+  void DisableProfiling() override;
+  std::vector<lite_api::OpProfileRecord> GetProfileRecords() const override;
+  int64_t GetNumDroppedProfileRecords() const override;
+  std::string GetProfileChromeTrace() const override;
+
  private:
   std::shared_ptr<Predictor> raw_predictor_;
   lite_api::CxxConfig config_;
@@ -18,6 +18,9 @@
 #include <string>
 #include "lite/api/paddle_api.h"
 #include "lite/core/device_info.h"
+#include "lite/core/kernel_tuner.h"
+#include "lite/core/optimizer/mir/embedding_compress_pass.h"
+#include "lite/core/optimizer/mir/memory_optimize_pass.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
 #include "lite/core/version.h"
@@ -33,6 +36,10 @@
 #endif
 #include "lite/backends/x86/mklml.h"
 #endif
+#if (defined LITE_WITH_X86) && !(defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+#include "lite/backends/x86/parallel.h"
+#endif
 namespace paddle {
 namespace lite {
 
@@ -107,6 +114,32 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       CHECK(pass);
       pass->SetQuantType(config.quant_type());
     }
+    if (config.embedding_compress_type() !=
+        lite_api::EmbeddingCompressType::COMPRESS_NONE) {
+      passes.push_back("embedding_compress_pass");
+      auto *pass =
+          mir::PassManager::Global().LookUp<mir::EmbeddingCompressPass>(
+              "embedding_compress_pass");
+      CHECK(pass);
+      pass->SetCompressType(config.embedding_compress_type());
+    }
+    if (config.enable_x86_bf16()) {
+      passes.push_back("bf16_weight_pass");
+    }
+    if (config.enable_x86_prepacked_weights()) {
+      passes.push_back("weight_prepack_pass");
+    }
+#ifdef LITE_WITH_X86
+    // Keep the independent ops independent in the memory reuse plan if they
+    // run concurrently.
+    auto *memory_pass =
+        mir::PassManager::Global().LookUp<mir::MemoryOptimizePass>(
+            "memory_optimize_pass");
+    if (memory_pass) {
+      bool inter_op_parallel = config.x86_inter_op_parallel();
+      memory_pass->SetAttr<bool>("inter_op_parallel", &inter_op_parallel);
+    }
+#endif
     raw_predictor_->Build(config, places, passes);
   } else {
     raw_predictor_->PrepareFeedFetch();
@@ -158,6 +191,20 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
   VLOG(3) << "x86_math_num_threads() is set successfully and the "
              "number of threads is:"
           << real_num_threads;
+#elif (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // Without MKL, the x86 math threads are managed by the built-in thread pool
+  // of the current thread.
+  x86::SetNumThreads(config.x86_math_num_threads());
+  x86::SetThreadAffinity(config.x86_math_cpu_ids());
+  VLOG(3) << "x86_math_num_threads() is set successfully and the "
+             "number of threads is:"
+          << x86::GetMaxThreads();
+#endif
+#ifdef LITE_WITH_X86
+  raw_predictor_->SetInterOpParallel(config.x86_inter_op_parallel());
+  KernelTuner::Global().Init(config.x86_kernel_tune_mode(),
+                             config.x86_kernel_tune_file(),
+                             config.x86_kernel_tune_repeats());
 #endif
 
 #ifdef LITE_WITH_XPU
@@ -234,6 +281,14 @@ std::vector<std::string> CxxPaddleApiImpl::GetOutputNames() {
 void CxxPaddleApiImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+#endif
+#if (defined LITE_WITH_X86) && !(defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // The thread pool belongs to the calling thread, which may not be the one
+  // the predictor was created on. Both calls are no-ops if the pool of the
+  // calling thread is already set up the same.
+  x86::SetNumThreads(config_.x86_math_num_threads());
+  x86::SetThreadAffinity(config_.x86_math_cpu_ids());
 #endif
   raw_predictor_->Run();
 }
@@ -285,6 +340,27 @@ bool CxxPaddleApiImpl::TryShrinkMemory() {
   return raw_predictor_->TryShrinkMemory();
 }
 
+void CxxPaddleApiImpl::EnableProfiling(int sample_interval, int max_records) {
+  raw_predictor_->runtime_profiler()->Enable(sample_interval, max_records);
+}
+
+void CxxPaddleApiImpl::DisableProfiling() {
+  raw_predictor_->runtime_profiler()->Disable();
+}
+
+std::vector<lite_api::OpProfileRecord> CxxPaddleApiImpl::GetProfileRecords()
+    const {
+  return raw_predictor_->runtime_profiler()->records();
+}
+
+int64_t CxxPaddleApiImpl::GetNumDroppedProfileRecords() const {
+  return raw_predictor_->runtime_profiler()->num_dropped_records();
+}
+
+std::string CxxPaddleApiImpl::GetProfileChromeTrace() const {
+  return raw_predictor_->runtime_profiler()->ChromeTrace();
+}
+
 }  // namespace lite
 
 namespace lite_api {
@@ -23,13 +23,16 @@ namespace paddle {
 namespace lite {
 
 void LightPredictor::Build(const std::string& lite_model_file,
-                           bool model_from_memory) {
+                           bool model_from_memory,
+                           bool mmap_params) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
   if (model_from_memory) {
-    LoadModelNaiveFromMemory(
-        lite_model_file, scope_.get(), program_desc_.get());
+    LoadModelNaiveFromMemory(lite_model_file, scope_.get(), program_desc.get());
   } else {
-    LoadModelNaiveFromFile(lite_model_file, scope_.get(), program_desc_.get());
+    LoadModelNaiveFromFile(
+        lite_model_file, scope_.get(), program_desc.get(), mmap_params);
   }
+  program_desc_ = program_desc;
 
   // For weight quantization of post training, load the int8/16 weights
   // for optimized model, and dequant it to fp32.
@@ -40,7 +43,6 @@ void LightPredictor::Build(const std::string& lite_model_file,
 #endif
   BuildRuntimeProgram(program_desc_);
   PrepareFeedFetch();
-  program_desc_.reset();
 }
 
 void LightPredictor::Build(const std::string& model_dir,
@@ -48,17 +50,18 @@ void LightPredictor::Build(const std::string& model_dir,
                            const std::string& param_buffer,
                            lite_api::LiteModelType model_type,
                            bool model_from_memory) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
   switch (model_type) {
 #ifndef LITE_ON_TINY_PUBLISH
     case lite_api::LiteModelType::kProtobuf:
-      LoadModelPb(model_dir, "", "", scope_.get(), program_desc_.get());
+      LoadModelPb(model_dir, "", "", scope_.get(), program_desc.get());
       break;
     case lite_api::LiteModelType::kNaiveBuffer: {
       if (model_from_memory) {
         LoadModelNaiveFromMemory(
-            model_buffer, param_buffer, scope_.get(), program_desc_.get());
+            model_buffer, param_buffer, scope_.get(), program_desc.get());
       } else {
-        LoadModelNaive(model_dir, scope_.get(), program_desc_.get());
+        LoadModelNaive(model_dir, scope_.get(), program_desc.get());
       }
       break;
     }
@@ -66,6 +69,7 @@ void LightPredictor::Build(const std::string& model_dir,
     default:
       LOG(FATAL) << "Unknown model type";
   }
+  program_desc_ = program_desc;
 
   DequantizeWeight();
 
@@ -178,12 +182,24 @@ void LightPredictor::PrepareFeedFetch() {
   }
 }
 
+std::unique_ptr<LightPredictor> LightPredictor::Clone(
+    const std::vector<std::string>& var_names) {
+  CHECK(program_desc_) << "The program desc of current predictor should not "
+                          "be nullptr in Clone mode.";
+  CHECK(scope_) << "The scope of current predictor should not be nullptr in "
+                   "Clone mode.";
+  return std::unique_ptr<LightPredictor>(
+      new LightPredictor(program_desc_, scope_, var_names));
+}
+
 void LightPredictor::BuildRuntimeProgram(
-    const std::shared_ptr<const cpp::ProgramDesc>& program_desc) {
+    const std::shared_ptr<const cpp::ProgramDesc>& program_desc,
+    const std::vector<std::string>& var_names) {
   auto* exe_scope = &scope_->NewScope();
-  // Prepare workspace
-  scope_->Var("feed")->GetMutable<std::vector<lite::Tensor>>();
-  scope_->Var("fetch")->GetMutable<std::vector<lite::Tensor>>();
+  // Prepare workspace, the feed and fetch lists are private to each predictor
+  // because the scope_ is shared by the cloned predictors.
+  exe_scope->LocalVar("feed")->GetMutable<std::vector<lite::Tensor>>();
+  exe_scope->LocalVar("fetch")->GetMutable<std::vector<lite::Tensor>>();
   CHECK(program_desc);
   auto block_size = program_desc->BlocksSize();
   CHECK(block_size);
@@ -202,13 +218,22 @@ void LightPredictor::BuildRuntimeProgram(
         }
       } else {
         if (var_desc->Name() == "feed" || var_desc->Name() == "fetch") continue;
-        scope_->Var(var_desc->Name());
+        auto* var = scope_->Var(var_desc->Name());
+        // Copy the persistable variables which are not shared into the
+        // private scope.
+        if (std::find(var_names.begin(), var_names.end(), var_desc->Name()) !=
+            var_names.end()) {
+          auto* tensor =
+              exe_scope->LocalVar(var_desc->Name())->GetMutable<lite::Tensor>();
+          tensor->CopyDataFrom(var->Get<lite::Tensor>());
+        }
       }
     }
   }
   // Only extracting the ops and generate the runtime program from the main
   // block desc
   program_.reset(new RuntimeProgram(program_desc, exe_scope, kRootBlockIdx));
+  program_->set_runtime_profiler(&runtime_profiler_);
 }
 
 void LightPredictor::DequantizeWeight() {
@@ -238,6 +263,34 @@ void LightPredictor::DequantizeWeight() {
     }
     return result;
   };
+  // The quantized weights of the x86 fp32 fc, mul and conv2d kernels of NCHW
+  // are kept in int8 or int16, which are converted to fp32 in the gemm and
+  // multiplied with the scales attached by the ops. The other kernels, e.g.
+  // the NCHW8c conv2d, read the weights as fp32.
+  auto keep_quantized_weight = [](const cpp::OpDesc* op_desc,
+                                  const std::string& input_name) {
+#ifdef LITE_WITH_X86
+    static const std::map<std::string, std::string> weight_quant_ops = {
+        {"fc", "W"}, {"mul", "Y"}, {"conv2d", "Filter"}};
+    auto iter = weight_quant_ops.find(op_desc->Type());
+    if (iter == weight_quant_ops.end() || !op_desc->HasAttr(kKernelTypeAttr) ||
+        !op_desc->HasInput(iter->second) ||
+        op_desc->Input(iter->second) != std::vector<std::string>{input_name}) {
+      return false;
+    }
+    std::string op_type, alias;
+    Place place;
+    KernelBase::ParseKernelType(op_desc->GetAttr<std::string>(kKernelTypeAttr),
+                                &op_type,
+                                &alias,
+                                &place);
+    return place.target == TARGET(kX86) &&
+           place.precision == PRECISION(kFloat) &&
+           place.layout == DATALAYOUT(kNCHW);
+#else
+    return false;
+#endif
+  };
   Tensor tmp_tensor;
   for (size_t i = 0; i < program_desc->BlocksSize(); i++) {
     auto* block = program_desc->GetBlock<cpp::BlockDesc>(i);
@@ -261,9 +314,15 @@ void LightPredictor::DequantizeWeight() {
               input_scale_name = input_scale_name_alias;
               input_name = input_name.substr(0, found);
             }
+            if (keep_quantized_weight(op_desc, input_name)) {
+              continue;
+            }
             auto input_tensor =
                 scope_->FindVar(input_name)->GetMutable<lite::Tensor>();
             tmp_tensor.CopyDataFrom(*input_tensor);
+            // The dequantized weight is larger than the quantized one, so it
+            // can't be written into the aliased memory-mapped param.
+            input_tensor->clear();
             auto scale_list =
                 op_desc->GetAttr<std::vector<float>>(input_scale_name);
 
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
 #include <vector>
@@ -42,12 +43,26 @@ class LITE_API LightPredictor {
  public:
   // constructor function of LightPredictor, `lite_model_file` refers to data in
   // model file or buffer,`model_from_memory` refers to whther to load model
-  // from memory.
+  // from memory, `mmap_params` refers to whether to alias the params in the
+  // memory-mapped model file.
   LightPredictor(const std::string& lite_model_file,
-                 bool model_from_memory = false) {
+                 bool model_from_memory = false,
+                 bool mmap_params = false) {
     scope_ = std::make_shared<Scope>();
-    program_desc_ = std::make_shared<cpp::ProgramDesc>();
-    Build(lite_model_file, model_from_memory);
+    Build(lite_model_file, model_from_memory, mmap_params);
+  }
+
+  // Create a predictor which shares the persistable variables in `root` with
+  // an existing one, it's only called in LightPredictor::Clone. The
+  // persistable variables of name var_names are copied into the private scope
+  // instead of being shared.
+  LightPredictor(
+      const std::shared_ptr<const cpp::ProgramDesc>& program_desc,
+      const std::shared_ptr<Scope>& root,
+      const std::vector<std::string>& var_names = {})
+      : scope_(root), program_desc_(program_desc) {
+    BuildRuntimeProgram(program_desc_, var_names);
+    PrepareFeedFetch();
   }
 
   // NOTE: This is a deprecated API and will be removed in latter release.
@@ -58,7 +73,6 @@ class LITE_API LightPredictor {
                  lite_api::LiteModelType model_type =
                      lite_api::LiteModelType::kNaiveBuffer) {
     scope_ = std::make_shared<Scope>();
-    program_desc_ = std::make_shared<cpp::ProgramDesc>();
     Build(model_dir, model_buffer, param_buffer, model_type, model_from_memory);
   }
 
@@ -67,6 +81,12 @@ class LITE_API LightPredictor {
     program_->Run();
   }
 
+  // Create a predictor from an existing one, the cloned predictor has its own
+  // runtime program and activations, and shares the persistable variables
+  // except for `var_names` with the original predictor.
+  std::unique_ptr<LightPredictor> Clone(
+      const std::vector<std::string>& var_names = {});
+
   /// \brief Release all tmp tensor to compress the size of the memory pool.
   /// The memory pool is considered to be composed of a list of chunks, if
   /// the chunk is not occupied, it can be released.
@@ -93,6 +113,11 @@ class LITE_API LightPredictor {
   const std::vector<PrecisionType>& GetInputPrecisions() const;
   void PrepareFeedFetch();
   Scope* scope() { return scope_.get(); }
+  profile::RuntimeProfiler* runtime_profiler() { return &runtime_profiler_; }
+  // Run the independent ops concurrently on the x86 math threads.
+  void SetInterOpParallel(bool enable) {
+    if (program_) program_->set_inter_op_parallel(enable);
+  }
 
 #ifdef LITE_WITH_METAL
   void ConfigMetalContext(const lite_api::MobileConfig& config) {
@@ -108,7 +133,8 @@ class LITE_API LightPredictor {
   void CheckInputValid();
 
   void Build(const std::string& lite_model_file,
-             bool model_from_memory = false);
+             bool model_from_memory = false,
+             bool mmap_params = false);
 
   // NOTE: This is a deprecated API and will be removed in latter release.
   void Build(
@@ -119,7 +145,8 @@ class LITE_API LightPredictor {
       bool model_from_memory = false);
 
   void BuildRuntimeProgram(
-      const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
+      const std::shared_ptr<const cpp::ProgramDesc>& program_desc,
+      const std::vector<std::string>& var_names = {});
 
   void DequantizeWeight();
 
@@ -130,15 +157,20 @@ class LITE_API LightPredictor {
  private:
   std::shared_ptr<Scope> scope_;
   std::unique_ptr<RuntimeProgram> program_;
-  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  // The program desc is read-only once it's loaded, it's shared by the cloned
+  // predictors instead of being copied.
+  std::shared_ptr<const cpp::ProgramDesc> program_desc_;
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
   std::vector<PrecisionType> input_precisions_;
+  profile::RuntimeProfiler runtime_profiler_;
 };
 
 class LightPredictorImpl : public lite_api::PaddlePredictor {
  public:
   LightPredictorImpl() = default;
+  explicit LightPredictorImpl(std::unique_ptr<LightPredictor>&& raw_predictor)
+      : raw_predictor_(std::move(raw_predictor)) {}
 
   std::unique_ptr<lite_api::Tensor> GetInput(int i) override;
 
@@ -168,8 +200,18 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   /// \return a boolean variable.
   bool TryShrinkMemory() override;
 
+  void EnableProfiling(
+      int sample_interval = 1,
+      int max_records = lite_api::kDefaultMaxProfileRecords) override;
+  void DisableProfiling() override;
+  std::vector<lite_api::OpProfileRecord> GetProfileRecords() const override;
+  int64_t GetNumDroppedProfileRecords() const override;
+  std::string GetProfileChromeTrace() const override;
+
  private:
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
+  lite_api::MobileConfig config_;
+  std::mutex mutex_;
 };
 
 }  // namespace lite
@@ -15,6 +15,7 @@
 #include "lite/api/light_api.h"
 #include <string>
 #include "lite/api/paddle_api.h"
+#include "lite/core/kernel_tuner.h"
 #include "lite/core/version.h"
 #include "lite/model_parser/model_parser.h"
 #ifndef LITE_ON_TINY_PUBLISH
@@ -26,23 +27,36 @@
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
 #include "lite/backends/x86/mklml.h"
 #endif
+#if (defined LITE_WITH_X86) && !(defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+#include "lite/backends/x86/parallel.h"
+#endif
 
 namespace paddle {
 namespace lite {
 
 void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
-  // LightPredictor Only support NaiveBuffer backend in publish lib
-  if (config.lite_model_file().empty()) {
-    raw_predictor_.reset(
-        new LightPredictor(config.model_dir(),
-                           config.model_buffer(),
-                           config.param_buffer(),
-                           config.is_model_from_memory(),
-                           lite_api::LiteModelType::kNaiveBuffer));
-  } else {
-    raw_predictor_.reset(new LightPredictor(config.lite_model_file(),
-                                            config.is_model_from_memory()));
+  // The raw predictor has been created if it's in Clone mode.
+  if (!raw_predictor_) {
+    // LightPredictor Only support NaiveBuffer backend in publish lib
+    if (config.lite_model_file().empty()) {
+      raw_predictor_.reset(
+          new LightPredictor(config.model_dir(),
+                             config.model_buffer(),
+                             config.param_buffer(),
+                             config.is_model_from_memory(),
+                             lite_api::LiteModelType::kNaiveBuffer));
+    } else {
+      raw_predictor_.reset(new LightPredictor(config.lite_model_file(),
+                                              config.is_model_from_memory(),
+                                              config.mmap_params()));
+    }
   }
+  // Keep the settings to initialize the cloned predictors. The model data is
+  // useless for them, so the model file or buffer and the deprecated model
+  // and param buffers are not copied.
+  static_cast<lite_api::ConfigBase&>(config_) = config;
+  config_.set_mmap_params(config.mmap_params());
   mode_ = config.power_mode();
   threads_ = config.threads();
 
@@ -110,6 +124,20 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
   VLOG(3) << "x86_math_num_threads() is set successfully and the "
              "number of threads is:"
           << real_num_threads;
+#elif (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // Without MKL, the x86 math threads are managed by the built-in thread pool
+  // of the current thread.
+  x86::SetNumThreads(config.x86_math_num_threads());
+  x86::SetThreadAffinity(config.x86_math_cpu_ids());
+  VLOG(3) << "x86_math_num_threads() is set successfully and the "
+             "number of threads is:"
+          << x86::GetMaxThreads();
+#endif
+#ifdef LITE_WITH_X86
+  raw_predictor_->SetInterOpParallel(config.x86_inter_op_parallel());
+  KernelTuner::Global().Init(config.x86_kernel_tune_mode(),
+                             config.x86_kernel_tune_file(),
+                             config.x86_kernel_tune_repeats());
 #endif
 }
 
@@ -127,19 +155,33 @@ std::unique_ptr<const lite_api::Tensor> LightPredictorImpl::GetOutput(
 void LightPredictorImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+#endif
+#if (defined LITE_WITH_X86) && !(defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // The thread pool belongs to the calling thread, which may not be the one
+  // the predictor was created on. Both calls are no-ops if the pool of the
+  // calling thread is already set up the same.
+  x86::SetNumThreads(config_.x86_math_num_threads());
+  x86::SetThreadAffinity(config_.x86_math_cpu_ids());
 #endif
   raw_predictor_->Run();
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone() {
-  LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
-  return nullptr;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto predictor =
+      std::make_shared<LightPredictorImpl>(raw_predictor_->Clone());
+  predictor->Init(config_);
+  return predictor;
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone(
     const std::vector<std::string>& var_names) {
-  LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
-  return nullptr;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto predictor =
+      std::make_shared<LightPredictorImpl>(raw_predictor_->Clone(var_names));
+  predictor->Init(config_);
+  return predictor;
 }
 
 std::string LightPredictorImpl::GetVersion() const { return lite::version(); }
@@ -167,6 +209,27 @@ bool LightPredictorImpl::TryShrinkMemory() {
   return raw_predictor_->TryShrinkMemory();
 }
 
+void LightPredictorImpl::EnableProfiling(int sample_interval, int max_records) {
+  raw_predictor_->runtime_profiler()->Enable(sample_interval, max_records);
+}
+
+void LightPredictorImpl::DisableProfiling() {
+  raw_predictor_->runtime_profiler()->Disable();
+}
+
+std::vector<lite_api::OpProfileRecord> LightPredictorImpl::GetProfileRecords()
+    const {
+  return raw_predictor_->runtime_profiler()->records();
+}
+
+int64_t LightPredictorImpl::GetNumDroppedProfileRecords() const {
+  return raw_predictor_->runtime_profiler()->num_dropped_records();
+}
+
+std::string LightPredictorImpl::GetProfileChromeTrace() const {
+  return raw_predictor_->runtime_profiler()->ChromeTrace();
+}
+
 }  // namespace lite
 
 namespace lite_api {
@@ -15,6 +15,10 @@
 #include "lite/api/light_api.h"
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#include "lite/model_parser/model_parser.h"
+#endif
 
 DEFINE_string(optimized_model, "", "");
 
@@ -59,6 +63,389 @@ TEST(LightAPI, load) {
   }
 }
 
+TEST(LightAPI, clone) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+  LightPredictor predictor(FLAGS_optimized_model, "", "");
+  auto cloned_predictor = predictor.Clone();
+  ASSERT_NE(predictor.GetInput(0), cloned_predictor->GetInput(0));
+
+  for (auto* p : {&predictor, cloned_predictor.get()}) {
+    auto* input_tensor = p->GetInput(0);
+    input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = i;
+    }
+    p->Run();
+  }
+
+  const auto* output = predictor.GetOutput(0);
+  const auto* cloned_output = cloned_predictor->GetOutput(0);
+  ASSERT_NE(output, cloned_output);
+  ASSERT_EQ(output->dims(), cloned_output->dims());
+  for (int64_t i = 0; i < output->numel(); i++) {
+    EXPECT_NEAR(
+        output->data<float>()[i], cloned_output->data<float>()[i], 1e-6);
+  }
+}
+
+#ifdef LITE_WITH_X86
+TEST(LightAPI, inter_op_parallel) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+  LightPredictor predictor(FLAGS_optimized_model, "", "");
+  auto parallel_predictor = predictor.Clone();
+  x86::SetNumThreads(4);
+  parallel_predictor->SetInterOpParallel(true);
+
+  for (auto* p : {&predictor, parallel_predictor.get()}) {
+    auto* input_tensor = p->GetInput(0);
+    input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = i;
+    }
+    for (int i = 0; i < 2; i++) {
+      p->Run();
+    }
+  }
+  x86::SetNumThreads(1);
+
+  const auto* output = predictor.GetOutput(0);
+  const auto* parallel_output = parallel_predictor->GetOutput(0);
+  ASSERT_EQ(output->dims(), parallel_output->dims());
+  for (int64_t i = 0; i < output->numel(); i++) {
+    EXPECT_NEAR(
+        output->data<float>()[i], parallel_output->data<float>()[i], 1e-5);
+  }
+}
+#endif
+
+#ifdef LITE_WITH_X86
+namespace {
+void AddVar(cpp::BlockDesc* block,
+            const std::string& name,
+            VarDescAPI::Type type = VarDescAPI::Type::LOD_TENSOR,
+            bool persistable = false) {
+  auto* var = block->AddVar<cpp::VarDesc>();
+  var->SetName(name);
+  var->SetType(type);
+  var->SetPersistable(persistable);
+}
+
+cpp::OpDesc* AddOp(cpp::BlockDesc* block,
+                   const std::string& type,
+                   const std::string& input_arg,
+                   const std::string& input,
+                   const std::string& output_arg,
+                   const std::string& output,
+                   const std::string& alias,
+                   const Place& place) {
+  auto* op = block->AddOp<cpp::OpDesc>();
+  op->SetType(type);
+  op->SetInput(input_arg, {input});
+  op->SetOutput(output_arg, {output});
+  op->SetAttr<std::string>(kKernelTypeAttr,
+                           KernelBase::SerializeKernelType(type, alias, place));
+  return op;
+}
+}  // namespace
+
+// The weight-only quantized filter of the NCHW8c conv2d is dequantized at
+// load, as the kernel reads the filter as fp32.
+TEST(LightAPI, weight_quantized_conv_nchw8c) {
+  const int ic = 8;
+  const int oc = 16;
+  const int hw = 5;
+  const Place host{TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)};
+  const Place x86{TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW)};
+  const Place x86_nchw8c{
+      TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW8c)};
+  cpp::ProgramDesc program_desc;
+  auto* block = program_desc.AddBlock<cpp::BlockDesc>();
+  AddVar(block, "feed", VarDescAPI::Type::FEED_MINIBATCH, true);
+  AddVar(block, "fetch", VarDescAPI::Type::FETCH_LIST, true);
+  AddVar(block, "filter", VarDescAPI::Type::LOD_TENSOR, true);
+  for (auto name : {"x", "x_nchw8c", "out_nchw8c", "out"}) {
+    AddVar(block, name);
+  }
+  AddOp(block, "feed", "X", "feed", "Out", "x", "def", host)
+      ->SetAttr<int>("col", 0);
+  AddOp(block,
+        "layout",
+        "Input",
+        "x",
+        "Out",
+        "x_nchw8c",
+        "nchw2nchw8c",
+        x86);
+  auto* conv = AddOp(block,
+                     "conv2d",
+                     "Input",
+                     "x_nchw8c",
+                     "Output",
+                     "out_nchw8c",
+                     "def",
+                     x86_nchw8c);
+  conv->SetInput("Filter", {"filter"});
+  conv->SetAttr<std::vector<int>>("strides", {1, 1});
+  conv->SetAttr<std::vector<int>>("paddings", {1, 1});
+  conv->SetAttr<std::vector<int>>("dilations", {1, 1});
+  conv->SetAttr<int>("groups", 1);
+  conv->SetAttr<int>("quantize_weight_bits", 8);
+  std::vector<float> scales(oc);
+  for (int o = 0; o < oc; o++) {
+    scales[o] = 0.01f * (o + 1);
+  }
+  conv->SetAttr<std::vector<float>>("filter_quant_scale", scales);
+  AddOp(block,
+        "layout",
+        "Input",
+        "out_nchw8c",
+        "Out",
+        "out",
+        "nchw8c2nchw",
+        x86);
+  AddOp(block, "fetch", "X", "out", "Out", "fetch", "def", host)
+      ->SetAttr<int>("col", 0);
+
+  Scope scope;
+  auto* filter = scope.Var("filter")->GetMutable<Tensor>();
+  filter->Resize({oc, ic, 3, 3});
+  auto* filter_data = filter->mutable_data<int8_t>();
+  for (int64_t i = 0; i < filter->numel(); i++) {
+    filter_data[i] = static_cast<int8_t>(i % 255 - 127);
+  }
+  const std::string model_file = "weight_quantized_conv_nchw8c";
+  SaveModelNaive(model_file, scope, program_desc);
+
+  LightPredictor predictor(model_file + ".nb", false);
+  auto* input_tensor = predictor.GetInput(0);
+  input_tensor->Resize({1, ic, hw, hw});
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < ic * hw * hw; i++) {
+    data[i] = (i % 13) * 0.1f - 0.6f;
+  }
+  predictor.Run();
+
+  const auto* output = predictor.GetOutput(0);
+  ASSERT_EQ(output->dims().Vectorize(),
+            std::vector<int64_t>({1, oc, hw, hw}));
+  const float* out_data = output->data<float>();
+  for (int o = 0; o < oc; o++) {
+    for (int y = 0; y < hw; y++) {
+      for (int x = 0; x < hw; x++) {
+        float ref = 0.f;
+        for (int c = 0; c < ic; c++) {
+          for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+              int iy = y + i - 1;
+              int ix = x + j - 1;
+              if (iy < 0 || iy >= hw || ix < 0 || ix >= hw) continue;
+              ref += data[(c * hw + iy) * hw + ix] * scales[o] *
+                     filter_data[((o * ic + c) * 3 + i) * 3 + j];
+            }
+          }
+        }
+        EXPECT_NEAR(out_data[(o * hw + y) * hw + x], ref, 1e-3);
+      }
+    }
+  }
+}
+
+// The weight-only quantized filter of the NCHW conv2d(int8) and the weights of
+// the fc(int16) are kept quantized at load, and the scales are applied by the
+// x86 fp32 kernels.
+TEST(LightAPI, weight_quantized_conv_fc) {
+  const int ic = 3;
+  const int oc = 5;
+  const int hw = 4;
+  const int k = oc * hw * hw;
+  const int n = 7;
+  const Place host{TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)};
+  const Place x86{TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW)};
+  cpp::ProgramDesc program_desc;
+  auto* block = program_desc.AddBlock<cpp::BlockDesc>();
+  AddVar(block, "feed", VarDescAPI::Type::FEED_MINIBATCH, true);
+  AddVar(block, "fetch", VarDescAPI::Type::FETCH_LIST, true);
+  AddVar(block, "filter", VarDescAPI::Type::LOD_TENSOR, true);
+  AddVar(block, "w", VarDescAPI::Type::LOD_TENSOR, true);
+  for (auto name : {"x", "conv_out", "fc_out"}) {
+    AddVar(block, name);
+  }
+  AddOp(block, "feed", "X", "feed", "Out", "x", "def", host)
+      ->SetAttr<int>("col", 0);
+  auto* conv =
+      AddOp(block, "conv2d", "Input", "x", "Output", "conv_out", "def", x86);
+  conv->SetInput("Filter", {"filter"});
+  conv->SetAttr<std::vector<int>>("strides", {1, 1});
+  conv->SetAttr<std::vector<int>>("paddings", {1, 1});
+  conv->SetAttr<std::vector<int>>("dilations", {1, 1});
+  conv->SetAttr<int>("groups", 1);
+  conv->SetAttr<int>("quantize_weight_bits", 8);
+  std::vector<float> filter_scales(oc);
+  for (int o = 0; o < oc; o++) {
+    filter_scales[o] = 0.01f * (o + 1);
+  }
+  conv->SetAttr<std::vector<float>>("filter_quant_scale", filter_scales);
+  auto* fc =
+      AddOp(block, "fc", "Input", "conv_out", "Out", "fc_out", "def", x86);
+  fc->SetInput("W", {"w"});
+  fc->SetAttr<int>("in_num_col_dims", 1);
+  fc->SetAttr<int>("quantize_weight_bits", 16);
+  std::vector<float> w_scales(n);
+  for (int j = 0; j < n; j++) {
+    w_scales[j] = 1e-4f * (j + 1);
+  }
+  fc->SetAttr<std::vector<float>>("w_quant_scale", w_scales);
+  AddOp(block, "fetch", "X", "conv_out", "Out", "fetch", "def", host)
+      ->SetAttr<int>("col", 0);
+  AddOp(block, "fetch", "X", "fc_out", "Out", "fetch", "def", host)
+      ->SetAttr<int>("col", 1);
+
+  Scope scope;
+  auto* filter = scope.Var("filter")->GetMutable<Tensor>();
+  filter->Resize({oc, ic, 3, 3});
+  auto* filter_data = filter->mutable_data<int8_t>();
+  for (int64_t i = 0; i < filter->numel(); i++) {
+    filter_data[i] = static_cast<int8_t>(i % 255 - 127);
+  }
+  auto* w = scope.Var("w")->GetMutable<Tensor>();
+  w->Resize({k, n});
+  auto* w_data = w->mutable_data<int16_t>();
+  for (int64_t i = 0; i < w->numel(); i++) {
+    w_data[i] = static_cast<int16_t>((i * 2731) % 65535 - 32767);
+  }
+  const std::string model_file = "weight_quantized_conv_fc";
+  SaveModelNaive(model_file, scope, program_desc);
+
+  LightPredictor predictor(model_file + ".nb", false);
+  EXPECT_EQ(predictor.GetTensor("filter")->precision(), PRECISION(kInt8));
+  EXPECT_EQ(predictor.GetTensor("w")->precision(), PRECISION(kInt16));
+  auto* input_tensor = predictor.GetInput(0);
+  input_tensor->Resize({1, ic, hw, hw});
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < ic * hw * hw; i++) {
+    data[i] = (i % 13) * 0.1f - 0.6f;
+  }
+  predictor.Run();
+
+  const auto* conv_output = predictor.GetOutput(0);
+  ASSERT_EQ(conv_output->dims().Vectorize(),
+            std::vector<int64_t>({1, oc, hw, hw}));
+  const float* conv_data = conv_output->data<float>();
+  for (int o = 0; o < oc; o++) {
+    for (int y = 0; y < hw; y++) {
+      for (int x = 0; x < hw; x++) {
+        float ref = 0.f;
+        for (int c = 0; c < ic; c++) {
+          for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+              int iy = y + i - 1;
+              int ix = x + j - 1;
+              if (iy < 0 || iy >= hw || ix < 0 || ix >= hw) continue;
+              ref += data[(c * hw + iy) * hw + ix] * filter_scales[o] *
+                     filter_data[((o * ic + c) * 3 + i) * 3 + j];
+            }
+          }
+        }
+        EXPECT_NEAR(conv_data[(o * hw + y) * hw + x], ref, 1e-3);
+      }
+    }
+  }
+
+  const auto* fc_output = predictor.GetOutput(1);
+  ASSERT_EQ(fc_output->dims().Vectorize(), std::vector<int64_t>({1, n}));
+  const float* fc_data = fc_output->data<float>();
+  for (int j = 0; j < n; j++) {
+    float ref = 0.f;
+    for (int p = 0; p < k; p++) {
+      ref += conv_data[p] * w_scales[j] * w_data[p * n + j];
+    }
+    EXPECT_NEAR(fc_data[j], ref, 1e-3);
+  }
+}
+#endif
+
+TEST(LightAPI, runtime_profiler) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+  LightPredictor predictor(FLAGS_optimized_model, "", "");
+  auto* input_tensor = predictor.GetInput(0);
+  input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+
+  // Profile one of every 2 runs.
+  predictor.runtime_profiler()->Enable(2);
+  for (int i = 0; i < 4; i++) {
+    predictor.Run();
+  }
+  predictor.runtime_profiler()->Disable();
+  predictor.Run();
+
+  const auto& records = predictor.runtime_profiler()->records();
+  ASSERT_FALSE(records.empty());
+  ASSERT_EQ(records.size() % 2, 0u);
+  size_t num_ops = records.size() / 2;
+  for (size_t i = 0; i < records.size(); i++) {
+    EXPECT_EQ(records[i].run_id, static_cast<int>(i / num_ops));
+    EXPECT_EQ(records[i].op_type, records[i % num_ops].op_type);
+    EXPECT_FALSE(records[i].kernel.empty());
+    EXPECT_FALSE(records[i].output_shapes.empty());
+    EXPECT_GE(records[i].duration_us, 0.);
+  }
+  auto trace = predictor.runtime_profiler()->ChromeTrace();
+  EXPECT_EQ(trace.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(trace.find(records[0].op_type), std::string::npos);
+}
+
+TEST(LightAPI, runtime_profiler_max_records) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+  LightPredictor predictor(FLAGS_optimized_model, "", "");
+  auto* input_tensor = predictor.GetInput(0);
+  input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+
+  auto* profiler = predictor.runtime_profiler();
+  profiler->Enable(1);
+  predictor.Run();
+  const size_t num_ops = profiler->records().size();
+  ASSERT_GT(num_ops, 0u);
+  EXPECT_EQ(profiler->num_dropped_records(), 0);
+
+  // Only the newest records are kept.
+  const int max_records = static_cast<int>(num_ops) + 1;
+  profiler->Enable(1, max_records);
+  for (int i = 0; i < 3; i++) {
+    predictor.Run();
+  }
+  auto records = profiler->records();
+  ASSERT_EQ(records.size(), static_cast<size_t>(max_records));
+  EXPECT_EQ(profiler->num_dropped_records(),
+            static_cast<int64_t>(3 * num_ops - max_records));
+  EXPECT_EQ(records.front().run_id, 1);
+  for (size_t i = 1; i < records.size(); i++) {
+    EXPECT_EQ(records[i].run_id, 2);
+  }
+
+  // The dropped records are reset by enabling the profiling again.
+  profiler->Enable(1);
+  EXPECT_TRUE(profiler->records().empty());
+  EXPECT_EQ(profiler->num_dropped_records(), 0);
+}
+
 TEST(LightAPI, loadNaiveBuffer) {
   if (FLAGS_optimized_model.empty()) {
     FLAGS_optimized_model = "lite_naive_model";
@@ -104,6 +104,17 @@ void Tensor::ShareExternalMemory(void *data,
   tensor(raw_tensor_)->ResetBuffer(buf, memory_size);
 }
 
+void Tensor::ShareExternalMemory(void *data,
+                                 size_t memory_size,
+                                 TargetType target,
+                                 std::shared_ptr<void> holder) {
+  // The holder is released along with the deleter of the buffer.
+  std::shared_ptr<lite::Buffer> buf(
+      new lite::Buffer(data, target, memory_size),
+      [holder](lite::Buffer *buffer) { delete buffer; });
+  tensor(raw_tensor_)->ResetBuffer(buf, memory_size);
+}
+
 template <typename T>
 T *Tensor::mutable_data(TargetType type) const {
   return tensor(raw_tensor_)->mutable_data<T>(type);
@@ -281,6 +292,31 @@ void PaddlePredictor::SaveOptimizedModel(const std::string &model_dir,
       << "The SaveOptimizedModel API is only supported by CxxConfig predictor.";
 }
 
+void PaddlePredictor::EnableProfiling(int sample_interval, int max_records) {
+  LOG(FATAL) << "The EnableProfiling API is not supported by this predictor.";
+}
+
+void PaddlePredictor::DisableProfiling() {
+  LOG(FATAL) << "The DisableProfiling API is not supported by this predictor.";
+}
+
+std::vector<OpProfileRecord> PaddlePredictor::GetProfileRecords() const {
+  LOG(FATAL) << "The GetProfileRecords API is not supported by this predictor.";
+  return {};
+}
+
+int64_t PaddlePredictor::GetNumDroppedProfileRecords() const {
+  LOG(FATAL) << "The GetNumDroppedProfileRecords API is not supported by this "
+                "predictor.";
+  return 0;
+}
+
+std::string PaddlePredictor::GetProfileChromeTrace() const {
+  LOG(FATAL)
+      << "The GetProfileChromeTrace API is not supported by this predictor.";
+  return "";
+}
+
 template <typename ConfigT>
 std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(const ConfigT &) {
   return std::shared_ptr<PaddlePredictor>();
@@ -386,6 +422,35 @@ void ConfigBase::set_x86_math_num_threads(int threads) {
   x86_math_num_threads_ = threads;
 }
 int ConfigBase::x86_math_num_threads() const { return x86_math_num_threads_; }
+void ConfigBase::set_x86_math_cpu_ids(const std::vector<int> &cpu_ids) {
+  x86_math_cpu_ids_ = cpu_ids;
+}
+const std::vector<int> &ConfigBase::x86_math_cpu_ids() const {
+  return x86_math_cpu_ids_;
+}
+void ConfigBase::set_x86_inter_op_parallel(bool enable) {
+  x86_inter_op_parallel_ = enable;
+}
+bool ConfigBase::x86_inter_op_parallel() const {
+  return x86_inter_op_parallel_;
+}
+void ConfigBase::set_x86_kernel_tune(CPUTuneMode mode,
+                                     const std::string &tune_file,
+                                     int repeats) {
+  CHECK_GT(repeats, 0) << "The repeats of x86 kernel tuning should be > 0.";
+  x86_kernel_tune_mode_ = mode;
+  x86_kernel_tune_file_ = tune_file;
+  x86_kernel_tune_repeats_ = repeats;
+}
+CPUTuneMode ConfigBase::x86_kernel_tune_mode() const {
+  return x86_kernel_tune_mode_;
+}
+const std::string &ConfigBase::x86_kernel_tune_file() const {
+  return x86_kernel_tune_file_;
+}
+int ConfigBase::x86_kernel_tune_repeats() const {
+  return x86_kernel_tune_repeats_;
+}
 #endif
 
 void ConfigBase::set_subgraph_model_cache_buffers(
@@ -62,6 +62,12 @@ struct LITE_API Tensor {
   // state
   // during the prediction process.
   void ShareExternalMemory(void* data, size_t memory_size, TargetType target);
+  // Share external memory which is kept alive by the holder, the holder is
+  // released once the tensor no longer uses the memory.
+  void ShareExternalMemory(void* data,
+                           size_t memory_size,
+                           TargetType target,
+                           std::shared_ptr<void> holder);
 
   template <typename T, TargetType type = TargetType::kHost>
   void CopyFromCpu(const T* data);
@@ -85,6 +91,30 @@ struct LITE_API Tensor {
   void* raw_tensor_;
 };
 
+/// The default max number of the kept profiling records.
+constexpr int kDefaultMaxProfileRecords = 1 << 16;
+
+/// The profiling record of an op in a profiled run.
+struct LITE_API OpProfileRecord {
+  /// The index of the profiled run, starting from 0.
+  int run_id{0};
+  std::string op_type;
+  /// The summary of the kernel, including its target, precision, layout and
+  /// alias.
+  std::string kernel;
+  std::vector<shape_t> input_shapes;
+  std::vector<shape_t> output_shapes;
+  /// The start time since the profiling is enabled, in microseconds.
+  double start_us{0.};
+  /// The wall time of the op, in microseconds.
+  double duration_us{0.};
+  /// The amount of computation in GOPs, which is only available when the
+  /// library is built with LITE_WITH_PROFILE, otherwise it's 0.
+  float gops{0.f};
+  /// The bytes allocated by the op, excluding the reused memory.
+  int64_t allocated_bytes{0};
+};
+
 /// The PaddlePredictor defines the basic interfaces for different kinds of
 /// predictors.
 class LITE_API PaddlePredictor {
@@ -131,6 +161,22 @@ class LITE_API PaddlePredictor {
       LiteModelType model_type = LiteModelType::kProtobuf,
       bool record_info = false);
 
+  /// Enable the op level profiling, which profiles one of every
+  /// `sample_interval` runs. The records of the last profiling are cleared.
+  /// At most `max_records` records are kept, the oldest ones are dropped
+  /// when the limit is reached.
+  virtual void EnableProfiling(int sample_interval = 1,
+                               int max_records = kDefaultMaxProfileRecords);
+  /// Disable the op level profiling, the records are kept.
+  virtual void DisableProfiling();
+  /// Get the kept records of the ops of the profiled runs.
+  virtual std::vector<OpProfileRecord> GetProfileRecords() const;
+  /// Get the number of the records dropped because of `max_records`.
+  virtual int64_t GetNumDroppedProfileRecords() const;
+  /// Get the records in the Chrome trace event format, which can be loaded by
+  /// chrome://tracing or Perfetto.
+  virtual std::string GetProfileChromeTrace() const;
+
   virtual ~PaddlePredictor() = default;
 
  protected:
@@ -172,6 +218,11 @@ class LITE_API ConfigBase {
   std::string nnadapter_subgraph_partition_config_buffer_{};
   int device_id_{0};
   int x86_math_num_threads_ = 1;
+  std::vector<int> x86_math_cpu_ids_{};
+  bool x86_inter_op_parallel_{false};
+  CPUTuneMode x86_kernel_tune_mode_{CPU_TUNE_NONE};
+  std::string x86_kernel_tune_file_{""};
+  int x86_kernel_tune_repeats_{3};
 
   std::string metal_path_;
   bool metal_use_mps_;
@@ -279,6 +330,27 @@ class LITE_API ConfigBase {
   // set x86_math_num_threads
   void set_x86_math_num_threads(int threads);
   int x86_math_num_threads() const;
+  // set the CPUs which the x86 math threads are bound to, it only takes effect
+  // when the x86 math threads are managed by the built-in thread pool(without
+  // MKL)
+  void set_x86_math_cpu_ids(const std::vector<int>& cpu_ids);
+  const std::vector<int>& x86_math_cpu_ids() const;
+  // run the independent ops concurrently on the x86 math threads, the ops
+  // which run concurrently are single-threaded. It's only used when all of the
+  // ops are on the host.
+  void set_x86_inter_op_parallel(bool enable);
+  bool x86_inter_op_parallel() const;
+  // choose the implementation variants of the x86 kernels (e.g. the conv
+  // algorithms) by benchmarking them at the actual shapes on the first run.
+  // The winners are keyed by the op signature and the CPU model, and they are
+  // loaded from and saved to tune_file if it's not empty. Each variant is run
+  // `repeats` times and the fastest run counts.
+  void set_x86_kernel_tune(CPUTuneMode mode = CPU_TUNE_NONE,
+                           const std::string& tune_file = "",
+                           int repeats = 3);
+  CPUTuneMode x86_kernel_tune_mode() const;
+  const std::string& x86_kernel_tune_file() const;
+  int x86_kernel_tune_repeats() const;
 
   void set_metal_lib_path(const std::string& path);
   void set_metal_use_mps(bool flag);
@@ -317,6 +389,10 @@ class LITE_API CxxConfig : public ConfigBase {
   std::vector<std::string> passes_internal_{};
   bool quant_model_{false};  // Enable post_quant_dynamic in opt
   QuantType quant_type_{QuantType::QUANT_INT16};
+  EmbeddingCompressType embedding_compress_type_{
+      EmbeddingCompressType::COMPRESS_NONE};  // Enable embedding_compress_pass
+  bool enable_x86_bf16_{false};               // Enable bf16_weight_pass
+  bool enable_x86_prepacked_weights_{false};  // Enable weight_prepack_pass
   std::map<int, std::vector<std::shared_ptr<void>>>
       preferred_inputs_for_warmup_;
 #ifdef LITE_WITH_CUDA
@@ -430,6 +506,29 @@ class LITE_API CxxConfig : public ConfigBase {
   bool quant_model() const { return quant_model_; }
   void set_quant_type(QuantType quant_type) { quant_type_ = quant_type; }
   QuantType quant_type() const { return quant_type_; }
+  // Compress the fp32 tables of the x86 embedding lookups in opt.
+  void set_embedding_compress_type(EmbeddingCompressType type) {
+    embedding_compress_type_ = type;
+  }
+  EmbeddingCompressType embedding_compress_type() const {
+    return embedding_compress_type_;
+  }
+  // Store the fp32 weights of the x86 fc, matmul, conv2d and embedding
+  // lookups in bf16, they are computed with the fp32 accumulation.
+  void set_enable_x86_bf16(bool enable_x86_bf16) {
+    enable_x86_bf16_ = enable_x86_bf16;
+  }
+  bool enable_x86_bf16() const { return enable_x86_bf16_; }
+  // Pack the weights of the x86 fc, mul, matmul and conv2d kernels when the
+  // predictor is created, the packed weights are saved by
+  // SaveOptimizedModel, so they are not packed again when the model is
+  // loaded. It isn't supported by the opt tool, whose x86 kernels don't pack.
+  void set_enable_x86_prepacked_weights(bool enable_x86_prepacked_weights) {
+    enable_x86_prepacked_weights_ = enable_x86_prepacked_weights;
+  }
+  bool enable_x86_prepacked_weights() const {
+    return enable_x86_prepacked_weights_;
+  }
 };
 
 /// MobileConfig is the config for the light weight predictor, it will skip
@@ -438,6 +537,8 @@ class LITE_API MobileConfig : public ConfigBase {
   // whether to load data from memory. Model data will be loaded from memory
   // buffer if model_from_memory_ is true.
   bool model_from_memory_{false};
+  // whether to memory-map the model file and alias the params in place.
+  bool mmap_params_{false};
 
   // model data readed from file or memory buffer in combined format.
   std::string lite_model_file_;
@@ -463,6 +564,12 @@ class LITE_API MobileConfig : public ConfigBase {
   // abandoned in v3.0.
   bool model_from_memory() const { return model_from_memory_; }
 
+  // set whether to memory-map the model file set by `set_model_from_file` and
+  // alias the params in place instead of copying them, the read-only pages of
+  // params are shared by all the processes which load the same model file.
+  void set_mmap_params(bool x) { mmap_params_ = x; }
+  bool mmap_params() const { return mmap_params_; }
+
   // NOTE: This is a deprecated API and will be removed in latter release.
   void set_model_buffer(const char* model_buffer,
                         size_t model_buffer_size,
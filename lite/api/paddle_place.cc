@@ -103,7 +103,8 @@ const std::string& PrecisionToStr(PrecisionType precision) {
                                                  "int64_t",
                                                  "int16_t",
                                                  "uint8_t",
-                                                 "double"};
+                                                 "double",
+                                                 "bfloat16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -118,7 +119,8 @@ const std::string& DataLayoutToStr(DataLayoutType layout) {
                                                   "ImageFolder",
                                                   "ImageNW",
                                                   "MetalTexture2DArray",
-                                                  "MetalTexture2D"};
+                                                  "MetalTexture2D",
+                                                  "NCHW8c"};
   auto x = static_cast<int>(layout);
   CHECK_LT(x, static_cast<int>(DATALAYOUT(NUM)));
   return datalayout2string[x];
@@ -158,7 +160,10 @@ const std::string& PrecisionRepr(PrecisionType precision) {
                                                  "kFP16",
                                                  "kBool",
                                                  "kInt64",
-                                                 "kInt16"};
+                                                 "kInt16",
+                                                 "kUInt8",
+                                                 "kFP64",
+                                                 "kBF16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -173,7 +178,8 @@ const std::string& DataLayoutRepr(DataLayoutType layout) {
                                                   "kImageFolder",
                                                   "kImageNW",
                                                   "kMetalTexture2DArray",
-                                                  "kMetalTexture2D"};
+                                                  "kMetalTexture2D",
+                                                  "kNCHW8c"};
   auto x = static_cast<int>(layout);
   CHECK_LT(x, static_cast<int>(DATALAYOUT(NUM)));
   return datalayout2string[x];
@@ -186,6 +192,13 @@ const std::string& CLTuneModeToStr(CLTuneMode mode) {
   return cl_tune_mode[x];
 }
 
+const std::string& CPUTuneModeToStr(CPUTuneMode mode) {
+  static const std::string cpu_tune_mode[] = {
+      "CPU_TUNE_NONE", "CPU_TUNE_CACHED", "CPU_TUNE_NORMAL"};
+  auto x = static_cast<int>(mode);
+  return cpu_tune_mode[x];
+}
+
 const std::string& CLPrecisionTypeToStr(CLPrecisionType type) {
   static const std::string cl_precision_type[] = {
       "CL_PRECISION_AUTO", "CL_PRECISION_FP32", "CL_PRECISION_FP16"};
@@ -234,7 +247,8 @@ std::set<DataLayoutType> ExpandValidLayouts(DataLayoutType layout) {
        DATALAYOUT(kImageFolder),
        DATALAYOUT(kImageNW),
        DATALAYOUT(kMetalTexture2DArray),
-       DATALAYOUT(kMetalTexture2D)});
+       DATALAYOUT(kMetalTexture2D),
+       DATALAYOUT(kNCHW8c)});
   if (layout == DATALAYOUT(kAny)) {
     return valid_set;
   }
@@ -76,7 +76,8 @@ enum class PrecisionType : int {
   kInt16 = 8,
   kUInt8 = 9,
   kFP64 = 10,
-  NUM = 11,  // number of fields.
+  kBF16 = 11,
+  NUM = 12,  // number of fields.
 };
 enum class DataLayoutType : int {
   kUnk = 0,
@@ -88,7 +89,8 @@ enum class DataLayoutType : int {
   kAny = 2,           // any data layout
   kMetalTexture2DArray = 7,
   kMetalTexture2D = 8,
-  NUM = 9,  // number of fields.
+  kNCHW8c = 9,  // for x86, NCHW blocked by 8 channels
+  NUM = 10,     // number of fields.
 };
 
 typedef enum {
@@ -107,6 +109,13 @@ typedef enum {
   CL_TUNE_EXHAUSTIVE = 3
 } CLTuneMode;
 
+// How the implementation variants of the x86 kernels are chosen.
+typedef enum {
+  CPU_TUNE_NONE = 0,    // by the static heuristics
+  CPU_TUNE_CACHED = 1,  // by the winners in the tuning cache if any
+  CPU_TUNE_NORMAL = 2,  // benchmark the variants missing in the tuning cache
+} CPUTuneMode;
+
 typedef enum {
   CL_PRECISION_AUTO = 0,
   CL_PRECISION_FP32 = 1,
@@ -158,6 +167,8 @@ static size_t PrecisionTypeLength(PrecisionType type) {
       return 8;
     case PrecisionType::kFP16:
       return 2;
+    case PrecisionType::kBF16:
+      return 2;
     case PrecisionType::kInt16:
       return 2;
     default:
@@ -170,6 +181,14 @@ enum class QuantType : int {
   QUANT_INT16,
 };
 
+// The formats of the fp32 embedding tables compressed by opt for the x86
+// lookup kernels, which dequantize the rows on gather.
+enum class EmbeddingCompressType : int {
+  COMPRESS_NONE,
+  COMPRESS_INT8,  // row-wise symmetric int8 with a fp32 scale per row
+  COMPRESS_FP16,
+};
+
 template <typename T>
 struct PrecisionTypeTrait {
   constexpr static PrecisionType Type() { return PrecisionType::kUnk; }
@@ -225,6 +244,8 @@ const std::string& DataLayoutRepr(DataLayoutType layout);
 
 const std::string& CLTuneModeToStr(CLTuneMode mode);
 
+const std::string& CPUTuneModeToStr(CPUTuneMode mode);
+
 const std::string& CLPrecisionTypeToStr(CLPrecisionType type);
 
 // Get a set of all the elements represented by the target.
@@ -32,12 +32,16 @@ USE_MIR_PASS(graph_visualize_pass);
 USE_MIR_PASS(adaptive_1x1_pool2d_convert_global_pass);
 USE_MIR_PASS(remove_scale1_pass);
 USE_MIR_PASS(remove_tf_redundant_ops_pass);
+USE_MIR_PASS(constant_folding_pass);
+USE_MIR_PASS(common_subexpression_elimination_pass);
+USE_MIR_PASS(dead_code_elimination_pass);
 USE_MIR_PASS(lite_conv_bn_fuse_pass);
 USE_MIR_PASS(lite_conv_conv_fuse_pass);
 USE_MIR_PASS(lite_squeeze2_matmul_fuse_pass);
 USE_MIR_PASS(lite_reshape2_matmul_fuse_pass);
 USE_MIR_PASS(lite_matmul_fuse_pass);
 USE_MIR_PASS(lite_fc_fuse_pass);
+USE_MIR_PASS(lite_fused_multihead_attention_fuse_pass);
 USE_MIR_PASS(lite_matmul_element_add_fuse_pass);
 USE_MIR_PASS(lite_shuffle_channel_fuse_pass);
 USE_MIR_PASS(lite_transpose_softmax_transpose_fuse_pass);
@@ -52,6 +56,7 @@ USE_MIR_PASS(lite_match_matrix_activation_fuse_pass);
 USE_MIR_PASS(lite_scales_fuse_pass);
 USE_MIR_PASS(lite_scaleacts_fuse_pass);
 USE_MIR_PASS(lite_sequence_reverse_embedding_fuse_pass);
+USE_MIR_PASS(lite_embedding_seq_pool_fuse_pass);
 USE_MIR_PASS(lite_elementwise_activation_fuse_pass);
 USE_MIR_PASS(lite_elementwise_scale_fuse_pass);
 USE_MIR_PASS(lite_conv_scale_fuse_pass);
@@ -73,6 +78,9 @@ USE_MIR_PASS(mlu_subgraph_pass);
 USE_MIR_PASS(mlu_postprocess_pass);
 USE_MIR_PASS(weight_quantization_preprocess_pass);
 USE_MIR_PASS(post_quant_dynamic_pass);
+USE_MIR_PASS(embedding_compress_pass);
+USE_MIR_PASS(bf16_weight_pass);
+USE_MIR_PASS(weight_prepack_pass);
 USE_MIR_PASS(fp16_attribute_pass);
 USE_MIR_PASS(apu_subgraph_pass);
 USE_MIR_PASS(fpga_concat_fuse_pass);
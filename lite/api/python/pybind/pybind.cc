@@ -45,6 +45,7 @@ using lite_api::CxxConfig;
 using lite_api::DataLayoutType;
 using lite_api::MLUCoreVersion;
 using lite_api::MobileConfig;
+using lite_api::OpProfileRecord;
 using lite_api::OptBase;
 using lite_api::Place;
 using lite_api::PowerMode;
@@ -69,6 +70,8 @@ void BindLiteOpt(py::module *m) {
       .def("set_model_type", &OptBase::SetModelType)
       .def("set_quant_model", &OptBase::SetQuantModel)
       .def("set_quant_type", &OptBase::SetQuantType)
+      .def("set_embedding_compress_type", &OptBase::SetEmbeddingCompressType)
+      .def("set_x86_bf16", &OptBase::SetX86Bf16)
       .def("record_model_info", &OptBase::RecordModelInfo)
       .def("set_passes_internal", &OptBase::SetPassesInternal)
       .def("run", &OptBase::Run)
@@ -104,18 +107,17 @@ void BindLiteApi(py::module *m) {
 // Global helper methods
 #ifndef LITE_ON_TINY_PUBLISH
   m->def("create_paddle_predictor",
-         [](const CxxConfig &config) -> std::unique_ptr<CxxPaddleApiImpl> {
-           auto x = std::unique_ptr<CxxPaddleApiImpl>(new CxxPaddleApiImpl());
+         [](const CxxConfig &config) -> std::shared_ptr<CxxPaddleApiImpl> {
+           auto x = std::make_shared<CxxPaddleApiImpl>();
            x->Init(config);
-           return std::move(x);
+           return x;
          });
 #endif
   m->def("create_paddle_predictor",
-         [](const MobileConfig &config) -> std::unique_ptr<LightPredictorImpl> {
-           auto x =
-               std::unique_ptr<LightPredictorImpl>(new LightPredictorImpl());
+         [](const MobileConfig &config) -> std::shared_ptr<LightPredictorImpl> {
+           auto x = std::make_shared<LightPredictorImpl>();
            x->Init(config);
-           return std::move(x);
+           return x;
          });
 }
 
@@ -164,7 +166,9 @@ void BindLiteMobileConfig(py::module *m) {
       .def("set_model_dir", &MobileConfig::set_model_dir)
       .def("model_dir", &MobileConfig::model_dir)
       .def("set_model_buffer", &MobileConfig::set_model_buffer)
-      .def("is_model_from_memory", &MobileConfig::is_model_from_memory);
+      .def("is_model_from_memory", &MobileConfig::is_model_from_memory)
+      .def("set_mmap_params", &MobileConfig::set_mmap_params)
+      .def("mmap_params", &MobileConfig::mmap_params);
 #ifdef LITE_WITH_ARM
   mobile_config.def("set_threads", &MobileConfig::set_threads)
       .def("threads", &MobileConfig::threads)
@@ -227,6 +231,7 @@ void BindLitePlace(py::module *m) {
       .value("ImageDefault", DataLayoutType::kImageDefault)
       .value("ImageFolder", DataLayoutType::kImageFolder)
       .value("ImageNW", DataLayoutType::kImageNW)
+      .value("NCHW8c", DataLayoutType::kNCHW8c)
       .value("Any", DataLayoutType::kAny);
 
   // Place
@@ -237,6 +242,18 @@ void BindLitePlace(py::module *m) {
            py::arg("layout") = DataLayoutType::kNCHW,
            py::arg("device") = 0)
       .def("is_valid", &Place::is_valid);
+
+  // OpProfileRecord
+  py::class_<OpProfileRecord>(*m, "OpProfileRecord")
+      .def_readonly("run_id", &OpProfileRecord::run_id)
+      .def_readonly("op_type", &OpProfileRecord::op_type)
+      .def_readonly("kernel", &OpProfileRecord::kernel)
+      .def_readonly("input_shapes", &OpProfileRecord::input_shapes)
+      .def_readonly("output_shapes", &OpProfileRecord::output_shapes)
+      .def_readonly("start_us", &OpProfileRecord::start_us)
+      .def_readonly("duration_us", &OpProfileRecord::duration_us)
+      .def_readonly("gops", &OpProfileRecord::gops)
+      .def_readonly("allocated_bytes", &OpProfileRecord::allocated_bytes);
 }
 
 void BindLiteTensor(py::module *m) {
@@ -260,7 +277,8 @@ void BindLiteTensor(py::module *m) {
       .def("from_numpy",
            SetTensorFromPyArray,
            py::arg("array"),
-           py::arg("place") = TargetType::kHost);
+           py::arg("place") = TargetType::kHost,
+           py::arg("share_memory") = false);
 
 #define DO_GETTER_ONCE(data_type__, name__)                           \
   tensor.def(#name__, [=](Tensor &self) -> std::vector<data_type__> { \
@@ -300,14 +318,44 @@ void BindLiteTensor(py::module *m) {
 #undef DATA_GETTER_SETTER_ONCE
 }
 
+// Run the predictor on its own worker thread, and return the
+// concurrent.futures.Future of the run. The runs of a predictor are
+// serialized, the runs of the cloned predictors are parallel since the GIL is
+// released by run.
+static py::object RunPredictorAsync(py::object self) {
+  if (!py::hasattr(self, "_run_executor")) {
+    auto executor_type =
+        py::module::import("concurrent.futures").attr("ThreadPoolExecutor");
+    self.attr("_run_executor") = executor_type(1);
+  }
+  return self.attr("_run_executor").attr("submit")(self.attr("run"));
+}
+
 #ifndef LITE_ON_TINY_PUBLISH
 void BindLiteCxxPredictor(py::module *m) {
-  py::class_<CxxPaddleApiImpl>(*m, "CxxPredictor")
+  py::class_<CxxPaddleApiImpl, std::shared_ptr<CxxPaddleApiImpl>>(
+      *m, "CxxPredictor", py::dynamic_attr())
       .def(py::init<>())
       .def("get_input", &CxxPaddleApiImpl::GetInput)
       .def("get_output", &CxxPaddleApiImpl::GetOutput)
-      .def("run", &CxxPaddleApiImpl::Run)
+      .def("run",
+           &CxxPaddleApiImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_async", RunPredictorAsync)
+      .def("clone",
+           [](CxxPaddleApiImpl &self) {
+             return std::static_pointer_cast<CxxPaddleApiImpl>(self.Clone());
+           })
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
+      .def("enable_profiling",
+           &CxxPaddleApiImpl::EnableProfiling,
+           py::arg("sample_interval") = 1,
+           py::arg("max_records") = lite_api::kDefaultMaxProfileRecords)
+      .def("disable_profiling", &CxxPaddleApiImpl::DisableProfiling)
+      .def("get_profile_records", &CxxPaddleApiImpl::GetProfileRecords)
+      .def("get_num_dropped_profile_records",
+           &CxxPaddleApiImpl::GetNumDroppedProfileRecords)
+      .def("get_profile_chrome_trace", &CxxPaddleApiImpl::GetProfileChromeTrace)
       .def("save_optimized_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
              self.SaveOptimizedModel(output_dir,
@@ -317,12 +365,30 @@ void BindLiteCxxPredictor(py::module *m) {
 #endif
 
 void BindLiteLightPredictor(py::module *m) {
-  py::class_<LightPredictorImpl>(*m, "LightPredictor")
+  py::class_<LightPredictorImpl, std::shared_ptr<LightPredictorImpl>>(
+      *m, "LightPredictor", py::dynamic_attr())
       .def(py::init<>())
       .def("get_input", &LightPredictorImpl::GetInput)
       .def("get_output", &LightPredictorImpl::GetOutput)
-      .def("run", &LightPredictorImpl::Run)
-      .def("get_version", &LightPredictorImpl::GetVersion);
+      .def("run",
+           &LightPredictorImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_async", RunPredictorAsync)
+      .def("clone",
+           [](LightPredictorImpl &self) {
+             return std::static_pointer_cast<LightPredictorImpl>(self.Clone());
+           })
+      .def("get_version", &LightPredictorImpl::GetVersion)
+      .def("enable_profiling",
+           &LightPredictorImpl::EnableProfiling,
+           py::arg("sample_interval") = 1,
+           py::arg("max_records") = lite_api::kDefaultMaxProfileRecords)
+      .def("disable_profiling", &LightPredictorImpl::DisableProfiling)
+      .def("get_profile_records", &LightPredictorImpl::GetProfileRecords)
+      .def("get_num_dropped_profile_records",
+           &LightPredictorImpl::GetNumDroppedProfileRecords)
+      .def("get_profile_chrome_trace",
+           &LightPredictorImpl::GetProfileChromeTrace);
 }
 
 }  // namespace pybind
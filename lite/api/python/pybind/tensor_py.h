@@ -16,6 +16,7 @@
 #define LITE_API_PYTHON_PYBIND_TENSOR_PY_H_
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <map>
@@ -26,6 +27,7 @@
 #include <vector>
 #include "lite/api/paddle_api.h"
 #include "lite/api/python/pybind/pybind.h"
+#include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
 
 namespace py = pybind11;
@@ -102,15 +104,58 @@ inline py::array TensorToPyArray(const Tensor &tensor,
                    base);
 }
 
+////////////////////////////////////////////////////////////////
+// Function Name: SharedPyArrayBuffers
+// Usage: The data pointers of the numpy arrays which are shared
+//        by the tensors. A pointer is only kept while a tensor
+//        still holds the array, it's only accessed with the GIL
+//        held.
+////////////////////////////////////////////////////////////////
+inline std::multiset<const void *> &SharedPyArrayBuffers() {
+  static auto *buffers = new std::multiset<const void *>();
+  return *buffers;
+}
+
+////////////////////////////////////////////////////////////////
+// Function Name: SharePyArray
+// Usage: Share the nbytes at data, which lie in the buffer of
+//        the numpy array, with the tensor. The array is held by
+//        the buffer of the tensor, and is released once the
+//        tensor is filled again or destroyed.
+////////////////////////////////////////////////////////////////
+inline void SharePyArray(Tensor *self,
+                         const py::array &array,
+                         const void *data,
+                         size_t nbytes,
+                         const TargetType &place) {
+  SharedPyArrayBuffers().insert(data);
+  std::shared_ptr<void> holder(new py::object(array), [data](void *object) {
+    // The tensor may be released by a thread without the GIL.
+    if (!Py_IsInitialized()) return;
+    py::gil_scoped_acquire gil;
+    auto &buffers = SharedPyArrayBuffers();
+    auto iter = buffers.find(data);
+    if (iter != buffers.end()) buffers.erase(iter);
+    delete static_cast<py::object *>(object);
+  });
+  self->ShareExternalMemory(const_cast<void *>(data), nbytes, place, holder);
+}
+
 ////////////////////////////////////////////////////////////////
 // Function Name: SetTensorFromPyArrayT
-// Usage: Transform numpy of specified precision into tensor
+// Usage: Transform numpy of specified precision into tensor. If
+//        share_memory is true, the tensor on the host shares the
+//        buffer of the C-contiguous numpy array aligned to
+//        MALLOC_ALIGN without copying, which must not be modified
+//        until the run ends. The unaligned array is copied, since
+//        the SIMD kernels rely on the alignment of the tensors.
 ////////////////////////////////////////////////////////////////
 template <typename T>
 void SetTensorFromPyArrayT(
     Tensor *self,
     const py::array_t<T, py::array::c_style | py::array::forcecast> &array,
-    const TargetType &place) {
+    const TargetType &place,
+    bool share_memory = false) {
   std::vector<int64_t> dims;
   dims.reserve(array.ndim());
   for (decltype(array.ndim()) i = 0; i < array.ndim(); ++i) {
@@ -118,6 +163,30 @@ void SetTensorFromPyArrayT(
   }
   self->Resize(dims);
 
+  // The buffer of a shared numpy array is never written, the tensor which
+  // shares one shares a private copy of the new array instead.
+  bool sharing = self->IsInitialized() &&
+                 SharedPyArrayBuffers().count(self->data<int8_t>()) > 0;
+  bool on_host = place == TargetType::kHost || place == TargetType::kX86 ||
+                 place == TargetType::kARM;
+  bool aligned =
+      reinterpret_cast<uintptr_t>(array.data()) % MALLOC_ALIGN == 0;
+  if (on_host && array.nbytes() > 0 && (sharing || share_memory)) {
+    if (share_memory && aligned) {
+      SharePyArray(self, array, array.data(), array.nbytes(), place);
+    } else {
+      // The copy is placed at the aligned address of a larger array.
+      py::array_t<int8_t> copy(array.nbytes() + MALLOC_ALIGN);
+      const uintptr_t mask = MALLOC_ALIGN - 1;
+      auto addr = reinterpret_cast<uintptr_t>(copy.mutable_data());
+      void *data = reinterpret_cast<void *>((addr + mask) & ~mask);
+      std::memcpy(data, array.data(), array.nbytes());
+      SharePyArray(self, copy, data, array.nbytes(), place);
+    }
+    self->SetPrecision(lite_api::PrecisionTypeTrait<T>::Type());
+    return;
+  }
+
   auto dst = self->mutable_data<T>(place);
   std::memcpy(dst, array.data(), array.nbytes());
 }
@@ -131,24 +200,25 @@ void SetTensorFromPyArrayT(
 ////////////////////////////////////////////////////////////////
 void SetTensorFromPyArray(Tensor *self,
                           const py::object &obj,
-                          const TargetType &place) {
+                          const TargetType &place,
+                          bool share_memory = false) {
   auto array = obj.cast<py::array>();
   if (py::isinstance<py::array_t<float>>(array)) {
-    SetTensorFromPyArrayT<float>(self, array, place);
+    SetTensorFromPyArrayT<float>(self, array, place, share_memory);
   } else if (py::isinstance<py::array_t<int>>(array)) {
-    SetTensorFromPyArrayT<int>(self, array, place);
+    SetTensorFromPyArrayT<int>(self, array, place, share_memory);
   } else if (py::isinstance<py::array_t<int64_t>>(array)) {
-    SetTensorFromPyArrayT<int64_t>(self, array, place);
+    SetTensorFromPyArrayT<int64_t>(self, array, place, share_memory);
   } else if (py::isinstance<py::array_t<double>>(array)) {
-    SetTensorFromPyArrayT<double>(self, array, place);
+    SetTensorFromPyArrayT<double>(self, array, place, share_memory);
   } else if (py::isinstance<py::array_t<int8_t>>(array)) {
-    SetTensorFromPyArrayT<int8_t>(self, array, place);
+    SetTensorFromPyArrayT<int8_t>(self, array, place, share_memory);
   } else if (py::isinstance<py::array_t<int16_t>>(array)) {
-    SetTensorFromPyArrayT<int16_t>(self, array, place);
+    SetTensorFromPyArrayT<int16_t>(self, array, place, share_memory);
   } else if (py::isinstance<py::array_t<uint8_t>>(array)) {
-    SetTensorFromPyArrayT<uint8_t>(self, array, place);
+    SetTensorFromPyArrayT<uint8_t>(self, array, place, share_memory);
   } else if (py::isinstance<py::array_t<bool>>(array)) {
-    SetTensorFromPyArrayT<bool>(self, array, place);
+    SetTensorFromPyArrayT<bool>(self, array, place, share_memory);
   } else {
     // obj may be any type, obj.cast<py::array>() may be failed,
     // then the array.dtype will be string of unknown meaning,
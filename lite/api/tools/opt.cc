@@ -47,6 +47,15 @@ DEFINE_string(quant_type,
               "QUANT_INT16",
               "Set the quant_type for post_quant_dynamic, "
               "and it should be QUANT_INT8 or QUANT_INT16 for now.");
+DEFINE_string(embedding_compress_type,
+              "COMPRESS_NONE",
+              "Compress the fp32 tables of the x86 embedding lookups, "
+              "and it should be COMPRESS_NONE, COMPRESS_INT8 or "
+              "COMPRESS_FP16.");
+DEFINE_bool(enable_x86_bf16,
+            false,
+            "Store the weights of the x86 fc, matmul, conv2d and embedding "
+            "lookups in bf16.");
 DEFINE_bool(enable_fp16, false, "Set kernel_type run in FP16.");
 DEFINE_bool(record_tailoring_info,
             false,
@@ -108,6 +117,8 @@ int main(int argc, char** argv) {
     opt.SetQuantModel(true);
     opt.SetQuantType(FLAGS_quant_type);
   }
+  opt.SetEmbeddingCompressType(FLAGS_embedding_compress_type);
+  opt.SetX86Bf16(FLAGS_enable_x86_bf16);
   if (FLAGS_print_all_ops) {
     opt.PrintAllOps();
     return 0;
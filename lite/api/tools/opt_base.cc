@@ -53,6 +53,22 @@ void OptBase::SetQuantType(const std::string& quant_type) {
   }
 }
 
+void OptBase::SetEmbeddingCompressType(const std::string& compress_type) {
+  if (compress_type == "COMPRESS_INT8") {
+    opt_config_.set_embedding_compress_type(
+        lite_api::EmbeddingCompressType::COMPRESS_INT8);
+  } else if (compress_type == "COMPRESS_FP16") {
+    opt_config_.set_embedding_compress_type(
+        lite_api::EmbeddingCompressType::COMPRESS_FP16);
+  } else if (compress_type != "COMPRESS_NONE") {
+    OPT_LOG_FATAL << "Unsupported embedding compress type: " << compress_type;
+  }
+}
+
+void OptBase::SetX86Bf16(bool enable_x86_bf16) {
+  opt_config_.set_enable_x86_bf16(enable_x86_bf16);
+}
+
 void OptBase::SetPassesInternal(
     const std::vector<std::string>& passes_internal) {
   opt_config_.set_passes_internal(passes_internal);
@@ -362,6 +378,10 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "  Arguments of mode quantization in opt:\n"
       "        `--quant_model=(true|false)`\n"
       "        `--quant_type=(QUANT_INT8|QUANT_INT16)`\n"
+      "        "
+      "`--embedding_compress_type=(COMPRESS_NONE|COMPRESS_INT8|COMPRESS_FP16)`"
+      "\n"
+      "        `--enable_x86_bf16=(true|false)`\n"
       "  Arguments of enable_fp16 in opt: \n"
       "        `--enable_fp16=(true|false)`\n"
       "  Arguments of model checking and ops information:\n"
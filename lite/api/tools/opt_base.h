@@ -53,6 +53,8 @@ class LITE_API OptBase {
   void RecordModelInfo(bool record_strip_info = true);
   void SetQuantModel(bool quant_model);
   void SetQuantType(const std::string &quant_type);
+  void SetEmbeddingCompressType(const std::string &compress_type);
+  void SetX86Bf16(bool enable_x86_bf16);
   // set optimized_model type
   void SetModelType(std::string model_type = "naive_buffer");
   // internal inference for developer, not recommanded.
@@ -15,6 +15,7 @@
 #include "lite/backends/host/math/beam_search.h"
 #include <cmath>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace paddle {
@@ -149,7 +150,7 @@ std::vector<std::vector<Item>> SelectTopBeamSizeItems(const Tensor *pre_ids,
 
   // find the current candidates
   // auto abs_lod = framework::ToAbsOffset(scores->lod());
-  auto abs_lod = scores->lod();
+  const auto &abs_lod = scores->lod();
   auto *pre_ids_data = pre_ids->data<int64_t>();
   auto *pre_scores_data = pre_scores->data<float>();
 
@@ -190,7 +191,7 @@ std::vector<std::vector<Item>> SelectTopBeamSizeItems(const Tensor *pre_ids,
       }
     }
 
-    result.emplace_back(top_beam);
+    result.emplace_back(std::move(top_beam));
   }
   return result;
 }
@@ -206,7 +207,7 @@ void beam_search(const Tensor *pre_ids,
                  int beam_size,
                  int end_id,
                  bool is_accumulated) {
-  auto abs_lod = scores->lod();
+  const auto &abs_lod = scores->lod();
   auto &high_level = abs_lod[level];
   auto items = SelectTopBeamSizeItems(pre_ids,
                                       pre_scores,
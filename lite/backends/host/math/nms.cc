@@ -0,0 +1,291 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/nms.h"
+#if defined(__AVX__) || defined(__SSE__)
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+void NmsTopK(const float* scores,
+             int64_t score_stride,
+             int64_t num,
+             float score_threshold,
+             int64_t top_k,
+             std::vector<int>* indices) {
+  indices->clear();
+  for (int64_t i = 0; i < num; i++) {
+    if (scores[i * score_stride] > score_threshold) {
+      indices->push_back(static_cast<int>(i));
+    }
+  }
+  auto compare = [scores, score_stride](int a, int b) {
+    float score_a = scores[a * score_stride];
+    float score_b = scores[b * score_stride];
+    return score_a > score_b || (score_a == score_b && a < b);
+  };
+  if (top_k > -1 && top_k < static_cast<int64_t>(indices->size())) {
+    std::partial_sort(
+        indices->begin(), indices->begin() + top_k, indices->end(), compare);
+    indices->resize(top_k);
+  } else {
+    std::sort(indices->begin(), indices->end(), compare);
+  }
+}
+
+namespace {
+
+// The stored boxes in the structure of arrays.
+struct BoxArrays {
+  const float* xmin;
+  const float* ymin;
+  const float* xmax;
+  const float* ymax;
+  const float* area;
+};
+
+// The box whose IoU with the stored boxes is computed.
+struct QueryBox {
+  float xmin;
+  float ymin;
+  float xmax;
+  float ymax;
+  float area;
+  float norm;
+};
+
+inline float QueryIoU(const QueryBox& q, const BoxArrays& b, int64_t j) {
+  if (b.xmin[j] > q.xmax || b.xmax[j] < q.xmin || b.ymin[j] > q.ymax ||
+      b.ymax[j] < q.ymin) {
+    return 0.f;
+  }
+  const float inter_w =
+      (std::min)(q.xmax, b.xmax[j]) - (std::max)(q.xmin, b.xmin[j]) + q.norm;
+  const float inter_h =
+      (std::min)(q.ymax, b.ymax[j]) - (std::max)(q.ymin, b.ymin[j]) + q.norm;
+  const float inter_area = inter_w * inter_h;
+  return inter_area / (q.area + b.area[j] - inter_area);
+}
+
+#if defined(__AVX__) || defined(__SSE__)
+#ifdef __AVX__
+using VecF = __m256;
+constexpr int64_t kLanes = 8;
+inline VecF VSet(float v) { return _mm256_set1_ps(v); }
+inline VecF VLoad(const float* p) { return _mm256_loadu_ps(p); }
+inline void VStore(float* p, VecF v) { _mm256_storeu_ps(p, v); }
+inline VecF VMin(VecF a, VecF b) { return _mm256_min_ps(a, b); }
+inline VecF VMax(VecF a, VecF b) { return _mm256_max_ps(a, b); }
+inline VecF VAdd(VecF a, VecF b) { return _mm256_add_ps(a, b); }
+inline VecF VSub(VecF a, VecF b) { return _mm256_sub_ps(a, b); }
+inline VecF VMul(VecF a, VecF b) { return _mm256_mul_ps(a, b); }
+inline VecF VDiv(VecF a, VecF b) { return _mm256_div_ps(a, b); }
+inline VecF VOr(VecF a, VecF b) { return _mm256_or_ps(a, b); }
+inline VecF VAndNot(VecF a, VecF b) { return _mm256_andnot_ps(a, b); }
+inline VecF VGt(VecF a, VecF b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline VecF VLt(VecF a, VecF b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+// a > b or either is NaN, i.e. !(a <= b).
+inline VecF VNle(VecF a, VecF b) { return _mm256_cmp_ps(a, b, _CMP_NLE_UQ); }
+inline int VMask(VecF a) { return _mm256_movemask_ps(a); }
+#else
+using VecF = __m128;
+constexpr int64_t kLanes = 4;
+inline VecF VSet(float v) { return _mm_set1_ps(v); }
+inline VecF VLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void VStore(float* p, VecF v) { _mm_storeu_ps(p, v); }
+inline VecF VMin(VecF a, VecF b) { return _mm_min_ps(a, b); }
+inline VecF VMax(VecF a, VecF b) { return _mm_max_ps(a, b); }
+inline VecF VAdd(VecF a, VecF b) { return _mm_add_ps(a, b); }
+inline VecF VSub(VecF a, VecF b) { return _mm_sub_ps(a, b); }
+inline VecF VMul(VecF a, VecF b) { return _mm_mul_ps(a, b); }
+inline VecF VDiv(VecF a, VecF b) { return _mm_div_ps(a, b); }
+inline VecF VOr(VecF a, VecF b) { return _mm_or_ps(a, b); }
+inline VecF VAndNot(VecF a, VecF b) { return _mm_andnot_ps(a, b); }
+inline VecF VGt(VecF a, VecF b) { return _mm_cmpgt_ps(a, b); }
+inline VecF VLt(VecF a, VecF b) { return _mm_cmplt_ps(a, b); }
+inline VecF VNle(VecF a, VecF b) { return _mm_cmpnle_ps(a, b); }
+inline int VMask(VecF a) { return _mm_movemask_ps(a); }
+#endif
+
+struct VecQueryBox {
+  explicit VecQueryBox(const QueryBox& q)
+      : xmin(VSet(q.xmin)),
+        ymin(VSet(q.ymin)),
+        xmax(VSet(q.xmax)),
+        ymax(VSet(q.ymax)),
+        area(VSet(q.area)),
+        norm(VSet(q.norm)) {}
+
+  VecF xmin;
+  VecF ymin;
+  VecF xmax;
+  VecF ymax;
+  VecF area;
+  VecF norm;
+};
+
+// The IoU of the query box with the stored boxes [j, j + kLanes).
+inline VecF QueryIoU(const VecQueryBox& q, const BoxArrays& b, int64_t j) {
+  VecF xmin = VLoad(b.xmin + j);
+  VecF ymin = VLoad(b.ymin + j);
+  VecF xmax = VLoad(b.xmax + j);
+  VecF ymax = VLoad(b.ymax + j);
+  VecF disjoint = VOr(VOr(VGt(xmin, q.xmax), VLt(xmax, q.xmin)),
+                      VOr(VGt(ymin, q.ymax), VLt(ymax, q.ymin)));
+  VecF inter_w = VAdd(VSub(VMin(q.xmax, xmax), VMax(q.xmin, xmin)), q.norm);
+  VecF inter_h = VAdd(VSub(VMin(q.ymax, ymax), VMax(q.ymin, ymin)), q.norm);
+  VecF inter_area = VMul(inter_w, inter_h);
+  VecF iou =
+      VDiv(inter_area, VSub(VAdd(q.area, VLoad(b.area + j)), inter_area));
+  return VAndNot(disjoint, iou);
+}
+#endif
+
+}  // namespace
+
+NmsBoxes::NmsBoxes(bool normalized) : normalized_(normalized) {}
+
+void NmsBoxes::Reserve(int64_t num) {
+  xmin_.reserve(num);
+  ymin_.reserve(num);
+  xmax_.reserve(num);
+  ymax_.reserve(num);
+  area_.reserve(num);
+}
+
+void NmsBoxes::Clear() {
+  xmin_.clear();
+  ymin_.clear();
+  xmax_.clear();
+  ymax_.clear();
+  area_.clear();
+}
+
+float NmsBoxes::Area(const float* box) const {
+  if (box[2] < box[0] || box[3] < box[1]) {
+    // The invalid box, e.g. xmax < xmin or ymax < ymin.
+    return 0.f;
+  }
+  const float w = box[2] - box[0];
+  const float h = box[3] - box[1];
+  return normalized_ ? w * h : (w + 1) * (h + 1);
+}
+
+void NmsBoxes::Append(const float* box) {
+  xmin_.push_back(box[0]);
+  ymin_.push_back(box[1]);
+  xmax_.push_back(box[2]);
+  ymax_.push_back(box[3]);
+  area_.push_back(Area(box));
+}
+
+void NmsBoxes::IoU(const float* box, int64_t num, float* iou) const {
+  const QueryBox q{
+      box[0], box[1], box[2], box[3], Area(box), normalized_ ? 0.f : 1.f};
+  const BoxArrays b{
+      xmin_.data(), ymin_.data(), xmax_.data(), ymax_.data(), area_.data()};
+  int64_t j = 0;
+#if defined(__AVX__) || defined(__SSE__)
+  const VecQueryBox vq(q);
+  for (; j + kLanes <= num; j += kLanes) {
+    VStore(iou + j, QueryIoU(vq, b, j));
+  }
+#endif
+  for (; j < num; j++) {
+    iou[j] = QueryIoU(q, b, j);
+  }
+}
+
+bool NmsBoxes::Overlaps(const float* box, float threshold) const {
+  const QueryBox q{
+      box[0], box[1], box[2], box[3], Area(box), normalized_ ? 0.f : 1.f};
+  const BoxArrays b{
+      xmin_.data(), ymin_.data(), xmax_.data(), ymax_.data(), area_.data()};
+  const int64_t num = size();
+  int64_t j = 0;
+#if defined(__AVX__) || defined(__SSE__)
+  const VecQueryBox vq(q);
+  const VecF vthreshold = VSet(threshold);
+  for (; j + kLanes <= num; j += kLanes) {
+    if (VMask(VNle(QueryIoU(vq, b, j), vthreshold))) {
+      return true;
+    }
+  }
+#endif
+  for (; j < num; j++) {
+    if (!(QueryIoU(q, b, j) <= threshold)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void NmsGreedy(const float* boxes,
+               int64_t box_stride,
+               const std::vector<int>& candidates,
+               float nms_threshold,
+               float eta,
+               bool normalized,
+               std::vector<int>* selected,
+               int64_t max_num) {
+  const int64_t num = static_cast<int64_t>(candidates.size());
+  NmsBoxes kept(normalized);
+  kept.Reserve(max_num > -1 ? (std::min)(max_num, num) : num);
+  float adaptive_threshold = nms_threshold;
+  for (int idx : candidates) {
+    if (max_num > -1 && kept.size() >= max_num) {
+      break;
+    }
+    const float* box = boxes + idx * box_stride;
+    if (kept.Overlaps(box, adaptive_threshold)) {
+      continue;
+    }
+    kept.Append(box);
+    selected->push_back(idx);
+    if (eta < 1 && adaptive_threshold > 0.5) {
+      adaptive_threshold *= eta;
+    }
+  }
+}
+
+void NmsParallelFor(int64_t num, const std::function<void(int64_t)>& task) {
+#ifdef LITE_WITH_X86
+  lite::x86::RunParallelFor(0,
+                            num,
+                            [&](int64_t begin, int64_t end) {
+                              for (int64_t i = begin; i < end; i++) {
+                                task(i);
+                              }
+                            },
+                            1);
+#else
+#pragma omp parallel for schedule(dynamic)
+  for (int64_t i = 0; i < num; i++) {
+    task(i);
+  }
+#endif
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,98 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+/*
+ * The NMS engine of the detection post-processing kernels, e.g.
+ * multiclass_nms, matrix_nms and generate_proposals.
+ *
+ * The box i of `num` boxes is [xmin, ymin, xmax, ymax] at boxes[i *
+ * box_stride], and its score is scores[i * score_stride], so the boxes and
+ * scores of a class are read in place from the [M, C, 4] boxes and [M, C]
+ * scores without being sliced. The IoU is the same as JaccardOverlap in
+ * nms_util.h, the box sizes are counted with a pixel offset of 1 unless the
+ * boxes are normalized.
+ */
+
+// The indices of the boxes whose score > score_threshold in the descending
+// order of the scores, the smaller index comes first for the equal scores.
+// Only the first top_k are kept if top_k > -1, they are selected by a partial
+// sort instead of sorting all the boxes.
+void NmsTopK(const float* scores,
+             int64_t score_stride,
+             int64_t num,
+             float score_threshold,
+             int64_t top_k,
+             std::vector<int>* indices);
+
+// The boxes in the structure of arrays, so the IoU of a box with a block of
+// them is computed by SIMD.
+class NmsBoxes {
+ public:
+  explicit NmsBoxes(bool normalized);
+
+  void Reserve(int64_t num);
+  void Clear();
+  void Append(const float* box);
+  int64_t size() const { return static_cast<int64_t>(area_.size()); }
+
+  // iou[j] = IoU(box, the box j) for j in [0, num), num <= size().
+  void IoU(const float* box, int64_t num, float* iou) const;
+  // Whether the IoU of the box with any of the boxes is not <= threshold, the
+  // rest of the boxes are skipped once one is found.
+  bool Overlaps(const float* box, float threshold) const;
+
+ private:
+  float Area(const float* box) const;
+
+  bool normalized_;
+  std::vector<float> xmin_;
+  std::vector<float> ymin_;
+  std::vector<float> xmax_;
+  std::vector<float> ymax_;
+  std::vector<float> area_;
+};
+
+// Greedy NMS of the candidates in order: a candidate is kept if its IoU with
+// each of the kept boxes <= the adaptive threshold, which starts from
+// nms_threshold and is multiplied by eta after a box is kept while it's > 0.5.
+// The indices of the kept boxes are appended to selected, it stops after
+// max_num boxes are kept if max_num > -1.
+void NmsGreedy(const float* boxes,
+               int64_t box_stride,
+               const std::vector<int>& candidates,
+               float nms_threshold,
+               float eta,
+               bool normalized,
+               std::vector<int>* selected,
+               int64_t max_num = -1);
+
+// Run task(i) for i in [0, num) in parallel, the NMS of the classes and the
+// images are independent.
+void NmsParallelFor(int64_t num, const std::function<void(int64_t)>& task);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,193 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/nms.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <utility>
+#include <vector>
+#include "lite/core/tensor.h"
+// nms_util.h uses Tensor without including it.
+#include "lite/backends/host/math/nms_util.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// num boxes of box_stride floats, a few of them are invalid or duplicated.
+static std::vector<float> RandomBoxes(int num,
+                                      int box_stride,
+                                      bool normalized) {
+  std::mt19937 rng(num);
+  float scale = normalized ? 1.f : 100.f;
+  std::uniform_real_distribution<float> pos(0.f, scale);
+  std::uniform_real_distribution<float> size(0.f, scale / 4);
+  std::vector<float> boxes(num * box_stride);
+  for (int i = 0; i < num; i++) {
+    float* box = boxes.data() + i * box_stride;
+    box[0] = pos(rng);
+    box[1] = pos(rng);
+    box[2] = box[0] + size(rng);
+    box[3] = box[1] + size(rng);
+    if (i % 17 == 5) {
+      std::swap(box[0], box[2]);
+    }
+    if (i % 13 == 7) {
+      std::copy(box - box_stride, box, box);
+    }
+  }
+  return boxes;
+}
+
+static std::vector<float> RandomScores(int num) {
+  std::mt19937 rng(num + 1);
+  // Coarse scores to have the equal ones.
+  std::uniform_int_distribution<int> score(0, 50);
+  std::vector<float> scores(num);
+  for (auto& s : scores) {
+    s = score(rng) / 50.f;
+  }
+  return scores;
+}
+
+// The greedy NMS by the scalar JaccardOverlap of nms_util.h.
+static std::vector<int> ReferenceNMS(const std::vector<float>& boxes,
+                                     int box_stride,
+                                     const std::vector<float>& scores,
+                                     float score_threshold,
+                                     int top_k,
+                                     float nms_threshold,
+                                     float eta,
+                                     bool normalized) {
+  std::vector<std::pair<float, int>> sorted_indices;
+  GetMaxScoreIndex(scores, score_threshold, top_k, &sorted_indices);
+  std::vector<int> selected;
+  float adaptive_threshold = nms_threshold;
+  for (auto& pair : sorted_indices) {
+    int idx = pair.second;
+    bool keep = true;
+    for (int kept_idx : selected) {
+      const float* box = boxes.data() + idx * box_stride;
+      const float* kept_box = boxes.data() + kept_idx * box_stride;
+      float overlap = JaccardOverlap<float>(box, kept_box, normalized);
+      if (!(overlap <= adaptive_threshold)) {
+        keep = false;
+        break;
+      }
+    }
+    if (keep) {
+      selected.push_back(idx);
+      if (eta < 1 && adaptive_threshold > 0.5) {
+        adaptive_threshold *= eta;
+      }
+    }
+  }
+  return selected;
+}
+
+TEST(NMS, top_k) {
+  for (int num : {0, 1, 7, 100, 333}) {
+    auto scores = RandomScores(num);
+    for (int top_k : {-1, 0, 5, 1000}) {
+      std::vector<std::pair<float, int>> sorted_indices;
+      GetMaxScoreIndex(scores, 0.3f, top_k, &sorted_indices);
+      std::vector<int> indices;
+      NmsTopK(scores.data(), 1, num, 0.3f, top_k, &indices);
+      ASSERT_EQ(indices.size(), sorted_indices.size());
+      for (size_t i = 0; i < indices.size(); i++) {
+        EXPECT_EQ(indices[i], sorted_indices[i].second);
+      }
+    }
+  }
+}
+
+TEST(NMS, iou) {
+  for (bool normalized : {true, false}) {
+    const int num = 37;
+    auto boxes = RandomBoxes(num, 4, normalized);
+    NmsBoxes soa(normalized);
+    for (int i = 0; i < num; i++) {
+      soa.Append(boxes.data() + i * 4);
+    }
+    std::vector<float> iou(num);
+    for (int i = 0; i < num; i++) {
+      const float* box = boxes.data() + i * 4;
+      soa.IoU(box, num, iou.data());
+      for (int j = 0; j < num; j++) {
+        float expected =
+            JaccardOverlap<float>(box, boxes.data() + j * 4, normalized);
+        EXPECT_FLOAT_EQ(iou[j], expected) << i << " " << j;
+      }
+    }
+  }
+}
+
+TEST(NMS, greedy) {
+  for (bool normalized : {true, false}) {
+    for (int num : {1, 9, 200, 1000}) {
+      // The boxes of a class of the [M, C, 4] boxes.
+      const int box_stride = 3 * 4;
+      auto boxes = RandomBoxes(num, box_stride, normalized);
+      auto scores = RandomScores(num);
+      for (float eta : {1.f, 0.9f}) {
+        for (int top_k : {-1, 50}) {
+          auto expected = ReferenceNMS(
+              boxes, box_stride, scores, 0.1f, top_k, 0.3f, eta, normalized);
+          std::vector<int> candidates;
+          NmsTopK(scores.data(), 1, num, 0.1f, top_k, &candidates);
+          std::vector<int> selected;
+          NmsGreedy(boxes.data(),
+                    box_stride,
+                    candidates,
+                    0.3f,
+                    eta,
+                    normalized,
+                    &selected);
+          EXPECT_EQ(selected, expected);
+
+          // Only the first kept boxes are selected.
+          selected.clear();
+          NmsGreedy(boxes.data(),
+                    box_stride,
+                    candidates,
+                    0.3f,
+                    eta,
+                    normalized,
+                    &selected,
+                    3);
+          expected.resize((std::min)(expected.size(), size_t(3)));
+          EXPECT_EQ(selected, expected);
+        }
+      }
+    }
+  }
+}
+
+TEST(NMS, parallel_for) {
+  std::vector<std::atomic<int>> counts(100);
+  for (auto& count : counts) {
+    count = 0;
+  }
+  NmsParallelFor(100, [&](int64_t i) { counts[i]++; });
+  for (auto& count : counts) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
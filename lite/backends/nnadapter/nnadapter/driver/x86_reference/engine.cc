@@ -0,0 +1,170 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "driver/x86_reference/engine.h"
+#include <stdlib.h>
+#include <string.h>
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/modeling.h"
+#include "utility/utility.h"
+
+namespace nnadapter {
+namespace x86_reference {
+
+#define REGISTER_KERNEL(__op_type__, __func_name__) \
+  extern int __func_name__(hal::Operation* operation);
+#include "driver/x86_reference/kernel/all.h"  // NOLINT
+#undef __NNADAPTER_DRIVER_X86_REFERENCE_KERNEL_ALL_H__
+#undef REGISTER_KERNEL
+
+Context::Context(void* device, const char* properties) : device_(device) {}
+
+Context::~Context() {}
+
+Program::~Program() { Clear(); }
+
+void Program::Clear() {
+  for (auto& operand : model_.operands) {
+    // The buffers of the inputs are owned by the caller
+    if (operand.type.lifetime != NNADAPTER_MODEL_INPUT && operand.buffer) {
+      free(operand.buffer);
+    }
+  }
+  model_.operands.clear();
+  model_.operations.clear();
+  model_.input_operands.clear();
+  model_.output_operands.clear();
+  input_types_.clear();
+  output_types_.clear();
+}
+
+int Program::Build(hal::Model* model, hal::Cache* cache) {
+  Clear();
+  // The source model is serialized to the cache and restored, so the programs
+  // built from the model and the cache are the same
+  if (model) {
+    NNADAPTER_VLOG(5) << "Origin model:" << std::endl << Visualize(model);
+    if (!SerializeModel(model, &cache->buffer)) {
+      NNADAPTER_LOG(ERROR) << "Failed to serialize the model to the cache!";
+      return NNADAPTER_DEVICE_INTERNAL_ERROR;
+    }
+  }
+  if (!DeserializeModel(cache->buffer.data(), cache->buffer.size(), &model_)) {
+    NNADAPTER_LOG(ERROR) << "Failed to deserialize the model from the cache!";
+    Clear();
+    return NNADAPTER_INVALID_PARAMETER;
+  }
+  for (auto& operand : model_.operands) {
+    if (!IsSupportedOperandType(operand.type)) {
+      NNADAPTER_LOG(ERROR) << "Unsupported operand "
+                           << OperandToString(&operand) << "!";
+      return NNADAPTER_INVALID_PARAMETER;
+    }
+  }
+  for (auto& operation : model_.operations) {
+    switch (operation.type) {
+#define REGISTER_KERNEL(__op_type__, __func_name__) \
+  case NNADAPTER_##__op_type__:
+#include "driver/x86_reference/kernel/all.h"  // NOLINT
+#undef __NNADAPTER_DRIVER_X86_REFERENCE_KERNEL_ALL_H__
+#undef REGISTER_KERNEL
+        break;
+      default:
+        NNADAPTER_LOG(ERROR) << "Unsupported operation("
+                             << OperationTypeToString(operation.type)
+                             << ") is found.";
+        return NNADAPTER_INVALID_PARAMETER;
+    }
+  }
+  for (auto operand : model_.input_operands) {
+    input_types_.push_back(operand->type);
+  }
+  for (auto operand : model_.output_operands) {
+    output_types_.push_back(operand->type);
+  }
+  NNADAPTER_VLOG(3) << "Build success.";
+  return NNADAPTER_NO_ERROR;
+}
+
+int Program::Execute(uint32_t input_count,
+                     hal::Argument* input_arguments,
+                     uint32_t output_count,
+                     hal::Argument* output_arguments) {
+  NNADAPTER_CHECK_EQ(input_types_.size(), input_count);
+  NNADAPTER_CHECK_EQ(output_types_.size(), output_count);
+  for (uint32_t i = 0; i < input_count; i++) {
+    auto& arg = input_arguments[i];
+    NNADAPTER_CHECK_GE(arg.index, 0);
+    NNADAPTER_CHECK_LT(arg.index, input_count);
+    NNADAPTER_CHECK(arg.memory);
+    NNADAPTER_CHECK(arg.access);
+    // The dimensions of the inputs may be changed at every execution, and
+    // the host buffers are used without copying
+    auto operand = model_.input_operands[arg.index];
+    operand->type = input_types_[arg.index];
+    operand->buffer = arg.access(arg.memory, &operand->type);
+    NNADAPTER_CHECK(operand->buffer);
+  }
+  int result = NNADAPTER_NO_ERROR;
+  auto start_time = GetCurrentUS();
+  for (auto& operation : model_.operations) {
+    switch (operation.type) {
+#define REGISTER_KERNEL(__op_type__, __func_name__) \
+  case NNADAPTER_##__op_type__:                     \
+    result = __func_name__(&operation);             \
+    break;
+#include "driver/x86_reference/kernel/all.h"  // NOLINT
+#undef __NNADAPTER_DRIVER_X86_REFERENCE_KERNEL_ALL_H__
+#undef REGISTER_KERNEL
+      default:
+        result = NNADAPTER_INVALID_PARAMETER;
+        break;
+    }
+    if (result != NNADAPTER_NO_ERROR) {
+      NNADAPTER_LOG(ERROR) << "Failed to compute "
+                           << OperationTypeToString(operation.type) << "("
+                           << result << ")!";
+      break;
+    }
+  }
+  NNADAPTER_VLOG(3) << "Process cost " << GetCurrentUS() - start_time << " us";
+  if (result == NNADAPTER_NO_ERROR) {
+    for (uint32_t i = 0; i < output_count; i++) {
+      auto& arg = output_arguments[i];
+      NNADAPTER_CHECK_GE(arg.index, 0);
+      NNADAPTER_CHECK_LT(arg.index, output_count);
+      NNADAPTER_CHECK(arg.memory);
+      NNADAPTER_CHECK(arg.access);
+      auto operand = model_.output_operands[arg.index];
+      // Tell the dimensions of the outputs to the caller, and copy the results
+      // to the host buffers
+      auto type = output_types_[arg.index];
+      type.dimension_count = operand->type.dimension_count;
+      memcpy(type.dimensions,
+             operand->type.dimensions,
+             sizeof(int32_t) * operand->type.dimension_count);
+      auto buffer = arg.access(arg.memory, &type);
+      NNADAPTER_CHECK(buffer);
+      memcpy(buffer, operand->buffer, GetOperandTypeBufferLength(type));
+    }
+  }
+  for (auto operand : model_.input_operands) {
+    operand->buffer = nullptr;
+  }
+  return result;
+}
+
+}  // namespace x86_reference
+}  // namespace nnadapter
@@ -0,0 +1,64 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "driver/x86_reference/utility.h"
+
+namespace nnadapter {
+namespace x86_reference {
+
+class Device {
+ public:
+  Device() {}
+  ~Device() {}
+};
+
+class Context {
+ public:
+  explicit Context(void* device, const char* properties);
+  ~Context();
+
+ private:
+  void* device_{nullptr};
+};
+
+// Run the operations of a model one by one with the reference kernels on the
+// host, which is used to test and benchmark the runtime without the devices
+class Program {
+ public:
+  explicit Program(Context* context) : context_(context) {}
+  ~Program();
+
+  int Build(hal::Model* model, hal::Cache* cache);
+  int Execute(uint32_t input_count,
+              hal::Argument* input_arguments,
+              uint32_t output_count,
+              hal::Argument* output_arguments);
+
+ private:
+  void Clear();
+
+ private:
+  Context* context_{nullptr};
+  // The model is always restored from the cache, the operations are in the
+  // topological order and the operands own their buffers except the inputs
+  hal::Model model_;
+  std::vector<NNAdapterOperandType> input_types_;
+  std::vector<NNAdapterOperandType> output_types_;
+};
+
+}  // namespace x86_reference
+}  // namespace nnadapter
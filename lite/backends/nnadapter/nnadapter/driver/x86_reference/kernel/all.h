@@ -0,0 +1,27 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __NNADAPTER_DRIVER_X86_REFERENCE_KERNEL_ALL_H__  // NOLINT
+#define __NNADAPTER_DRIVER_X86_REFERENCE_KERNEL_ALL_H__
+
+REGISTER_KERNEL(CONV_2D, ComputeConv2D)
+REGISTER_KERNEL(SOFTMAX, ComputeSoftmax)
+REGISTER_KERNEL(ABS, ComputeUnaryActivations)
+REGISTER_KERNEL(LOG, ComputeUnaryActivations)
+REGISTER_KERNEL(RELU, ComputeUnaryActivations)
+REGISTER_KERNEL(RELU6, ComputeUnaryActivations)
+REGISTER_KERNEL(SIGMOID, ComputeUnaryActivations)
+REGISTER_KERNEL(TANH, ComputeUnaryActivations)
+
+#endif  // NOLINT
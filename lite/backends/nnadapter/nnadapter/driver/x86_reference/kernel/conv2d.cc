@@ -0,0 +1,108 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <limits>
+#include "core/operation/conv2d.h"
+#include "driver/x86_reference/utility.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace x86_reference {
+
+int ComputeConv2D(hal::Operation* operation) {
+  CONV2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // Infer the output dimensions from the ones of the input, which are set by
+  // the caller at every execution
+  NNADAPTER_CHECK_EQ(input_operand->type.dimension_count, 4);
+  NNADAPTER_CHECK_EQ(input_channel_size, filter_channel_size * group);
+  NNADAPTER_CHECK_EQ(output_channel_size % group, 0);
+  auto batch_size = input_operand->type.dimensions[0];
+  auto input_height = input_operand->type.dimensions[2];
+  auto input_width = input_operand->type.dimensions[3];
+  auto output_height =
+      (input_height + padding_height_top + padding_height_bottom -
+       (dilation_height * (filter_height - 1) + 1)) /
+          stride_height +
+      1;
+  auto output_width = (input_width + padding_width_left + padding_width_right -
+                       (dilation_width * (filter_width - 1) + 1)) /
+                          stride_width +
+                      1;
+  auto& output_type = output_operand->type;
+  output_type.dimension_count = 4;
+  output_type.dimensions[0] = batch_size;
+  output_type.dimensions[1] = output_channel_size;
+  output_type.dimensions[2] = output_height;
+  output_type.dimensions[3] = output_width;
+  auto input = reinterpret_cast<const float*>(input_operand->buffer);
+  auto filter = reinterpret_cast<const float*>(filter_operand->buffer);
+  auto bias = bias_operand && bias_operand->buffer
+                  ? reinterpret_cast<const float*>(bias_operand->buffer)
+                  : nullptr;
+  auto output = reinterpret_cast<float*>(ResizeOperandBuffer(output_operand));
+  float min_value = -std::numeric_limits<float>::max();
+  float max_value = std::numeric_limits<float>::max();
+  if (fuse_code == NNADAPTER_FUSED_RELU) {
+    min_value = 0.0f;
+  } else if (fuse_code == NNADAPTER_FUSED_RELU1) {
+    min_value = -1.0f;
+    max_value = 1.0f;
+  } else if (fuse_code == NNADAPTER_FUSED_RELU6) {
+    min_value = 0.0f;
+    max_value = 6.0f;
+  } else if (fuse_code != NNADAPTER_FUSED_NONE) {
+    NNADAPTER_LOG(ERROR) << "Unsupported fuse_code(" << fuse_code << ").";
+    return NNADAPTER_INVALID_PARAMETER;
+  }
+  auto output_group_size = output_channel_size / group;
+  auto filter_size = filter_channel_size * filter_height * filter_width;
+  for (int32_t n = 0; n < batch_size; n++) {
+    for (int32_t oc = 0; oc < output_channel_size; oc++) {
+      auto ic_start = (oc / output_group_size) * filter_channel_size;
+      for (int32_t oh = 0; oh < output_height; oh++) {
+        for (int32_t ow = 0; ow < output_width; ow++) {
+          float sum = bias ? bias[oc] : 0.0f;
+          for (int32_t ic = 0; ic < filter_channel_size; ic++) {
+            auto input_plane =
+                input + (n * input_channel_size + ic_start + ic) *
+                            input_height * input_width;
+            auto filter_plane = filter + oc * filter_size +
+                                ic * filter_height * filter_width;
+            for (int32_t kh = 0; kh < filter_height; kh++) {
+              auto ih = oh * stride_height - padding_height_top +
+                        kh * dilation_height;
+              if (ih < 0 || ih >= input_height) continue;
+              for (int32_t kw = 0; kw < filter_width; kw++) {
+                auto iw = ow * stride_width - padding_width_left +
+                          kw * dilation_width;
+                if (iw < 0 || iw >= input_width) continue;
+                sum += input_plane[ih * input_width + iw] *
+                       filter_plane[kh * filter_width + kw];
+              }
+            }
+          }
+          output[((n * output_channel_size + oc) * output_height + oh) *
+                     output_width +
+                 ow] = std::min(std::max(sum, min_value), max_value);
+        }
+      }
+    }
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace x86_reference
+}  // namespace nnadapter
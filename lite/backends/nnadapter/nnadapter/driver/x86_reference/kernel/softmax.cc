@@ -0,0 +1,66 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include "core/operation/softmax.h"
+#include "driver/x86_reference/utility.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/utility.h"
+
+namespace nnadapter {
+namespace x86_reference {
+
+int ComputeSoftmax(hal::Operation* operation) {
+  SOFTMAX_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  NNADAPTER_CHECK_GE(axis, 0);
+  NNADAPTER_CHECK_LT(axis, input_type.dimension_count);
+  auto& output_type = output_operand->type;
+  output_type.dimension_count = input_type.dimension_count;
+  for (uint32_t i = 0; i < input_type.dimension_count; i++) {
+    output_type.dimensions[i] = input_type.dimensions[i];
+  }
+  auto outer_size = ProductionOfDimensions(input_type.dimensions, axis);
+  auto axis_size = input_type.dimensions[axis];
+  auto inner_size =
+      ProductionOfDimensions(input_type.dimensions + axis + 1,
+                             input_type.dimension_count - axis - 1);
+  auto input = reinterpret_cast<const float*>(input_operand->buffer);
+  auto output = reinterpret_cast<float*>(ResizeOperandBuffer(output_operand));
+  for (int64_t i = 0; i < outer_size; i++) {
+    for (int64_t j = 0; j < inner_size; j++) {
+      auto x = input + i * axis_size * inner_size + j;
+      auto y = output + i * axis_size * inner_size + j;
+      // Subtract the max value to avoid the overflow of exp
+      float max_value = x[0];
+      for (int32_t k = 1; k < axis_size; k++) {
+        max_value = std::max(max_value, x[k * inner_size]);
+      }
+      float sum = 0.0f;
+      for (int32_t k = 0; k < axis_size; k++) {
+        y[k * inner_size] = std::exp(x[k * inner_size] - max_value);
+        sum += y[k * inner_size];
+      }
+      for (int32_t k = 0; k < axis_size; k++) {
+        y[k * inner_size] /= sum;
+      }
+    }
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace x86_reference
+}  // namespace nnadapter
@@ -0,0 +1,62 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include "core/operation/unary_activations.h"
+#include "driver/x86_reference/utility.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/utility.h"
+
+namespace nnadapter {
+namespace x86_reference {
+
+int ComputeUnaryActivations(hal::Operation* operation) {
+  UNARY_ACTIVATIONS_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  auto& input_type = input_operand->type;
+  auto& output_type = output_operand->type;
+  output_type.dimension_count = input_type.dimension_count;
+  for (uint32_t i = 0; i < input_type.dimension_count; i++) {
+    output_type.dimensions[i] = input_type.dimensions[i];
+  }
+  auto size =
+      ProductionOfDimensions(input_type.dimensions, input_type.dimension_count);
+  auto input = reinterpret_cast<const float*>(input_operand->buffer);
+  auto output = reinterpret_cast<float*>(ResizeOperandBuffer(output_operand));
+  switch (operation->type) {
+#define UNARY_ACTIVATION_KERNEL(type, expr) \
+  case NNADAPTER_##type:                    \
+    for (int64_t i = 0; i < size; i++) {    \
+      auto x = input[i];                    \
+      output[i] = (expr);                   \
+    }                                       \
+    break;
+    UNARY_ACTIVATION_KERNEL(ABS, std::fabs(x))
+    UNARY_ACTIVATION_KERNEL(LOG, std::log(x))
+    UNARY_ACTIVATION_KERNEL(RELU, std::max(x, 0.0f))
+    UNARY_ACTIVATION_KERNEL(RELU6, std::min(std::max(x, 0.0f), 6.0f))
+    UNARY_ACTIVATION_KERNEL(SIGMOID, 1.0f / (1.0f + std::exp(-x)))
+    UNARY_ACTIVATION_KERNEL(TANH, std::tanh(x))
+#undef UNARY_ACTIVATION_KERNEL
+    default:
+      NNADAPTER_LOG(ERROR) << "Unsupported unary activation("
+                           << OperationTypeToString(operation->type) << ").";
+      return NNADAPTER_INVALID_PARAMETER;
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace x86_reference
+}  // namespace nnadapter
@@ -0,0 +1,270 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "driver/x86_reference/utility.h"
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <memory>
+#include <string>
+#include "utility/cache.h"
+#include "utility/logging.h"
+#include "utility/modeling.h"
+#include "utility/string.h"
+#include "utility/utility.h"
+
+namespace nnadapter {
+namespace x86_reference {
+
+static const char* X86_REFERENCE_CACHE_OPERAND_COUNT_KEY = "operand_count";
+static const char* X86_REFERENCE_CACHE_OPERAND_TYPE_KEY = "operand_%d_type";
+static const char* X86_REFERENCE_CACHE_OPERAND_BUFFER_KEY = "operand_%d_buffer";
+static const char* X86_REFERENCE_CACHE_OPERATION_COUNT_KEY = "operation_count";
+static const char* X86_REFERENCE_CACHE_OPERATION_KEY = "operation_%d";
+static const char* X86_REFERENCE_CACHE_INPUT_INDEXES_KEY = "input_indexes";
+static const char* X86_REFERENCE_CACHE_OUTPUT_INDEXES_KEY = "output_indexes";
+
+bool IsSupportedOperandType(const NNAdapterOperandType& type) {
+  switch (type.precision) {
+    case NNADAPTER_BOOL8:
+    case NNADAPTER_INT32:
+    case NNADAPTER_FLOAT32:
+    case NNADAPTER_TENSOR_BOOL8:
+    case NNADAPTER_TENSOR_INT32:
+      return type.lifetime == NNADAPTER_CONSTANT_COPY ||
+             type.lifetime == NNADAPTER_CONSTANT_REFERENCE;
+    case NNADAPTER_TENSOR_FLOAT32:
+      return type.layout == NNADAPTER_NCHW;
+    default:
+      break;
+  }
+  return false;
+}
+
+void* ResizeOperandBuffer(hal::Operand* operand) {
+  auto length = GetOperandTypeBufferLength(operand->type);
+  if (!operand->buffer || length > operand->length) {
+    free(operand->buffer);
+    operand->buffer = malloc(length);
+    NNADAPTER_CHECK(operand->buffer) << "Failed to allocate " << length
+                                     << " bytes for the operand.";
+    operand->length = length;
+  }
+  return operand->buffer;
+}
+
+static bool SetInt32Values(Cache* helper,
+                           const std::string& key,
+                           const std::vector<int32_t>& values) {
+  return helper->Set(key, values.data(), values.size() * sizeof(int32_t));
+}
+
+static bool GetInt32Values(Cache* helper,
+                           const std::string& key,
+                           std::vector<int32_t>* values) {
+  std::vector<uint8_t> value;
+  if (!helper->Get(key, &value) || value.size() % sizeof(int32_t) != 0) {
+    return false;
+  }
+  values->resize(value.size() / sizeof(int32_t));
+  if (!value.empty()) {
+    memcpy(values->data(), value.data(), value.size());
+  }
+  return true;
+}
+
+bool SerializeModel(hal::Model* model, std::vector<uint8_t>* buffer) {
+  auto helper = std::make_shared<nnadapter::Cache>();
+  // Serialize the types of the operands and the values of the constant ones
+  std::map<hal::Operand*, int32_t> operand_indexes;
+  uint64_t operand_count = 0;
+  for (auto& operand : model->operands) {
+    auto index = static_cast<int32_t>(operand_count++);
+    operand_indexes[&operand] = index;
+    if (!helper->Set(string_format(X86_REFERENCE_CACHE_OPERAND_TYPE_KEY, index),
+                     &operand.type,
+                     sizeof(NNAdapterOperandType))) {
+      return false;
+    }
+    if (IsConstantOperand(&operand) &&
+        !helper->Set(
+            string_format(X86_REFERENCE_CACHE_OPERAND_BUFFER_KEY, index),
+            operand.buffer,
+            operand.length)) {
+      return false;
+    }
+  }
+  if (!helper->Set(X86_REFERENCE_CACHE_OPERAND_COUNT_KEY,
+                   &operand_count,
+                   sizeof(operand_count))) {
+    return false;
+  }
+  // Serialize the operations in the topological order, each of them is stored
+  // as [type, input count, input indexes..., output count, output indexes...]
+  auto operations = SortOperationsInTopologicalOrder(model);
+  uint64_t operation_count = operations.size();
+  for (int i = 0; i < static_cast<int>(operation_count); i++) {
+    auto operation = operations[i];
+    std::vector<int32_t> values;
+    values.push_back(operation->type);
+    values.push_back(operation->input_operands.size());
+    for (auto operand : operation->input_operands) {
+      values.push_back(operand ? operand_indexes.at(operand) : -1);
+    }
+    values.push_back(operation->output_operands.size());
+    for (auto operand : operation->output_operands) {
+      values.push_back(operand_indexes.at(operand));
+    }
+    if (!SetInt32Values(helper.get(),
+                        string_format(X86_REFERENCE_CACHE_OPERATION_KEY, i),
+                        values)) {
+      return false;
+    }
+  }
+  if (!helper->Set(X86_REFERENCE_CACHE_OPERATION_COUNT_KEY,
+                   &operation_count,
+                   sizeof(operation_count))) {
+    return false;
+  }
+  // Serialize the indexes of the model inputs and outputs
+  std::vector<int32_t> input_indexes, output_indexes;
+  for (auto operand : model->input_operands) {
+    input_indexes.push_back(operand_indexes.at(operand));
+  }
+  for (auto operand : model->output_operands) {
+    output_indexes.push_back(operand_indexes.at(operand));
+  }
+  if (!SetInt32Values(helper.get(),
+                      X86_REFERENCE_CACHE_INPUT_INDEXES_KEY,
+                      input_indexes) ||
+      !SetInt32Values(helper.get(),
+                      X86_REFERENCE_CACHE_OUTPUT_INDEXES_KEY,
+                      output_indexes)) {
+    return false;
+  }
+  auto size = helper->GetSerializedSize();
+  buffer->resize(size);
+  return helper->Serialize(buffer->data(), size);
+}
+
+bool DeserializeModel(void* buffer, uint64_t size, hal::Model* model) {
+  NNADAPTER_CHECK(model->operands.empty() && model->operations.empty());
+  auto helper = std::make_shared<nnadapter::Cache>();
+  if (!helper->Deserialize(buffer, size)) {
+    return false;
+  }
+  std::vector<uint8_t> value;
+  // Deserialize the operands, the constant ones are copied
+  uint64_t operand_count = 0;
+  if (!helper->Get(X86_REFERENCE_CACHE_OPERAND_COUNT_KEY, &value) ||
+      value.size() != sizeof(operand_count)) {
+    return false;
+  }
+  memcpy(&operand_count, value.data(), sizeof(operand_count));
+  std::vector<hal::Operand*> operands(operand_count);
+  for (int i = 0; i < static_cast<int>(operand_count); i++) {
+    auto operand = AddOperand(model);
+    operands[i] = operand;
+    if (!helper->Get(string_format(X86_REFERENCE_CACHE_OPERAND_TYPE_KEY, i),
+                     &value) ||
+        value.size() != sizeof(NNAdapterOperandType)) {
+      return false;
+    }
+    memcpy(&operand->type, value.data(), sizeof(NNAdapterOperandType));
+    if (IsConstantOperand(operand)) {
+      if (!helper->Get(
+              string_format(X86_REFERENCE_CACHE_OPERAND_BUFFER_KEY, i),
+              &value)) {
+        return false;
+      }
+      operand->type.lifetime = NNADAPTER_CONSTANT_COPY;
+      operand->length = value.size();
+      operand->buffer = malloc(value.size());
+      NNADAPTER_CHECK(operand->buffer) << "Failed to allocate " << value.size()
+                                       << " bytes for the constant operand.";
+      memcpy(operand->buffer, value.data(), value.size());
+    }
+  }
+  auto get_operand = [&](int32_t index) -> hal::Operand* {
+    if (index < 0 || static_cast<uint64_t>(index) >= operand_count) {
+      return nullptr;
+    }
+    return operands[index];
+  };
+  // Deserialize the operations
+  uint64_t operation_count = 0;
+  if (!helper->Get(X86_REFERENCE_CACHE_OPERATION_COUNT_KEY, &value) ||
+      value.size() != sizeof(operation_count)) {
+    return false;
+  }
+  memcpy(&operation_count, value.data(), sizeof(operation_count));
+  for (int i = 0; i < static_cast<int>(operation_count); i++) {
+    std::vector<int32_t> values;
+    if (!GetInt32Values(helper.get(),
+                        string_format(X86_REFERENCE_CACHE_OPERATION_KEY, i),
+                        &values) ||
+        values.size() < 3) {
+      return false;
+    }
+    auto operation = AddOperation(model);
+    operation->type = values[0];
+    size_t offset = 1;
+    size_t input_count = values[offset++];
+    if (offset + input_count >= values.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < input_count; j++) {
+      operation->input_operands.push_back(get_operand(values[offset++]));
+    }
+    size_t output_count = values[offset++];
+    if (offset + output_count != values.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < output_count; j++) {
+      auto operand = get_operand(values[offset++]);
+      if (!operand) {
+        return false;
+      }
+      operation->output_operands.push_back(operand);
+    }
+  }
+  // Deserialize the model inputs and outputs
+  std::vector<int32_t> input_indexes, output_indexes;
+  if (!GetInt32Values(helper.get(),
+                      X86_REFERENCE_CACHE_INPUT_INDEXES_KEY,
+                      &input_indexes) ||
+      !GetInt32Values(helper.get(),
+                      X86_REFERENCE_CACHE_OUTPUT_INDEXES_KEY,
+                      &output_indexes)) {
+    return false;
+  }
+  for (auto index : input_indexes) {
+    auto operand = get_operand(index);
+    if (!operand) {
+      return false;
+    }
+    model->input_operands.push_back(operand);
+  }
+  for (auto index : output_indexes) {
+    auto operand = get_operand(index);
+    if (!operand) {
+      return false;
+    }
+    model->output_operands.push_back(operand);
+  }
+  return true;
+}
+
+}  // namespace x86_reference
+}  // namespace nnadapter
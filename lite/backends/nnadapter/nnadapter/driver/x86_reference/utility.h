@@ -0,0 +1,38 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "core/hal/types.h"
+
+namespace nnadapter {
+namespace x86_reference {
+
+// Only the float32 tensors and the scalar or tensor attributes are supported
+bool IsSupportedOperandType(const NNAdapterOperandType& type);
+
+// Reallocate the buffer of an operand if it's smaller than the length of its
+// type, the buffer is owned by the operand and released by the program
+void* ResizeOperandBuffer(hal::Operand* operand);
+
+// Serialize the operands and operations of a model into the buffer of the
+// cache, the operations are stored in the topological order
+bool SerializeModel(hal::Model* model, std::vector<uint8_t>* buffer);
+// Deserialize a model from the buffer of the cache into an empty model, the
+// constant operands are copied into the buffers owned by the model
+bool DeserializeModel(void* buffer, uint64_t size, hal::Model* model);
+
+}  // namespace x86_reference
+}  // namespace nnadapter
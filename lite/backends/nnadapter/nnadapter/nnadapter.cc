@@ -355,7 +355,7 @@ NNADAPTER_EXPORT int NNAdapterExecution_create(
 
 NNADAPTER_EXPORT void NNAdapterExecution_destroy(
     NNAdapterExecution* execution) {
-  if (!execution) {
+  if (execution) {
     auto e = reinterpret_cast<nnadapter::runtime::Execution*>(execution);
     delete e;
   }
@@ -393,6 +393,34 @@ NNADAPTER_EXPORT int NNAdapterExecution_compute(NNAdapterExecution* execution) {
   return e->Compute();
 }
 
+NNADAPTER_EXPORT int NNAdapterExecution_computeAsync(
+    NNAdapterExecution* execution, NNAdapterEvent** event) {
+  if (!execution || !event) {
+    return NNADAPTER_INVALID_PARAMETER;
+  }
+  auto e = reinterpret_cast<nnadapter::runtime::Execution*>(execution);
+  nnadapter::runtime::Event* v = nullptr;
+  int result = e->ComputeAsync(&v);
+  *event = reinterpret_cast<NNAdapterEvent*>(v);
+  return result;
+}
+
+NNADAPTER_EXPORT int NNAdapterEvent_wait(NNAdapterEvent* event) {
+  if (!event) {
+    return NNADAPTER_INVALID_PARAMETER;
+  }
+  auto v = reinterpret_cast<nnadapter::runtime::Event*>(event);
+  return v->Wait();
+}
+
+NNADAPTER_EXPORT void NNAdapterEvent_destroy(NNAdapterEvent* event) {
+  if (event) {
+    auto v = reinterpret_cast<nnadapter::runtime::Event*>(event);
+    v->Wait();
+    delete v;
+  }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -1303,6 +1303,13 @@ typedef struct NNAdapterCompilation NNAdapterCompilation;
  * Available since version 1.
  */
 typedef struct NNAdapterExecution NNAdapterExecution;
+/**
+ * An opaque type for Event, which is used to wait for the completion of an
+ * asynchronous computation.
+ *
+ * Available since version 1.
+ */
+typedef struct NNAdapterEvent NNAdapterEvent;
 
 #ifdef __cplusplus
 extern "C" {
@@ -1563,6 +1570,33 @@ int NNAdapterExecution_setOutput(NNAdapterExecution* execution,
  * Available since version 1.
  */
 int NNAdapterExecution_compute(NNAdapterExecution* execution);
+/**
+ * Start to run the execution asynchronously, and return an event to wait for
+ * its completion. The inputs and outputs(the memory and the functions to
+ * access them) are taken at the time of the call, so the ones of the next
+ * computation can be set while this one is running, but the memory should not
+ * be touched until the event is completed. At most two computations are in
+ * flight for an execution, it blocks until the earliest one is completed if
+ * both of them are running. The computations are run in the order of the
+ * calls, and `NNAdapterExecution_compute` waits for all of them.
+ *
+ * Available since version 1.
+ */
+int NNAdapterExecution_computeAsync(NNAdapterExecution* execution,
+                                    NNAdapterEvent** event);
+/**
+ * Wait for the completion of an asynchronous computation, and return its
+ * result.
+ *
+ * Available since version 1.
+ */
+int NNAdapterEvent_wait(NNAdapterEvent* event);
+/**
+ * Destroy an event, it waits for the completion of the computation first.
+ *
+ * Available since version 1.
+ */
+void NNAdapterEvent_destroy(NNAdapterEvent* event);
 
 #ifdef __cplusplus
 }
@@ -18,6 +18,33 @@
 namespace nnadapter {
 namespace runtime {
 
+void Event::Signal(int result) {
+  // Notify with the lock held, so the event can be destroyed as soon as the
+  // waiter returns.
+  std::lock_guard<std::mutex> lock(mutex_);
+  result_ = result;
+  completed_ = true;
+  cv_.notify_all();
+}
+
+int Event::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return completed_; });
+  return result_;
+}
+
+Execution::~Execution() {
+  // The pending requests are completed before the worker exits
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  submitted_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
 int Execution::SetInput(int32_t index,
                         void* memory,
                         void* (*access)(void* memory,
@@ -61,9 +88,66 @@ int Execution::SetOutput(int32_t index,
 }
 
 int Execution::Compute() {
-  // TODO(hong19860320) support asynchronously execution
+  // Wait for the pending requests to keep the order of the computations
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    completed_cv_.wait(lock, [this] { return pending_count_ == 0; });
+  }
   return compilation_->Execute(&input_arguments_, &output_arguments_);
 }
 
+int Execution::ComputeAsync(Event** event) {
+  if (!event) {
+    return NNADAPTER_INVALID_PARAMETER;
+  }
+  *event = nullptr;
+  auto e = new Event();
+  if (!e) {
+    return NNADAPTER_OUT_OF_MEMORY;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!worker_.joinable()) {
+    worker_ = std::thread(&Execution::RunRequests, this);
+  }
+  // Block until the earliest request is completed if both of the buffers are
+  // in use
+  const uint32_t buffer_count = sizeof(requests_) / sizeof(requests_[0]);
+  completed_cv_.wait(lock, [&] { return pending_count_ < buffer_count; });
+  auto& request = requests_[(head_ + pending_count_) % buffer_count];
+  request.input_arguments = input_arguments_;
+  request.output_arguments = output_arguments_;
+  request.event = e;
+  pending_count_++;
+  submitted_cv_.notify_one();
+  *event = e;
+  return NNADAPTER_NO_ERROR;
+}
+
+void Execution::RunRequests() {
+  const uint32_t buffer_count = sizeof(requests_) / sizeof(requests_[0]);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    submitted_cv_.wait(lock, [this] { return stopped_ || pending_count_ > 0; });
+    if (pending_count_ == 0) break;
+    // The request isn't touched by the producer until it's released
+    auto& request = requests_[head_];
+    lock.unlock();
+    int result = NNADAPTER_DEVICE_INTERNAL_ERROR;
+    try {
+      result = compilation_->Execute(&request.input_arguments,
+                                     &request.output_arguments);
+    } catch (const std::exception& e) {
+      NNADAPTER_LOG(ERROR) << "Failed to run the asynchronous computation, "
+                           << e.what();
+    }
+    request.event->Signal(result);
+    lock.lock();
+    request.event = nullptr;
+    head_ = (head_ + 1) % buffer_count;
+    pending_count_--;
+    completed_cv_.notify_all();
+  }
+}
+
 }  // namespace runtime
 }  // namespace nnadapter
@@ -14,15 +14,37 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <mutex>               // NOLINT
+#include <thread>              // NOLINT
 #include <vector>
 #include "runtime/compilation.h"
+#include "utility/micros.h"
 
 namespace nnadapter {
 namespace runtime {
 
+// The completion event of an asynchronous computation
+class Event {
+ public:
+  Event() {}
+  // Mark the computation as completed and wake up the waiters
+  void Signal(int result);
+  // Block until the computation is completed and return its result
+  int Wait();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool completed_{false};
+  int result_{NNADAPTER_NO_ERROR};
+  DISALLOW_COPY_AND_ASSIGN(Event);
+};
+
 class Execution {
  public:
   explicit Execution(Compilation* compilation) : compilation_(compilation) {}
+  ~Execution();
   int SetInput(int32_t index,
                void* memory,
                void* (*access)(void* memory, NNAdapterOperandType* type));
@@ -30,11 +52,33 @@ class Execution {
                 void* memory,
                 void* (*access)(void* memory, NNAdapterOperandType* type));
   int Compute();
+  int ComputeAsync(Event** event);
+
+ private:
+  typedef struct {
+    std::vector<hal::Argument> input_arguments;
+    std::vector<hal::Argument> output_arguments;
+    Event* event;
+  } Request;
+  // Run the queued requests in the order of submission
+  void RunRequests();
 
  private:
   Compilation* compilation_{nullptr};
   std::vector<hal::Argument> input_arguments_;
   std::vector<hal::Argument> output_arguments_;
+  // The arguments passed to the device HAL are double buffered, the inputs
+  // and outputs of the next request can be set while the current one is
+  // running.
+  Request requests_[2];
+  uint32_t head_{0};
+  uint32_t pending_count_{0};
+  bool stopped_{false};
+  std::mutex mutex_;
+  std::condition_variable submitted_cv_;
+  std::condition_variable completed_cv_;
+  std::thread worker_;
+  DISALLOW_COPY_AND_ASSIGN(Execution);
 };
 
 }  // namespace runtime
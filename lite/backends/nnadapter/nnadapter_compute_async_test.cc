@@ -0,0 +1,215 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "lite/backends/nnadapter/nnadapter_wrapper.h"
+
+namespace paddle {
+namespace lite {
+
+// The host memory of an input or an output of the execution.
+struct HostMemory {
+  std::vector<int32_t> dims;
+  std::vector<float> data;
+};
+
+static void* AccessInput(void* memory, NNAdapterOperandType* type) {
+  auto host_memory = static_cast<HostMemory*>(memory);
+  type->dimension_count = host_memory->dims.size();
+  for (size_t i = 0; i < host_memory->dims.size(); i++) {
+    type->dimensions[i] = host_memory->dims[i];
+  }
+  return host_memory->data.data();
+}
+
+static void* AccessOutput(void* memory, NNAdapterOperandType* type) {
+  auto host_memory = static_cast<HostMemory*>(memory);
+  host_memory->dims.assign(type->dimensions,
+                           type->dimensions + type->dimension_count);
+  size_t count = 1;
+  for (auto dim : host_memory->dims) {
+    count *= dim;
+  }
+  host_memory->data.resize(count);
+  return host_memory->data.data();
+}
+
+static NNAdapterOperand* AddTensor(NNAdapterModel* model,
+                                   const std::vector<int32_t>& dims) {
+  NNAdapterOperandType type;
+  memset(&type, 0, sizeof(type));
+  type.precision = NNADAPTER_TENSOR_FLOAT32;
+  type.layout = NNADAPTER_NCHW;
+  type.dimension_count = dims.size();
+  for (size_t i = 0; i < dims.size(); i++) {
+    type.dimensions[i] = dims[i];
+  }
+  NNAdapterOperand* operand = nullptr;
+  EXPECT_EQ(NNAdapterModel_addOperand_invoke(model, &type, &operand),
+            NNADAPTER_NO_ERROR);
+  return operand;
+}
+
+class NNAdapterComputeAsyncTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(NNAdapterWrapper::Global().Supported());
+    ASSERT_EQ(NNAdapterDevice_acquire_invoke("x86_reference", &device_),
+              NNADAPTER_NO_ERROR);
+    ASSERT_EQ(NNAdapterContext_create_invoke(&device_, 1, "", &context_),
+              NNADAPTER_NO_ERROR);
+    // y = tanh(abs(x))
+    ASSERT_EQ(NNAdapterModel_create_invoke(&model_), NNADAPTER_NO_ERROR);
+    auto x = AddTensor(model_, dims_);
+    auto abs = AddTensor(model_, dims_);
+    auto y = AddTensor(model_, dims_);
+    NNAdapterOperation* operation = nullptr;
+    ASSERT_EQ(NNAdapterModel_addOperation_invoke(
+                  model_, NNADAPTER_ABS, 1, &x, 1, &abs, &operation),
+              NNADAPTER_NO_ERROR);
+    ASSERT_EQ(NNAdapterModel_addOperation_invoke(
+                  model_, NNADAPTER_TANH, 1, &abs, 1, &y, &operation),
+              NNADAPTER_NO_ERROR);
+    ASSERT_EQ(
+        NNAdapterModel_identifyInputsAndOutputs_invoke(model_, 1, &x, 1, &y),
+        NNADAPTER_NO_ERROR);
+    ASSERT_EQ(NNAdapterModel_finish_invoke(model_), NNADAPTER_NO_ERROR);
+    ASSERT_EQ(NNAdapterCompilation_create_invoke(
+                  model_, "", nullptr, 0, "", context_, &compilation_),
+              NNADAPTER_NO_ERROR);
+    ASSERT_EQ(NNAdapterCompilation_finish_invoke(compilation_),
+              NNADAPTER_NO_ERROR);
+    ASSERT_EQ(NNAdapterExecution_create_invoke(compilation_, &execution_),
+              NNADAPTER_NO_ERROR);
+  }
+
+  void TearDown() override {
+    NNAdapterExecution_destroy_invoke(execution_);
+    if (compilation_) NNAdapterCompilation_destroy_invoke(compilation_);
+    if (model_) NNAdapterModel_destroy_invoke(model_);
+    if (context_) NNAdapterContext_destroy_invoke(context_);
+    if (device_) NNAdapterDevice_release_invoke(device_);
+  }
+
+  // The input of the request k, whose values differ from the other requests.
+  HostMemory MakeInput(int k) {
+    HostMemory input;
+    input.dims = dims_;
+    input.data.resize(2 * 3 * 4 * 5);
+    for (size_t i = 0; i < input.data.size(); i++) {
+      input.data[i] = (static_cast<int>(i % 17) - 8 + k) / 4.f;
+    }
+    return input;
+  }
+
+  void CheckOutput(const HostMemory& input, const HostMemory& output) {
+    ASSERT_EQ(output.dims, input.dims);
+    ASSERT_EQ(output.data.size(), input.data.size());
+    for (size_t i = 0; i < input.data.size(); i++) {
+      EXPECT_NEAR(output.data[i], std::tanh(std::fabs(input.data[i])), 1e-5);
+    }
+  }
+
+  // Queue a request of the input and the output.
+  NNAdapterEvent* Submit(HostMemory* input, HostMemory* output) {
+    EXPECT_EQ(NNAdapterExecution_setInput_invoke(
+                  execution_, 0, input, AccessInput),
+              NNADAPTER_NO_ERROR);
+    EXPECT_EQ(NNAdapterExecution_setOutput_invoke(
+                  execution_, 0, output, AccessOutput),
+              NNADAPTER_NO_ERROR);
+    NNAdapterEvent* event = nullptr;
+    EXPECT_EQ(NNAdapterExecution_computeAsync_invoke(execution_, &event),
+              NNADAPTER_NO_ERROR);
+    EXPECT_NE(event, nullptr);
+    return event;
+  }
+
+  const std::vector<int32_t> dims_{2, 3, 4, 5};
+  NNAdapterDevice* device_{nullptr};
+  NNAdapterContext* context_{nullptr};
+  NNAdapterModel* model_{nullptr};
+  NNAdapterCompilation* compilation_{nullptr};
+  NNAdapterExecution* execution_{nullptr};
+};
+
+TEST_F(NNAdapterComputeAsyncTest, queue_more_than_ring) {
+  // More requests than the two buffers of the ring, each with its own memory.
+  const int request_count = 7;
+  std::vector<HostMemory> inputs, outputs(request_count);
+  std::vector<NNAdapterEvent*> events;
+  for (int k = 0; k < request_count; k++) {
+    inputs.push_back(MakeInput(k));
+  }
+  for (int k = 0; k < request_count; k++) {
+    events.push_back(Submit(&inputs[k], &outputs[k]));
+  }
+  // Wait for the events out of the order of the requests.
+  for (int k = request_count - 1; k >= 0; k--) {
+    ASSERT_EQ(NNAdapterEvent_wait_invoke(events[k]), NNADAPTER_NO_ERROR);
+    // The event keeps its result until it's destroyed.
+    ASSERT_EQ(NNAdapterEvent_wait_invoke(events[k]), NNADAPTER_NO_ERROR);
+    CheckOutput(inputs[k], outputs[k]);
+    NNAdapterEvent_destroy_invoke(events[k]);
+  }
+}
+
+TEST_F(NNAdapterComputeAsyncTest, compute_waits_for_pending_requests) {
+  HostMemory inputs[3] = {MakeInput(0), MakeInput(1), MakeInput(2)};
+  HostMemory outputs[3];
+  NNAdapterEvent* events[2] = {Submit(&inputs[0], &outputs[0]),
+                               Submit(&inputs[1], &outputs[1])};
+  // The events are destroyed before they are waited, destroy waits for them.
+  NNAdapterEvent_destroy_invoke(events[0]);
+  NNAdapterExecution_setInput_invoke(execution_, 0, &inputs[2], AccessInput);
+  NNAdapterExecution_setOutput_invoke(execution_, 0, &outputs[2], AccessOutput);
+  ASSERT_EQ(NNAdapterExecution_compute_invoke(execution_), NNADAPTER_NO_ERROR);
+  for (int k = 0; k < 3; k++) {
+    CheckOutput(inputs[k], outputs[k]);
+  }
+  NNAdapterEvent_destroy_invoke(events[1]);
+}
+
+TEST_F(NNAdapterComputeAsyncTest, event_outlives_execution) {
+  HostMemory inputs[3] = {MakeInput(0), MakeInput(1), MakeInput(2)};
+  HostMemory outputs[3];
+  NNAdapterEvent* events[3];
+  for (int k = 0; k < 3; k++) {
+    events[k] = Submit(&inputs[k], &outputs[k]);
+  }
+  // The pending requests are completed by the destruction of the execution.
+  NNAdapterExecution_destroy_invoke(execution_);
+  execution_ = nullptr;
+  for (int k = 0; k < 3; k++) {
+    ASSERT_EQ(NNAdapterEvent_wait_invoke(events[k]), NNADAPTER_NO_ERROR);
+    NNAdapterEvent_destroy_invoke(events[k]);
+    CheckOutput(inputs[k], outputs[k]);
+  }
+}
+
+TEST_F(NNAdapterComputeAsyncTest, invalid_parameters) {
+  EXPECT_EQ(NNAdapterExecution_computeAsync_invoke(execution_, nullptr),
+            NNADAPTER_INVALID_PARAMETER);
+  NNAdapterEvent* event = nullptr;
+  EXPECT_EQ(NNAdapterExecution_computeAsync_invoke(nullptr, &event),
+            NNADAPTER_INVALID_PARAMETER);
+  EXPECT_EQ(NNAdapterEvent_wait_invoke(nullptr), NNADAPTER_INVALID_PARAMETER);
+  NNAdapterEvent_destroy_invoke(nullptr);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -90,6 +90,9 @@ bool NNAdapterWrapper::Initialize() {
   NNADAPTER_LOAD_FUNCTION(NNAdapterExecution_setInput)
   NNADAPTER_LOAD_FUNCTION(NNAdapterExecution_setOutput)
   NNADAPTER_LOAD_FUNCTION(NNAdapterExecution_compute)
+  NNADAPTER_LOAD_FUNCTION(NNAdapterExecution_computeAsync)
+  NNADAPTER_LOAD_FUNCTION(NNAdapterEvent_wait)
+  NNADAPTER_LOAD_FUNCTION(NNAdapterEvent_destroy)
 #undef NNADAPTER_LOAD_FUNCTION
   VLOG(4) << "Extract all of symbols from " << found_path << " done.";
   return true;
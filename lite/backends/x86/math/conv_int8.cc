@@ -0,0 +1,168 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/conv_int8.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "lite/backends/x86/parallel.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+void im2col_pack_s8(const int8_t* data_im,
+                    int channels,
+                    int height,
+                    int width,
+                    int kernel_h,
+                    int kernel_w,
+                    int pad_top,
+                    int pad_left,
+                    int stride_h,
+                    int stride_w,
+                    int dilation_h,
+                    int dilation_w,
+                    int output_h,
+                    int output_w,
+                    int16_t* packed_b) {
+  const int k = channels * kernel_h * kernel_w;
+  const int n = output_h * output_w;
+  const int k2 = (k + 1) / 2 * 2;
+  // The padded rows and columns of B must be zero.
+  std::memset(packed_b, 0, sizeof(int16_t) * gemm_s8_packed_b_size(k, n));
+  auto pack_rows = [&](int64_t begin, int64_t end) {
+    for (int64_t kk = begin; kk < end; kk++) {
+      const int c = static_cast<int>(kk) / (kernel_h * kernel_w);
+      const int i = static_cast<int>(kk) / kernel_w % kernel_h;
+      const int j = static_cast<int>(kk) % kernel_w;
+      const int8_t* src = data_im + c * height * width;
+      int16_t* dst = packed_b + (kk / 2) * 2 * kGemmS8NBlock + (kk % 2);
+      for (int oh = 0; oh < output_h; oh++) {
+        const int ih = oh * stride_h - pad_top + i * dilation_h;
+        if (ih < 0 || ih >= height) continue;
+        for (int ow = 0; ow < output_w; ow++) {
+          const int iw = ow * stride_w - pad_left + j * dilation_w;
+          if (iw < 0 || iw >= width) continue;
+          const int col = oh * output_w + ow;
+          dst[(col / kGemmS8NBlock) * kGemmS8NBlock * k2 +
+              (col % kGemmS8NBlock) * 2] = src[ih * width + iw];
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, k, pack_rows);
+}
+
+template <typename Dtype>
+void conv_depthwise_s8(const int8_t* din,
+                       const int8_t* weights,
+                       int channels,
+                       int height,
+                       int width,
+                       int output_h,
+                       int output_w,
+                       int kernel_h,
+                       int kernel_w,
+                       int pad_top,
+                       int pad_left,
+                       int stride_h,
+                       int stride_w,
+                       int dilation_h,
+                       int dilation_w,
+                       const GemmS8Epilogue& epilogue,
+                       Dtype* dout) {
+  const int out_size = output_h * output_w;
+  auto compute_channels = [&](int64_t begin, int64_t end) {
+    std::vector<int32_t> acc(out_size);
+    for (int64_t c = begin; c < end; c++) {
+      const int8_t* src = din + c * height * width;
+      const int8_t* w = weights + c * kernel_h * kernel_w;
+      std::fill(acc.begin(), acc.end(), 0);
+      for (int i = 0; i < kernel_h; i++) {
+        for (int j = 0; j < kernel_w; j++) {
+          const int32_t wv = w[i * kernel_w + j];
+          // The range of ow whose input column is inside the image.
+          const int offset_w = j * dilation_w - pad_left;
+          const int ow_begin =
+              offset_w >= 0 ? 0 : (stride_w - 1 - offset_w) / stride_w;
+          const int ow_end =
+              width - offset_w <= 0
+                  ? 0
+                  : std::min((width - 1 - offset_w) / stride_w + 1, output_w);
+          for (int oh = 0; oh < output_h; oh++) {
+            const int ih = oh * stride_h - pad_top + i * dilation_h;
+            if (ih < 0 || ih >= height) continue;
+            const int8_t* src_row = src + ih * width;
+            int32_t* acc_row = acc.data() + oh * output_w;
+            for (int ow = ow_begin; ow < ow_end; ow++) {
+              acc_row[ow] += wv * src_row[ow * stride_w + offset_w];
+            }
+          }
+        }
+      }
+      gemm_s8_epilogue<Dtype>(acc.data(),
+                              1,
+                              out_size,
+                              out_size,
+                              static_cast<int>(c),
+                              0,
+                              epilogue,
+                              dout + c * out_size,
+                              out_size);
+    }
+  };
+  lite::x86::RunParallelFor(0, channels, compute_channels);
+}
+
+template void conv_depthwise_s8<float>(const int8_t*,
+                                       const int8_t*,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       int,
+                                       const GemmS8Epilogue&,
+                                       float*);
+template void conv_depthwise_s8<int8_t>(const int8_t*,
+                                        const int8_t*,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        int,
+                                        const GemmS8Epilogue&,
+                                        int8_t*);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
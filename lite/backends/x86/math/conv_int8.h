@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "lite/backends/x86/math/gemm_int8.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// im2col of the int8 image(channels x height x width), the columns are packed
+// as the B of gemm_s8 directly, whose K is channels * kernel_h * kernel_w and
+// N is output_h * output_w.
+void im2col_pack_s8(const int8_t* data_im,
+                    int channels,
+                    int height,
+                    int width,
+                    int kernel_h,
+                    int kernel_w,
+                    int pad_top,
+                    int pad_left,
+                    int stride_h,
+                    int stride_w,
+                    int dilation_h,
+                    int dilation_w,
+                    int output_h,
+                    int output_w,
+                    int16_t* packed_b);
+
+// The int8 depthwise convolution with the channel multiplier 1, the output
+// stage is applied per channel.
+template <typename Dtype>
+void conv_depthwise_s8(const int8_t* din,
+                       const int8_t* weights,
+                       int channels,
+                       int height,
+                       int width,
+                       int output_h,
+                       int output_w,
+                       int kernel_h,
+                       int kernel_w,
+                       int pad_top,
+                       int pad_left,
+                       int stride_h,
+                       int stride_w,
+                       int dilation_h,
+                       int dilation_w,
+                       const GemmS8Epilogue& epilogue,
+                       Dtype* dout);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
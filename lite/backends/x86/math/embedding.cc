@@ -0,0 +1,246 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/embedding.h"
+#if defined(__AVX2__) || defined(__F16C__)
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/bfloat16.h"
+#include "lite/utils/float16.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The number of the output floats written by a task at least.
+static constexpr int64_t kEmbeddingFloatsPerTask = 4096;
+
+// dst = src or dst += src of the row of width floats.
+template <bool kAdd>
+static void gather_row(const float* src, int64_t width, float* dst) {
+  if (!kAdd) {
+    std::memcpy(dst, src, width * sizeof(float));
+    return;
+  }
+  for (int64_t i = 0; i < width; i++) {
+    dst[i] += src[i];
+  }
+}
+
+template <bool kAdd>
+static void gather_row(const float16* src, int64_t width, float* dst) {
+  int64_t i = 0;
+#ifdef __F16C__
+  for (; i + 8 <= width; i += 8) {
+    __m256 v = _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    if (kAdd) {
+      v = _mm256_add_ps(v, _mm256_loadu_ps(dst + i));
+    }
+    _mm256_storeu_ps(dst + i, v);
+  }
+#endif
+  for (; i < width; i++) {
+    float v = static_cast<float>(src[i]);
+    dst[i] = kAdd ? dst[i] + v : v;
+  }
+}
+
+template <bool kAdd>
+static void gather_row(const bfloat16* src, int64_t width, float* dst) {
+  int64_t i = 0;
+#ifdef __AVX2__
+  for (; i + 8 <= width; i += 8) {
+    __m256i bits = _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    __m256 v = _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16));
+    if (kAdd) {
+      v = _mm256_add_ps(v, _mm256_loadu_ps(dst + i));
+    }
+    _mm256_storeu_ps(dst + i, v);
+  }
+#endif
+  for (; i < width; i++) {
+    float v = static_cast<float>(src[i]);
+    dst[i] = kAdd ? dst[i] + v : v;
+  }
+}
+
+template <bool kAdd>
+static void gather_row(const int8_t* src,
+                       float scale,
+                       int64_t width,
+                       float* dst) {
+  int64_t i = 0;
+#ifdef __AVX2__
+  const __m256 vscale = _mm256_set1_ps(scale);
+  for (; i + 8 <= width; i += 8) {
+    __m128i q = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+    __m256 v = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(q));
+    if (kAdd) {
+      v = _mm256_fmadd_ps(v, vscale, _mm256_loadu_ps(dst + i));
+    } else {
+      v = _mm256_mul_ps(v, vscale);
+    }
+    _mm256_storeu_ps(dst + i, v);
+  }
+#endif
+  for (; i < width; i++) {
+    float v = src[i] * scale;
+    dst[i] = kAdd ? dst[i] + v : v;
+  }
+}
+
+namespace {
+
+// The view of the table which gathers its rows in fp32.
+class EmbeddingTable {
+ public:
+  EmbeddingTable(const lite::Tensor& table,
+                 const lite::Tensor* row_scale,
+                 int64_t padding_idx)
+      : precision_(table.precision()),
+        data_(table.raw_data()),
+        rows_(table.dims()[0]),
+        width_(table.dims()[1]),
+        padding_idx_(padding_idx) {
+    CHECK_EQ(table.dims().size(), 2UL);
+    if (precision_ == PRECISION(kInt8)) {
+      CHECK(row_scale) << "The int8 embedding table has no row scales.";
+      CHECK_EQ(row_scale->numel(), rows_);
+      row_scale_ = row_scale->data<float>();
+    } else {
+      CHECK(precision_ == PRECISION(kFloat) ||
+            precision_ == PRECISION(kFP16) ||
+            precision_ == PRECISION(kBF16))
+          << "Unsupported embedding table precision: "
+          << lite_api::PrecisionToStr(precision_);
+    }
+  }
+
+  int64_t width() const { return width_; }
+
+  // dst = table[id] or dst += table[id].
+  template <bool kAdd>
+  void Gather(int64_t id, float* dst) const {
+    if (padding_idx_ != -1 && id == padding_idx_) {
+      if (!kAdd) {
+        std::memset(dst, 0, width_ * sizeof(float));
+      }
+      return;
+    }
+    CHECK_GE(id, 0);
+    CHECK_LT(id, rows_);
+    switch (precision_) {
+      case PRECISION(kFloat):
+        gather_row<kAdd>(
+            static_cast<const float*>(data_) + id * width_, width_, dst);
+        break;
+      case PRECISION(kFP16):
+        gather_row<kAdd>(
+            static_cast<const float16*>(data_) + id * width_, width_, dst);
+        break;
+      case PRECISION(kBF16):
+        gather_row<kAdd>(
+            static_cast<const bfloat16*>(data_) + id * width_, width_, dst);
+        break;
+      default:
+        gather_row<kAdd>(static_cast<const int8_t*>(data_) + id * width_,
+                         row_scale_[id],
+                         width_,
+                         dst);
+        break;
+    }
+  }
+
+ private:
+  lite_api::PrecisionType precision_;
+  const void* data_;
+  const float* row_scale_{nullptr};
+  int64_t rows_;
+  int64_t width_;
+  int64_t padding_idx_;
+};
+
+}  // namespace
+
+void embedding_lookup(const lite::Tensor& table,
+                      const lite::Tensor* row_scale,
+                      const int64_t* ids,
+                      int64_t num,
+                      int64_t padding_idx,
+                      float* out) {
+  EmbeddingTable view(table, row_scale, padding_idx);
+  const int64_t width = view.width();
+  auto lookup = [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      view.Gather<false>(ids[i], out + i * width);
+    }
+  };
+  int64_t chunk = kEmbeddingFloatsPerTask / std::max<int64_t>(width, 1);
+  lite::x86::RunParallelFor(0, num, lookup, std::max<int64_t>(chunk, 1));
+}
+
+void embedding_seq_pool(const lite::Tensor& table,
+                        const lite::Tensor* row_scale,
+                        const int64_t* ids,
+                        const std::vector<uint64_t>& lod,
+                        int64_t padding_idx,
+                        const std::string& pool_type,
+                        float* out) {
+  CHECK(pool_type == "SUM" || pool_type == "AVERAGE" || pool_type == "SQRT")
+      << "Unsupported pool type of the embedding: " << pool_type;
+  EmbeddingTable view(table, row_scale, padding_idx);
+  const int64_t width = view.width();
+  const int64_t seq_num = static_cast<int64_t>(lod.size()) - 1;
+  const bool average = pool_type == "AVERAGE";
+  const bool sqrt_len = pool_type == "SQRT";
+  auto pool = [&](int64_t begin, int64_t end) {
+    for (int64_t s = begin; s < end; s++) {
+      float* dst = out + s * width;
+      const int64_t seq_begin = lod[s];
+      const int64_t seq_end = lod[s + 1];
+      if (seq_begin == seq_end) {
+        std::memset(dst, 0, width * sizeof(float));
+        continue;
+      }
+      view.Gather<false>(ids[seq_begin], dst);
+      for (int64_t i = seq_begin + 1; i < seq_end; i++) {
+        view.Gather<true>(ids[i], dst);
+      }
+      if (average || sqrt_len) {
+        float len = static_cast<float>(seq_end - seq_begin);
+        float scale = 1.f / (average ? len : std::sqrt(len));
+        for (int64_t j = 0; j < width; j++) {
+          dst[j] *= scale;
+        }
+      }
+    }
+  };
+  int64_t ids_num = seq_num > 0 ? static_cast<int64_t>(lod.back()) : 0;
+  int64_t floats_per_seq =
+      std::max<int64_t>(1, ids_num / std::max<int64_t>(seq_num, 1) * width);
+  int64_t chunk = kEmbeddingFloatsPerTask / floats_per_seq;
+  lite::x86::RunParallelFor(0, seq_num, pool, std::max<int64_t>(chunk, 1));
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
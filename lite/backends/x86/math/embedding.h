@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The [rows, width] tables of the embedding lookup are stored in one of the
+ * precisions:
+ *   kFloat: the fp32 values.
+ *   kFP16: the fp16 values.
+ *   kBF16: the bf16 values.
+ *   kInt8: the values quantized symmetrically row by row, the value is
+ *          table[row][i] * row_scale[row], row_scale is a fp32 [rows] tensor.
+ * The rows are dequantized to fp32 on gather, the row of padding_idx is read
+ * as zeros unless padding_idx is -1.
+ */
+
+// out[i] = table[ids[i]] for i in [0, num), the ids are gathered in parallel.
+void embedding_lookup(const lite::Tensor& table,
+                      const lite::Tensor* row_scale,
+                      const int64_t* ids,
+                      int64_t num,
+                      int64_t padding_idx,
+                      float* out);
+
+// Pool the rows of the ids of the sequence s in [lod[s], lod[s + 1]) to
+// out[s], pool_type is "SUM", "AVERAGE" or "SQRT" as sequence_pool does, and
+// the empty sequences are zeros. The sequences are pooled in parallel.
+void embedding_seq_pool(const lite::Tensor& table,
+                        const lite::Tensor* row_scale,
+                        const int64_t* ids,
+                        const std::vector<uint64_t>& lod,
+                        int64_t padding_idx,
+                        const std::string& pool_type,
+                        float* out);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
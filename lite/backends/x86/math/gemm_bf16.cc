@@ -0,0 +1,177 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include <algorithm>
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static inline int round_up(int x, int align) {
+  return (x + align - 1) / align * align;
+}
+
+int gemm_bf16_packed_a_size(int m, int k) {
+  return round_up(m, kGemmBf16MBlock) * round_up(k, 2);
+}
+
+int gemm_bf16_packed_b_size(int k, int n) {
+  return round_up(k, 2) * round_up(n, kGemmBf16NBlock);
+}
+
+void gemm_bf16_pack_a(
+    bool trans, const float* a, int m, int k, int lda, float* packed_a) {
+  const int k2 = round_up(k, 2);
+  const int m4 = round_up(m, kGemmBf16MBlock);
+  auto at = [=](int row, int col) {
+    return trans ? a[col * lda + row] : a[row * lda + col];
+  };
+  for (int mb = 0; mb < m4; mb += kGemmBf16MBlock) {
+    float* dst = packed_a + mb * k2;
+    for (int kk = 0; kk < k2; kk += 2) {
+      for (int r = 0; r < kGemmBf16MBlock; r++) {
+        const int row = mb + r;
+        const bool valid = row < m;
+        *(dst++) = valid ? at(row, kk) : 0.f;
+        *(dst++) = valid && kk + 1 < k ? at(row, kk + 1) : 0.f;
+      }
+    }
+  }
+}
+
+void gemm_bf16_pack_b(
+    bool trans, const bfloat16* b, int k, int n, int ldb, bfloat16* packed_b) {
+  const int k2 = round_up(k, 2);
+  const int n16 = round_up(n, kGemmBf16NBlock);
+  const bfloat16 zero(0.f);
+  auto at = [=](int row, int col) {
+    return trans ? b[col * ldb + row] : b[row * ldb + col];
+  };
+  for (int nb = 0; nb < n16; nb += kGemmBf16NBlock) {
+    bfloat16* dst = packed_b + nb * k2;
+    const int cols = std::min(kGemmBf16NBlock, n - nb);
+    for (int kk = 0; kk < k2; kk += 2) {
+      for (int c = 0; c < kGemmBf16NBlock; c++) {
+        const bool valid = c < cols;
+        *(dst++) = valid ? at(kk, nb + c) : zero;
+        *(dst++) = valid && kk + 1 < k ? at(kk + 1, nb + c) : zero;
+      }
+    }
+  }
+}
+
+void gemm_bf16_kernel_ref(const float* packed_a,
+                          const bfloat16* packed_b,
+                          int k2,
+                          float* acc) {
+  for (int r = 0; r < kGemmBf16MBlock; r++) {
+    for (int c = 0; c < kGemmBf16NBlock; c++) {
+      const float* a = packed_a + r * 2;
+      const bfloat16* b = packed_b + c * 2;
+      float sum = 0.f;
+      for (int kk = 0; kk < k2; kk += 2) {
+        sum += a[0] * static_cast<float>(b[0]) +
+               a[1] * static_cast<float>(b[1]);
+        a += kGemmBf16MBlock * 2;
+        b += kGemmBf16NBlock * 2;
+      }
+      acc[r * kGemmBf16NBlock + c] = sum;
+    }
+  }
+}
+
+// Select the fastest micro kernel which is supported by both of the compiler
+// and the current CPU.
+static GemmBf16Kernel select_gemm_bf16_kernel() {
+  GemmBf16Kernel kernel = nullptr;
+  if (device_has_avx512_bf16()) {
+    kernel = gemm_bf16_kernel_avx512();
+  }
+  AVXType level = device_avx_level();
+  if (kernel == nullptr &&
+      (level == AVXType::ISA_VNNI || level == AVXType::ISA_AVX2)) {
+    kernel = gemm_bf16_kernel_avx2();
+  }
+  return kernel == nullptr ? gemm_bf16_kernel_ref : kernel;
+}
+
+static void gemm_bf16_epilogue(const float* acc,
+                               int rows,
+                               int cols,
+                               int row_offset,
+                               int col_offset,
+                               const GemmBf16Epilogue& epilogue,
+                               float* c,
+                               int ldc) {
+  const float* bias = epilogue.bias ? epilogue.bias + col_offset : nullptr;
+  for (int r = 0; r < rows; r++) {
+    const float* src = acc + r * kGemmBf16NBlock;
+    for (int i = 0; i < cols; i++) {
+      float v = epilogue.alpha * src[i] + (bias ? bias[i] : 0.f);
+      v = epilogue.relu ? std::max(v, 0.f) : v;
+      const int row = row_offset + r;
+      const int col = col_offset + i;
+      c[epilogue.trans_c ? col * ldc + row : row * ldc + col] = v;
+    }
+  }
+}
+
+void gemm_bf16(const float* packed_a,
+               const bfloat16* packed_b,
+               int m,
+               int n,
+               int k,
+               const GemmBf16Epilogue& epilogue,
+               float* c,
+               int ldc,
+               GemmBf16Kernel kernel) {
+  static const GemmBf16Kernel default_kernel = select_gemm_bf16_kernel();
+  if (kernel == nullptr) {
+    kernel = default_kernel;
+  }
+  const int k2 = round_up(k, 2);
+  const int num_mb = (m + kGemmBf16MBlock - 1) / kGemmBf16MBlock;
+  const int num_panels = (n + kGemmBf16NBlock - 1) / kGemmBf16NBlock;
+  // The blocks of A are iterated in the inner loop to keep the panels of B in
+  // cache, B is read once for the small M of the memory bound fc.
+  auto compute_blocks = [&](int64_t begin, int64_t end) {
+    float acc[kGemmBf16MBlock * kGemmBf16NBlock];
+    for (int64_t t = begin; t < end; t++) {
+      const int panel = static_cast<int>(t / num_mb);
+      const int mb = static_cast<int>(t % num_mb);
+      const int row = mb * kGemmBf16MBlock;
+      const int col = panel * kGemmBf16NBlock;
+      kernel(packed_a + row * k2, packed_b + col * k2, k2, acc);
+      gemm_bf16_epilogue(acc,
+                         std::min(kGemmBf16MBlock, m - row),
+                         std::min(kGemmBf16NBlock, n - col),
+                         row,
+                         col,
+                         epilogue,
+                         c,
+                         ldc);
+    }
+  };
+  lite::x86::RunParallelFor(
+      0, static_cast<int64_t>(num_mb) * num_panels, compute_blocks);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,93 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The bf16 GEMM computes C(M x N) = A(M x K) * B(K x N) of the fp32 A and the
+ * bf16 B with the fp32 accumulation, B is the weights stored in bf16 to halve
+ * their memory and bandwidth. B is packed as pairs along K, so a pair of
+ * products is accumulated by one vdpbf16ps lane of AVX512-BF16, or by two FMAs
+ * of AVX2 after the bf16 are widened to fp32 by shifts. A is rounded to bf16
+ * by the AVX512-BF16 kernel only.
+ *
+ * packed A: blocks of 4 rows, each block is [K/2][4 rows][2] fp32.
+ * packed B: panels of 16 columns, each panel is [K/2][16 cols][2] bf16.
+ * K is padded to a multiple of 2, M to 4 and N to 16 with zeros.
+ */
+constexpr int kGemmBf16MBlock = 4;
+constexpr int kGemmBf16NBlock = 16;
+
+// The number of the elements of the packed A(fp32) and B(bf16).
+int gemm_bf16_packed_a_size(int m, int k);
+int gemm_bf16_packed_b_size(int k, int n);
+
+// Pack A(M x K), A is stored as K x M if trans is true.
+void gemm_bf16_pack_a(
+    bool trans, const float* a, int m, int k, int lda, float* packed_a);
+// Pack B(K x N), B is stored as N x K if trans is true.
+void gemm_bf16_pack_b(
+    bool trans, const bfloat16* b, int k, int n, int ldb, bfloat16* packed_b);
+
+// The output stage: out = alpha * acc + bias, followed by relu if relu is
+// true. bias is optional and indexed by the column of C. C is stored
+// transposed, i.e. as N x M, if trans_c is true.
+struct GemmBf16Epilogue {
+  float alpha{1.f};
+  const float* bias{nullptr};
+  bool relu{false};
+  bool trans_c{false};
+};
+
+// The micro kernel computes the block C(4 x 16) of one block of the packed A
+// and one panel of the packed B, k2 is the padded K, the block is stored to
+// acc with the leading dimension 16.
+using GemmBf16Kernel = void (*)(const float* packed_a,
+                                const bfloat16* packed_b,
+                                int k2,
+                                float* acc);
+
+// The micro kernels of the instruction sets, nullptr is returned if the
+// instruction set isn't enabled by the compiler.
+GemmBf16Kernel gemm_bf16_kernel_avx2();
+GemmBf16Kernel gemm_bf16_kernel_avx512();
+// The portable micro kernel.
+void gemm_bf16_kernel_ref(const float* packed_a,
+                          const bfloat16* packed_b,
+                          int k2,
+                          float* acc);
+
+// C = epilogue(packed_a * packed_b), the blocks of C are computed in parallel.
+// The micro kernel is selected by the CPU if kernel is nullptr.
+void gemm_bf16(const float* packed_a,
+               const bfloat16* packed_b,
+               int m,
+               int n,
+               int k,
+               const GemmBf16Epilogue& epilogue,
+               float* c,
+               int ldc,
+               GemmBf16Kernel kernel = nullptr);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
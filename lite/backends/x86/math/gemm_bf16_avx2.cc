@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <immintrin.h>
+#include "lite/backends/x86/math/gemm_bf16.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#if defined(__AVX2__) && defined(__FMA__)
+// A pair of bf16 of B is one int32 lane, the bf16 of the even K is the low
+// half, so it's widened to fp32 by a left shift, and the one of the odd K by
+// clearing the low half.
+#define GEMM_BF16_ROW(r)                           \
+  va0 = _mm256_broadcast_ss(packed_a + r * 2);     \
+  va1 = _mm256_broadcast_ss(packed_a + r * 2 + 1); \
+  c##r##0 = _mm256_fmadd_ps(va0, vb0e, c##r##0);   \
+  c##r##1 = _mm256_fmadd_ps(va0, vb1e, c##r##1);   \
+  c##r##0 = _mm256_fmadd_ps(va1, vb0o, c##r##0);   \
+  c##r##1 = _mm256_fmadd_ps(va1, vb1o, c##r##1);
+
+static void gemm_bf16_kernel_avx2_func(const float* packed_a,
+                                       const bfloat16* packed_b,
+                                       int k2,
+                                       float* acc) {
+  const __m256i odd_mask = _mm256_set1_epi32(0xffff0000);
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 va0, va1;
+  for (int kk = 0; kk < k2; kk += 2) {
+    const __m256i* b = reinterpret_cast<const __m256i*>(packed_b);
+    __m256i vb0 = _mm256_loadu_si256(b);
+    __m256i vb1 = _mm256_loadu_si256(b + 1);
+    __m256 vb0e = _mm256_castsi256_ps(_mm256_slli_epi32(vb0, 16));
+    __m256 vb0o = _mm256_castsi256_ps(_mm256_and_si256(vb0, odd_mask));
+    __m256 vb1e = _mm256_castsi256_ps(_mm256_slli_epi32(vb1, 16));
+    __m256 vb1o = _mm256_castsi256_ps(_mm256_and_si256(vb1, odd_mask));
+    GEMM_BF16_ROW(0)
+    GEMM_BF16_ROW(1)
+    GEMM_BF16_ROW(2)
+    GEMM_BF16_ROW(3)
+    packed_a += kGemmBf16MBlock * 2;
+    packed_b += kGemmBf16NBlock * 2;
+  }
+  _mm256_storeu_ps(acc, c00);
+  _mm256_storeu_ps(acc + 8, c01);
+  _mm256_storeu_ps(acc + 16, c10);
+  _mm256_storeu_ps(acc + 24, c11);
+  _mm256_storeu_ps(acc + 32, c20);
+  _mm256_storeu_ps(acc + 40, c21);
+  _mm256_storeu_ps(acc + 48, c30);
+  _mm256_storeu_ps(acc + 56, c31);
+}
+#undef GEMM_BF16_ROW
+
+GemmBf16Kernel gemm_bf16_kernel_avx2() { return gemm_bf16_kernel_avx2_func; }
+#else
+GemmBf16Kernel gemm_bf16_kernel_avx2() { return nullptr; }
+#endif
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
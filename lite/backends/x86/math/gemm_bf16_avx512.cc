@@ -0,0 +1,84 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <immintrin.h>
+#include "lite/backends/x86/math/gemm_bf16.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#if defined(__AVX512BF16__) && defined(__AVX512VL__)
+// The 4 pairs of A of a step are rounded to bf16 by one vcvtneps2bf16, each
+// pair is broadcasted as one int32 lane, and vdpbf16ps multiplies it with the
+// pairs of 16 columns of B and accumulates both of the products.
+#define GEMM_BF16_ROW(r, s)                                         \
+  c##s##r = _mm512_dpbf16_ps(                                       \
+      c##s##r, (__m512bh)_mm512_permutexvar_epi32(idx##r, va), vb);
+
+#define GEMM_BF16_STEP(s)                                       \
+  va = _mm512_castsi256_si512(_mm256_castsi128_si256(           \
+      (__m128i)_mm256_cvtneps_pbh(_mm256_loadu_ps(packed_a)))); \
+  vb = (__m512bh)_mm512_loadu_si512(packed_b);                  \
+  GEMM_BF16_ROW(0, s)                                           \
+  GEMM_BF16_ROW(1, s)                                           \
+  GEMM_BF16_ROW(2, s)                                           \
+  GEMM_BF16_ROW(3, s)                                           \
+  packed_a += kGemmBf16MBlock * 2;                              \
+  packed_b += kGemmBf16NBlock * 2;
+
+static void gemm_bf16_kernel_avx512_func(const float* packed_a,
+                                         const bfloat16* packed_b,
+                                         int k2,
+                                         float* acc) {
+  const __m512i idx0 = _mm512_set1_epi32(0);
+  const __m512i idx1 = _mm512_set1_epi32(1);
+  const __m512i idx2 = _mm512_set1_epi32(2);
+  const __m512i idx3 = _mm512_set1_epi32(3);
+  __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+  __m512 c02 = _mm512_setzero_ps(), c03 = _mm512_setzero_ps();
+  __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+  __m512 c12 = _mm512_setzero_ps(), c13 = _mm512_setzero_ps();
+  __m512i va;
+  __m512bh vb;
+  // vdpbf16ps has a long latency, so two sets of accumulators are used for
+  // the even and odd pairs of K to hide it.
+  int kk = 0;
+  for (; kk + 4 <= k2; kk += 4) {
+    GEMM_BF16_STEP(0)
+    GEMM_BF16_STEP(1)
+  }
+  if (kk < k2) {
+    GEMM_BF16_STEP(0)
+  }
+  _mm512_storeu_ps(acc, _mm512_add_ps(c00, c10));
+  _mm512_storeu_ps(acc + kGemmBf16NBlock, _mm512_add_ps(c01, c11));
+  _mm512_storeu_ps(acc + 2 * kGemmBf16NBlock, _mm512_add_ps(c02, c12));
+  _mm512_storeu_ps(acc + 3 * kGemmBf16NBlock, _mm512_add_ps(c03, c13));
+}
+#undef GEMM_BF16_STEP
+#undef GEMM_BF16_ROW
+
+GemmBf16Kernel gemm_bf16_kernel_avx512() {
+  return gemm_bf16_kernel_avx512_func;
+}
+#else
+GemmBf16Kernel gemm_bf16_kernel_avx512() { return nullptr; }
+#endif
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,196 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static std::vector<float> RandomData(int size, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(rng);
+  }
+  return data;
+}
+
+static std::vector<bfloat16> ToBf16(const std::vector<float>& data) {
+  std::vector<bfloat16> out;
+  for (auto v : data) {
+    out.emplace_back(v);
+  }
+  return out;
+}
+
+// The naive C(M x N) = A(M x K) * B(K x N) of the fp32 A and the bf16 B, A is
+// stored as K x M if trans_a is true and B is stored as N x K if trans_b is
+// true. abs_sum is the sum of the absolute products, which bounds the error of
+// rounding A to bf16.
+static void ReferenceGemm(bool trans_a,
+                          bool trans_b,
+                          const std::vector<float>& a,
+                          const std::vector<bfloat16>& b,
+                          int m,
+                          int n,
+                          int k,
+                          std::vector<float>* c,
+                          std::vector<float>* abs_sum) {
+  c->assign(m * n, 0.f);
+  abs_sum->assign(m * n, 0.f);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum = 0.;
+      double sum_abs = 0.;
+      for (int p = 0; p < k; p++) {
+        float va = trans_a ? a[p * m + i] : a[i * k + p];
+        float vb = static_cast<float>(trans_b ? b[j * k + p] : b[p * n + j]);
+        sum += va * vb;
+        sum_abs += std::fabs(va * vb);
+      }
+      (*c)[i * n + j] = static_cast<float>(sum);
+      (*abs_sum)[i * n + j] = static_cast<float>(sum_abs);
+    }
+  }
+}
+
+static std::vector<GemmBf16Kernel> AvailableKernels() {
+  std::vector<GemmBf16Kernel> kernels{gemm_bf16_kernel_ref};
+  AVXType level = device_avx_level();
+  if ((level == AVXType::ISA_AVX2 || level == AVXType::ISA_VNNI) &&
+      gemm_bf16_kernel_avx2() != nullptr) {
+    kernels.push_back(gemm_bf16_kernel_avx2());
+  }
+  if (device_has_avx512_bf16() && gemm_bf16_kernel_avx512() != nullptr) {
+    kernels.push_back(gemm_bf16_kernel_avx512());
+  }
+  return kernels;
+}
+
+// The AVX512-BF16 kernel rounds A to bf16, whose relative error is 2^-9.
+static float Tolerance(float abs_sum) { return abs_sum / 256.f + 1e-5f; }
+
+TEST(gemm_bf16, micro_kernels) {
+  // K is odd, so the last pair along K is padded with a zero.
+  const int k = 37;
+  auto a = RandomData(kGemmBf16MBlock * k, 1);
+  auto b = ToBf16(RandomData(k * kGemmBf16NBlock, 2));
+  std::vector<float> packed_a(gemm_bf16_packed_a_size(kGemmBf16MBlock, k));
+  std::vector<bfloat16> packed_b(gemm_bf16_packed_b_size(k, kGemmBf16NBlock));
+  gemm_bf16_pack_a(false, a.data(), kGemmBf16MBlock, k, k, packed_a.data());
+  gemm_bf16_pack_b(
+      false, b.data(), k, kGemmBf16NBlock, kGemmBf16NBlock, packed_b.data());
+  std::vector<float> ref, abs_sum;
+  ReferenceGemm(
+      false, false, a, b, kGemmBf16MBlock, kGemmBf16NBlock, k, &ref, &abs_sum);
+
+  for (auto kernel : AvailableKernels()) {
+    std::vector<float> acc(kGemmBf16MBlock * kGemmBf16NBlock, -1.f);
+    kernel(packed_a.data(), packed_b.data(), k + 1, acc.data());
+    for (int i = 0; i < kGemmBf16MBlock * kGemmBf16NBlock; i++) {
+      ASSERT_NEAR(acc[i], ref[i], Tolerance(abs_sum[i])) << "at " << i;
+    }
+  }
+}
+
+static void TestGemmBf16(bool trans_a,
+                         bool trans_b,
+                         bool trans_c,
+                         int m,
+                         int n,
+                         int k,
+                         GemmBf16Kernel kernel) {
+  auto a = RandomData(m * k, m + k);
+  auto b = ToBf16(RandomData(k * n, n + k));
+  auto bias = RandomData(n, n);
+  std::vector<float> packed_a(gemm_bf16_packed_a_size(m, k));
+  std::vector<bfloat16> packed_b(gemm_bf16_packed_b_size(k, n));
+  gemm_bf16_pack_a(trans_a, a.data(), m, k, trans_a ? m : k, packed_a.data());
+  gemm_bf16_pack_b(trans_b, b.data(), k, n, trans_b ? k : n, packed_b.data());
+
+  GemmBf16Epilogue epilogue;
+  epilogue.alpha = 0.5f;
+  epilogue.bias = bias.data();
+  epilogue.relu = true;
+  epilogue.trans_c = trans_c;
+  // C is a sub-matrix of a larger buffer, the padding must be kept.
+  const int rows = trans_c ? n : m;
+  const int cols = trans_c ? m : n;
+  const int ldc = cols + 3;
+  std::vector<float> c(rows * ldc, 7.f);
+  gemm_bf16(packed_a.data(),
+            packed_b.data(),
+            m,
+            n,
+            k,
+            epilogue,
+            c.data(),
+            ldc,
+            kernel);
+
+  std::vector<float> ref, abs_sum;
+  ReferenceGemm(trans_a, trans_b, a, b, m, n, k, &ref, &abs_sum);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float v = std::max(0.5f * ref[i * n + j] + bias[j], 0.f);
+      float out = trans_c ? c[j * ldc + i] : c[i * ldc + j];
+      ASSERT_NEAR(out, v, Tolerance(abs_sum[i * n + j]))
+          << "m=" << m << " n=" << n << " k=" << k << " at (" << i << ", "
+          << j << ")";
+    }
+  }
+  for (int i = 0; i < rows; i++) {
+    for (int j = cols; j < ldc; j++) {
+      ASSERT_EQ(c[i * ldc + j], 7.f);
+    }
+  }
+}
+
+TEST(gemm_bf16, compare_with_reference) {
+  // M isn't a multiple of 4, N isn't a multiple of 16 and K is odd, so the
+  // tail blocks, the tail panel and the padded K are covered.
+  const int shapes[][3] = {
+      {1, 1, 1}, {4, 16, 32}, {5, 9, 3}, {7, 37, 65}, {13, 40, 129}};
+  for (auto kernel : AvailableKernels()) {
+    for (auto& shape : shapes) {
+      for (bool trans_a : {false, true}) {
+        for (bool trans_b : {false, true}) {
+          for (bool trans_c : {false, true}) {
+            TestGemmBf16(trans_a,
+                         trans_b,
+                         trans_c,
+                         shape[0],
+                         shape[1],
+                         shape[2],
+                         kernel);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,269 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_int8.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/device_info.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static inline int round_up(int x, int align) {
+  return (x + align - 1) / align * align;
+}
+
+int gemm_s8_packed_a_size(int m, int k) {
+  return round_up(m, kGemmS8MBlock) * round_up(k, 2);
+}
+
+int gemm_s8_packed_b_size(int k, int n) {
+  return round_up(k, 2) * round_up(n, kGemmS8NBlock);
+}
+
+void gemm_s8_pack_a(const int8_t* a, int m, int k, int lda, int16_t* packed_a) {
+  const int k2 = round_up(k, 2);
+  const int m4 = round_up(m, kGemmS8MBlock);
+  for (int mb = 0; mb < m4; mb += kGemmS8MBlock) {
+    int16_t* dst = packed_a + mb * k2;
+    for (int kk = 0; kk < k2; kk += 2) {
+      for (int r = 0; r < kGemmS8MBlock; r++) {
+        const int row = mb + r;
+        if (row < m) {
+          const int8_t* src = a + row * lda + kk;
+          *(dst++) = src[0];
+          *(dst++) = kk + 1 < k ? src[1] : 0;
+        } else {
+          *(dst++) = 0;
+          *(dst++) = 0;
+        }
+      }
+    }
+  }
+}
+
+void gemm_s8_pack_b(const int8_t* b, int k, int n, int ldb, int16_t* packed_b) {
+  const int k2 = round_up(k, 2);
+  const int n8 = round_up(n, kGemmS8NBlock);
+  for (int nb = 0; nb < n8; nb += kGemmS8NBlock) {
+    int16_t* dst = packed_b + nb * k2;
+    const int cols = std::min(kGemmS8NBlock, n - nb);
+    for (int kk = 0; kk < k2; kk += 2) {
+      const int8_t* src0 = b + kk * ldb + nb;
+      const int8_t* src1 = kk + 1 < k ? src0 + ldb : nullptr;
+      for (int c = 0; c < kGemmS8NBlock; c++) {
+        bool valid = c < cols;
+        *(dst++) = valid ? src0[c] : 0;
+        *(dst++) = valid && src1 ? src1[c] : 0;
+      }
+    }
+  }
+}
+
+void gemm_s8_kernel_ref(const int16_t* packed_a,
+                        const int16_t* packed_b,
+                        int num_panels,
+                        int k2,
+                        int32_t* acc) {
+  const int cols = num_panels * kGemmS8NBlock;
+  for (int r = 0; r < kGemmS8MBlock; r++) {
+    for (int c = 0; c < cols; c++) {
+      const int16_t* b = packed_b + (c / kGemmS8NBlock) * kGemmS8NBlock * k2 +
+                         (c % kGemmS8NBlock) * 2;
+      const int16_t* a = packed_a + r * 2;
+      int32_t sum = 0;
+      for (int kk = 0; kk < k2; kk += 2) {
+        sum += static_cast<int32_t>(a[0]) * b[0] +
+               static_cast<int32_t>(a[1]) * b[1];
+        a += kGemmS8MBlock * 2;
+        b += kGemmS8NBlock * 2;
+      }
+      acc[r * 2 * kGemmS8NBlock + c] = sum;
+    }
+  }
+}
+
+// Select the fastest micro kernel which is supported by both of the compiler
+// and the current CPU.
+static GemmS8Kernel select_gemm_s8_kernel() {
+  GemmS8Kernel kernel = nullptr;
+  AVXType level = device_avx_level();
+  if (level == AVXType::ISA_VNNI) {
+    kernel = gemm_s8_kernel_vnni();
+  }
+  if (kernel == nullptr &&
+      (level == AVXType::ISA_VNNI || level == AVXType::ISA_AVX2)) {
+    kernel = gemm_s8_kernel_avx2();
+  }
+  return kernel == nullptr ? gemm_s8_kernel_ref : kernel;
+}
+
+// The activations are rewritten as out = v > 0 ? min(v, upper) : v * slope.
+static void get_act_bounds(const GemmS8Epilogue& epilogue,
+                           float* upper,
+                           float* slope) {
+  *upper = std::numeric_limits<float>::max();
+  *slope = 1.f;
+  switch (epilogue.act_type) {
+    case lite_api::ActivationType::kIndentity:
+      break;
+    case lite_api::ActivationType::kRelu:
+      *slope = 0.f;
+      break;
+    case lite_api::ActivationType::kRelu6:
+      *upper = epilogue.relu6_threshold;
+      *slope = 0.f;
+      break;
+    case lite_api::ActivationType::kLeakyRelu:
+      *slope = epilogue.leaky_alpha;
+      break;
+    default:
+      LOG(FATAL) << "[X86] int8 gemm doesn't support the activation type "
+                 << static_cast<int>(epilogue.act_type);
+  }
+}
+
+template <typename Dtype>
+static inline Dtype cast_output(float v);
+
+template <>
+inline float cast_output<float>(float v) {
+  return v;
+}
+
+template <>
+inline int8_t cast_output<int8_t>(float v) {
+  v = std::round(v);
+  v = v > 127.f ? 127.f : (v < -127.f ? -127.f : v);
+  return static_cast<int8_t>(v);
+}
+
+template <typename Dtype>
+void gemm_s8_epilogue(const int32_t* acc,
+                      int rows,
+                      int cols,
+                      int ldacc,
+                      int row_offset,
+                      int col_offset,
+                      const GemmS8Epilogue& epilogue,
+                      Dtype* c,
+                      int ldc) {
+  float upper = 0.f;
+  float slope = 0.f;
+  get_act_bounds(epilogue, &upper, &slope);
+  const float* scale = epilogue.scale;
+  const float* bias = epilogue.bias;
+  for (int r = 0; r < rows; r++) {
+    const int32_t* src = acc + r * ldacc;
+    Dtype* dst = c + r * ldc;
+    if (epilogue.per_row) {
+      const float s = scale[row_offset + r];
+      const float b = bias ? bias[row_offset + r] : 0.f;
+      for (int i = 0; i < cols; i++) {
+        float v = static_cast<float>(src[i]) * s + b;
+        v = v > 0.f ? std::min(v, upper) : v * slope;
+        dst[i] = cast_output<Dtype>(v);
+      }
+    } else {
+      const float* s = scale + col_offset;
+      const float* b = bias ? bias + col_offset : nullptr;
+      for (int i = 0; i < cols; i++) {
+        float v = static_cast<float>(src[i]) * s[i] + (b ? b[i] : 0.f);
+        v = v > 0.f ? std::min(v, upper) : v * slope;
+        dst[i] = cast_output<Dtype>(v);
+      }
+    }
+  }
+}
+
+template <typename Dtype>
+void gemm_s8(const int16_t* packed_a,
+             const int16_t* packed_b,
+             int m,
+             int n,
+             int k,
+             const GemmS8Epilogue& epilogue,
+             Dtype* c,
+             int ldc,
+             GemmS8Kernel kernel) {
+  static const GemmS8Kernel default_kernel = select_gemm_s8_kernel();
+  if (kernel == nullptr) {
+    kernel = default_kernel;
+  }
+  CHECK(epilogue.scale) << "The scale of int8 gemm is required";
+  const int k2 = round_up(k, 2);
+  const int num_mb = (m + kGemmS8MBlock - 1) / kGemmS8MBlock;
+  const int num_panels = (n + kGemmS8NBlock - 1) / kGemmS8NBlock;
+  // Each task computes 2 panels, the blocks of A are iterated in the inner
+  // loop to keep the panels of B in cache.
+  const int num_nb = (num_panels + 1) / 2;
+  auto compute_blocks = [&](int64_t begin, int64_t end) {
+    int32_t acc[kGemmS8MBlock * 2 * kGemmS8NBlock];
+    for (int64_t t = begin; t < end; t++) {
+      const int nb = static_cast<int>(t / num_mb);
+      const int mb = static_cast<int>(t % num_mb);
+      const int panel = nb * 2;
+      const int np = std::min(2, num_panels - panel);
+      const int row = mb * kGemmS8MBlock;
+      const int col = panel * kGemmS8NBlock;
+      kernel(packed_a + row * k2, packed_b + col * k2, np, k2, acc);
+      gemm_s8_epilogue<Dtype>(acc,
+                              std::min(kGemmS8MBlock, m - row),
+                              std::min(np * kGemmS8NBlock, n - col),
+                              2 * kGemmS8NBlock,
+                              row,
+                              col,
+                              epilogue,
+                              c + row * ldc + col,
+                              ldc);
+    }
+  };
+  lite::x86::RunParallelFor(
+      0, static_cast<int64_t>(num_mb) * num_nb, compute_blocks);
+}
+
+#define INSTANTIATE_GEMM_S8(Dtype)                               \
+  template void gemm_s8_epilogue<Dtype>(const int32_t*,         \
+                                        int,                    \
+                                        int,                    \
+                                        int,                    \
+                                        int,                    \
+                                        int,                    \
+                                        const GemmS8Epilogue&,  \
+                                        Dtype*,                 \
+                                        int);                   \
+  template void gemm_s8<Dtype>(const int16_t*,                  \
+                               const int16_t*,                  \
+                               int,                             \
+                               int,                             \
+                               int,                             \
+                               const GemmS8Epilogue&,           \
+                               Dtype*,                          \
+                               int,                             \
+                               GemmS8Kernel);
+
+INSTANTIATE_GEMM_S8(float);
+INSTANTIATE_GEMM_S8(int8_t);
+#undef INSTANTIATE_GEMM_S8
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,112 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The int8 GEMM computes C(M x N) = A(M x K) * B(K x N) with the int32
+ * accumulation, and converts the accumulators to float or int8 by the fused
+ * output stage. Both operands are widened to int16 and packed as pairs along
+ * K, so that a pair of products is accumulated by one vpmaddwd(AVX2) or
+ * vpdpwssd(AVX512-VNNI) lane without the saturation of vpmaddubsw.
+ *
+ * packed A: blocks of 4 rows, each block is [K/2][4 rows][2] int16.
+ * packed B: panels of 8 columns, each panel is [K/2][8 cols][2] int16.
+ * K is padded to a multiple of 2, M to 4 and N to 8 with zeros.
+ */
+constexpr int kGemmS8MBlock = 4;
+constexpr int kGemmS8NBlock = 8;
+
+// The number of int16 elements of the packed A and B.
+int gemm_s8_packed_a_size(int m, int k);
+int gemm_s8_packed_b_size(int k, int n);
+
+// Pack A(M x K) with the leading dimension lda.
+void gemm_s8_pack_a(const int8_t* a, int m, int k, int lda, int16_t* packed_a);
+// Pack B(K x N) with the leading dimension ldb.
+void gemm_s8_pack_b(const int8_t* b, int k, int n, int ldb, int16_t* packed_b);
+
+// The output stage: out = act(acc * scale + bias), scale is required and bias
+// is optional, both of them are indexed by the row of C if per_row is true,
+// otherwise by the column. The int8 output is rounded and clamped to
+// [-127, 127].
+struct GemmS8Epilogue {
+  const float* scale{nullptr};
+  const float* bias{nullptr};
+  bool per_row{true};
+  lite_api::ActivationType act_type{lite_api::ActivationType::kIndentity};
+  float relu6_threshold{6.f};
+  float leaky_alpha{0.f};
+};
+
+// Apply the output stage to the int32 block acc(rows x cols) with the leading
+// dimension ldacc, row_offset and col_offset are the position of the block in
+// C, which are used to index scale and bias.
+template <typename Dtype>
+void gemm_s8_epilogue(const int32_t* acc,
+                      int rows,
+                      int cols,
+                      int ldacc,
+                      int row_offset,
+                      int col_offset,
+                      const GemmS8Epilogue& epilogue,
+                      Dtype* c,
+                      int ldc);
+
+// The micro kernel computes the int32 block C(4 x 8 * NP) of one block of the
+// packed A and NP(1 or 2) adjacent panels of the packed B, k2 is the padded K,
+// the block is stored to acc with the leading dimension 16.
+using GemmS8Kernel = void (*)(const int16_t* packed_a,
+                              const int16_t* packed_b,
+                              int num_panels,
+                              int k2,
+                              int32_t* acc);
+
+// The micro kernels of the instruction sets, nullptr is returned if the
+// instruction set isn't enabled by the compiler.
+GemmS8Kernel gemm_s8_kernel_avx2();
+GemmS8Kernel gemm_s8_kernel_vnni();
+// The portable micro kernel.
+void gemm_s8_kernel_ref(const int16_t* packed_a,
+                        const int16_t* packed_b,
+                        int num_panels,
+                        int k2,
+                        int32_t* acc);
+
+// C = epilogue(packed_a * packed_b), Dtype is float or int8_t, the blocks of
+// C are computed in parallel. The micro kernel is selected by the CPU if
+// kernel is nullptr.
+template <typename Dtype>
+void gemm_s8(const int16_t* packed_a,
+             const int16_t* packed_b,
+             int m,
+             int n,
+             int k,
+             const GemmS8Epilogue& epilogue,
+             Dtype* c,
+             int ldc,
+             GemmS8Kernel kernel = nullptr);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
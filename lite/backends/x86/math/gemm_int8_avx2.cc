@@ -0,0 +1,121 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <immintrin.h>
+#include <cstring>
+#include "lite/backends/x86/math/gemm_int8.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#if defined(__AVX2__)
+static inline __m256i broadcast_pair(const int16_t* a) {
+  int32_t pair;
+  std::memcpy(&pair, a, sizeof(pair));
+  return _mm256_set1_epi32(pair);
+}
+
+// The pair of int16 of A is broadcasted as one int32 lane, vpmaddwd multiplies
+// it with the pairs of 8 columns of B and adds the adjacent products.
+#define ACCUM(c, a, b) _mm256_add_epi32(c, _mm256_madd_epi16(a, b))
+#define GEMM_S8_ROW(r, s)                    \
+  va = broadcast_pair(packed_a + r * 2);     \
+  c##s##r##0 = ACCUM(c##s##r##0, va, vb0);   \
+  if (NP > 1) {                              \
+    c##s##r##1 = ACCUM(c##s##r##1, va, vb1); \
+  }
+
+#define GEMM_S8_STEP(s)                                             \
+  vb0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b0));   \
+  b0 += kGemmS8NBlock * 2;                                          \
+  if (NP > 1) {                                                     \
+    vb1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b1)); \
+    b1 += kGemmS8NBlock * 2;                                        \
+  }                                                                 \
+  GEMM_S8_ROW(0, s)                                                 \
+  GEMM_S8_ROW(1, s)                                                 \
+  GEMM_S8_ROW(2, s)                                                 \
+  GEMM_S8_ROW(3, s)                                                 \
+  packed_a += kGemmS8MBlock * 2;
+
+template <int NP>
+static void gemm_s8_kernel_avx2_impl(const int16_t* packed_a,
+                                     const int16_t* packed_b,
+                                     int k2,
+                                     int32_t* acc) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i c000 = zero, c001 = zero, c010 = zero, c011 = zero;
+  __m256i c020 = zero, c021 = zero, c030 = zero, c031 = zero;
+  const int16_t* b0 = packed_b;
+  const int16_t* b1 = packed_b + kGemmS8NBlock * k2;
+  __m256i va;
+  __m256i vb0;
+  __m256i vb1 = zero;
+  for (int kk = 0; kk < k2; kk += 2) {
+    GEMM_S8_STEP(0)
+  }
+  int32_t* dst = acc;
+  const int ld = 2 * kGemmS8NBlock;
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 0 * ld + 0),
+                      c000);
+  if (NP > 1) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 0 * ld + 8),
+                        c001);
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 1 * ld + 0),
+                      c010);
+  if (NP > 1) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 1 * ld + 8),
+                        c011);
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * ld + 0),
+                      c020);
+  if (NP > 1) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * ld + 8),
+                        c021);
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 3 * ld + 0),
+                      c030);
+  if (NP > 1) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 3 * ld + 8),
+                        c031);
+  }
+}
+#undef GEMM_S8_STEP
+#undef GEMM_S8_ROW
+#undef ACCUM
+
+static void gemm_s8_kernel_avx2_func(const int16_t* packed_a,
+                                     const int16_t* packed_b,
+                                     int num_panels,
+                                     int k2,
+                                     int32_t* acc) {
+  if (num_panels == 2) {
+    gemm_s8_kernel_avx2_impl<2>(packed_a, packed_b, k2, acc);
+  } else {
+    gemm_s8_kernel_avx2_impl<1>(packed_a, packed_b, k2, acc);
+  }
+}
+
+GemmS8Kernel gemm_s8_kernel_avx2() { return gemm_s8_kernel_avx2_func; }
+#else
+GemmS8Kernel gemm_s8_kernel_avx2() { return nullptr; }
+#endif
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,179 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_int8.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static std::vector<int8_t> RandomData(int size, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(-127, 127);
+  std::vector<int8_t> data(size);
+  for (auto& v : data) {
+    v = static_cast<int8_t>(dist(rng));
+  }
+  return data;
+}
+
+// The naive int32 C(M x N) = A(M x K) * B(K x N).
+static std::vector<int32_t> ReferenceGemm(const std::vector<int8_t>& a,
+                                          const std::vector<int8_t>& b,
+                                          int m,
+                                          int n,
+                                          int k) {
+  std::vector<int32_t> c(m * n, 0);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      int32_t sum = 0;
+      for (int p = 0; p < k; p++) {
+        sum += static_cast<int32_t>(a[i * k + p]) * b[p * n + j];
+      }
+      c[i * n + j] = sum;
+    }
+  }
+  return c;
+}
+
+static std::vector<GemmS8Kernel> AvailableKernels() {
+  std::vector<GemmS8Kernel> kernels{gemm_s8_kernel_ref};
+  AVXType level = device_avx_level();
+  if ((level == AVXType::ISA_AVX2 || level == AVXType::ISA_VNNI) &&
+      gemm_s8_kernel_avx2() != nullptr) {
+    kernels.push_back(gemm_s8_kernel_avx2());
+  }
+  if (level == AVXType::ISA_VNNI && gemm_s8_kernel_vnni() != nullptr) {
+    kernels.push_back(gemm_s8_kernel_vnni());
+  }
+  return kernels;
+}
+
+TEST(gemm_int8, micro_kernels) {
+  // K is odd, so the last pair along K is padded with a zero.
+  const int k = 37;
+  const int k2 = k + 1;
+  const int n = 2 * kGemmS8NBlock;
+  auto a = RandomData(kGemmS8MBlock * k, 1);
+  auto b = RandomData(k * n, 2);
+  std::vector<int16_t> packed_a(gemm_s8_packed_a_size(kGemmS8MBlock, k));
+  std::vector<int16_t> packed_b(gemm_s8_packed_b_size(k, n));
+  gemm_s8_pack_a(a.data(), kGemmS8MBlock, k, k, packed_a.data());
+  gemm_s8_pack_b(b.data(), k, n, n, packed_b.data());
+  auto ref = ReferenceGemm(a, b, kGemmS8MBlock, n, k);
+
+  for (auto kernel : AvailableKernels()) {
+    for (int num_panels : {1, 2}) {
+      std::vector<int32_t> acc(kGemmS8MBlock * n, -1);
+      kernel(packed_a.data(), packed_b.data(), num_panels, k2, acc.data());
+      for (int i = 0; i < kGemmS8MBlock; i++) {
+        for (int j = 0; j < num_panels * kGemmS8NBlock; j++) {
+          ASSERT_EQ(acc[i * n + j], ref[i * n + j])
+              << "num_panels=" << num_panels << " at (" << i << ", " << j
+              << ")";
+        }
+      }
+    }
+  }
+}
+
+template <typename Dtype>
+static void TestGemmS8(
+    int m, int n, int k, bool per_row, bool relu, GemmS8Kernel kernel) {
+  auto a = RandomData(m * k, m + k);
+  auto b = RandomData(k * n, n + k);
+  std::vector<int16_t> packed_a(gemm_s8_packed_a_size(m, k));
+  std::vector<int16_t> packed_b(gemm_s8_packed_b_size(k, n));
+  gemm_s8_pack_a(a.data(), m, k, k, packed_a.data());
+  gemm_s8_pack_b(b.data(), k, n, n, packed_b.data());
+
+  // The scales keep the int8 outputs mostly in the range.
+  const int num_scales = per_row ? m : n;
+  std::vector<float> scale(num_scales);
+  std::vector<float> bias(num_scales);
+  for (int i = 0; i < num_scales; i++) {
+    scale[i] = (1.f + i % 3) / (127.f * std::max(k, 1));
+    bias[i] = (i % 5) * 0.5f - 1.f;
+  }
+  GemmS8Epilogue epilogue;
+  epilogue.scale = scale.data();
+  epilogue.bias = bias.data();
+  epilogue.per_row = per_row;
+  if (relu) {
+    epilogue.act_type = lite_api::ActivationType::kRelu;
+  }
+
+  // C is a sub-matrix of a larger buffer, the padding must be kept.
+  const int ldc = n + 3;
+  std::vector<Dtype> c(m * ldc, 7);
+  gemm_s8<Dtype>(packed_a.data(),
+                 packed_b.data(),
+                 m,
+                 n,
+                 k,
+                 epilogue,
+                 c.data(),
+                 ldc,
+                 kernel);
+
+  auto ref = ReferenceGemm(a, b, m, n, k);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      const int idx = per_row ? i : j;
+      float v = ref[i * n + j] * scale[idx] + bias[idx];
+      v = relu ? std::max(v, 0.f) : v;
+      if (std::is_same<Dtype, int8_t>::value) {
+        v = std::min(std::max(std::round(v), -127.f), 127.f);
+      }
+      ASSERT_NEAR(static_cast<float>(c[i * ldc + j]), v, 1e-4f)
+          << "m=" << m << " n=" << n << " k=" << k << " at (" << i << ", "
+          << j << ")";
+    }
+    for (int j = n; j < ldc; j++) {
+      ASSERT_EQ(c[i * ldc + j], static_cast<Dtype>(7));
+    }
+  }
+}
+
+TEST(gemm_int8, compare_with_reference) {
+  // M isn't a multiple of 4, N isn't a multiple of 8 or 16 and K is odd, so
+  // the tail blocks, the single tail panel and the padded K are covered.
+  const int shapes[][3] = {
+      {1, 1, 1}, {4, 16, 32}, {5, 9, 3}, {7, 23, 65}, {13, 40, 129}};
+  for (auto kernel : AvailableKernels()) {
+    for (auto& shape : shapes) {
+      for (bool per_row : {false, true}) {
+        for (bool relu : {false, true}) {
+          TestGemmS8<float>(
+              shape[0], shape[1], shape[2], per_row, relu, kernel);
+          TestGemmS8<int8_t>(
+              shape[0], shape[1], shape[2], per_row, relu, kernel);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
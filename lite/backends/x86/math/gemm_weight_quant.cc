@@ -0,0 +1,194 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_weight_quant.h"
+#include <algorithm>
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static inline int round_up(int x, int align) {
+  return (x + align - 1) / align * align;
+}
+
+int gemm_weight_quant_packed_a_size(int m, int k) {
+  return round_up(m, kGemmWeightQuantMBlock) * round_up(k, 2);
+}
+
+int gemm_weight_quant_packed_b_size(int k, int n) {
+  return round_up(k, 2) * round_up(n, kGemmWeightQuantNBlock);
+}
+
+void gemm_weight_quant_pack_a(
+    bool trans, const float* a, int m, int k, int lda, float* packed_a) {
+  const int k2 = round_up(k, 2);
+  const int m4 = round_up(m, kGemmWeightQuantMBlock);
+  auto at = [=](int row, int col) {
+    return trans ? a[col * lda + row] : a[row * lda + col];
+  };
+  for (int mb = 0; mb < m4; mb += kGemmWeightQuantMBlock) {
+    float* dst = packed_a + mb * k2;
+    for (int kk = 0; kk < k2; kk += 2) {
+      for (int r = 0; r < kGemmWeightQuantMBlock; r++) {
+        const int row = mb + r;
+        const bool valid = row < m;
+        *(dst++) = valid ? at(row, kk) : 0.f;
+        *(dst++) = valid && kk + 1 < k ? at(row, kk + 1) : 0.f;
+      }
+    }
+  }
+}
+
+template <typename T>
+void gemm_weight_quant_pack_b(
+    bool trans, const T* b, int k, int n, int ldb, T* packed_b) {
+  const int k2 = round_up(k, 2);
+  const int n16 = round_up(n, kGemmWeightQuantNBlock);
+  for (int nb = 0; nb < n16; nb += kGemmWeightQuantNBlock) {
+    T* dst = packed_b + nb * k2;
+    const int cols = std::min(kGemmWeightQuantNBlock, n - nb);
+    for (int kk = 0; kk < k2; kk++) {
+      for (int c = 0; c < kGemmWeightQuantNBlock; c++) {
+        const bool valid = c < cols && kk < k;
+        const int col = nb + c;
+        *(dst++) = valid ? (trans ? b[col * ldb + kk] : b[kk * ldb + col]) : 0;
+      }
+    }
+  }
+}
+
+template <typename T>
+void gemm_weight_quant_kernel_ref(const float* packed_a,
+                                  const T* packed_b,
+                                  int k2,
+                                  float* acc) {
+  for (int r = 0; r < kGemmWeightQuantMBlock; r++) {
+    for (int c = 0; c < kGemmWeightQuantNBlock; c++) {
+      const float* a = packed_a + r * 2;
+      const T* b = packed_b + c;
+      float sum = 0.f;
+      for (int kk = 0; kk < k2; kk += 2) {
+        sum += a[0] * static_cast<float>(b[0]) +
+               a[1] * static_cast<float>(b[kGemmWeightQuantNBlock]);
+        a += kGemmWeightQuantMBlock * 2;
+        b += kGemmWeightQuantNBlock * 2;
+      }
+      acc[r * kGemmWeightQuantNBlock + c] = sum;
+    }
+  }
+}
+
+template <typename T>
+static GemmWeightQuantKernel<T> select_gemm_weight_quant_kernel() {
+  GemmWeightQuantKernel<T> kernel = nullptr;
+  AVXType level = device_avx_level();
+  if (level == AVXType::ISA_VNNI || level == AVXType::ISA_AVX2) {
+    kernel = gemm_weight_quant_kernel_avx2<T>();
+  }
+  return kernel == nullptr ? gemm_weight_quant_kernel_ref<T> : kernel;
+}
+
+static void gemm_weight_quant_epilogue(const float* acc,
+                                       int rows,
+                                       int cols,
+                                       int row_offset,
+                                       int col_offset,
+                                       const GemmWeightQuantEpilogue& epilogue,
+                                       float* c,
+                                       int ldc) {
+  const float* scale = epilogue.scale + col_offset;
+  const float* bias = epilogue.bias ? epilogue.bias + col_offset : nullptr;
+  for (int r = 0; r < rows; r++) {
+    const float* src = acc + r * kGemmWeightQuantNBlock;
+    for (int i = 0; i < cols; i++) {
+      float v = epilogue.alpha * scale[i] * src[i] + (bias ? bias[i] : 0.f);
+      v = epilogue.relu ? std::max(v, 0.f) : v;
+      const int row = row_offset + r;
+      const int col = col_offset + i;
+      c[epilogue.trans_c ? col * ldc + row : row * ldc + col] = v;
+    }
+  }
+}
+
+template <typename T>
+void gemm_weight_quant(const float* packed_a,
+                       const T* packed_b,
+                       int m,
+                       int n,
+                       int k,
+                       const GemmWeightQuantEpilogue& epilogue,
+                       float* c,
+                       int ldc,
+                       GemmWeightQuantKernel<T> kernel) {
+  static const GemmWeightQuantKernel<T> default_kernel =
+      select_gemm_weight_quant_kernel<T>();
+  if (kernel == nullptr) {
+    kernel = default_kernel;
+  }
+  const int k2 = round_up(k, 2);
+  const int num_mb = (m + kGemmWeightQuantMBlock - 1) / kGemmWeightQuantMBlock;
+  const int num_panels =
+      (n + kGemmWeightQuantNBlock - 1) / kGemmWeightQuantNBlock;
+  // The blocks of A are iterated in the inner loop to keep the panels of B in
+  // cache, B is read once for the small M of the memory bound fc.
+  auto compute_blocks = [&](int64_t begin, int64_t end) {
+    float acc[kGemmWeightQuantMBlock * kGemmWeightQuantNBlock];
+    for (int64_t t = begin; t < end; t++) {
+      const int panel = static_cast<int>(t / num_mb);
+      const int mb = static_cast<int>(t % num_mb);
+      const int row = mb * kGemmWeightQuantMBlock;
+      const int col = panel * kGemmWeightQuantNBlock;
+      kernel(packed_a + row * k2, packed_b + col * k2, k2, acc);
+      gemm_weight_quant_epilogue(acc,
+                                 std::min(kGemmWeightQuantMBlock, m - row),
+                                 std::min(kGemmWeightQuantNBlock, n - col),
+                                 row,
+                                 col,
+                                 epilogue,
+                                 c,
+                                 ldc);
+    }
+  };
+  lite::x86::RunParallelFor(
+      0, static_cast<int64_t>(num_mb) * num_panels, compute_blocks);
+}
+
+#define INSTANTIATE_GEMM_WEIGHT_QUANT(T)                             \
+  template void gemm_weight_quant_pack_b<T>(                         \
+      bool trans, const T* b, int k, int n, int ldb, T* packed_b);   \
+  template void gemm_weight_quant_kernel_ref<T>(                     \
+      const float* packed_a, const T* packed_b, int k2, float* acc); \
+  template void gemm_weight_quant<T>(                                \
+      const float* packed_a,                                         \
+      const T* packed_b,                                             \
+      int m,                                                         \
+      int n,                                                         \
+      int k,                                                         \
+      const GemmWeightQuantEpilogue& epilogue,                       \
+      float* c,                                                      \
+      int ldc,                                                       \
+      GemmWeightQuantKernel<T> kernel);
+
+INSTANTIATE_GEMM_WEIGHT_QUANT(int8_t)
+INSTANTIATE_GEMM_WEIGHT_QUANT(int16_t)
+#undef INSTANTIATE_GEMM_WEIGHT_QUANT
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,103 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The weight-only quantized GEMM computes C(M x N) = A(M x K) * B(K x N) of
+ * the fp32 A and the int8 or int16 B with the fp32 accumulation, B is the
+ * weights kept in int8 or int16 with a scale for each column. The integers of
+ * B are converted to fp32 in the registers of the micro kernel, and the scales
+ * are applied to the accumulators in the output stage, so the weights are
+ * never dequantized in memory.
+ *
+ * packed A: blocks of 4 rows, each block is [K/2][4 rows][2] fp32.
+ * packed B: panels of 16 columns, each panel is [K][16 cols] int8 or int16.
+ * K is padded to a multiple of 2, M to 4 and N to 16 with zeros.
+ */
+constexpr int kGemmWeightQuantMBlock = 4;
+constexpr int kGemmWeightQuantNBlock = 16;
+
+// The number of the elements of the packed A(fp32) and B(int8 or int16).
+int gemm_weight_quant_packed_a_size(int m, int k);
+int gemm_weight_quant_packed_b_size(int k, int n);
+
+// Pack A(M x K), A is stored as K x M if trans is true.
+void gemm_weight_quant_pack_a(
+    bool trans, const float* a, int m, int k, int lda, float* packed_a);
+// Pack B(K x N), B is stored as N x K if trans is true. T is int8_t or
+// int16_t.
+template <typename T>
+void gemm_weight_quant_pack_b(
+    bool trans, const T* b, int k, int n, int ldb, T* packed_b);
+
+// The output stage: out = alpha * scale * acc + bias, followed by relu if
+// relu is true. scale is required and bias is optional, both are indexed by
+// the column of C. C is stored transposed, i.e. as N x M, if trans_c is true.
+struct GemmWeightQuantEpilogue {
+  float alpha{1.f};
+  const float* scale{nullptr};
+  const float* bias{nullptr};
+  bool relu{false};
+  bool trans_c{false};
+};
+
+// The micro kernel computes the block C(4 x 16) of one block of the packed A
+// and one panel of the packed B without the scales, k2 is the padded K, the
+// block is stored to acc with the leading dimension 16.
+template <typename T>
+using GemmWeightQuantKernel = void (*)(const float* packed_a,
+                                       const T* packed_b,
+                                       int k2,
+                                       float* acc);
+
+// The AVX2 micro kernel, nullptr is returned if AVX2 isn't enabled by the
+// compiler.
+template <typename T>
+GemmWeightQuantKernel<T> gemm_weight_quant_kernel_avx2();
+template <>
+GemmWeightQuantKernel<int8_t> gemm_weight_quant_kernel_avx2<int8_t>();
+template <>
+GemmWeightQuantKernel<int16_t> gemm_weight_quant_kernel_avx2<int16_t>();
+// The portable micro kernel.
+template <typename T>
+void gemm_weight_quant_kernel_ref(const float* packed_a,
+                                  const T* packed_b,
+                                  int k2,
+                                  float* acc);
+
+// C = epilogue(packed_a * packed_b), the blocks of C are computed in parallel.
+// The micro kernel is selected by the CPU if kernel is nullptr.
+template <typename T>
+void gemm_weight_quant(const float* packed_a,
+                       const T* packed_b,
+                       int m,
+                       int n,
+                       int k,
+                       const GemmWeightQuantEpilogue& epilogue,
+                       float* c,
+                       int ldc,
+                       GemmWeightQuantKernel<T> kernel = nullptr);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,101 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <immintrin.h>
+#include "lite/backends/x86/math/gemm_weight_quant.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The 16 int8 of a row of the panel are widened to 2 x 8 fp32.
+static inline void load_b_avx2(const int8_t* b, __m256* lo, __m256* hi) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  *lo = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(v));
+  *hi = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(v, 8)));
+}
+
+// The 16 int16 of a row of the panel are widened to 2 x 8 fp32.
+static inline void load_b_avx2(const int16_t* b, __m256* lo, __m256* hi) {
+  const __m128i* p = reinterpret_cast<const __m128i*>(b);
+  *lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(p)));
+  *hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(p + 1)));
+}
+
+#define GEMM_WEIGHT_QUANT_ROW(r)                   \
+  va0 = _mm256_broadcast_ss(packed_a + r * 2);     \
+  va1 = _mm256_broadcast_ss(packed_a + r * 2 + 1); \
+  c##r##0 = _mm256_fmadd_ps(va0, vb0l, c##r##0);   \
+  c##r##1 = _mm256_fmadd_ps(va0, vb0h, c##r##1);   \
+  c##r##0 = _mm256_fmadd_ps(va1, vb1l, c##r##0);   \
+  c##r##1 = _mm256_fmadd_ps(va1, vb1h, c##r##1);
+
+template <typename T>
+static void gemm_weight_quant_kernel_avx2_func(const float* packed_a,
+                                               const T* packed_b,
+                                               int k2,
+                                               float* acc) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 va0, va1, vb0l, vb0h, vb1l, vb1h;
+  for (int kk = 0; kk < k2; kk += 2) {
+    load_b_avx2(packed_b, &vb0l, &vb0h);
+    load_b_avx2(packed_b + kGemmWeightQuantNBlock, &vb1l, &vb1h);
+    GEMM_WEIGHT_QUANT_ROW(0)
+    GEMM_WEIGHT_QUANT_ROW(1)
+    GEMM_WEIGHT_QUANT_ROW(2)
+    GEMM_WEIGHT_QUANT_ROW(3)
+    packed_a += kGemmWeightQuantMBlock * 2;
+    packed_b += kGemmWeightQuantNBlock * 2;
+  }
+  _mm256_storeu_ps(acc, c00);
+  _mm256_storeu_ps(acc + 8, c01);
+  _mm256_storeu_ps(acc + 16, c10);
+  _mm256_storeu_ps(acc + 24, c11);
+  _mm256_storeu_ps(acc + 32, c20);
+  _mm256_storeu_ps(acc + 40, c21);
+  _mm256_storeu_ps(acc + 48, c30);
+  _mm256_storeu_ps(acc + 56, c31);
+}
+#undef GEMM_WEIGHT_QUANT_ROW
+
+template <>
+GemmWeightQuantKernel<int8_t> gemm_weight_quant_kernel_avx2<int8_t>() {
+  return gemm_weight_quant_kernel_avx2_func<int8_t>;
+}
+
+template <>
+GemmWeightQuantKernel<int16_t> gemm_weight_quant_kernel_avx2<int16_t>() {
+  return gemm_weight_quant_kernel_avx2_func<int16_t>;
+}
+#else
+template <>
+GemmWeightQuantKernel<int8_t> gemm_weight_quant_kernel_avx2<int8_t>() {
+  return nullptr;
+}
+
+template <>
+GemmWeightQuantKernel<int16_t> gemm_weight_quant_kernel_avx2<int16_t>() {
+  return nullptr;
+}
+#endif
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,215 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_weight_quant.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static std::vector<float> RandomData(int size, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(rng);
+  }
+  return data;
+}
+
+template <typename T>
+static std::vector<T> RandomQuantData(int size, int seed) {
+  std::mt19937 rng(seed);
+  const int max = std::numeric_limits<T>::max();
+  std::uniform_int_distribution<int> dist(-max, max);
+  std::vector<T> data(size);
+  for (auto& v : data) {
+    v = static_cast<T>(dist(rng));
+  }
+  return data;
+}
+
+// The naive C(M x N) = A(M x K) * B(K x N) without the scales, A is stored as
+// K x M if trans_a is true and B is stored as N x K if trans_b is true.
+template <typename T>
+static std::vector<float> ReferenceGemm(bool trans_a,
+                                        bool trans_b,
+                                        const std::vector<float>& a,
+                                        const std::vector<T>& b,
+                                        int m,
+                                        int n,
+                                        int k) {
+  std::vector<float> c(m * n, 0.f);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum = 0.;
+      for (int p = 0; p < k; p++) {
+        float va = trans_a ? a[p * m + i] : a[i * k + p];
+        float vb = trans_b ? b[j * k + p] : b[p * n + j];
+        sum += va * vb;
+      }
+      c[i * n + j] = static_cast<float>(sum);
+    }
+  }
+  return c;
+}
+
+template <typename T>
+static std::vector<GemmWeightQuantKernel<T>> AvailableKernels() {
+  std::vector<GemmWeightQuantKernel<T>> kernels{
+      gemm_weight_quant_kernel_ref<T>};
+  AVXType level = device_avx_level();
+  if ((level == AVXType::ISA_AVX2 || level == AVXType::ISA_VNNI) &&
+      gemm_weight_quant_kernel_avx2<T>() != nullptr) {
+    kernels.push_back(gemm_weight_quant_kernel_avx2<T>());
+  }
+  return kernels;
+}
+
+// The accumulators grow with the range of T and K.
+template <typename T>
+static float Tolerance(int k) {
+  return 1e-6f * std::numeric_limits<T>::max() * std::max(k, 1);
+}
+
+template <typename T>
+static void TestMicroKernels() {
+  // K is odd, so the last pair along K is padded with a zero.
+  const int k = 37;
+  const int m = kGemmWeightQuantMBlock;
+  const int n = kGemmWeightQuantNBlock;
+  auto a = RandomData(m * k, 1);
+  auto b = RandomQuantData<T>(k * n, 2);
+  std::vector<float> packed_a(gemm_weight_quant_packed_a_size(m, k));
+  std::vector<T> packed_b(gemm_weight_quant_packed_b_size(k, n));
+  gemm_weight_quant_pack_a(false, a.data(), m, k, k, packed_a.data());
+  gemm_weight_quant_pack_b<T>(false, b.data(), k, n, n, packed_b.data());
+  auto ref = ReferenceGemm<T>(false, false, a, b, m, n, k);
+
+  for (auto kernel : AvailableKernels<T>()) {
+    std::vector<float> acc(m * n, -1.f);
+    kernel(packed_a.data(), packed_b.data(), k + 1, acc.data());
+    for (int i = 0; i < m * n; i++) {
+      ASSERT_NEAR(acc[i], ref[i], Tolerance<T>(k)) << "at " << i;
+    }
+  }
+}
+
+TEST(gemm_weight_quant, micro_kernels) {
+  TestMicroKernels<int8_t>();
+  TestMicroKernels<int16_t>();
+}
+
+template <typename T>
+static void TestGemmWeightQuant(bool trans_a,
+                                bool trans_b,
+                                bool trans_c,
+                                int m,
+                                int n,
+                                int k,
+                                GemmWeightQuantKernel<T> kernel) {
+  auto a = RandomData(m * k, m + k);
+  auto b = RandomQuantData<T>(k * n, n + k);
+  auto bias = RandomData(n, n);
+  std::vector<float> scale(n);
+  for (int i = 0; i < n; i++) {
+    scale[i] = (1.f + i % 3) / std::numeric_limits<T>::max();
+  }
+  std::vector<float> packed_a(gemm_weight_quant_packed_a_size(m, k));
+  std::vector<T> packed_b(gemm_weight_quant_packed_b_size(k, n));
+  gemm_weight_quant_pack_a(
+      trans_a, a.data(), m, k, trans_a ? m : k, packed_a.data());
+  gemm_weight_quant_pack_b<T>(
+      trans_b, b.data(), k, n, trans_b ? k : n, packed_b.data());
+
+  GemmWeightQuantEpilogue epilogue;
+  epilogue.alpha = 0.5f;
+  epilogue.scale = scale.data();
+  epilogue.bias = bias.data();
+  epilogue.relu = true;
+  epilogue.trans_c = trans_c;
+  // C is a sub-matrix of a larger buffer, the padding must be kept.
+  const int rows = trans_c ? n : m;
+  const int cols = trans_c ? m : n;
+  const int ldc = cols + 3;
+  std::vector<float> c(rows * ldc, 7.f);
+  gemm_weight_quant<T>(packed_a.data(),
+                       packed_b.data(),
+                       m,
+                       n,
+                       k,
+                       epilogue,
+                       c.data(),
+                       ldc,
+                       kernel);
+
+  auto ref = ReferenceGemm<T>(trans_a, trans_b, a, b, m, n, k);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float v = std::max(0.5f * scale[j] * ref[i * n + j] + bias[j], 0.f);
+      float out = trans_c ? c[j * ldc + i] : c[i * ldc + j];
+      ASSERT_NEAR(out, v, 1e-4f * std::max(k, 1))
+          << "m=" << m << " n=" << n << " k=" << k << " at (" << i << ", "
+          << j << ")";
+    }
+  }
+  for (int i = 0; i < rows; i++) {
+    for (int j = cols; j < ldc; j++) {
+      ASSERT_EQ(c[i * ldc + j], 7.f);
+    }
+  }
+}
+
+template <typename T>
+static void TestCompareWithReference() {
+  // M isn't a multiple of 4, N isn't a multiple of 16 and K is odd, so the
+  // tail blocks, the tail panel and the padded K are covered.
+  const int shapes[][3] = {
+      {1, 1, 1}, {4, 16, 32}, {5, 9, 3}, {7, 37, 65}, {13, 40, 129}};
+  for (auto kernel : AvailableKernels<T>()) {
+    for (auto& shape : shapes) {
+      for (bool trans_a : {false, true}) {
+        for (bool trans_b : {false, true}) {
+          for (bool trans_c : {false, true}) {
+            TestGemmWeightQuant<T>(trans_a,
+                                   trans_b,
+                                   trans_c,
+                                   shape[0],
+                                   shape[1],
+                                   shape[2],
+                                   kernel);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(gemm_weight_quant, compare_with_reference) {
+  TestCompareWithReference<int8_t>();
+  TestCompareWithReference<int16_t>();
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
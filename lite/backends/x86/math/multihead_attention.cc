@@ -0,0 +1,154 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/multihead_attention.h"
+#include <algorithm>
+#include <cmath>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+void softmax_row(float* x, int n) {
+  float max_val = x[0];
+  for (int i = 1; i < n; i++) {
+    max_val = std::max(max_val, x[i]);
+  }
+  float sum = 0.f;
+  for (int i = 0; i < n; i++) {
+    x[i] = std::exp(x[i] - max_val);
+    sum += x[i];
+  }
+  const float scale = 1.f / sum;
+  for (int i = 0; i < n; i++) {
+    x[i] *= scale;
+  }
+}
+
+}  // namespace
+
+void multihead_attention(const float* qkv,
+                         int batch,
+                         int seq_len,
+                         int head_number,
+                         int size_per_head,
+                         float alpha,
+                         const float* mask,
+                         const std::vector<int64_t>& mask_dims,
+                         float* out) {
+  const int hidden = head_number * size_per_head;
+  const int64_t qkv_stride = 3 * hidden;
+  // The strides of the broadcasted mask, the broadcasted dims are 0. The mask
+  // of the lower rank is aligned to the trailing dims.
+  int64_t mask_strides[4] = {0, 0, 0, 0};
+  if (mask) {
+    CHECK_LE(mask_dims.size(), 4UL);
+    const int offset = 4 - static_cast<int>(mask_dims.size());
+    int64_t stride = 1;
+    for (int i = static_cast<int>(mask_dims.size()) - 1; i >= 0; i--) {
+      mask_strides[offset + i] = mask_dims[i] == 1 ? 0 : stride;
+      stride *= mask_dims[i];
+    }
+  }
+
+  auto compute_heads = [&](int64_t begin, int64_t end) {
+    std::vector<float> key_t(static_cast<size_t>(size_per_head) * seq_len);
+    std::vector<float> scores(static_cast<size_t>(kAttentionRowBlock) *
+                              seq_len);
+    for (int64_t task = begin; task < end; task++) {
+      const int64_t b = task / head_number;
+      const int64_t h = task % head_number;
+      const float* q = qkv + b * seq_len * qkv_stride + h * size_per_head;
+      const float* k = q + hidden;
+      const float* v = q + 2 * hidden;
+      const float* mask_bh =
+          mask ? mask + b * mask_strides[0] + h * mask_strides[1] : nullptr;
+
+      // The trailing padded keys are skipped, the same as the pad_begin of
+      // attention_padding_mask.
+      int key_len = seq_len;
+      if (mask_bh && mask_strides[2] == 0) {
+        const int64_t key_stride = mask_strides[3];
+        while (key_len > 0 &&
+               mask_bh[(key_len - 1) * key_stride] <= kAttentionMaskedValue) {
+          key_len--;
+        }
+        if (key_len == 0) key_len = seq_len;
+      }
+
+      // K is transposed to [size_per_head, key_len], so the scores of a query
+      // are accumulated along the contiguous keys.
+      for (int j = 0; j < key_len; j++) {
+        const float* k_row = k + j * qkv_stride;
+        for (int c = 0; c < size_per_head; c++) {
+          key_t[c * key_len + j] = k_row[c];
+        }
+      }
+
+      for (int row = 0; row < seq_len; row += kAttentionRowBlock) {
+        const int rows = std::min(kAttentionRowBlock, seq_len - row);
+        // scores = alpha * Q * K^T + mask
+        std::fill(scores.begin(), scores.begin() + rows * key_len, 0.f);
+        for (int c = 0; c < size_per_head; c++) {
+          const float* kt = key_t.data() + c * key_len;
+          for (int r = 0; r < rows; r++) {
+            const float qv = alpha * q[(row + r) * qkv_stride + c];
+            float* s = scores.data() + r * key_len;
+            for (int j = 0; j < key_len; j++) {
+              s[j] += qv * kt[j];
+            }
+          }
+        }
+        for (int r = 0; r < rows; r++) {
+          float* s = scores.data() + r * key_len;
+          if (mask_bh) {
+            const float* m = mask_bh + (row + r) * mask_strides[2];
+            for (int j = 0; j < key_len; j++) {
+              s[j] += m[j * mask_strides[3]];
+            }
+          }
+          softmax_row(s, key_len);
+        }
+
+        // out = scores * V
+        float* o = out + (b * seq_len + row) * hidden + h * size_per_head;
+        for (int r = 0; r < rows; r++) {
+          std::fill(o + r * hidden, o + r * hidden + size_per_head, 0.f);
+        }
+        for (int j = 0; j < key_len; j++) {
+          const float* v_row = v + j * qkv_stride;
+          for (int r = 0; r < rows; r++) {
+            const float p = scores[r * key_len + j];
+            float* o_row = o + r * hidden;
+            for (int c = 0; c < size_per_head; c++) {
+              o_row[c] += p * v_row[c];
+            }
+          }
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(
+      0, static_cast<int64_t>(batch) * head_number, compute_heads);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,56 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The number of the query rows whose scores are computed together, the
+// transposed K and V are reused by the block of rows in cache.
+constexpr int kAttentionRowBlock = 32;
+// The keys whose mask isn't greater than it get zero weights after softmax.
+// If the mask is shared by all of the queries, the trailing masked keys are
+// treated as the padding of attention_padding_mask and skipped.
+constexpr float kAttentionMaskedValue = -1e4f;
+
+/*
+ * The scaled dot-product attention of all the heads:
+ *   out = softmax(alpha * Q * K^T + mask) * V
+ * qkv is [batch, seq_len, 3, head_number, size_per_head], i.e. each row is
+ * the Q, K and V projections of a token. mask can be nullptr, otherwise its
+ * dims mask_dims(at most 4-D) are aligned to the trailing dims and broadcasted
+ * to [batch, head_number, seq_len, seq_len].
+ * out is [batch, seq_len, head_number, size_per_head].
+ * The batch x head_number attentions are computed in parallel.
+ */
+void multihead_attention(const float* qkv,
+                         int batch,
+                         int seq_len,
+                         int head_number,
+                         int size_per_head,
+                         float alpha,
+                         const float* mask,
+                         const std::vector<int64_t>& mask_dims,
+                         float* out);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
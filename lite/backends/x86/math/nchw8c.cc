@@ -0,0 +1,716 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/nchw8c.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "lite/backends/x86/math/avx_mathfuns.h"
+#include "lite/backends/x86/math/conv_utils.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// The number of the output pixels computed together by the convolution.
+constexpr int kConvTileWidth = 8;
+// The number of the floats processed by a task of the activation.
+constexpr int64_t kActivationChunk = 16384;
+
+inline int num_blocks(int channel) {
+  return (channel + kNCHW8cBlock - 1) / kNCHW8cBlock;
+}
+
+inline int valid_lanes(int channel, int block) {
+  return std::min(kNCHW8cBlock, channel - block * kNCHW8cBlock);
+}
+
+// Load the 8 channels from the plain per channel data, the lanes out of the
+// channels are zero.
+inline __m256 load_channels(const float* data, int channel, int block) {
+  const int lanes = valid_lanes(channel, block);
+  if (lanes == kNCHW8cBlock) {
+    return _mm256_loadu_ps(data + block * kNCHW8cBlock);
+  }
+  float buffer[kNCHW8cBlock] = {0.f};
+  std::memcpy(buffer, data + block * kNCHW8cBlock, lanes * sizeof(float));
+  return _mm256_loadu_ps(buffer);
+}
+
+// hstart/hend of the output row, which follows Pool2dFunctor.
+inline void pool_window(int out_index,
+                        int in_size,
+                        int out_size,
+                        int ksize,
+                        int stride,
+                        int padding,
+                        bool adaptive,
+                        int* start,
+                        int* end) {
+  if (adaptive) {
+    *start = static_cast<int>(std::floor(static_cast<double>(out_index) *
+                                         in_size / out_size));
+    *end = static_cast<int>(std::ceil(static_cast<double>(out_index + 1) *
+                                      in_size / out_size));
+  } else {
+    *start = out_index * stride - padding;
+    *end = std::min(*start + ksize, in_size);
+    *start = std::max(*start, 0);
+  }
+}
+
+inline __m256 elementwise_m256(__m256 x, __m256 y, ElementwiseNCHW8cType type) {
+  switch (type) {
+    case ElementwiseNCHW8cType::kAdd:
+      return _mm256_add_ps(x, y);
+    case ElementwiseNCHW8cType::kSub:
+      return _mm256_sub_ps(x, y);
+    default:
+      return _mm256_mul_ps(x, y);
+  }
+}
+
+inline float elementwise_float(float x, float y, ElementwiseNCHW8cType type) {
+  switch (type) {
+    case ElementwiseNCHW8cType::kAdd:
+      return x + y;
+    case ElementwiseNCHW8cType::kSub:
+      return x - y;
+    default:
+      return x * y;
+  }
+}
+
+}  // namespace
+
+int64_t nchw8c_size(const DDim& dims) {
+  if (dims.size() != 4) {
+    return dims.production();
+  }
+  return dims[0] * num_blocks(dims[1]) * kNCHW8cBlock * dims[2] * dims[3];
+}
+
+float* nchw8c_mutable_data(lite::Tensor* tensor) {
+  return tensor->mutable_data<float>(
+      TARGET(kX86), nchw8c_size(tensor->dims()) * sizeof(float));
+}
+
+void nchw_to_nchw8c(
+    const float* src, float* dst, int batch, int channel, int spatial) {
+  const int blocks = num_blocks(channel);
+  auto convert_blocks = [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int block = task % blocks;
+      const int lanes = valid_lanes(channel, block);
+      const float* src_block =
+          src + ((task / blocks) * channel + block * kNCHW8cBlock) * spatial;
+      float* dst_block = dst + task * spatial * kNCHW8cBlock;
+      for (int i = 0; i < spatial; i++) {
+        float* dst_pixel = dst_block + i * kNCHW8cBlock;
+        for (int lane = 0; lane < lanes; lane++) {
+          dst_pixel[lane] = src_block[lane * spatial + i];
+        }
+        for (int lane = lanes; lane < kNCHW8cBlock; lane++) {
+          dst_pixel[lane] = 0.f;
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, batch * blocks, convert_blocks);
+}
+
+void nchw8c_to_nchw(
+    const float* src, float* dst, int batch, int channel, int spatial) {
+  const int blocks = num_blocks(channel);
+  auto convert_blocks = [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int block = task % blocks;
+      const int lanes = valid_lanes(channel, block);
+      const float* src_block = src + task * spatial * kNCHW8cBlock;
+      float* dst_block =
+          dst + ((task / blocks) * channel + block * kNCHW8cBlock) * spatial;
+      for (int lane = 0; lane < lanes; lane++) {
+        float* dst_channel = dst_block + lane * spatial;
+        for (int i = 0; i < spatial; i++) {
+          dst_channel[i] = src_block[i * kNCHW8cBlock + lane];
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, batch * blocks, convert_blocks);
+}
+
+void pack_conv_filter_nchw8c(const lite::Tensor& filter,
+                             lite::Tensor* packed) {
+  CHECK_EQ(filter.dims().size(), 4UL);
+  const int oc = filter.dims()[0];
+  const int ic = filter.dims()[1];
+  const int kernel_size = filter.dims()[2] * filter.dims()[3];
+  const int blocks = num_blocks(oc);
+  packed->Resize({blocks, filter.dims()[2], filter.dims()[3], ic, 8});
+  const float* src = filter.data<float>();
+  float* dst = packed->mutable_data<float>();
+  std::memset(dst, 0, packed->numel() * sizeof(float));
+  for (int o = 0; o < oc; o++) {
+    const int block = o / kNCHW8cBlock;
+    const int lane = o % kNCHW8cBlock;
+    for (int c = 0; c < ic; c++) {
+      for (int k = 0; k < kernel_size; k++) {
+        dst[((block * kernel_size + k) * ic + c) * kNCHW8cBlock + lane] =
+            src[(o * ic + c) * kernel_size + k];
+      }
+    }
+  }
+}
+
+void pack_depthwise_filter_nchw8c(const lite::Tensor& filter,
+                                  lite::Tensor* packed) {
+  CHECK_EQ(filter.dims().size(), 4UL);
+  CHECK_EQ(filter.dims()[1], 1);
+  const int channel = filter.dims()[0];
+  const int kernel_size = filter.dims()[2] * filter.dims()[3];
+  const int blocks = num_blocks(channel);
+  packed->Resize({1, blocks, filter.dims()[2], filter.dims()[3], 8});
+  const float* src = filter.data<float>();
+  float* dst = packed->mutable_data<float>();
+  std::memset(dst, 0, packed->numel() * sizeof(float));
+  for (int c = 0; c < channel; c++) {
+    const int block = c / kNCHW8cBlock;
+    const int lane = c % kNCHW8cBlock;
+    for (int k = 0; k < kernel_size; k++) {
+      dst[(block * kernel_size + k) * kNCHW8cBlock + lane] =
+          src[c * kernel_size + k];
+    }
+  }
+}
+
+void pad_channel_nchw8c(const lite::Tensor& bias, lite::Tensor* padded) {
+  const int channel = bias.numel();
+  padded->Resize({num_blocks(channel) * kNCHW8cBlock});
+  float* dst = padded->mutable_data<float>();
+  std::memset(dst, 0, padded->numel() * sizeof(float));
+  std::memcpy(dst, bias.data<float>(), channel * sizeof(float));
+}
+
+void conv2d_nchw8c(const lite::Tensor& input,
+                   const lite::Tensor& packed_filter,
+                   const float* bias,
+                   int kernel_h,
+                   int kernel_w,
+                   const std::vector<int>& strides,
+                   const std::vector<int>& paddings,
+                   const std::vector<int>& dilations,
+                   bool has_act,
+                   lite_api::ActivationType act_type,
+                   lite::Tensor* output) {
+  const int batch = input.dims()[0];
+  const int ic = input.dims()[1];
+  const int ih = input.dims()[2];
+  const int iw = input.dims()[3];
+  const int oc = output->dims()[1];
+  const int oh = output->dims()[2];
+  const int ow = output->dims()[3];
+  const int in_blocks = num_blocks(ic);
+  const int out_blocks = num_blocks(oc);
+  const int stride_h = strides[0];
+  const int stride_w = strides[1];
+  const int pad_top = paddings[0];
+  const int pad_left = paddings[2];
+  const int dilation_h = dilations[0];
+  const int dilation_w = dilations[1];
+  const int64_t in_block_size = ih * iw * kNCHW8cBlock;
+  const int64_t filter_block_size = kernel_h * kernel_w * ic * kNCHW8cBlock;
+
+  const float* input_data = input.data<float>();
+  const float* filter_data = packed_filter.data<float>();
+  float* output_data = nchw8c_mutable_data(output);
+
+  // A task computes a row of the output block, the output pixels of a tile
+  // share the filter vector of 8 output channels which is loaded once.
+  auto compute_rows = [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int oy = task % oh;
+      const int out_block = (task / oh) % out_blocks;
+      const int n = task / oh / out_blocks;
+      const float* input_batch = input_data + n * in_blocks * in_block_size;
+      const float* filter_block = filter_data + out_block * filter_block_size;
+      float* output_row = output_data + task * ow * kNCHW8cBlock;
+      const __m256 bias_val = bias
+                                  ? _mm256_loadu_ps(bias + out_block * 8)
+                                  : _mm256_setzero_ps();
+      for (int ox = 0; ox < ow; ox += kConvTileWidth) {
+        const int tile = std::min(kConvTileWidth, ow - ox);
+        __m256 acc[kConvTileWidth];
+        for (int t = 0; t < kConvTileWidth; t++) {
+          acc[t] = bias_val;
+        }
+        for (int ky = 0; ky < kernel_h; ky++) {
+          const int iy = oy * stride_h - pad_top + ky * dilation_h;
+          if (iy < 0 || iy >= ih) continue;
+          for (int kx = 0; kx < kernel_w; kx++) {
+            const int ix0 = ox * stride_w - pad_left + kx * dilation_w;
+            const bool full_tile =
+                tile == kConvTileWidth && ix0 >= 0 &&
+                ix0 + (kConvTileWidth - 1) * stride_w < iw;
+            const float* filter_ptr =
+                filter_block + (ky * kernel_w + kx) * ic * kNCHW8cBlock;
+            const float* input_row = input_batch + iy * iw * kNCHW8cBlock;
+            for (int c = 0; c < ic; c++) {
+              const __m256 w = _mm256_loadu_ps(filter_ptr + c * kNCHW8cBlock);
+              const float* input_ptr = input_row +
+                                       (c / kNCHW8cBlock) * in_block_size +
+                                       c % kNCHW8cBlock;
+              if (full_tile) {
+                for (int t = 0; t < kConvTileWidth; t++) {
+                  const float x =
+                      input_ptr[(ix0 + t * stride_w) * kNCHW8cBlock];
+                  acc[t] = _mm256_fmadd_ps(_mm256_set1_ps(x), w, acc[t]);
+                }
+              } else {
+                for (int t = 0; t < tile; t++) {
+                  const int ix = ix0 + t * stride_w;
+                  if (ix < 0 || ix >= iw) continue;
+                  const float x = input_ptr[ix * kNCHW8cBlock];
+                  acc[t] = _mm256_fmadd_ps(_mm256_set1_ps(x), w, acc[t]);
+                }
+              }
+            }
+          }
+        }
+        for (int t = 0; t < tile; t++) {
+          const __m256 val = has_act ? activation8_m256(acc[t], act_type)
+                                     : acc[t];
+          _mm256_storeu_ps(output_row + (ox + t) * kNCHW8cBlock, val);
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, batch * out_blocks * oh, compute_rows);
+}
+
+void conv2d_group_nchw8c(const lite::Tensor& input,
+                         const lite::Tensor& filter,
+                         const float* bias,
+                         int groups,
+                         const std::vector<int>& strides,
+                         const std::vector<int>& paddings,
+                         const std::vector<int>& dilations,
+                         bool has_act,
+                         lite_api::ActivationType act_type,
+                         lite::Tensor* output) {
+  const int batch = input.dims()[0];
+  const int ic = input.dims()[1];
+  const int ih = input.dims()[2];
+  const int iw = input.dims()[3];
+  const int oc = output->dims()[1];
+  const int oh = output->dims()[2];
+  const int ow = output->dims()[3];
+  const int kernel_h = filter.dims()[2];
+  const int kernel_w = filter.dims()[3];
+  const int ic_per_group = ic / groups;
+  const int oc_per_group = oc / groups;
+  const int64_t in_block_size = ih * iw * kNCHW8cBlock;
+  const int64_t out_block_size = oh * ow * kNCHW8cBlock;
+
+  const float* input_data = input.data<float>();
+  const float* filter_data = filter.data<float>();
+  float* output_data = nchw8c_mutable_data(output);
+
+  auto compute_channels = [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int o = task % oc;
+      const int n = task / oc;
+      const int group = o / oc_per_group;
+      const float* input_batch =
+          input_data + n * num_blocks(ic) * in_block_size;
+      const float* filter_ptr =
+          filter_data + o * ic_per_group * kernel_h * kernel_w;
+      float* output_ptr = output_data +
+                          (n * num_blocks(oc) + o / kNCHW8cBlock) *
+                              out_block_size +
+                          o % kNCHW8cBlock;
+      for (int oy = 0; oy < oh; oy++) {
+        for (int ox = 0; ox < ow; ox++) {
+          float sum = bias ? bias[o] : 0.f;
+          for (int i = 0; i < ic_per_group; i++) {
+            const int c = group * ic_per_group + i;
+            const float* input_ptr = input_batch +
+                                     (c / kNCHW8cBlock) * in_block_size +
+                                     c % kNCHW8cBlock;
+            const float* w = filter_ptr + i * kernel_h * kernel_w;
+            for (int ky = 0; ky < kernel_h; ky++) {
+              const int iy = oy * strides[0] - paddings[0] + ky * dilations[0];
+              if (iy < 0 || iy >= ih) continue;
+              for (int kx = 0; kx < kernel_w; kx++) {
+                const int ix =
+                    ox * strides[1] - paddings[2] + kx * dilations[1];
+                if (ix < 0 || ix >= iw) continue;
+                sum += input_ptr[(iy * iw + ix) * kNCHW8cBlock] *
+                       w[ky * kernel_w + kx];
+              }
+            }
+          }
+          output_ptr[(oy * ow + ox) * kNCHW8cBlock] =
+              has_act ? activation1_float(sum, act_type) : sum;
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, batch * oc, compute_channels);
+}
+
+void pool2d_nchw8c(const lite::Tensor& input,
+                   const std::vector<int>& ksize,
+                   const std::vector<int>& strides,
+                   const std::vector<int>& paddings,
+                   bool is_max,
+                   bool exclusive,
+                   bool adaptive,
+                   lite::Tensor* output) {
+  const int batch = input.dims()[0];
+  const int blocks = num_blocks(input.dims()[1]);
+  const int ih = input.dims()[2];
+  const int iw = input.dims()[3];
+  const int oh = output->dims()[2];
+  const int ow = output->dims()[3];
+  const float* input_data = input.data<float>();
+  float* output_data = nchw8c_mutable_data(output);
+
+  auto compute_rows = [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int oy = task % oh;
+      const float* input_block =
+          input_data + (task / oh) * ih * iw * kNCHW8cBlock;
+      float* output_row = output_data + task * ow * kNCHW8cBlock;
+      int hstart, hend;
+      pool_window(oy,
+                  ih,
+                  oh,
+                  ksize[0],
+                  strides[0],
+                  paddings[0],
+                  adaptive,
+                  &hstart,
+                  &hend);
+      for (int ox = 0; ox < ow; ox++) {
+        int wstart, wend;
+        pool_window(ox,
+                    iw,
+                    ow,
+                    ksize[1],
+                    strides[1],
+                    paddings[2],
+                    adaptive,
+                    &wstart,
+                    &wend);
+        __m256 acc =
+            is_max ? _mm256_set1_ps(-FLT_MAX) : _mm256_setzero_ps();
+        for (int y = hstart; y < hend; y++) {
+          const float* input_ptr = input_block + y * iw * kNCHW8cBlock;
+          for (int x = wstart; x < wend; x++) {
+            const __m256 val = _mm256_loadu_ps(input_ptr + x * kNCHW8cBlock);
+            acc = is_max ? _mm256_max_ps(acc, val) : _mm256_add_ps(acc, val);
+          }
+        }
+        if (!is_max) {
+          const int pool_size = (exclusive || adaptive)
+                                    ? (hend - hstart) * (wend - wstart)
+                                    : ksize[0] * ksize[1];
+          acc = _mm256_mul_ps(acc,
+                              _mm256_set1_ps(1.f / std::max(pool_size, 1)));
+        }
+        _mm256_storeu_ps(output_row + ox * kNCHW8cBlock, acc);
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, batch * blocks * oh, compute_rows);
+}
+
+// The fallback of the broadcasts which aren't per channel, the 4-D operands
+// are converted to NCHW and the others are already stored in NCHW.
+static void elementwise_broadcast_nchw(const lite::Tensor& x,
+                                       const lite::Tensor& y,
+                                       int axis,
+                                       ElementwiseNCHW8cType type,
+                                       lite::Tensor* out) {
+  auto nchw_data = [](const lite::Tensor& tensor, std::vector<float>* buffer) {
+    const auto& dims = tensor.dims();
+    if (dims.size() != 4) {
+      return tensor.data<float>();
+    }
+    buffer->resize(dims.production());
+    nchw8c_to_nchw(tensor.data<float>(),
+                   buffer->data(),
+                   dims[0],
+                   dims[1],
+                   dims[2] * dims[3]);
+    return static_cast<const float*>(buffer->data());
+  };
+  std::vector<float> x_buffer;
+  std::vector<float> y_buffer;
+  const float* x_data = nchw_data(x, &x_buffer);
+  const float* y_data = nchw_data(y, &y_buffer);
+
+  // The strides of x and y in the dims of out, which are 0 for the broadcast
+  // dims. The operand of the lower rank is aligned to out by axis, as
+  // ElementwiseOp::InferShape.
+  const auto& out_dims = out->dims();
+  const int rank = static_cast<int>(out_dims.size());
+  auto broadcast_strides = [&](const DDim& dims) {
+    const int dims_rank = static_cast<int>(dims.size());
+    const int offset =
+        dims_rank == rank ? 0 : (axis == -1 ? rank - dims_rank : axis);
+    CHECK(offset >= 0 && offset + dims_rank <= rank)
+        << "The NCHW8c elementwise can't broadcast " << dims << " to "
+        << out_dims << " with axis " << axis;
+    std::vector<int64_t> strides(rank, 0);
+    int64_t stride = 1;
+    for (int i = dims_rank - 1; i >= 0; i--) {
+      if (dims[i] != 1) {
+        CHECK_EQ(dims[i], out_dims[offset + i])
+            << "The NCHW8c elementwise can't broadcast " << dims << " to "
+            << out_dims << " with axis " << axis;
+        strides[offset + i] = stride;
+      }
+      stride *= dims[i];
+    }
+    return strides;
+  };
+  const auto x_strides = broadcast_strides(x.dims());
+  const auto y_strides = broadcast_strides(y.dims());
+
+  std::vector<float> out_buffer;
+  float* out_data = nchw8c_mutable_data(out);
+  float* dst = out_data;
+  if (rank == 4) {
+    out_buffer.resize(out_dims.production());
+    dst = out_buffer.data();
+  }
+  std::vector<int64_t> index(rank, 0);
+  int64_t x_offset = 0;
+  int64_t y_offset = 0;
+  const int64_t numel = out_dims.production();
+  for (int64_t i = 0; i < numel; i++) {
+    dst[i] = elementwise_float(x_data[x_offset], y_data[y_offset], type);
+    for (int d = rank - 1; d >= 0; d--) {
+      index[d]++;
+      x_offset += x_strides[d];
+      y_offset += y_strides[d];
+      if (index[d] < out_dims[d]) break;
+      x_offset -= x_strides[d] * out_dims[d];
+      y_offset -= y_strides[d] * out_dims[d];
+      index[d] = 0;
+    }
+  }
+  if (rank == 4) {
+    nchw_to_nchw8c(
+        dst, out_data, out_dims[0], out_dims[1], out_dims[2] * out_dims[3]);
+  }
+}
+
+void elementwise_nchw8c(const lite::Tensor& x,
+                        const lite::Tensor& y,
+                        int axis,
+                        ElementwiseNCHW8cType type,
+                        lite::Tensor* out) {
+  const auto& x_dims = x.dims();
+  const auto& y_dims = y.dims();
+  const float* x_data = x.data<float>();
+  const float* y_data = y.data<float>();
+  float* out_data = nchw8c_mutable_data(out);
+  const int64_t size = nchw8c_size(x_dims);
+
+  if (x_dims == y_dims ||
+      (y.numel() == 1 && y_dims.size() <= x_dims.size())) {
+    const bool is_scalar = x_dims != y_dims;
+    auto compute_chunks = [&](int64_t begin, int64_t end) {
+      const int64_t start = begin * kActivationChunk;
+      const int64_t stop = std::min(size, end * kActivationChunk);
+      int64_t i = start;
+      for (; i + kNCHW8cBlock <= stop; i += kNCHW8cBlock) {
+        const __m256 y_val = is_scalar ? _mm256_set1_ps(y_data[0])
+                                       : _mm256_loadu_ps(y_data + i);
+        _mm256_storeu_ps(
+            out_data + i,
+            elementwise_m256(_mm256_loadu_ps(x_data + i), y_val, type));
+      }
+      for (; i < stop; i++) {
+        out_data[i] = elementwise_float(
+            x_data[i], is_scalar ? y_data[0] : y_data[i], type);
+      }
+    };
+    lite::x86::RunParallelFor(
+        0, (size + kActivationChunk - 1) / kActivationChunk, compute_chunks);
+    return;
+  }
+
+  // The per channel y is [c] with axis 1, or [1, c, 1, 1] and [n, c, 1, 1]
+  // which is blocked.
+  const bool is_blocked_y =
+      x_dims.size() == 4 && y_dims.size() == 4 && y_dims[1] == x_dims[1] &&
+      y_dims[2] == 1 && y_dims[3] == 1 &&
+      (y_dims[0] == 1 || y_dims[0] == x_dims[0]);
+  const bool is_channel_y = x_dims.size() == 4 && y_dims.size() == 1 &&
+                            y_dims[0] == x_dims[1] && axis == 1;
+  if (!is_blocked_y && !is_channel_y) {
+    elementwise_broadcast_nchw(x, y, axis, type, out);
+    return;
+  }
+  const int batch = x_dims[0];
+  const int channel = x_dims[1];
+  const int spatial = x_dims[2] * x_dims[3];
+  const int blocks = num_blocks(channel);
+  const int64_t y_batch_stride =
+      is_blocked_y && y_dims[0] != 1 ? blocks * kNCHW8cBlock : 0;
+  auto compute_blocks = [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int block = task % blocks;
+      const int n = task / blocks;
+      const __m256 y_val =
+          load_channels(y_data + n * y_batch_stride, channel, block);
+      const float* x_ptr = x_data + task * spatial * kNCHW8cBlock;
+      float* out_ptr = out_data + task * spatial * kNCHW8cBlock;
+      for (int i = 0; i < spatial; i++) {
+        _mm256_storeu_ps(
+            out_ptr + i * kNCHW8cBlock,
+            elementwise_m256(
+                _mm256_loadu_ps(x_ptr + i * kNCHW8cBlock), y_val, type));
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, batch * blocks, compute_blocks);
+}
+
+void activation_nchw8c(const float* x,
+                       float* y,
+                       int64_t size,
+                       lite_api::ActivationType act_type,
+                       float alpha) {
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 alpha_val = _mm256_set1_ps(alpha);
+  auto act_m256 = [&](__m256 val) -> __m256 {
+    switch (act_type) {
+      case lite_api::ActivationType::kRelu:
+        return _mm256_max_ps(val, zero);
+      case lite_api::ActivationType::kRelu6:
+        return _mm256_min_ps(_mm256_max_ps(val, zero), alpha_val);
+      case lite_api::ActivationType::kLeakyRelu:
+        return _mm256_add_ps(
+            _mm256_max_ps(val, zero),
+            _mm256_mul_ps(alpha_val, _mm256_min_ps(val, zero)));
+      case lite_api::ActivationType::kSigmoid:
+        return _mm256_div_ps(
+            one, _mm256_add_ps(one, exp256_ps(_mm256_sub_ps(zero, val))));
+      case lite_api::ActivationType::kTanh: {
+        // tanh(x) = 2 / (1 + exp(-2x)) - 1
+        const __m256 exp_val =
+            exp256_ps(_mm256_mul_ps(_mm256_set1_ps(-2.f), val));
+        return _mm256_sub_ps(
+            _mm256_div_ps(_mm256_set1_ps(2.f), _mm256_add_ps(one, exp_val)),
+            one);
+      }
+      default:
+        LOG(FATAL) << "The NCHW8c activation doesn't support "
+                   << lite_api::ActivationTypeToStr(act_type);
+    }
+    return val;
+  };
+  auto act_float = [&](float val) -> float {
+    switch (act_type) {
+      case lite_api::ActivationType::kRelu:
+        return std::max(val, 0.f);
+      case lite_api::ActivationType::kRelu6:
+        return std::min(std::max(val, 0.f), alpha);
+      case lite_api::ActivationType::kLeakyRelu:
+        return val > 0.f ? val : val * alpha;
+      case lite_api::ActivationType::kSigmoid:
+        return 1.f / (1.f + std::exp(-val));
+      case lite_api::ActivationType::kTanh:
+        return std::tanh(val);
+      default:
+        LOG(FATAL) << "The NCHW8c activation doesn't support "
+                   << lite_api::ActivationTypeToStr(act_type);
+    }
+    return val;
+  };
+  auto compute_chunks = [&](int64_t begin, int64_t end) {
+    const int64_t start = begin * kActivationChunk;
+    const int64_t stop = std::min(size, end * kActivationChunk);
+    int64_t i = start;
+    for (; i + kNCHW8cBlock <= stop; i += kNCHW8cBlock) {
+      _mm256_storeu_ps(y + i, act_m256(_mm256_loadu_ps(x + i)));
+    }
+    for (; i < stop; i++) {
+      y[i] = act_float(x[i]);
+    }
+  };
+  lite::x86::RunParallelFor(
+      0, (size + kActivationChunk - 1) / kActivationChunk, compute_chunks);
+}
+
+void scale_bias_nchw8c(const lite::Tensor& x,
+                       const float* scale,
+                       const float* bias,
+                       lite::Tensor* out) {
+  const auto& dims = x.dims();
+  const float* x_data = x.data<float>();
+  float* out_data = nchw8c_mutable_data(out);
+  const int batch = dims[0];
+  const int channel = dims.size() > 1 ? dims[1] : 1;
+  const int spatial = dims.size() > 2 ? dims.count(2, dims.size()) : 1;
+  if (dims.size() != 4) {
+    // The tensor is stored as NCHW.
+    for (int n = 0; n < batch; n++) {
+      for (int c = 0; c < channel; c++) {
+        const int64_t offset = (n * channel + c) * spatial;
+        for (int i = 0; i < spatial; i++) {
+          out_data[offset + i] = x_data[offset + i] * scale[c] + bias[c];
+        }
+      }
+    }
+    return;
+  }
+  const int blocks = num_blocks(channel);
+  auto compute_blocks = [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int block = task % blocks;
+      const __m256 scale_val = _mm256_loadu_ps(scale + block * kNCHW8cBlock);
+      const __m256 bias_val = _mm256_loadu_ps(bias + block * kNCHW8cBlock);
+      const float* x_ptr = x_data + task * spatial * kNCHW8cBlock;
+      float* out_ptr = out_data + task * spatial * kNCHW8cBlock;
+      for (int i = 0; i < spatial; i++) {
+        _mm256_storeu_ps(
+            out_ptr + i * kNCHW8cBlock,
+            _mm256_fmadd_ps(_mm256_loadu_ps(x_ptr + i * kNCHW8cBlock),
+                            scale_val,
+                            bias_val));
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, batch * blocks, compute_blocks);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,116 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "lite/api/paddle_place.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The tensor of the NCHW8c layout keeps its logical NCHW dims, and the data is
+// stored as [N, ceil(C / 8), H, W, 8]. The padded channels of the last block
+// are never read across the channels, so their values are unspecified. The
+// tensors whose rank isn't 4 are stored as they are in NCHW.
+constexpr int kNCHW8cBlock = 8;
+
+// The number of floats to store the tensor of the dims in NCHW8c.
+int64_t nchw8c_size(const DDim& dims);
+// Allocate the NCHW8c storage of the tensor whose dims are set.
+float* nchw8c_mutable_data(lite::Tensor* tensor);
+
+void nchw_to_nchw8c(
+    const float* src, float* dst, int batch, int channel, int spatial);
+void nchw8c_to_nchw(
+    const float* src, float* dst, int batch, int channel, int spatial);
+
+// Pack the filter [oc, ic, kh, kw] of the convolution whose groups is 1 to
+// [ceil(oc / 8), kh, kw, ic, 8], and the depthwise filter [c, 1, kh, kw] to
+// [1, ceil(c / 8), kh, kw, 8] which is used by conv_depthwise_m256. The bias
+// [oc] is padded to [ceil(oc / 8) * 8]. The padded channels are zero.
+void pack_conv_filter_nchw8c(const lite::Tensor& filter, lite::Tensor* packed);
+void pack_depthwise_filter_nchw8c(const lite::Tensor& filter,
+                                  lite::Tensor* packed);
+void pad_channel_nchw8c(const lite::Tensor& bias, lite::Tensor* padded);
+
+// The input and output are NCHW8c, the filter is packed by
+// pack_conv_filter_nchw8c, and the bias is padded or nullptr. The paddings are
+// [top, bottom, left, right], the activation supports relu and relu6.
+void conv2d_nchw8c(const lite::Tensor& input,
+                   const lite::Tensor& packed_filter,
+                   const float* bias,
+                   int kernel_h,
+                   int kernel_w,
+                   const std::vector<int>& strides,
+                   const std::vector<int>& paddings,
+                   const std::vector<int>& dilations,
+                   bool has_act,
+                   lite_api::ActivationType act_type,
+                   lite::Tensor* output);
+
+// The grouped convolution of the original filter [oc, ic / groups, kh, kw] and
+// bias [oc], it's the fallback of the groups which isn't 1 or depthwise.
+void conv2d_group_nchw8c(const lite::Tensor& input,
+                         const lite::Tensor& filter,
+                         const float* bias,
+                         int groups,
+                         const std::vector<int>& strides,
+                         const std::vector<int>& paddings,
+                         const std::vector<int>& dilations,
+                         bool has_act,
+                         lite_api::ActivationType act_type,
+                         lite::Tensor* output);
+
+void pool2d_nchw8c(const lite::Tensor& input,
+                   const std::vector<int>& ksize,
+                   const std::vector<int>& strides,
+                   const std::vector<int>& paddings,
+                   bool is_max,
+                   bool exclusive,
+                   bool adaptive,
+                   lite::Tensor* output);
+
+enum class ElementwiseNCHW8cType { kAdd, kSub, kMul };
+
+// out = x op y, y is in the same dims of x, a scalar, or a per channel tensor
+// whose dims are [c] with axis 1, or [1, c, 1, 1] and [n, c, 1, 1]. The other
+// broadcasts are computed in NCHW, which is slower.
+void elementwise_nchw8c(const lite::Tensor& x,
+                        const lite::Tensor& y,
+                        int axis,
+                        ElementwiseNCHW8cType type,
+                        lite::Tensor* out);
+
+// The activation is applied to the storage of the layout directly, alpha is
+// the slope of leaky_relu or the threshold of relu6.
+void activation_nchw8c(const float* x,
+                       float* y,
+                       int64_t size,
+                       lite_api::ActivationType act_type,
+                       float alpha);
+
+// out = x * scale + bias per channel, the scale and bias are padded.
+void scale_bias_nchw8c(const lite::Tensor& x,
+                       const float* scale,
+                       const float* bias,
+                       lite::Tensor* out);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
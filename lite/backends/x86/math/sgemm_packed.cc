@@ -0,0 +1,202 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/sgemm_packed.h"
+#include <algorithm>
+#include <string>
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The steps of K of each block, a panel of B is 16KB.
+constexpr int kSgemmKC = 256;
+// The number of blocks of A and panels of B computed by each task.
+constexpr int kSgemmMBlocks = 8;
+constexpr int kSgemmNPanels = 4;
+
+static inline int round_up(int x, int align) {
+  return (x + align - 1) / align * align;
+}
+
+int sgemm_packed_a_size(int m, int k) { return round_up(m, kSgemmMR) * k; }
+
+int sgemm_packed_b_size(int k, int n) { return round_up(n, kSgemmNR) * k; }
+
+std::string sgemm_packed_a_layout() {
+  return "x86/sgemm_packed_a/" + std::to_string(kSgemmMR);
+}
+
+std::string sgemm_packed_b_layout() {
+  return "x86/sgemm_packed_b/" + std::to_string(kSgemmNR);
+}
+
+void sgemm_pack_a(
+    bool trans, const float* a, int m, int k, int lda, float* packed_a) {
+  const int num_blocks = (m + kSgemmMR - 1) / kSgemmMR;
+  auto pack_blocks = [&](int64_t begin, int64_t end) {
+    for (int64_t mb = begin; mb < end; mb++) {
+      const int row = static_cast<int>(mb) * kSgemmMR;
+      const int rows = std::min(kSgemmMR, m - row);
+      float* dst = packed_a + row * k;
+      for (int kk = 0; kk < k; kk++) {
+        for (int r = 0; r < kSgemmMR; r++) {
+          if (r >= rows) {
+            *(dst++) = 0.f;
+          } else if (trans) {
+            *(dst++) = a[kk * lda + row + r];
+          } else {
+            *(dst++) = a[(row + r) * lda + kk];
+          }
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, num_blocks, pack_blocks);
+}
+
+void sgemm_pack_b(
+    bool trans, const float* b, int k, int n, int ldb, float* packed_b) {
+  // B is packed by the chunks of rows, so that the source is read row by row
+  // instead of the large stride of the panel.
+  constexpr int kChunk = 32;
+  const int num_panels = (n + kSgemmNR - 1) / kSgemmNR;
+  const int num_chunks = (k + kChunk - 1) / kChunk;
+  auto pack_chunks = [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      const int k_begin = static_cast<int>(chunk) * kChunk;
+      const int k_end = std::min(k_begin + kChunk, k);
+      for (int nb = 0; nb < num_panels; nb++) {
+        const int col = nb * kSgemmNR;
+        const int cols = std::min(kSgemmNR, n - col);
+        float* dst = packed_b + col * k + k_begin * kSgemmNR;
+        for (int kk = k_begin; kk < k_end; kk++) {
+          if (trans) {
+            for (int c = 0; c < cols; c++) {
+              dst[c] = b[(col + c) * ldb + kk];
+            }
+          } else {
+            std::copy(b + kk * ldb + col, b + kk * ldb + col + cols, dst);
+          }
+          std::fill(dst + cols, dst + kSgemmNR, 0.f);
+          dst += kSgemmNR;
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(0, num_chunks, pack_chunks);
+}
+
+void sgemm_kernel_ref(const float* packed_a,
+                      const float* packed_b,
+                      int kc,
+                      float* c,
+                      int ldc,
+                      bool accumulate) {
+  float acc[kSgemmMR][kSgemmNR] = {{0.f}};
+  for (int kk = 0; kk < kc; kk++) {
+    for (int r = 0; r < kSgemmMR; r++) {
+      for (int i = 0; i < kSgemmNR; i++) {
+        acc[r][i] += packed_a[r] * packed_b[i];
+      }
+    }
+    packed_a += kSgemmMR;
+    packed_b += kSgemmNR;
+  }
+  for (int r = 0; r < kSgemmMR; r++) {
+    for (int i = 0; i < kSgemmNR; i++) {
+      c[r * ldc + i] = accumulate ? c[r * ldc + i] + acc[r][i] : acc[r][i];
+    }
+  }
+}
+
+static SgemmKernel select_sgemm_kernel() {
+  SgemmKernel kernel = nullptr;
+  AVXType level = device_avx_level();
+  if ((level == AVXType::ISA_AVX2 || level == AVXType::ISA_VNNI) &&
+      device_fma_level() == FMAType::ISA_FMA) {
+    kernel = sgemm_kernel_avx2();
+  }
+  return kernel == nullptr ? sgemm_kernel_ref : kernel;
+}
+
+void sgemm_packed(const float* packed_a,
+                  const float* packed_b,
+                  int m,
+                  int n,
+                  int k,
+                  float* c,
+                  int ldc,
+                  SgemmKernel kernel) {
+  static const SgemmKernel default_kernel = select_sgemm_kernel();
+  if (kernel == nullptr) {
+    kernel = default_kernel;
+  }
+  if (k <= 0) {
+    for (int i = 0; i < m; i++) {
+      std::fill(c + i * ldc, c + i * ldc + n, 0.f);
+    }
+    return;
+  }
+  const int num_mb = (m + kSgemmMR - 1) / kSgemmMR;
+  const int num_nb = (n + kSgemmNR - 1) / kSgemmNR;
+  const int num_mtasks = (num_mb + kSgemmMBlocks - 1) / kSgemmMBlocks;
+  const int num_ntasks = (num_nb + kSgemmNPanels - 1) / kSgemmNPanels;
+  auto compute_blocks = [&](int64_t begin, int64_t end) {
+    float tile[kSgemmMR * kSgemmNR];
+    for (int64_t t = begin; t < end; t++) {
+      const int mb_begin = static_cast<int>(t % num_mtasks) * kSgemmMBlocks;
+      const int nb_begin = static_cast<int>(t / num_mtasks) * kSgemmNPanels;
+      const int mb_end = std::min(mb_begin + kSgemmMBlocks, num_mb);
+      const int nb_end = std::min(nb_begin + kSgemmNPanels, num_nb);
+      for (int k0 = 0; k0 < k; k0 += kSgemmKC) {
+        const int kc = std::min(kSgemmKC, k - k0);
+        const bool accumulate = k0 > 0;
+        for (int nb = nb_begin; nb < nb_end; nb++) {
+          const int col = nb * kSgemmNR;
+          const int cols = std::min(kSgemmNR, n - col);
+          const float* b = packed_b + col * k + k0 * kSgemmNR;
+          for (int mb = mb_begin; mb < mb_end; mb++) {
+            const int row = mb * kSgemmMR;
+            const int rows = std::min(kSgemmMR, m - row);
+            const float* a = packed_a + row * k + k0 * kSgemmMR;
+            float* dst = c + row * ldc + col;
+            if (rows == kSgemmMR && cols == kSgemmNR) {
+              kernel(a, b, kc, dst, ldc, accumulate);
+              continue;
+            }
+            // The tail blocks are computed in the local tile.
+            kernel(a, b, kc, tile, kSgemmNR, false);
+            for (int r = 0; r < rows; r++) {
+              for (int i = 0; i < cols; i++) {
+                float v = tile[r * kSgemmNR + i];
+                dst[r * ldc + i] = accumulate ? dst[r * ldc + i] + v : v;
+              }
+            }
+          }
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(
+      0, static_cast<int64_t>(num_mtasks) * num_ntasks, compute_blocks);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
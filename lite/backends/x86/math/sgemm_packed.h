@@ -0,0 +1,89 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The packed sgemm computes C(M x N) = A(M x K) * B(K x N), it doesn't depend
+ * on the cblas library. Both of the operands must be packed in advance, so the
+ * weights can be packed only once when the kernel is prepared.
+ *
+ * packed A: blocks of 6 rows, each block is [K][6].
+ * packed B: panels of 16 columns, each panel is [K][16].
+ * M is padded to a multiple of 6 and N to 16 with zeros.
+ * The computation is blocked by K to keep the panel of B in L1 cache and the
+ * blocks of A in L2 cache, and the blocks of C are computed in parallel.
+ */
+constexpr int kSgemmMR = 6;
+constexpr int kSgemmNR = 16;
+
+// The number of float elements of the packed A and B.
+int sgemm_packed_a_size(int m, int k);
+int sgemm_packed_b_size(int k, int n);
+
+// The keys of the layouts of the packed A and B. The operands packed ahead of
+// time, e.g. by opt, are adopted only if they were packed with the same key.
+std::string sgemm_packed_a_layout();
+std::string sgemm_packed_b_layout();
+
+// Pack A(M x K), A is stored as K x M if trans is true.
+void sgemm_pack_a(
+    bool trans, const float* a, int m, int k, int lda, float* packed_a);
+// Pack B(K x N), B is stored as N x K if trans is true.
+void sgemm_pack_b(
+    bool trans, const float* b, int k, int n, int ldb, float* packed_b);
+
+// The micro kernel computes the block C(6 x 16) of kc steps of one block of
+// the packed A and one panel of the packed B, the result is added to C if
+// accumulate is true, otherwise it's stored to C.
+using SgemmKernel = void (*)(const float* packed_a,
+                             const float* packed_b,
+                             int kc,
+                             float* c,
+                             int ldc,
+                             bool accumulate);
+
+// The AVX2/FMA micro kernel, nullptr is returned if it isn't enabled by the
+// compiler.
+SgemmKernel sgemm_kernel_avx2();
+// The portable micro kernel.
+void sgemm_kernel_ref(const float* packed_a,
+                      const float* packed_b,
+                      int kc,
+                      float* c,
+                      int ldc,
+                      bool accumulate);
+
+// C is set to zeros if K is 0. The micro kernel is selected by the CPU if
+// kernel is nullptr.
+void sgemm_packed(const float* packed_a,
+                  const float* packed_b,
+                  int m,
+                  int n,
+                  int k,
+                  float* c,
+                  int ldc,
+                  SgemmKernel kernel = nullptr);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
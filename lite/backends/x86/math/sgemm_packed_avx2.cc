@@ -0,0 +1,82 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <immintrin.h>
+#include "lite/backends/x86/math/sgemm_packed.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#if defined(__AVX2__) && defined(__FMA__)
+// 12 accumulators hold the block C(6 x 16), each step broadcasts one element
+// of each row of A and multiplies it with the 16 elements of B.
+#define SGEMM_ROW(r)                           \
+  va = _mm256_broadcast_ss(packed_a + r);      \
+  c##r##0 = _mm256_fmadd_ps(va, vb0, c##r##0); \
+  c##r##1 = _mm256_fmadd_ps(va, vb1, c##r##1);
+
+#define SGEMM_STORE(r)                                                  \
+  if (accumulate) {                                                     \
+    c##r##0 = _mm256_add_ps(c##r##0, _mm256_loadu_ps(c + r * ldc));     \
+    c##r##1 = _mm256_add_ps(c##r##1, _mm256_loadu_ps(c + r * ldc + 8)); \
+  }                                                                     \
+  _mm256_storeu_ps(c + r * ldc, c##r##0);                               \
+  _mm256_storeu_ps(c + r * ldc + 8, c##r##1);
+
+static void sgemm_kernel_avx2_func(const float* packed_a,
+                                   const float* packed_b,
+                                   int kc,
+                                   float* c,
+                                   int ldc,
+                                   bool accumulate) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+  __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+  __m256 va;
+  for (int kk = 0; kk < kc; kk++) {
+    __m256 vb0 = _mm256_loadu_ps(packed_b);
+    __m256 vb1 = _mm256_loadu_ps(packed_b + 8);
+    SGEMM_ROW(0)
+    SGEMM_ROW(1)
+    SGEMM_ROW(2)
+    SGEMM_ROW(3)
+    SGEMM_ROW(4)
+    SGEMM_ROW(5)
+    packed_a += kSgemmMR;
+    packed_b += kSgemmNR;
+  }
+  SGEMM_STORE(0)
+  SGEMM_STORE(1)
+  SGEMM_STORE(2)
+  SGEMM_STORE(3)
+  SGEMM_STORE(4)
+  SGEMM_STORE(5)
+}
+#undef SGEMM_STORE
+#undef SGEMM_ROW
+
+SgemmKernel sgemm_kernel_avx2() { return sgemm_kernel_avx2_func; }
+#else
+SgemmKernel sgemm_kernel_avx2() { return nullptr; }
+#endif
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
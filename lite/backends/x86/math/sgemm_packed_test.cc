@@ -0,0 +1,154 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/sgemm_packed.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static std::vector<float> RandomData(int size, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(rng);
+  }
+  return data;
+}
+
+// The naive C(M x N) = A(M x K) * B(K x N), A is stored as K x M if trans_a
+// is true and B is stored as N x K if trans_b is true.
+static std::vector<float> ReferenceGemm(bool trans_a,
+                                        bool trans_b,
+                                        const std::vector<float>& a,
+                                        const std::vector<float>& b,
+                                        int m,
+                                        int n,
+                                        int k) {
+  std::vector<float> c(m * n, 0.f);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum = 0.;
+      for (int p = 0; p < k; p++) {
+        float va = trans_a ? a[p * m + i] : a[i * k + p];
+        float vb = trans_b ? b[j * k + p] : b[p * n + j];
+        sum += va * vb;
+      }
+      c[i * n + j] = static_cast<float>(sum);
+    }
+  }
+  return c;
+}
+
+static std::vector<SgemmKernel> AvailableKernels() {
+  std::vector<SgemmKernel> kernels{sgemm_kernel_ref};
+  AVXType level = device_avx_level();
+  if ((level == AVXType::ISA_AVX2 || level == AVXType::ISA_VNNI) &&
+      device_fma_level() == FMAType::ISA_FMA &&
+      sgemm_kernel_avx2() != nullptr) {
+    kernels.push_back(sgemm_kernel_avx2());
+  }
+  return kernels;
+}
+
+static void TestSgemmPacked(
+    bool trans_a, bool trans_b, int m, int n, int k, SgemmKernel kernel) {
+  auto a = RandomData(m * k, m + k);
+  auto b = RandomData(k * n, n + k);
+  std::vector<float> packed_a(sgemm_packed_a_size(m, k));
+  std::vector<float> packed_b(sgemm_packed_b_size(k, n));
+  sgemm_pack_a(trans_a, a.data(), m, k, trans_a ? m : k, packed_a.data());
+  sgemm_pack_b(trans_b, b.data(), k, n, trans_b ? k : n, packed_b.data());
+
+  // C is a sub-matrix of a larger buffer, the padding must be kept.
+  const int ldc = n + 3;
+  std::vector<float> c(m * ldc, 7.f);
+  sgemm_packed(
+      packed_a.data(), packed_b.data(), m, n, k, c.data(), ldc, kernel);
+
+  auto ref = ReferenceGemm(trans_a, trans_b, a, b, m, n, k);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      ASSERT_NEAR(c[i * ldc + j], ref[i * n + j], 1e-4f * std::max(k, 1))
+          << "m=" << m << " n=" << n << " k=" << k << " at (" << i << ", "
+          << j << ")";
+    }
+    for (int j = n; j < ldc; j++) {
+      ASSERT_EQ(c[i * ldc + j], 7.f);
+    }
+  }
+}
+
+TEST(sgemm_packed, compare_with_reference) {
+  // M isn't a multiple of 6, N isn't a multiple of 16, K is larger than one
+  // block of K, so both the tail blocks and the accumulation are covered.
+  const int shapes[][3] = {
+      {1, 1, 1}, {6, 16, 256}, {13, 37, 300}, {50, 70, 600}, {5, 130, 257}};
+  for (auto kernel : AvailableKernels()) {
+    for (auto& shape : shapes) {
+      for (bool trans_a : {false, true}) {
+        for (bool trans_b : {false, true}) {
+          TestSgemmPacked(
+              trans_a, trans_b, shape[0], shape[1], shape[2], kernel);
+        }
+      }
+    }
+  }
+}
+
+TEST(sgemm_packed, micro_kernels) {
+  const int kc = 300;
+  auto a = RandomData(kSgemmMR * kc, 1);
+  auto b = RandomData(kc * kSgemmNR, 2);
+  std::vector<float> packed_a(sgemm_packed_a_size(kSgemmMR, kc));
+  std::vector<float> packed_b(sgemm_packed_b_size(kc, kSgemmNR));
+  sgemm_pack_a(false, a.data(), kSgemmMR, kc, kc, packed_a.data());
+  sgemm_pack_b(false, b.data(), kc, kSgemmNR, kSgemmNR, packed_b.data());
+  auto ref = ReferenceGemm(false, false, a, b, kSgemmMR, kSgemmNR, kc);
+
+  for (auto kernel : AvailableKernels()) {
+    std::vector<float> c(kSgemmMR * kSgemmNR, 1.f);
+    kernel(packed_a.data(), packed_b.data(), kc, c.data(), kSgemmNR, false);
+    for (int i = 0; i < kSgemmMR * kSgemmNR; i++) {
+      ASSERT_NEAR(c[i], ref[i], 1e-3f);
+    }
+    kernel(packed_a.data(), packed_b.data(), kc, c.data(), kSgemmNR, true);
+    for (int i = 0; i < kSgemmMR * kSgemmNR; i++) {
+      ASSERT_NEAR(c[i], 2 * ref[i], 2e-3f);
+    }
+  }
+}
+
+TEST(sgemm_packed, zero_k) {
+  const int m = 7;
+  const int n = 17;
+  std::vector<float> c(m * n, 1.f);
+  sgemm_packed(nullptr, nullptr, m, n, 0, c.data(), n);
+  for (auto v : c) {
+    ASSERT_EQ(v, 0.f);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
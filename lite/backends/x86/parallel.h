@@ -15,9 +15,13 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
+#include <vector>
 #ifdef PADDLE_WITH_MKLML
 #include <omp.h>
 #include "lite/backends/x86/mklml.h"
+#else
+#include "lite/backends/x86/thread_pool.h"
 #endif
 
 namespace paddle {
@@ -33,6 +37,16 @@ static void SetNumThreads(int num_threads) {
   x86::MKL_Set_Num_Threads(real_num_threads);
 #endif
   omp_set_num_threads(real_num_threads);
+#else
+  ThreadPool::Local().SetNumThreads(num_threads);
+#endif
+}
+
+// Bind the math threads of the current thread to the given CPUs, it's only
+// supported by the built-in thread pool.
+static void SetThreadAffinity(const std::vector<int>& cpu_ids) {
+#ifndef PADDLE_WITH_MKLML
+  ThreadPool::Local().SetAffinity(cpu_ids);
 #endif
 }
 
@@ -41,22 +55,40 @@ static inline int64_t GetMaxThreads() {
 #ifdef PADDLE_WITH_MKLML
   // Do not support nested omp parallem.
   num_threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+  num_threads =
+      ThreadPool::InParallel() ? 1 : ThreadPool::Local().num_threads();
 #endif
   return (std::max<int>)(num_threads, 1L);
 }
 
+#ifdef PADDLE_WITH_MKLML
 using ThreadHandler =
     std::function<void(const int64_t begin, const int64_t end)>;
+#endif
 
+// Run f over [begin, end) in parallel, chunk_size is the hint of the minimum
+// size of the sub-range passed to f, the range is evenly split among the
+// threads if it's 0.
 static inline void RunParallelFor(const int64_t begin,
                                   const int64_t end,
-                                  const ThreadHandler& f) {
+                                  const ThreadHandler& f,
+                                  const int64_t chunk_size = 0) {
   if (begin >= end) {
     return;
   }
 
 #ifdef PADDLE_WITH_MKLML
   int64_t num_threads = (std::min)(GetMaxThreads(), end - begin);
+  if (num_threads > 1 && chunk_size > 0) {
+    int64_t num_chunks = (end - begin + chunk_size - 1) / chunk_size;
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+    for (int64_t i = 0; i < num_chunks; i++) {
+      int64_t begin_chunk = begin + i * chunk_size;
+      f(begin_chunk, (std::min)(end, begin_chunk + chunk_size));
+    }
+    return;
+  }
   if (num_threads > 1) {
 #pragma omp parallel num_threads(num_threads)
     {
@@ -67,9 +99,10 @@ static inline void RunParallelFor(const int64_t begin,
     }
     return;
   }
-#endif
-
   f(begin, end);
+#else
+  ThreadPool::Local().ParallelFor(begin, end, chunk_size, f);
+#endif
 }
 
 }  // namespace x86
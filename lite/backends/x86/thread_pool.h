@@ -0,0 +1,273 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <algorithm>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/utils/cp_logging.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+using ThreadHandler =
+    std::function<void(const int64_t begin, const int64_t end)>;
+
+/*
+ * ThreadPool is a persistent work-stealing thread pool, which is used by
+ * RunParallelFor when OpenMP(MKLML) is not available.
+ * The range is split into chunks, each participant(the calling thread and the
+ * workers) owns a contiguous slot of chunks, takes chunks from the front of
+ * its own slot, and steals chunks from the back of the other slots when its
+ * own slot is empty.
+ * Each thread owns its pool(see Local()), so the predictors which run on the
+ * different threads are bound to their own number of threads and never
+ * contend for the workers.
+ */
+class ThreadPool {
+ public:
+  // The default number of chunks for each participant, the more chunks, the
+  // better load balance and the more scheduling overhead.
+  static constexpr int64_t kChunksPerThread = 4;
+
+  static ThreadPool& Local() {
+    static LITE_THREAD_LOCAL ThreadPool pool;
+    return pool;
+  }
+
+  ThreadPool() = default;
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool() { StopWorkers(); }
+
+  int num_threads() const { return num_threads_; }
+
+  // Set the number of participants including the calling thread, so
+  // `num_threads - 1` workers take part in the jobs. The workers are kept
+  // when the number is lowered and only the missing ones are created when
+  // it's raised, so the predictors with the different numbers of threads
+  // which run on the same thread never respawn them.
+  void SetNumThreads(int num_threads) {
+    num_threads = (std::max)(num_threads, 1);
+    if (num_threads == num_threads_) return;
+    const int num_workers = static_cast<int>(workers_.size());
+    if (num_threads > num_workers + 1) {
+      slots_.reset(new Slot[num_threads]);
+      // The workers start from the current generation, otherwise the job
+      // which is issued before a worker starts running would be missed by it.
+      for (int i = num_workers + 1; i < num_threads; i++) {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this, i, generation_);
+      }
+      ApplyAffinity();
+    }
+    num_threads_ = num_threads;
+  }
+
+  // Pin the calling thread to cpu_ids[0] and the i-th worker to
+  // cpu_ids[i % cpu_ids.size()], an empty list means no pinning. The threads
+  // aren't rebound if the list is unchanged.
+  void SetAffinity(const std::vector<int>& cpu_ids) {
+    if (cpu_ids == cpu_ids_) return;
+    cpu_ids_ = cpu_ids;
+    ApplyAffinity();
+  }
+
+  static bool InParallel() { return InParallelFlag(); }
+
+  // Run f over [begin, end) in parallel, chunk_size is the hint of the
+  // minimum size of the sub-range passed to f, 0 means it's decided by the
+  // number of threads.
+  void ParallelFor(const int64_t begin,
+                   const int64_t end,
+                   const int64_t chunk_size,
+                   const ThreadHandler& f) {
+    const int64_t size = end - begin;
+    if (size <= 0) return;
+    int64_t chunk = chunk_size > 0
+                        ? chunk_size
+                        : (size + num_threads_ * kChunksPerThread - 1) /
+                              (num_threads_ * kChunksPerThread);
+    int64_t num_chunks = (size + chunk - 1) / chunk;
+    int num_participants =
+        static_cast<int>((std::min)(static_cast<int64_t>(num_threads_),
+                                    num_chunks));
+    // The nested parallel region is executed serially by the current thread,
+    // the same as the behavior of OpenMP.
+    if (num_participants <= 1 || InParallelFlag()) {
+      f(begin, end);
+      return;
+    }
+    std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+    if (!run_lock.owns_lock()) {
+      f(begin, end);
+      return;
+    }
+    for (int i = 0; i < num_participants; i++) {
+      slots_[i].head = num_chunks * i / num_participants;
+      slots_[i].tail = num_chunks * (i + 1) / num_participants;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_.begin = begin;
+      job_.end = end;
+      job_.chunk = chunk;
+      job_.num_participants = num_participants;
+      job_.func = &f;
+      active_workers_ = num_participants - 1;
+      ++generation_;
+    }
+    cond_.notify_all();
+    InParallelFlag() = true;
+    RunChunks(0);
+    InParallelFlag() = false;
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cond_.wait(lock, [this] { return active_workers_ == 0; });
+    job_.func = nullptr;
+  }
+
+ private:
+  struct Slot {
+    std::mutex mutex;
+    int64_t head{0};
+    int64_t tail{0};
+  };
+
+  struct Job {
+    int64_t begin{0};
+    int64_t end{0};
+    int64_t chunk{1};
+    int num_participants{0};
+    const ThreadHandler* func{nullptr};
+  };
+
+  static bool& InParallelFlag() {
+    static LITE_THREAD_LOCAL bool in_parallel = false;
+    return in_parallel;
+  }
+
+  // Take a chunk from the front of its own slot.
+  bool PopChunk(int idx, int64_t* chunk_idx) {
+    std::lock_guard<std::mutex> lock(slots_[idx].mutex);
+    if (slots_[idx].head >= slots_[idx].tail) return false;
+    *chunk_idx = slots_[idx].head++;
+    return true;
+  }
+
+  // Steal a chunk from the back of the other slot.
+  bool StealChunk(int idx, int64_t* chunk_idx) {
+    std::lock_guard<std::mutex> lock(slots_[idx].mutex);
+    if (slots_[idx].head >= slots_[idx].tail) return false;
+    *chunk_idx = --slots_[idx].tail;
+    return true;
+  }
+
+  void RunChunks(int idx) {
+    const int num_participants = job_.num_participants;
+    int64_t chunk_idx = 0;
+    while (true) {
+      bool found = PopChunk(idx, &chunk_idx);
+      for (int i = 1; !found && i < num_participants; i++) {
+        found = StealChunk((idx + i) % num_participants, &chunk_idx);
+      }
+      if (!found) break;
+      int64_t chunk_begin = job_.begin + chunk_idx * job_.chunk;
+      int64_t chunk_end = (std::min)(job_.end, chunk_begin + job_.chunk);
+      (*job_.func)(chunk_begin, chunk_end);
+    }
+  }
+
+  void WorkerLoop(int idx, int64_t generation) {
+    InParallelFlag() = true;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock,
+                   [&] { return stop_ || generation != generation_; });
+        if (stop_) return;
+        generation = generation_;
+        if (idx >= job_.num_participants) continue;
+      }
+      RunChunks(idx);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --active_workers_;
+      }
+      done_cond_.notify_one();
+    }
+  }
+
+  void StopWorkers() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+    workers_.clear();
+    stop_ = false;
+    num_threads_ = 1;
+  }
+
+  void ApplyAffinity() {
+    if (cpu_ids_.empty()) return;
+#if defined(__linux__) && !defined(__ANDROID__)
+    auto set_affinity = [&](pthread_t thread, int idx) {
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      CPU_SET(cpu_ids_[idx % cpu_ids_.size()], &mask);
+      if (pthread_setaffinity_np(thread, sizeof(mask), &mask) != 0) {
+        LOG(WARNING) << "Failed to bind the x86 math thread " << idx
+                     << " to CPU " << cpu_ids_[idx % cpu_ids_.size()];
+      }
+    };
+    set_affinity(pthread_self(), 0);
+    for (size_t i = 0; i < workers_.size(); i++) {
+      set_affinity(workers_[i].native_handle(), i + 1);
+    }
+#else
+    LOG(WARNING) << "Binding the x86 math threads to CPUs is not supported on "
+                    "the current platform.";
+#endif
+  }
+
+  int num_threads_{1};
+  std::vector<int> cpu_ids_;
+  std::vector<std::thread> workers_;
+  std::unique_ptr<Slot[]> slots_;
+  Job job_;
+  int64_t generation_{0};
+  int active_workers_{0};
+  bool stop_{false};
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::condition_variable done_cond_;
+};
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,97 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>  // NOLINT
+#include <set>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+TEST(thread_pool, parallel_for) {
+  ThreadPool pool;
+  pool.SetNumThreads(4);
+  EXPECT_EQ(pool.num_threads(), 4);
+  for (int64_t chunk_size : {0, 1, 3, 64, 2000}) {
+    std::vector<int> counts(1000, 0);
+    pool.ParallelFor(7, 1000, chunk_size, [&](int64_t begin, int64_t end) {
+      EXPECT_LT(begin, end);
+      if (chunk_size > 0) {
+        EXPECT_LE(end - begin, chunk_size);
+      }
+      for (int64_t i = begin; i < end; i++) {
+        counts[i]++;
+      }
+    });
+    for (int64_t i = 0; i < 1000; i++) {
+      EXPECT_EQ(counts[i], i < 7 ? 0 : 1);
+    }
+  }
+}
+
+// The workers are kept when the number of threads is lowered, and the jobs
+// still only run on the requested number of threads.
+TEST(thread_pool, lower_and_raise_num_threads) {
+  ThreadPool pool;
+  for (int num_threads : {4, 2, 1, 3, 4, 6}) {
+    pool.SetNumThreads(num_threads);
+    EXPECT_EQ(pool.num_threads(), num_threads);
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::vector<int> counts(1000, 0);
+    pool.ParallelFor(0, 1000, 1, [&](int64_t begin, int64_t end) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      }
+      for (int64_t i = begin; i < end; i++) {
+        counts[i]++;
+      }
+    });
+    EXPECT_LE(thread_ids.size(), static_cast<size_t>(num_threads));
+    for (int64_t i = 0; i < 1000; i++) {
+      EXPECT_EQ(counts[i], 1);
+    }
+  }
+}
+
+TEST(thread_pool, nested_and_concurrent) {
+  std::atomic<int64_t> total{0};
+  auto run = [&](int num_threads) {
+    auto& pool = ThreadPool::Local();
+    pool.SetNumThreads(num_threads);
+    for (int i = 0; i < 100; i++) {
+      pool.ParallelFor(0, 64, 0, [&](int64_t begin, int64_t end) {
+        // The nested region is executed serially.
+        pool.ParallelFor(begin, end, 0, [&](int64_t b, int64_t e) {
+          total += e - b;
+        });
+      });
+    }
+  };
+  std::thread t0(run, 2);
+  std::thread t1(run, 3);
+  t0.join();
+  t1.join();
+  EXPECT_EQ(total.load(), 2 * 100 * 64);
+}
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
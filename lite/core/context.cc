@@ -27,6 +27,10 @@ LITE_THREAD_LOCAL int
         0};  // NOLINT
 #endif
 
+#ifdef LITE_WITH_X86
+LITE_THREAD_LOCAL TensorLite Context<TargetType::kX86>::workspace_;
+#endif
+
 #ifdef LITE_WITH_MLU
 int Context<TargetType::kMLU>::next_queue_id_{0};
 std::map<int, int> Context<TargetType::kMLU>::queue_id_map_;
@@ -576,11 +576,28 @@ class Context<TargetType::kX86> {
   SSEType sse_level() { return device_sse_level(); }
   AVXType avx_level() { return device_avx_level(); }
   FMAType fma_level() { return device_fma_level(); }
+  bool has_avx512_bf16() { return device_has_avx512_bf16(); }
+
+  template <typename T>
+  T* workspace_data() {
+    return reinterpret_cast<T*>(workspace_.mutable_data<int8_t>());
+  }
+
+  // Extend the workspace to at least `size` bytes. The workspace is shared by
+  // all of the kernels running on the current thread and never shrinks, so
+  // the scratch memory is not allocated in Run once the shapes are stable.
+  bool ExtendWorkspace(size_t size) {
+    if (static_cast<size_t>(workspace_.numel()) < size) {
+      workspace_.Resize({static_cast<int64_t>(size)});
+    }
+    return workspace_.mutable_data<int8_t>() != nullptr;
+  }
 
  private:
   // overall information
   //
   // kernel information
+  static LITE_THREAD_LOCAL TensorLite workspace_;
 };
 #endif
 
@@ -14,6 +14,7 @@
 
 #include "lite/core/context.h"
 #include <gtest/gtest.h>
+#include <thread>  // NOLINT
 
 namespace paddle {
 namespace lite {
@@ -47,5 +48,50 @@ namespace lite {
 // }
 // #endif
 
+#ifdef LITE_WITH_X86
+TEST(X86Context, ExtendWorkspace) {
+  auto ctx1_p = ContextScheduler::Global().NewContext(TargetType::kX86);
+  auto ctx2_p = ContextScheduler::Global().NewContext(TargetType::kX86);
+  auto& ctx1 = ctx1_p->As<X86Context>();
+  auto& ctx2 = ctx2_p->As<X86Context>();
+
+  ASSERT_TRUE(ctx1.ExtendWorkspace(256));
+  auto* data = ctx1.workspace_data<int8_t>();
+  ASSERT_TRUE(data != nullptr);
+  data[255] = 1;
+
+  // The kernels running on the same thread share the workspace, a smaller
+  // size neither reallocates nor shrinks it.
+  ASSERT_TRUE(ctx2.ExtendWorkspace(64));
+  EXPECT_EQ(ctx2.workspace_data<int8_t>(), data);
+  ASSERT_TRUE(ctx1.ExtendWorkspace(256));
+  EXPECT_EQ(ctx1.workspace_data<int8_t>(), data);
+  EXPECT_EQ(data[255], 1);
+
+  // A larger size grows the workspace for all of the kernels.
+  const size_t large_size = 1 << 20;
+  ASSERT_TRUE(ctx2.ExtendWorkspace(large_size));
+  auto* large_data = ctx2.workspace_data<int8_t>();
+  large_data[large_size - 1] = 2;
+  EXPECT_EQ(ctx1.workspace_data<int8_t>(), large_data);
+  ASSERT_TRUE(ctx1.ExtendWorkspace(256));
+  EXPECT_EQ(ctx1.workspace_data<int8_t>(), large_data);
+  EXPECT_EQ(large_data[large_size - 1], 2);
+
+  // The other threads have their own workspaces.
+  int8_t* thread_data = nullptr;
+  std::thread thread([&]() {
+    auto ctx_p = ContextScheduler::Global().NewContext(TargetType::kX86);
+    auto& ctx = ctx_p->As<X86Context>();
+    ASSERT_TRUE(ctx.ExtendWorkspace(256));
+    thread_data = ctx.workspace_data<int8_t>();
+  });
+  thread.join();
+  EXPECT_TRUE(thread_data != nullptr);
+  EXPECT_NE(thread_data, large_data);
+  EXPECT_EQ(ctx1.workspace_data<int8_t>(), large_data);
+}
+#endif
+
 }  // namespace lite
 }  // namespace paddle
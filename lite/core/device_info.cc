@@ -1393,6 +1393,43 @@ bool feature_detect_vnni() {
   return (eax & 6) == 6;
 }
 
+bool feature_detect_avx512_bf16() {
+  uint32_t eax, ebx, ecx, edx;
+
+// check cpu support
+#if defined(_WIN32)
+  int cpuInfo[4];
+  __cpuidex(cpuInfo, 7, 0);
+  ebx = cpuInfo[1];
+  __cpuidex(cpuInfo, 7, 1);
+  eax = cpuInfo[0];
+#else
+  asm volatile("cpuid\n"
+               : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+               : "a"(7), "c"(0)
+               : "cc");
+  uint32_t ebx_leaf7 = ebx;
+  asm volatile("cpuid\n"
+               : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+               : "a"(7), "c"(1)
+               : "cc");
+  ebx = ebx_leaf7;
+#endif
+  // avx512f    ---> 16 ebx of the sub-leaf 0
+  // avx512vl   ---> 31 ebx of the sub-leaf 0
+  // avx512bf16 ---> 5 eax of the sub-leaf 1
+  if (!(bit(ebx, 16) && bit(ebx, 31) && bit(eax, 5))) return false;
+
+// check os support zmm, ymm and xmm, and the opmask
+#if defined(_WIN32)
+  eax = _xgetbv(0);
+#else
+  asm volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+#endif
+
+  return (eax & 0xe6) == 0xe6;
+}
+
 bool feature_detect_avx_fma(int ftr) {
   // see Detecting Availability and Support in
   // https://software.intel.com/en-us/articles/introduction-to-intel-advanced-vector-extensions
@@ -1439,6 +1476,15 @@ AVXType device_avx_level() {
     return AVXType::AVX_NONE;
 }
 
+bool device_has_avx512_bf16() {
+#ifdef LITE_WITH_AVX
+  static const bool has_avx512_bf16 = feature_detect_avx512_bf16();
+  return has_avx512_bf16;
+#else
+  return false;
+#endif
+}
+
 FMAType device_fma_level() {
 #ifdef LITE_WITH_AVX
   if (feature_detect_avx_fma(12))
@@ -1448,6 +1494,34 @@ FMAType device_fma_level() {
     return FMAType::FMA_NONE;
 }
 
+std::string device_cpu_model() {
+  // The brand string is returned by the leaves 0x80000002 ~ 0x80000004.
+  uint32_t regs[12] = {0};
+  for (uint32_t i = 0; i < 3; i++) {
+    uint32_t* r = regs + i * 4;
+#if defined(_WIN32)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0x80000002 + i);
+    for (int j = 0; j < 4; j++) {
+      r[j] = cpuInfo[j];
+    }
+#else
+    asm volatile("cpuid\n"
+                 : "=a"(r[0]), "=b"(r[1]), "=c"(r[2]), "=d"(r[3])
+                 : "a"(0x80000002 + i), "c"(0)
+                 : "cc");
+#endif
+  }
+  std::string model(reinterpret_cast<const char*>(regs), sizeof(regs));
+  model = model.substr(0, model.find('\0'));
+  // Trim the leading and trailing spaces of the brand string.
+  size_t begin = model.find_first_not_of(' ');
+  if (begin == std::string::npos) {
+    return "unknown";
+  }
+  return model.substr(begin, model.find_last_not_of(' ') - begin + 1);
+}
+
 #endif
 
 }  // namespace lite
@@ -359,6 +359,10 @@ enum class FMAType { FMA_NONE, ISA_FMA };
 SSEType device_sse_level();
 AVXType device_avx_level();
 FMAType device_fma_level();
+// Whether the CPU and the OS support the AVX512-BF16 instructions.
+bool device_has_avx512_bf16();
+// The brand string of the CPU, e.g. "Intel(R) Xeon(R) Gold 6148 CPU @ 2.40GHz"
+std::string device_cpu_model();
 #endif
 
 }  // namespace lite
@@ -58,6 +58,14 @@ class KernelBase {
   /// Run the kernel. Before Run, both the param_ and context_ should be valid.
   virtual void Run() = 0;
 
+  /// Run the weight transform of `PrepareForRun` ahead of time, e.g. by opt,
+  /// it's invoked after `SetParam`. The transformed weights are stored to
+  /// `prepacked` and saved to the optimized model, and `PrepareForRun` adopts
+  /// them instead of transforming the weights again if their layout key is
+  /// the same. Returns the layout key, or an empty string if the kernel has no
+  /// weights to transform.
+  virtual std::string PrepackWeights(Tensor* prepacked) { return ""; }
+
 #ifdef LITE_WITH_METAL
   virtual void SaveOutput() {}
 #endif
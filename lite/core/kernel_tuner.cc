@@ -0,0 +1,179 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kernel_tuner.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include "lite/core/device_info.h"
+#include "lite/utils/cp_logging.h"
+#include "lite/utils/io.h"
+#include "lite/utils/timer.h"
+
+namespace paddle {
+namespace lite {
+
+KernelTuner& KernelTuner::Global() {
+  static auto* x = new KernelTuner;
+  return *x;
+}
+
+const std::string& KernelTuner::CpuModel() {
+  static const std::string model = [] {
+#ifdef LITE_WITH_X86
+    std::string name = device_cpu_model();
+#else
+    std::string name = "unknown";
+#endif
+    std::replace(name.begin(), name.end(), ' ', '_');
+    return name;
+  }();
+  return model;
+}
+
+void KernelTuner::Init(lite_api::CPUTuneMode mode,
+                       const std::string& tune_file,
+                       int repeats) {
+  if (mode == lite_api::CPU_TUNE_NONE) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The mode is shared by the predictors, so it's only raised, otherwise a
+  // predictor without tuning would turn it off for the earlier ones.
+  mode_ = std::max(mode_, mode);
+  repeats_ = std::max(repeats, 1);
+  if (tune_file != tune_file_) {
+    // The variants tuned for the previous file are written to it first.
+    SaveLocked();
+    tune_file_ = tune_file;
+    cache_.clear();
+    Load();
+  }
+}
+
+void KernelTuner::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SaveLocked();
+  mode_ = lite_api::CPU_TUNE_NONE;
+  repeats_ = 3;
+  tune_file_.clear();
+  cache_.clear();
+}
+
+std::string KernelTuner::Key(const std::string& signature) const {
+  return signature + "@" + CpuModel();
+}
+
+void KernelTuner::Load() {
+  if (tune_file_.empty() || !IsFileExists(tune_file_)) {
+    LOG(INFO) << "No x86 kernel tuning file: " << tune_file_;
+    return;
+  }
+  for (auto& line : ReadLines(tune_file_)) {
+    size_t pos = line.rfind(' ');
+    if (line.empty() || line[0] == '#' || pos == std::string::npos) {
+      continue;
+    }
+    cache_[line.substr(0, pos)] = line.substr(pos + 1);
+  }
+  LOG(INFO) << "Load " << cache_.size()
+            << " entries from the x86 kernel tuning file: " << tune_file_;
+}
+
+void KernelTuner::Save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SaveLocked();
+}
+
+void KernelTuner::SaveLocked() {
+  if (!dirty_ || tune_file_.empty()) {
+    return;
+  }
+  std::ofstream file(tune_file_);
+  if (!file.is_open()) {
+    LOG(WARNING) << "Failed to write the x86 kernel tuning file: "
+                 << tune_file_;
+    return;
+  }
+  for (auto& entry : cache_) {
+    file << entry.first << " " << entry.second << "\n";
+  }
+  dirty_ = false;
+  LOG(INFO) << "Save " << cache_.size()
+            << " entries to the x86 kernel tuning file: " << tune_file_;
+}
+
+bool KernelTuner::Lookup(const std::string& signature,
+                         std::string* variant) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(Key(signature));
+  if (it == cache_.end()) {
+    return false;
+  }
+  *variant = it->second;
+  return true;
+}
+
+void KernelTuner::Record(const std::string& signature,
+                         const std::string& variant) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& value = cache_[Key(signature)];
+  dirty_ = dirty_ || value != variant;
+  value = variant;
+}
+
+std::string KernelTuner::Tune(
+    const std::string& signature,
+    const std::vector<std::string>& candidates,
+    const std::vector<std::function<void()>>& variants,
+    const std::string& fallback) {
+  if (!enabled() || candidates.empty()) {
+    return fallback;
+  }
+  std::string variant;
+  if (Lookup(signature, &variant) &&
+      std::find(candidates.begin(), candidates.end(), variant) !=
+          candidates.end()) {
+    return variant;
+  }
+  if (candidates.size() == 1) {
+    return candidates[0];
+  }
+  if (mode_ != lite_api::CPU_TUNE_NORMAL) {
+    return fallback;
+  }
+  CHECK_EQ(candidates.size(), variants.size());
+  size_t best = 0;
+  uint64_t best_us = std::numeric_limits<uint64_t>::max();
+  for (size_t i = 0; i < variants.size(); i++) {
+    // The first run is not timed since it allocates the workspace.
+    variants[i]();
+    for (int r = 0; r < repeats_; r++) {
+      uint64_t start = Timer::GetCurrentUS();
+      variants[i]();
+      uint64_t elapsed = Timer::GetCurrentUS() - start;
+      if (elapsed < best_us) {
+        best_us = elapsed;
+        best = i;
+      }
+    }
+  }
+  VLOG(3) << "Tuned " << signature << ": " << candidates[best] << " "
+          << best_us << "us";
+  Record(signature, candidates[best]);
+  return candidates[best];
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,88 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * The tuning cache of the implementation variants of the CPU kernels.
+ *
+ * A kernel which has several ways to compute the same result (e.g. conv2d by
+ * im2col + gemm or by the direct depthwise routines) asks the tuner for the
+ * variant of its signature in PrepareForRun, where the actual shapes are
+ * known. The signature describes the op, its shapes and attributes, and the
+ * CPU model is appended to it, so a cache file can be shared by the machines.
+ * In CPU_TUNE_NORMAL mode, the variants missing in the cache are benchmarked
+ * on the actual inputs and the fastest one is recorded.
+ *
+ * The cache file has a line of "<signature>@<cpu model> <variant>" for every
+ * entry, it's loaded by Init and saved when the runtime program is released.
+ */
+class KernelTuner {
+ public:
+  static KernelTuner& Global();
+
+  // Called by every predictor. CPU_TUNE_NONE leaves the tuner as it is, and
+  // the mode is never lowered by a later predictor.
+  void Init(lite_api::CPUTuneMode mode,
+            const std::string& tune_file,
+            int repeats);
+  // Save the cache and turn off the tuning, e.g. between the unit tests.
+  void Reset();
+  lite_api::CPUTuneMode mode() const { return mode_; }
+  bool enabled() const { return mode_ != lite_api::CPU_TUNE_NONE; }
+
+  // Return the variant of the signature, it's the one in the cache, or the
+  // fastest of the candidates which is benchmarked by running variants[i] for
+  // candidates[i], or `fallback` if neither is available.
+  std::string Tune(const std::string& signature,
+                   const std::vector<std::string>& candidates,
+                   const std::vector<std::function<void()>>& variants,
+                   const std::string& fallback);
+
+  bool Lookup(const std::string& signature, std::string* variant) const;
+  void Record(const std::string& signature, const std::string& variant);
+
+  // Write the cache file if new variants have been recorded since the last
+  // save.
+  void Save();
+
+  // The CPU model of the keys without the spaces.
+  static const std::string& CpuModel();
+
+ private:
+  KernelTuner() = default;
+  std::string Key(const std::string& signature) const;
+  void Load();
+  void SaveLocked();
+
+  lite_api::CPUTuneMode mode_{lite_api::CPU_TUNE_NONE};
+  std::string tune_file_;
+  int repeats_{3};
+  bool dirty_{false};
+  std::map<std::string, std::string> cache_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,73 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kernel_tuner.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "lite/utils/timer.h"
+
+namespace paddle {
+namespace lite {
+
+TEST(KernelTuner, tune_and_reload) {
+  const std::string tune_file = "kernel_tuner_test_cache.txt";
+  std::remove(tune_file.c_str());
+  auto& tuner = KernelTuner::Global();
+  tuner.Init(lite_api::CPU_TUNE_NORMAL, tune_file, 2);
+
+  int slow_runs = 0;
+  int fast_runs = 0;
+  std::vector<std::function<void()>> variants{
+      [&] {
+        slow_runs++;
+        Timer::SleepInMs(5);
+      },
+      [&] { fast_runs++; }};
+  std::vector<std::string> candidates{"slow", "fast"};
+  EXPECT_EQ(tuner.Tune("op/a", candidates, variants, "slow"), "fast");
+  // A warm up run and 2 timed runs for each variant.
+  EXPECT_EQ(slow_runs, 3);
+  EXPECT_EQ(fast_runs, 3);
+
+  // The cached variant is reused without running the variants.
+  EXPECT_EQ(tuner.Tune("op/a", candidates, variants, "slow"), "fast");
+  EXPECT_EQ(fast_runs, 3);
+  // The cached variant which is not a candidate any more is ignored.
+  EXPECT_EQ(tuner.Tune("op/a", {"slow"}, {variants[0]}, "slow"), "slow");
+  tuner.Save();
+
+  // Reload the cache file, and the missing variants fall back in the cached
+  // mode.
+  tuner.Reset();
+  tuner.Init(lite_api::CPU_TUNE_CACHED, tune_file, 1);
+  std::string variant;
+  ASSERT_TRUE(tuner.Lookup("op/a", &variant));
+  EXPECT_EQ(variant, "fast");
+  EXPECT_EQ(tuner.Tune("op/b", candidates, variants, "slow"), "slow");
+  EXPECT_EQ(slow_runs, 3);
+
+  // A later predictor without tuning keeps the mode and the cache of the
+  // earlier ones.
+  tuner.Init(lite_api::CPU_TUNE_NONE, "", 1);
+  EXPECT_EQ(tuner.mode(), lite_api::CPU_TUNE_CACHED);
+  EXPECT_EQ(tuner.Tune("op/a", candidates, variants, "slow"), "fast");
+
+  tuner.Reset();
+  EXPECT_FALSE(tuner.enabled());
+  EXPECT_EQ(tuner.Tune("op/a", candidates, variants, "slow"), "slow");
+  std::remove(tune_file.c_str());
+}
+
+}  // namespace lite
+}  // namespace paddle
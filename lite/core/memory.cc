@@ -22,6 +22,13 @@
 namespace paddle {
 namespace lite {
 
+static size_t& MallocBytesOfThread() {
+  static LITE_THREAD_LOCAL size_t malloc_bytes = 0;
+  return malloc_bytes;
+}
+
+size_t TargetMallocBytes() { return MallocBytesOfThread(); }
+
 void* TargetMalloc(TargetType target, size_t size) {
   void* data{nullptr};
   switch (target) {
@@ -69,6 +76,7 @@ void* TargetMalloc(TargetType target, size_t size) {
     default:
       LOG(FATAL) << "Unknown supported target " << TargetToStr(target);
   }
+  MallocBytesOfThread() += size;
   return data;
 }
 
@@ -56,6 +56,10 @@ namespace lite {
 // the `switch` here.
 LITE_API void* TargetMalloc(TargetType target, size_t size);
 
+// The total bytes allocated by TargetMalloc on the calling thread, which is
+// used by the runtime profiler to measure the allocation of each op.
+LITE_API size_t TargetMallocBytes();
+
 // Free memory for a specific Target. All the targets should be an element in
 // the `switch` here.
 void LITE_API TargetFree(TargetType target,
@@ -215,6 +219,9 @@ class Buffer {
     data_ = nullptr;
     target_ = TargetType::kHost;
     space_ = 0;
+    // The buffer no longer refers to the external data, so it can own the
+    // data allocated later.
+    own_data_ = true;
   }
 
   void CopyDataFrom(const Buffer& other, size_t nbytes) {
@@ -13,6 +13,12 @@
 // limitations under the License.
 
 #include "lite/core/model/base/io.h"
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace paddle {
 namespace lite {
@@ -63,6 +69,48 @@ void BinaryFileWriter::Write(const void* src, size_t size) const {
   cur_ += size;
 }
 
+#if !defined(_WIN32)
+MmapFileReader::MmapFileReader(const std::string& path, size_t offset) {
+  int fd = open(path.c_str(), O_RDONLY);
+  CHECK_NE(fd, -1) << "Unable to open file: " << path;
+  struct stat file_stat;
+  CHECK_EQ(fstat(fd, &file_stat), 0) << "Unable to stat file: " << path;
+  const size_t file_size = static_cast<size_t>(file_stat.st_size);
+  CHECK_LE(offset, file_size) << "The offset is out of range of " << path;
+  // The private writable mapping allows the kernels to modify the aliased
+  // params in place, the modified pages are copied on write and never
+  // written back to the file.
+  void* addr = nullptr;
+  if (file_size > 0) {
+    addr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  CHECK(addr != MAP_FAILED) << "Unable to map file: " << path;
+  mapping_.reset(static_cast<char*>(addr), [file_size](char* data) {
+    if (data) {
+      munmap(data, file_size);
+    }
+  });
+  buf_ = mapping_.get() + offset;
+  length_ = file_size - offset;
+}
+
+void MmapFileReader::Read(void* dst, size_t size) const {
+  CHECK(dst);
+  CHECK_LE(cur_ + size, length_) << "Failed to read " << size << " bytes.";
+  lite::TargetCopy(TargetType::kHost, dst, buf_ + cur_, size);
+  cur_ += size;
+}
+
+std::shared_ptr<const void> MmapFileReader::ReadInPlace(size_t size) const {
+  CHECK_LE(cur_ + size, length_) << "Failed to read " << size << " bytes.";
+  // Share the ownership of the mapping and point to the current position.
+  std::shared_ptr<const void> data(mapping_, buf_ + cur_);
+  cur_ += size;
+  return data;
+}
+#endif
+
 void StringBufferReader::Read(void* dst, size_t size) const {
   CHECK(dst);
   lite::TargetCopy(TargetType::kHost, dst, buf_ + cur_, size);
@@ -84,6 +84,14 @@ class ByteReader {
   virtual size_t current() const = 0;
   virtual bool ReachEnd() const = 0;
 
+  // Return the address of the next `size` bytes and skip them without copying
+  // if the reader is backed by a memory mapping, the returned pointer also
+  // keeps the mapping alive. Otherwise, nullptr is returned and nothing is
+  // consumed.
+  virtual std::shared_ptr<const void> ReadInPlace(size_t size) const {
+    return nullptr;
+  }
+
   template <typename T,
             typename = typename std::enable_if<
                 std::is_trivially_copyable<T>::value>::type>
@@ -119,6 +127,8 @@ class ByteWriter {
 
   virtual size_t Align(size_t bytes_size) const = 0;
 
+  virtual size_t current() const = 0;
+
   virtual ~ByteWriter() = default;
 
  private:
@@ -168,6 +178,8 @@ class BinaryFileWriter : public ByteWriter {
     return padding_bytes;
   }
 
+  size_t current() const override { return cur_; }
+
  private:
   FILE* file_{};
   mutable size_t cur_{0};
@@ -179,6 +191,28 @@ class BinaryFileWriter : public ByteWriter {
   }
 };
 
+#if !defined(_WIN32)
+// MmapFileReader maps the whole file into memory with copy-on-write pages,
+// the pages are loaded lazily and the untouched ones are shared by all the
+// processes which map the same file.
+class MmapFileReader : public ByteReader {
+ public:
+  explicit MmapFileReader(const std::string& path, size_t offset = 0);
+  ~MmapFileReader() = default;
+  void Read(void* dst, size_t size) const override;
+  std::shared_ptr<const void> ReadInPlace(size_t size) const override;
+  bool ReachEnd() const override { return cur_ >= length_; }
+  size_t length() const override { return length_; }
+  size_t current() const override { return cur_; }
+
+ private:
+  std::shared_ptr<char> mapping_;
+  const char* buf_{nullptr};
+  size_t length_{0};
+  mutable size_t cur_{0};
+};
+#endif
+
 class StringBufferReader : public ByteReader {
  public:
   explicit StringBufferReader(const std::string& buffer)
@@ -56,6 +56,7 @@ enum class VarDataType {
   SIZE_T,
   UINT8,
   INT8,
+  BF16,
 
   // Other types that may need additional descriptions
   LOD_TENSOR,
@@ -87,6 +88,7 @@ inline VarDataType ConvertPrecisionType(lite_api::PrecisionType type) {
     CASE(Int32, INT32);
     CASE(Int64, INT64);
     CASE(FP16, FP16);
+    CASE(BF16, BF16);
     CASE(Float, FP32);
     default:
       LOG(FATAL) << "Illegal flatbuffer VarType." << static_cast<int>(type);
@@ -108,6 +110,7 @@ inline lite_api::PrecisionType ConvertPrecisionType(VarDataType type) {
     CASE(Int32, INT32);
     CASE(Int64, INT64);
     CASE(FP16, FP16);
+    CASE(BF16, BF16);
     CASE(Float, FP32);
     default:
       LOG(FATAL) << "Illegal flatbuffer VarType: " << static_cast<int>(type);
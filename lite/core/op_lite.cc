@@ -187,6 +187,21 @@ void OpLite::AttachOutput(const cpp::OpDesc &op_desc,
   }
 }
 
+void OpLite::AttachPrepackedWeight(const cpp::OpDesc &op_desc,
+                                   lite::Scope *scope,
+                                   lite::Tensor **prepacked_weight,
+                                   std::string *prepacked_weight_key) {
+  *prepacked_weight = nullptr;
+  prepacked_weight_key->clear();
+  AttachInput(op_desc, scope, kPrepackedWeightInput, true, prepacked_weight);
+  if (*prepacked_weight != nullptr) {
+    CHECK(op_desc.HasAttr(kPrepackedWeightKeyAttr))
+        << "The layout key of the prepacked weights is not found";
+    *prepacked_weight_key =
+        op_desc.GetAttr<std::string>(kPrepackedWeightKeyAttr);
+  }
+}
+
 bool OpInfo::GetInputArgname(const std::string &value_name,
                              std::string *out) const {
   for (auto &item : inputs()) {
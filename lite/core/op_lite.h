@@ -42,6 +42,11 @@ class SSAGraph;
 
 class OpInfo;
 
+// The optional input of the weights transformed ahead of time and the attr of
+// the key of their layout, see KernelBase::PrepackWeights.
+static const char kPrepackedWeightInput[] = "PrepackedWeight";
+static const char kPrepackedWeightKeyAttr[] = "prepacked_weight_key";
+
 /**
  * The base class of an light-weight operators, currently just used in inference
  * to eliminate overhead of some operations in current framework.
@@ -134,6 +139,12 @@ class OpLite : public Registry {
                     bool is_dispensable,
                     lite::Tensor **output_var);
 
+  // Attach the optional prepacked weights and their layout key by op_desc
+  void AttachPrepackedWeight(const cpp::OpDesc &op_desc,
+                             lite::Scope *scope,
+                             lite::Tensor **prepacked_weight,
+                             std::string *prepacked_weight_key);
+
   virtual ~OpLite() = default;
 
  protected:
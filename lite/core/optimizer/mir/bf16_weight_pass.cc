@@ -0,0 +1,114 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/bf16_weight_pass.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::map<std::string, std::string> Bf16WeightPass::bf16_weight_ops = {
+    {"fc", "W"},
+    {"matmul", "Y"},
+    {"conv2d", "Filter"},
+    {"lookup_table", "W"},
+    {"lookup_table_v2", "W"},
+    {"fused_embedding_seq_pool", "W"}};
+
+static bool IsBf16Consumer(Node* node, const std::string& weight_name) {
+  auto& stmt = node->AsStmt();
+  auto* op_info = stmt.op_info();
+  auto iter = Bf16WeightPass::bf16_weight_ops.find(op_info->Type());
+  if (iter == Bf16WeightPass::bf16_weight_ops.end() ||
+      !op_info->HasInput(iter->second) ||
+      op_info->Input(iter->second) != std::vector<std::string>{weight_name}) {
+    return false;
+  }
+  // Only the x86 fp32 kernels of NCHW read the bf16 weights, the others, e.g.
+  // the NCHW8c conv2d, read the weights as fp32.
+  for (auto& kernel : stmt.kernels()) {
+    if (kernel->target() != TARGET(kX86) ||
+        kernel->precision() != PRECISION(kFloat) ||
+        kernel->layout() != DATALAYOUT(kNCHW)) {
+      return false;
+    }
+  }
+  return !stmt.kernels().empty();
+}
+
+// The expected rank of the weight of the consumer, which is skipped if it
+// doesn't match, e.g. the N-D Y of matmul.
+static size_t WeightRank(Node* node) {
+  const std::string& op_type = node->AsStmt().op_info()->Type();
+  return op_type == "conv2d" ? 4 : 2;
+}
+
+static void ConvertToBF16(const Tensor& src, Tensor* dst) {
+  const float* src_data = src.data<float>();
+  dst->Resize(src.dims());
+  bfloat16* dst_data = dst->mutable_data<bfloat16>();
+  for (int64_t i = 0; i < src.numel(); i++) {
+    dst_data[i] = bfloat16(src_data[i]);
+  }
+  dst->set_precision(PRECISION(kBF16));
+}
+
+void Bf16WeightPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  std::vector<Node*> weights;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg() || !node.arg()->is_weight || node.outlinks.empty()) {
+      continue;
+    }
+    const std::string& name = node.arg()->name;
+    bool convertible = true;
+    for (auto* op_node : node.outlinks) {
+      convertible = convertible && IsBf16Consumer(op_node, name);
+    }
+    if (convertible) {
+      weights.push_back(&node);
+    }
+  }
+
+  for (auto* weight_node : weights) {
+    const std::string weight_name = weight_node->arg()->name;
+    auto* first_op = weight_node->outlinks.front();
+    auto* scope = first_op->stmt()->op()->scope();
+    auto* weight = scope->FindMutableTensor(weight_name);
+    CHECK(weight) << "Can not find the weight " << weight_name << " in scope.";
+    if (weight->precision() != PRECISION(kFloat) ||
+        weight->dims().size() != WeightRank(first_op)) {
+      VLOG(4) << "The weight " << weight_name << " is not a fp32 tensor of "
+              << "the expected rank, so skip converting it to bf16.";
+      continue;
+    }
+    Tensor fp32_weight;
+    fp32_weight.CopyDataFrom(*weight);
+    weight->clear();
+    ConvertToBF16(fp32_weight, weight);
+    VLOG(4) << "Convert the weight " << weight_name << " to bf16.";
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(bf16_weight_pass, paddle::lite::mir::Bf16WeightPass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,45 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Convert the fp32 weights of the ops run by the x86 fp32 kernels of NCHW to
+ * bf16, the kernels keep the weights in bf16 and compute with the fp32
+ * accumulation, which halves the memory and the bandwidth of the weights:
+ *   fc: W
+ *   matmul: the persistable 2-D Y
+ *   conv2d: Filter
+ *   lookup_table, lookup_table_v2, fused_embedding_seq_pool: W
+ * A weight is converted only if all of its consumers are such ops.
+ */
+class Bf16WeightPass : public ProgramPass {
+ public:
+  // The ops and the names of their inputs which can be bf16.
+  static const std::map<std::string, std::string> bf16_weight_ops;
+
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,102 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/bf16_weight_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// x -> conv2d(filter) -> out, where the filter is [16, 8, 3, 3] of fp32.
+static std::shared_ptr<Scope> ApplyPassToConv(
+    const std::vector<Place>& valid_places) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  block_desc->ClearOps();
+  block_desc->ClearVars();
+  for (auto name : {"x", "filter", "out"}) {
+    auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+    var_desc->SetDataType(VarDescAPI::Type::FP32);
+    var_desc->SetPersistable(std::string(name) == "filter");
+  }
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("conv2d");
+  op_desc->SetInput("Input", {"x"});
+  op_desc->SetInput("Filter", {"filter"});
+  op_desc->SetOutput("Output", {"out"});
+  op_desc->SetAttr<std::vector<int>>("strides", {1, 1});
+  op_desc->SetAttr<std::vector<int>>("paddings", {1, 1});
+  op_desc->SetAttr<std::vector<int>>("dilations", {1, 1});
+  op_desc->SetAttr<int>("groups", 1);
+
+  auto scope = std::make_shared<Scope>();
+  auto* filter = scope->Var("filter")->GetMutable<Tensor>();
+  filter->Resize({16, 8, 3, 3});
+  auto* filter_data = filter->mutable_data<float>();
+  for (int64_t i = 0; i < filter->numel(); i++) {
+    filter_data[i] = (i % 7 - 3) * 0.25f;
+  }
+  filter->set_persistable(true);
+  Program program(program_desc, scope, valid_places);
+  std::unique_ptr<SSAGraph> graph(new SSAGraph);
+  graph->Build(program, valid_places);
+  auto* pass = PassManager::Global().LookUp<Bf16WeightPass>("bf16_weight_pass");
+  CHECK(pass);
+  pass->Apply(graph);
+  return scope;
+}
+
+TEST(bf16_weight_pass, convert_conv_filter) {
+  auto scope = ApplyPassToConv({Place{TARGET(kX86), PRECISION(kFloat)}});
+  const auto* filter = scope->FindTensor("filter");
+  ASSERT_EQ(filter->precision(), PRECISION(kBF16));
+  ASSERT_EQ(filter->dims(), DDim({16, 8, 3, 3}));
+  for (int64_t i = 0; i < filter->numel(); i++) {
+    EXPECT_EQ(static_cast<float>(filter->data<bfloat16>()[i]),
+              (i % 7 - 3) * 0.25f);
+  }
+}
+
+// The NCHW8c conv2d reads the filter as fp32, so the filter isn't converted.
+TEST(bf16_weight_pass, skip_conv_filter_of_nchw8c) {
+  auto scope = ApplyPassToConv(
+      {Place{TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW8c)},
+       Place{TARGET(kX86), PRECISION(kFloat)}});
+  const auto* filter = scope->FindTensor("filter");
+  ASSERT_EQ(filter->precision(), PRECISION(kFloat));
+  for (int64_t i = 0; i < filter->numel(); i++) {
+    EXPECT_EQ(filter->data<float>()[i], (i % 7 - 3) * 0.25f);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(conv2d);
+USE_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW8c, def);
+USE_MIR_PASS(bf16_weight_pass);
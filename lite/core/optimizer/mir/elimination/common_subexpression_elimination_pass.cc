@@ -0,0 +1,252 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/elimination/common_subexpression_elimination_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pass_utils.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::set<std::string>
+    CommonSubexpressionEliminationPass::unmergeable_ops_ = {
+        "feed",
+        "fetch",
+        "while",
+        "conditional_block",
+        "subgraph",
+        "print",
+        "write_back",
+        "write_to_array",
+        "increment",
+        "uniform_random",
+        "gaussian_random",
+        "truncated_gaussian_random",
+        "randint",
+        "randperm",
+        "sampling_id",
+        "bernoulli",
+        "multinomial",
+        "random_crop",
+        "dropout"};
+
+// The attrs which don't affect the computation.
+static const std::set<std::string> kIgnoredAttrs = {"op_callstack",
+                                                    "op_namescope",
+                                                    "op_role",
+                                                    "op_role_var",
+                                                    "op_device"};
+
+template <typename T>
+static void AppendValue(std::string* key, const T& value) {
+  key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void AppendValue(std::string* key, const std::string& value) {
+  AppendValue(key, value.size());
+  key->append(value);
+}
+
+template <typename T>
+static void AppendValue(std::string* key, const std::vector<T>& values) {
+  AppendValue(key, values.size());
+  for (auto& value : values) {
+    AppendValue(key, value);
+  }
+}
+
+// Serialize the attr into the key, false is returned if the type of the attr
+// isn't supported.
+static bool AppendAttr(std::string* key,
+                       const OpInfo& op_info,
+                       const std::string& attr_name,
+                       OpAttrType attr_type) {
+  AppendValue(key, attr_name);
+  AppendValue(key, static_cast<int>(attr_type));
+  switch (attr_type) {
+#define APPEND_ATTR(type__, T)                       \
+  case OpAttrType::type__:                           \
+    AppendValue(key, op_info.GetAttr<T>(attr_name)); \
+    return true;
+    APPEND_ATTR(INT, int32_t)
+    APPEND_ATTR(FLOAT, float)
+    APPEND_ATTR(STRING, std::string)
+    APPEND_ATTR(INTS, std::vector<int32_t>)
+    APPEND_ATTR(FLOATS, std::vector<float>)
+    APPEND_ATTR(STRINGS, std::vector<std::string>)
+    APPEND_ATTR(BOOLEAN, bool)
+    APPEND_ATTR(LONG, int64_t)
+    APPEND_ATTR(LONGS, std::vector<int64_t>)
+#undef APPEND_ATTR
+    default:
+      return false;
+  }
+}
+
+// The key is made of the op type, the attrs, the input nodes and the output
+// args, the ops with the same key compute the same values. An empty key is
+// returned if the op can't be compared, e.g. it has a sub-block.
+std::string CommonSubexpressionEliminationPass::GenOpKey(Node* op_node) const {
+  const auto* op_info = op_node->AsStmt().op_info();
+  std::string key;
+  AppendValue(&key, op_info->Type());
+  for (auto& attr : op_info->attr_types()) {
+    if (kIgnoredAttrs.count(attr.first)) continue;
+    if (!AppendAttr(&key, *op_info, attr.first, attr.second)) {
+      return "";
+    }
+  }
+  std::map<std::string, Node*> in_nodes;
+  for (auto* in : op_node->inlinks) {
+    in_nodes[in->arg()->name] = in;
+  }
+  for (auto& arg_name : op_info->input_argnames()) {
+    AppendValue(&key, arg_name);
+    auto var_names = op_info->Input(arg_name);
+    AppendValue(&key, var_names.size());
+    for (auto& var_name : var_names) {
+      auto it = in_nodes.find(var_name);
+      if (it == in_nodes.end()) return "";
+      AppendValue(&key, it->second);
+    }
+  }
+  for (auto& arg_name : op_info->output_argnames()) {
+    AppendValue(&key, arg_name);
+    AppendValue(&key, op_info->Output(arg_name).size());
+  }
+  return key;
+}
+
+bool CommonSubexpressionEliminationPass::IsMergeable(
+    Node* op_node,
+    const std::map<std::string, int>& arg_counts,
+    const std::set<std::string>& shared_var_names) const {
+  auto& stmt = op_node->AsStmt();
+  if (unmergeable_ops_.count(stmt.op_type()) || op_node->outlinks.empty()) {
+    return false;
+  }
+  // The outputs which are written by the other ops or read before written,
+  // e.g. the states of a loop, can't be shared by the consumers.
+  for (auto* out : op_node->outlinks) {
+    const auto& var_name = out->arg()->name;
+    if (out->arg()->is_weight || arg_counts.at(var_name) != 1 ||
+        shared_var_names.count(var_name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CommonSubexpressionEliminationPass::SetAllGraphs(
+    std::vector<std::unique_ptr<mir::SSAGraph>>* graphs) {
+  CHECK(graphs && !graphs->empty());
+  graphs_ = graphs;
+}
+
+void CommonSubexpressionEliminationPass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  CHECK(graphs_) << "The graphs should be set by SetAllGraphs().";
+  auto shared_var_names =
+      CollectVarNamesOfOtherBlocks(*graphs_, graph->blockIdx());
+  std::map<std::string, int> arg_counts;
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) {
+      arg_counts[node.arg()->name]++;
+    }
+  }
+  std::unordered_map<std::string, Node*> op_nodes;
+  int merged_count = 0;
+  for (auto* op_node : graph->StmtTopologicalOrder()) {
+    if (!IsMergeable(op_node, arg_counts, shared_var_names)) continue;
+    auto key = GenOpKey(op_node);
+    if (key.empty()) continue;
+    auto it = op_nodes.find(key);
+    if (it == op_nodes.end()) {
+      op_nodes[key] = op_node;
+      continue;
+    }
+    // The names of the outputs are kept for the feed, fetch and control flow
+    // ops, as they are referred by the predictor or the sub-blocks.
+    bool has_unmergeable_consumer = false;
+    for (auto* out : op_node->outlinks) {
+      for (auto* consumer : out->outlinks) {
+        has_unmergeable_consumer =
+            has_unmergeable_consumer ||
+            unmergeable_ops_.count(consumer->AsStmt().op_type());
+      }
+    }
+    if (has_unmergeable_consumer) continue;
+
+    auto* kept_node = it->second;
+    const auto* op_info = op_node->AsStmt().op_info();
+    const auto* kept_op_info = kept_node->AsStmt().op_info();
+    std::map<std::string, Node*> kept_out_nodes;
+    for (auto* out : kept_node->outlinks) {
+      kept_out_nodes[out->arg()->name] = out;
+    }
+    std::set<const Node*> nodes2rm{op_node};
+    for (auto* out : op_node->outlinks) {
+      nodes2rm.insert(out);
+    }
+    for (auto& arg_name : op_info->output_argnames()) {
+      auto var_names = op_info->Output(arg_name);
+      auto kept_var_names = kept_op_info->Output(arg_name);
+      for (size_t i = 0; i < var_names.size(); i++) {
+        auto* kept_out_node = kept_out_nodes.at(kept_var_names[i]);
+        Node* out_node = nullptr;
+        for (auto* out : op_node->outlinks) {
+          if (out->arg()->name == var_names[i]) out_node = out;
+        }
+        CHECK(out_node);
+        std::set<Node*> consumers(out_node->outlinks.begin(),
+                                  out_node->outlinks.end());
+        for (auto* consumer : consumers) {
+          auto new_op_info = *consumer->AsStmt().op_info();
+          new_op_info.UpdateAllInputs(var_names[i], kept_var_names[i]);
+          consumer->AsStmt().ResetOp(new_op_info, graph->valid_places());
+          // The consumer may read both of the duplicates, e.g. x + x.
+          if (std::find(kept_out_node->outlinks.begin(),
+                        kept_out_node->outlinks.end(),
+                        consumer) == kept_out_node->outlinks.end()) {
+            DirectedLink(kept_out_node, consumer);
+          }
+        }
+        VLOG(4) << "Merge " << var_names[i] << " into " << kept_var_names[i]
+                << " of " << op_info->Type();
+      }
+    }
+    GraphSafeRemoveNodes(graph.get(), nodes2rm);
+    merged_count++;
+  }
+  VLOG(3) << "Merged " << merged_count << " ops in the block "
+          << graph->blockIdx();
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(common_subexpression_elimination_pass,
+                  paddle::lite::mir::CommonSubexpressionEliminationPass)
+    .BindTargets({TARGET(kAny)});
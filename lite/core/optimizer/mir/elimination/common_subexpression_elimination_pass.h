@@ -0,0 +1,67 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Merge the ops which compute the same values, i.e. the ops of the same type
+ * with the same attrs and the same input nodes, e.g. the attention mask which
+ * is computed by every encoder layer:
+ *
+ *              mask                             mask
+ *            /      \                             |
+ *        scale      scale                       scale
+ *          |          |          ==>              |
+ *     unsqueeze2  unsqueeze2                  unsqueeze2
+ *          |          |                       /        \
+ *     layer 0     layer 1                layer 0     layer 1
+ *
+ * The consumers of the duplicated ops read the outputs of the first one, and
+ * the merged ops may make their consumers identical in turn. The ops with
+ * side effects, the random ops and the control flow ops are never merged, nor
+ * an op if any of its outputs is written by another op, is a weight or is
+ * referred by the other blocks.
+ */
+class CommonSubexpressionEliminationPass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+  void SetAllGraphs(std::vector<std::unique_ptr<mir::SSAGraph>>* graphs);
+
+ private:
+  bool IsMergeable(Node* op_node,
+                   const std::map<std::string, int>& arg_counts,
+                   const std::set<std::string>& shared_var_names) const;
+  std::string GenOpKey(Node* op_node) const;
+
+  std::vector<std::unique_ptr<mir::SSAGraph>>* graphs_{nullptr};
+  // The ops whose outputs may differ even if they have the same inputs, or
+  // which must run as many times as they are listed.
+  static const std::set<std::string> unmergeable_ops_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,179 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/common_subexpression_elimination_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+class CommonSubexpressionEliminationPassTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    program_desc_ = std::make_shared<cpp::ProgramDesc>();
+  }
+
+  cpp::BlockDesc* AddBlock(const std::vector<std::string>& var_names) {
+    auto* block_desc = program_desc_->AddBlock<cpp::BlockDesc>();
+    block_desc->ClearOps();
+    block_desc->ClearVars();
+    for (auto& var_name : var_names) {
+      auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+      var_desc->SetName(var_name);
+      var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+      var_desc->SetDataType(VarDescAPI::Type::FP32);
+      var_desc->SetPersistable(false);
+    }
+    return block_desc;
+  }
+
+  void AddOpDesc(cpp::BlockDesc* block_desc,
+                 const std::string& type,
+                 const std::map<std::string, std::string>& inputs,
+                 const std::string& out,
+                 float scale = 2.f) {
+    auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+    op_desc->SetType(type);
+    for (auto& input : inputs) {
+      op_desc->SetInput(input.first, {input.second});
+    }
+    op_desc->SetOutput("Out", {out});
+    if (type == "scale") {
+      op_desc->SetAttr<float>("scale", scale);
+      op_desc->SetAttr<float>("bias", 0.f);
+      op_desc->SetAttr<bool>("bias_after_scale", true);
+    } else if (type == "elementwise_add") {
+      op_desc->SetAttr<int>("axis", -1);
+    }
+  }
+
+  // Build the graphs of all of the blocks and apply the pass to the root
+  // block.
+  void ApplyPass() {
+    std::vector<Place> valid_places{{TARGET(kX86), PRECISION(kFloat)},
+                                    {TARGET(kHost), PRECISION(kAny)}};
+    scope_ = std::make_shared<Scope>();
+    program_.reset(new Program(program_desc_, scope_, valid_places));
+    for (size_t i = 0; i < program_desc_->BlocksSize(); i++) {
+      graphs_.emplace_back(new SSAGraph);
+      graphs_.back()->Build(*program_, valid_places, i);
+    }
+    auto* pass =
+        PassManager::Global().LookUp<CommonSubexpressionEliminationPass>(
+            "common_subexpression_elimination_pass");
+    ASSERT_TRUE(pass);
+    pass->SetAllGraphs(&graphs_);
+    pass->Apply(graphs_[kRootBlockIdx]);
+  }
+
+  // The ops of the root block, e.g. "scale(x)->a".
+  std::vector<std::string> Stmts() {
+    std::vector<std::string> stmts;
+    for (auto* op_node : graphs_[kRootBlockIdx]->StmtTopologicalOrder()) {
+      const auto* op_info = op_node->AsStmt().op_info();
+      std::string stmt = op_info->Type() + "(";
+      for (auto& var_name : op_info->input_names()) {
+        stmt += (stmt.back() == '(' ? "" : ",") + var_name;
+      }
+      stmts.push_back(stmt + ")->" + op_info->Output("Out").front());
+    }
+    return stmts;
+  }
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  std::shared_ptr<Scope> scope_;
+  std::unique_ptr<Program> program_;
+  std::vector<std::unique_ptr<SSAGraph>> graphs_;
+};
+
+// x -> scale -> a1 -> scale -> b1 --
+//                                   |-> elementwise_add -> out
+// x -> scale -> a2 -> scale -> b2 --
+TEST_F(CommonSubexpressionEliminationPassTest, merge_duplicate_chains) {
+  auto* block = AddBlock({"x", "a1", "a2", "b1", "b2", "c", "out"});
+  AddOpDesc(block, "scale", {{"X", "x"}}, "a1");
+  AddOpDesc(block, "scale", {{"X", "x"}}, "a2");
+  AddOpDesc(block, "scale", {{"X", "a1"}}, "b1", 3.f);
+  AddOpDesc(block, "scale", {{"X", "a2"}}, "b2", 3.f);
+  // The same input with the different attrs isn't merged.
+  AddOpDesc(block, "scale", {{"X", "a2"}}, "c", 4.f);
+  AddOpDesc(block, "elementwise_add", {{"X", "b1"}, {"Y", "b2"}}, "out");
+  ApplyPass();
+
+  auto stmts = Stmts();
+  std::sort(stmts.begin(), stmts.end());
+  EXPECT_EQ(stmts,
+            std::vector<std::string>({"elementwise_add(b1,b1)->out",
+                                      "scale(a1)->b1",
+                                      "scale(a1)->c",
+                                      "scale(x)->a1"}));
+  // The consumer reading both of the duplicates is linked to the kept output
+  // once.
+  for (auto& node : graphs_[kRootBlockIdx]->mutable_nodes()) {
+    if (node.IsStmt() && node.AsStmt().op_type() == "elementwise_add") {
+      ASSERT_EQ(node.inlinks.size(), 1u);
+      auto* b1 = node.inlinks.front();
+      EXPECT_EQ(b1->arg()->name, "b1");
+      EXPECT_EQ(std::count(b1->outlinks.begin(), b1->outlinks.end(), &node),
+                1);
+    }
+  }
+}
+
+TEST_F(CommonSubexpressionEliminationPassTest, skip_multiply_written_outputs) {
+  auto* block = AddBlock({"x", "y", "a1", "a2", "out"});
+  AddOpDesc(block, "scale", {{"X", "x"}}, "a1");
+  AddOpDesc(block, "scale", {{"X", "x"}}, "a2");
+  AddOpDesc(block, "assign", {{"X", "y"}}, "a2");
+  AddOpDesc(block, "elementwise_add", {{"X", "a1"}, {"Y", "a2"}}, "out");
+  ApplyPass();
+
+  EXPECT_EQ(Stmts().size(), 4u);
+}
+
+TEST_F(CommonSubexpressionEliminationPassTest, skip_shared_outputs) {
+  auto* block = AddBlock({"x", "a1", "a2", "out"});
+  AddOpDesc(block, "scale", {{"X", "x"}}, "a1");
+  AddOpDesc(block, "scale", {{"X", "x"}}, "a2");
+  AddOpDesc(block, "elementwise_add", {{"X", "a1"}, {"Y", "a2"}}, "out");
+  // a2 is read by the sub-block.
+  auto* sub_block = AddBlock({"b"});
+  AddOpDesc(sub_block, "scale", {{"X", "a2"}}, "b");
+  ApplyPass();
+
+  EXPECT_EQ(Stmts().size(), 3u);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(scale);
+USE_LITE_OP(assign);
+USE_LITE_OP(elementwise_add);
+USE_LITE_KERNEL(scale, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(assign, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(elementwise_add, kX86, kFloat, kNCHW, def);
+USE_MIR_PASS(common_subexpression_elimination_pass);
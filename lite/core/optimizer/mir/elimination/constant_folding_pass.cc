@@ -0,0 +1,297 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <string.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/context.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+#include "lite/core/type_system.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::set<std::string> ConstantFoldingPass::unfoldable_ops_ = {
+    "feed",
+    "fetch",
+    "while",
+    "conditional_block",
+    "select_input",
+    "subgraph",
+    "io_copy",
+    "io_copy_once",
+    "layout",
+    "layout_once",
+    "calib",
+    "calib_once",
+    "print",
+    "uniform_random",
+    "dropout",
+    "increment",
+    "write_back",
+    "read_from_array",
+    "write_to_array",
+    "tensor_array_to_tensor",
+    "lod_array_length",
+    "lod_reset",
+    "merge_lod_tensor",
+    "split_lod_tensor",
+    "beam_search",
+    "beam_search_decode",
+    "fake_quantize_abs_max",
+    "fake_quantize_range_abs_max",
+    "fake_quantize_moving_average_abs_max",
+    "fake_quantize_dequantize_abs_max",
+    "fake_quantize_dequantize_moving_average_abs_max",
+    "fake_dequantize_max_abs",
+    "fake_channel_wise_quantize_abs_max",
+    "fake_channel_wise_dequantize_max_abs",
+    "fake_channel_wise_quantize_dequantize_abs_max"};
+
+// The tensor of the arg node, nullptr is returned if the var isn't a tensor.
+static Tensor* GetArgTensor(Node* op_node, Node* arg_node) {
+  auto* var = op_node->AsStmt().op()->scope()->FindVar(arg_node->arg()->name);
+  if (var == nullptr || !var->IsType<Tensor>()) {
+    return nullptr;
+  }
+  return var->GetMutable<Tensor>();
+}
+
+bool ConstantFoldingPass::IsFoldable(
+    Node* op_node, const std::map<std::string, int>& write_counts) const {
+  auto& stmt = op_node->AsStmt();
+  if (unfoldable_ops_.count(stmt.op_type()) || op_node->outlinks.empty()) {
+    return false;
+  }
+  // The weights updated by the other ops are also skipped, e.g. the
+  // persistable states, as the folded op would miss the new values.
+  for (auto* in : op_node->inlinks) {
+    if (!in->IsArg() || !in->arg()->is_weight ||
+        write_counts.count(in->arg()->name)) {
+      return false;
+    }
+    auto* tensor = GetArgTensor(op_node, in);
+    if (tensor == nullptr || !tensor->IsInitialized()) {
+      return false;
+    }
+  }
+  // The output can't be folded if it's a weight or is written by the other
+  // ops, e.g. a loop counter updated in place, as the folded value must stay
+  // the same across the inferences.
+  for (auto* out : op_node->outlinks) {
+    if (!out->IsArg() || out->arg()->is_weight ||
+        write_counts.at(out->arg()->name) != 1 ||
+        GetArgTensor(op_node, out) == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy the tensor if it shares the buffer with any of the inputs, e.g. the
+// reshape of a weight, as the weights may be updated in place by the fusion
+// passes later.
+static void UnshareBuffer(Tensor* tensor,
+                          const std::vector<const Tensor*>& inputs) {
+  auto base = [](const Tensor* t) {
+    return static_cast<const char*>(t->raw_data()) - t->offset();
+  };
+  bool shared = false;
+  for (auto* input : inputs) {
+    shared = shared || base(input) == base(tensor);
+  }
+  if (!shared) return;
+  size_t size = tensor->numel() * PrecisionTypeLength(tensor->precision());
+  Tensor copied;
+  copied.Resize(tensor->dims());
+  auto* copied_data = copied.mutable_data(tensor->target(), size);
+  memcpy(copied_data, tensor->raw_data(), size);
+  copied.set_precision(tensor->precision());
+  copied.set_lod(tensor->lod());
+  tensor->ShareDataWith(copied);
+}
+
+// Whether the target is the CPU of the optimization stage, only the kernels
+// which are compiled in are real, the others are fake.
+static bool IsHostTarget(TargetType target) {
+  switch (target) {
+    case TARGET(kHost):
+    case TARGET(kAny):
+#ifdef LITE_WITH_X86
+    case TARGET(kX86):
+#endif
+#ifdef LITE_WITH_ARM
+    case TARGET(kARM):
+#endif
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::unique_ptr<KernelBase> ConstantFoldingPass::PickKernel(
+    Node* op_node) const {
+  const std::vector<TargetType> targets{
+#ifdef LITE_WITH_X86
+      TARGET(kX86),
+#endif
+#ifdef LITE_WITH_ARM
+      TARGET(kARM),
+#endif
+      TARGET(kHost)};
+  const std::vector<PrecisionType> precisions{PRECISION(kFloat),
+                                              PRECISION(kInt32),
+                                              PRECISION(kInt64),
+                                              PRECISION(kInt8),
+                                              PRECISION(kBool)};
+  std::vector<Place> places;
+  for (auto target : targets) {
+    for (auto precision : precisions) {
+      places.emplace_back(target, precision, DATALAYOUT(kNCHW));
+    }
+  }
+
+  auto& stmt = op_node->AsStmt();
+  const auto* op_info = stmt.op_info();
+  auto kernels = stmt.op()->CreateKernels(places);
+  for (auto& kernel : kernels) {
+    if (!IsHostTarget(kernel->target())) continue;
+    // All of the inputs and outputs should be the host tensors and the input
+    // precisions should match the weights.
+    auto is_matched = [&](const std::string& arg_name,
+                          const std::vector<std::string>& var_names,
+                          bool is_input) -> bool {
+      if (var_names.empty()) return true;
+      const auto* param_type =
+          is_input ? ParamTypeRegistry::Global().RetrieveInArgument(
+                         kernel->place(), kernel->GenParamTypeKey(), arg_name)
+                   : ParamTypeRegistry::Global().RetrieveOutArgument(
+                         kernel->place(), kernel->GenParamTypeKey(), arg_name);
+      if (param_type == nullptr) return false;
+      const Type* decl_type = param_type->type;
+      if (!decl_type->IsTensor() || !IsHostTarget(decl_type->target()) ||
+          (decl_type->layout() != DATALAYOUT(kNCHW) &&
+           decl_type->layout() != DATALAYOUT(kAny))) {
+        return false;
+      }
+      if (!is_input || decl_type->precision() == PRECISION(kAny)) {
+        return true;
+      }
+      for (auto& var_name : var_names) {
+        auto* var = stmt.op()->scope()->FindVar(var_name);
+        if (var->Get<Tensor>().precision() != decl_type->precision()) {
+          return false;
+        }
+      }
+      return true;
+    };
+    bool matched = true;
+    for (auto& arg_name : op_info->input_argnames()) {
+      matched = matched && is_matched(arg_name, op_info->Input(arg_name), true);
+    }
+    for (auto& arg_name : op_info->output_argnames()) {
+      matched =
+          matched && is_matched(arg_name, op_info->Output(arg_name), false);
+    }
+    if (matched) {
+      return std::move(kernel);
+    }
+  }
+  return nullptr;
+}
+
+bool ConstantFoldingPass::Fold(Node* op_node) const {
+  auto& stmt = op_node->AsStmt();
+  auto kernel = PickKernel(op_node);
+  if (!kernel) {
+    VLOG(4) << "No host kernel to fold " << stmt.op_type();
+    return false;
+  }
+  auto op = stmt.op();
+  if (!op->CheckShape() || !op->InferShape()) {
+    VLOG(4) << "Failed to infer the shape of " << stmt.op_type();
+    return false;
+  }
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  kernel->Launch();
+  std::vector<const Tensor*> inputs;
+  for (auto* in : op_node->inlinks) {
+    inputs.push_back(GetArgTensor(op_node, in));
+  }
+  for (auto* out : op_node->outlinks) {
+    auto* tensor = GetArgTensor(op_node, out);
+    UnshareBuffer(tensor, inputs);
+    tensor->set_persistable(true);
+    out->arg()->is_weight = true;
+    VLOG(4) << "Fold " << out->arg()->name << " of " << stmt.op_type()
+            << " with the dims " << tensor->dims().repr();
+  }
+  return true;
+}
+
+void ConstantFoldingPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+  VLOG(4) << "Skip constant_folding_pass as the kernels of the opt tool are "
+             "fake.";
+#else
+  std::map<std::string, int> write_counts;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt()) continue;
+    for (auto* out : node.outlinks) {
+      write_counts[out->arg()->name]++;
+    }
+  }
+  int folded_count = 0;
+  for (auto* op_node : graph->StmtTopologicalOrder()) {
+    if (!IsFoldable(op_node, write_counts) || !Fold(op_node)) {
+      continue;
+    }
+    // The outputs are the weights which are never written at runtime now.
+    for (auto* out : op_node->outlinks) {
+      write_counts.erase(out->arg()->name);
+    }
+    // Remove the folded op, the weights which are only used by it and the
+    // unused outputs, e.g. the XShape of reshape2.
+    std::set<const Node*> nodes2rm{op_node};
+    for (auto* in : op_node->inlinks) {
+      if (in->outlinks.size() == 1 && in->inlinks.empty()) {
+        nodes2rm.insert(in);
+      }
+    }
+    for (auto* out : op_node->outlinks) {
+      if (out->outlinks.empty()) {
+        nodes2rm.insert(out);
+      }
+    }
+    GraphSafeRemoveNodes(graph.get(), nodes2rm);
+    folded_count++;
+  }
+  VLOG(3) << "Folded " << folded_count << " ops in the block "
+          << graph->blockIdx();
+#endif
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(constant_folding_pass, paddle::lite::mir::ConstantFoldingPass)
+    .BindTargets({TARGET(kAny)});
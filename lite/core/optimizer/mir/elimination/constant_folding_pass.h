@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Run the ops whose inputs are all weights once at the optimization stage,
+ * e.g. the transpose of a weight, the scale of a weight, the reshape of a
+ * constant and the fill_constant, assign_value, shape, range or linspace with
+ * the constant args, and replace their outputs with the new persistable
+ * weights. The folded ops and the weights only used by them are removed, and
+ * the ops consuming the outputs of the folded ops may be folded in turn:
+ *
+ *     x         weight
+ *     |           |
+ *     |       transpose2                 x    folded weight
+ *     |           |                      |          |
+ *     |         scale         ==>        ---matmul---
+ *     |           |                           |
+ *     ---matmul---                            v
+ *          |
+ *          v
+ *
+ * The ops are run with the CPU kernels, i.e. the host, x86 and arm kernels
+ * which are compiled in, and the pass does nothing in the opt tool whose
+ * kernels are fake. The ops with side effects, the random ops and the control
+ * flow ops are never folded, nor an op if any of its outputs is written by
+ * another op.
+ */
+class ConstantFoldingPass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool IsFoldable(Node* op_node,
+                  const std::map<std::string, int>& write_counts) const;
+  std::unique_ptr<KernelBase> PickKernel(Node* op_node) const;
+  bool Fold(Node* op_node) const;
+
+  // The ops which must run at every inference.
+  static const std::set<std::string> unfoldable_ops_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
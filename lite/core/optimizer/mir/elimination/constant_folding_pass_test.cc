@@ -0,0 +1,237 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+class ConstantFoldingPassTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    program_desc_ = std::make_shared<cpp::ProgramDesc>();
+    block_desc_ = program_desc_->AddBlock<cpp::BlockDesc>();
+    block_desc_->ClearOps();
+    block_desc_->ClearVars();
+  }
+
+  void AddVarDesc(const std::string& name, bool persistable) {
+    auto* var_desc = block_desc_->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+    var_desc->SetDataType(VarDescAPI::Type::FP32);
+    var_desc->SetPersistable(persistable);
+  }
+
+  cpp::OpDesc* AddOpDesc(const std::string& type,
+                         const std::map<std::string, std::string>& inputs,
+                         const std::map<std::string, std::string>& outputs) {
+    auto* op_desc = block_desc_->AddOp<cpp::OpDesc>();
+    op_desc->SetType(type);
+    for (auto& input : inputs) {
+      op_desc->SetInput(input.first, {input.second});
+    }
+    for (auto& output : outputs) {
+      op_desc->SetOutput(output.first, {output.second});
+    }
+    if (type == "scale") {
+      op_desc->SetAttr<float>("scale", 2.f);
+      op_desc->SetAttr<float>("bias", 1.f);
+      op_desc->SetAttr<bool>("bias_after_scale", true);
+    } else if (type == "elementwise_add") {
+      op_desc->SetAttr<int>("axis", -1);
+    } else if (type == "transpose2") {
+      op_desc->SetAttr<std::vector<int>>("axis", {1, 0});
+    } else if (type == "reshape2") {
+      op_desc->SetAttr<std::vector<int>>("shape", {3, 2});
+      op_desc->SetAttr<bool>("inplace", true);
+    } else if (type == "increment") {
+      op_desc->SetAttr<float>("step", 1.f);
+    }
+    return op_desc;
+  }
+
+  // Build the graph of the block, the weight w is the 2 x 3 tensor of 0, 1,
+  // ..., 5, which is loaded before the ops are created.
+  void BuildGraph() {
+    std::vector<Place> valid_places{{TARGET(kX86), PRECISION(kFloat)},
+                                    {TARGET(kHost), PRECISION(kAny)}};
+    scope_ = std::make_shared<Scope>();
+    auto* w = scope_->Var("w")->GetMutable<Tensor>();
+    w->Resize({2, 3});
+    auto* w_data = w->mutable_data<float>();
+    for (int i = 0; i < 6; i++) {
+      w_data[i] = i;
+    }
+    w->set_persistable(true);
+    program_.reset(new Program(program_desc_, scope_, valid_places));
+    graph_.reset(new SSAGraph);
+    graph_->Build(*program_, valid_places);
+  }
+
+  void ApplyPass() {
+    auto* pass = PassManager::Global().LookUp<ConstantFoldingPass>(
+        "constant_folding_pass");
+    ASSERT_TRUE(pass);
+    pass->Apply(graph_);
+  }
+
+  std::vector<std::string> StmtTypes() {
+    std::vector<std::string> types;
+    for (auto* op_node : graph_->StmtTopologicalOrder()) {
+      types.push_back(op_node->AsStmt().op_type());
+    }
+    return types;
+  }
+
+  // The arg nodes of the var, a var written by several ops has several nodes.
+  std::vector<Node*> ArgNodes(const std::string& name) {
+    std::vector<Node*> nodes;
+    for (auto& node : graph_->mutable_nodes()) {
+      if (node.IsArg() && node.arg()->name == name) {
+        nodes.push_back(&node);
+      }
+    }
+    return nodes;
+  }
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  cpp::BlockDesc* block_desc_{nullptr};
+  std::shared_ptr<Scope> scope_;
+  std::unique_ptr<Program> program_;
+  std::unique_ptr<SSAGraph> graph_;
+};
+
+// w -> transpose2 -> w_t -> scale -> w_s -> elementwise_add(x, w_s) -> out
+TEST_F(ConstantFoldingPassTest, fold_weight_chain) {
+  AddVarDesc("w", true);
+  for (auto name : {"x", "w_t", "w_t_xshape", "w_s", "out"}) {
+    AddVarDesc(name, false);
+  }
+  AddOpDesc(
+      "transpose2", {{"X", "w"}}, {{"Out", "w_t"}, {"XShape", "w_t_xshape"}});
+  AddOpDesc("scale", {{"X", "w_t"}}, {{"Out", "w_s"}});
+  AddOpDesc("elementwise_add", {{"X", "x"}, {"Y", "w_s"}}, {{"Out", "out"}});
+  BuildGraph();
+  ApplyPass();
+
+  EXPECT_EQ(StmtTypes(), std::vector<std::string>({"elementwise_add"}));
+  // The weight only used by the folded op and the intermediate outputs are
+  // removed.
+  for (auto name : {"w", "w_t", "w_t_xshape"}) {
+    EXPECT_TRUE(ArgNodes(name).empty()) << name;
+  }
+  auto w_s_nodes = ArgNodes("w_s");
+  ASSERT_EQ(w_s_nodes.size(), 1u);
+  EXPECT_TRUE(w_s_nodes[0]->arg()->is_weight);
+  const auto* w_s = program_->exec_scope()->FindTensor("w_s");
+  ASSERT_TRUE(w_s);
+  EXPECT_TRUE(w_s->persistable());
+  ASSERT_EQ(w_s->dims(), DDim({3, 2}));
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 2; j++) {
+      EXPECT_EQ(w_s->data<float>()[i * 2 + j], 2.f * (j * 3 + i) + 1.f);
+    }
+  }
+}
+
+// scale(w) and assign(x) both write a, so scale isn't folded.
+TEST_F(ConstantFoldingPassTest, skip_output_written_by_other_op) {
+  AddVarDesc("w", true);
+  for (auto name : {"x", "a", "out"}) {
+    AddVarDesc(name, false);
+  }
+  AddOpDesc("scale", {{"X", "w"}}, {{"Out", "a"}});
+  AddOpDesc("assign", {{"X", "x"}}, {{"Out", "a"}});
+  AddOpDesc("elementwise_add", {{"X", "x"}, {"Y", "a"}}, {{"Out", "out"}});
+  BuildGraph();
+  ApplyPass();
+
+  EXPECT_EQ(StmtTypes(),
+            std::vector<std::string>({"scale", "assign", "elementwise_add"}));
+  for (auto* node : ArgNodes("a")) {
+    EXPECT_FALSE(node->arg()->is_weight);
+  }
+  EXPECT_FALSE(program_->exec_scope()->FindTensor("a")->persistable());
+}
+
+// increment must run at every inference though its input is a weight.
+TEST_F(ConstantFoldingPassTest, skip_unfoldable_ops) {
+  AddVarDesc("w", true);
+  for (auto name : {"x", "w_inc", "out"}) {
+    AddVarDesc(name, false);
+  }
+  AddOpDesc("increment", {{"X", "w"}}, {{"Out", "w_inc"}});
+  AddOpDesc("elementwise_add", {{"X", "x"}, {"Y", "w_inc"}}, {{"Out", "out"}});
+  BuildGraph();
+  ApplyPass();
+
+  EXPECT_EQ(StmtTypes(),
+            std::vector<std::string>({"increment", "elementwise_add"}));
+  ASSERT_EQ(ArgNodes("w").size(), 1u);
+  ASSERT_EQ(ArgNodes("w_inc").size(), 1u);
+  EXPECT_FALSE(ArgNodes("w_inc")[0]->arg()->is_weight);
+}
+
+// The in-place reshape2 shares the buffer of w, the folded output is copied.
+TEST_F(ConstantFoldingPassTest, unshare_buffer_of_reshape) {
+  AddVarDesc("w", true);
+  for (auto name : {"x", "w_r", "w_r_xshape", "out"}) {
+    AddVarDesc(name, false);
+  }
+  AddOpDesc(
+      "reshape2", {{"X", "w"}}, {{"Out", "w_r"}, {"XShape", "w_r_xshape"}});
+  AddOpDesc("elementwise_add", {{"X", "x"}, {"Y", "w_r"}}, {{"Out", "out"}});
+  BuildGraph();
+  ApplyPass();
+
+  EXPECT_EQ(StmtTypes(), std::vector<std::string>({"elementwise_add"}));
+  const auto* w = scope_->FindTensor("w");
+  const auto* w_r = program_->exec_scope()->FindTensor("w_r");
+  ASSERT_EQ(w_r->dims(), DDim({3, 2}));
+  EXPECT_TRUE(w_r->persistable());
+  EXPECT_NE(w_r->raw_data(), w->raw_data());
+  for (int i = 0; i < 6; i++) {
+    EXPECT_EQ(w_r->data<float>()[i], w->data<float>()[i]);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(transpose2);
+USE_LITE_OP(scale);
+USE_LITE_OP(assign);
+USE_LITE_OP(increment);
+USE_LITE_OP(reshape2);
+USE_LITE_OP(elementwise_add);
+USE_LITE_KERNEL(transpose2, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(scale, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(assign, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(increment, kHost, kAny, kNCHW, def);
+USE_LITE_KERNEL(reshape2, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(elementwise_add, kX86, kFloat, kNCHW, def);
+USE_MIR_PASS(constant_folding_pass);
@@ -0,0 +1,142 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/elimination/dead_code_elimination_pass.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/model/base/proto_desc.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pass_utils.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::set<std::string> DeadCodeEliminationPass::kept_ops_ = {
+    "feed",
+    "fetch",
+    "while",
+    "conditional_block",
+    "subgraph",
+    "print",
+    "write_back",
+    "write_to_array"};
+
+void DeadCodeEliminationPass::SetAllGraphs(
+    std::vector<std::unique_ptr<mir::SSAGraph>>* graphs) {
+  CHECK(graphs && !graphs->empty());
+  graphs_ = graphs;
+}
+
+void DeadCodeEliminationPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  CHECK(graphs_) << "The graphs should be set by SetAllGraphs().";
+  auto op_nodes = graph->StmtTopologicalOrder();
+  if (graph->blockIdx() == kRootBlockIdx) {
+    bool has_fetch = false;
+    for (auto* op_node : op_nodes) {
+      has_fetch = has_fetch || op_node->AsStmt().op_type() == "fetch";
+    }
+    if (!has_fetch) {
+      VLOG(3) << "Skip dead_code_elimination_pass as there is no fetch op.";
+      return;
+    }
+  }
+  auto shared_var_names =
+      CollectVarNamesOfOtherBlocks(*graphs_, graph->blockIdx());
+  // The vars read before written, i.e. the values carried from the previous
+  // inferences or the previous iterations of the loop.
+  std::set<std::string> carried_var_names;
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg() && node.inlinks.empty()) {
+      carried_var_names.insert(node.arg()->name);
+    }
+  }
+  auto is_kept = [&](Node* op_node) -> bool {
+    if (kept_ops_.count(op_node->AsStmt().op_type()) ||
+        op_node->outlinks.empty()) {
+      return true;
+    }
+    for (auto* out : op_node->outlinks) {
+      const auto& var_name = out->arg()->name;
+      if (out->arg()->is_weight || shared_var_names.count(var_name) ||
+          carried_var_names.count(var_name)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // Mark the live ops from the kept ones to their producers.
+  std::set<const Node*> live_op_nodes;
+  std::vector<Node*> worklist;
+  for (auto* op_node : op_nodes) {
+    if (is_kept(op_node)) {
+      live_op_nodes.insert(op_node);
+      worklist.push_back(op_node);
+    }
+  }
+  while (!worklist.empty()) {
+    auto* op_node = worklist.back();
+    worklist.pop_back();
+    for (auto* in : op_node->inlinks) {
+      for (auto* producer : in->inlinks) {
+        if (live_op_nodes.insert(producer).second) {
+          worklist.push_back(producer);
+        }
+      }
+    }
+  }
+
+  // Remove the dead ops, their outputs and the inputs which are only used by
+  // them.
+  std::set<const Node*> nodes2rm;
+  for (auto* op_node : op_nodes) {
+    if (live_op_nodes.count(op_node)) continue;
+    VLOG(4) << "Remove the dead op " << op_node->AsStmt().op_type();
+    nodes2rm.insert(op_node);
+    for (auto* out : op_node->outlinks) {
+      nodes2rm.insert(out);
+    }
+  }
+  if (nodes2rm.empty()) return;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg() || !node.inlinks.empty() || node.outlinks.empty() ||
+        nodes2rm.count(&node)) {
+      continue;
+    }
+    bool is_unused = true;
+    for (auto* consumer : node.outlinks) {
+      is_unused = is_unused && nodes2rm.count(consumer);
+    }
+    if (is_unused) {
+      nodes2rm.insert(&node);
+    }
+  }
+  int removed_count = op_nodes.size() - live_op_nodes.size();
+  GraphSafeRemoveNodes(graph.get(), nodes2rm);
+  VLOG(3) << "Removed " << removed_count << " dead ops in the block "
+          << graph->blockIdx();
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(dead_code_elimination_pass,
+                  paddle::lite::mir::DeadCodeEliminationPass)
+    .BindTargets({TARGET(kAny)});
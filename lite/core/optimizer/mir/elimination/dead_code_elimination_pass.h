@@ -0,0 +1,57 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Remove the ops whose outputs never reach a fetch op, e.g. the branches
+ * which are left unused by the conversion of the model or by the other
+ * passes:
+ *
+ *          x                                x
+ *        /   \                              |
+ *    shape   conv2d          ==>          conv2d
+ *      |       |                            |
+ *    slice   fetch                        fetch
+ *
+ * The feed, fetch, control flow ops and the ops with side effects are always
+ * kept, as well as the ops writing the weights, the vars referred by the other
+ * blocks and the vars read before written in the block, e.g. the states of a
+ * loop. The root block is skipped if it has no fetch op.
+ */
+class DeadCodeEliminationPass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+  void SetAllGraphs(std::vector<std::unique_ptr<mir::SSAGraph>>* graphs);
+
+ private:
+  std::vector<std::unique_ptr<mir::SSAGraph>>* graphs_{nullptr};
+  // The ops which are always kept whether their outputs are used or not.
+  static const std::set<std::string> kept_ops_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,170 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/dead_code_elimination_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+class DeadCodeEliminationPassTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    program_desc_ = std::make_shared<cpp::ProgramDesc>();
+  }
+
+  cpp::BlockDesc* AddBlock(const std::vector<std::string>& var_names) {
+    auto* block_desc = program_desc_->AddBlock<cpp::BlockDesc>();
+    block_desc->ClearOps();
+    block_desc->ClearVars();
+    for (auto& var_name : var_names) {
+      auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+      var_desc->SetName(var_name);
+      var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+      var_desc->SetDataType(VarDescAPI::Type::FP32);
+      var_desc->SetPersistable(false);
+    }
+    return block_desc;
+  }
+
+  void AddOpDesc(cpp::BlockDesc* block_desc,
+                 const std::string& type,
+                 const std::string& x,
+                 const std::string& out) {
+    auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+    op_desc->SetType(type);
+    op_desc->SetInput("X", {x});
+    op_desc->SetOutput("Out", {out});
+    if (type == "scale") {
+      op_desc->SetAttr<float>("scale", 2.f);
+      op_desc->SetAttr<float>("bias", 0.f);
+      op_desc->SetAttr<bool>("bias_after_scale", true);
+    } else if (type == "feed" || type == "fetch") {
+      op_desc->SetAttr<int>("col", 0);
+    }
+  }
+
+  // Build the graphs of all of the blocks and apply the pass to each of them.
+  void ApplyPass() {
+    std::vector<Place> valid_places{{TARGET(kX86), PRECISION(kFloat)},
+                                    {TARGET(kHost), PRECISION(kAny)}};
+    scope_ = std::make_shared<Scope>();
+    program_.reset(new Program(program_desc_, scope_, valid_places));
+    for (size_t i = 0; i < program_desc_->BlocksSize(); i++) {
+      graphs_.emplace_back(new SSAGraph);
+      graphs_.back()->Build(*program_, valid_places, i);
+    }
+    auto* pass = PassManager::Global().LookUp<DeadCodeEliminationPass>(
+        "dead_code_elimination_pass");
+    ASSERT_TRUE(pass);
+    pass->SetAllGraphs(&graphs_);
+    for (auto& graph : graphs_) {
+      pass->Apply(graph);
+    }
+  }
+
+  // The sorted outputs of the ops of the block.
+  std::vector<std::string> StmtOutputs(int block_idx) {
+    std::vector<std::string> outputs;
+    for (auto* op_node : graphs_[block_idx]->StmtTopologicalOrder()) {
+      outputs.push_back(op_node->AsStmt().op_info()->Output("Out").front());
+    }
+    std::sort(outputs.begin(), outputs.end());
+    return outputs;
+  }
+
+  bool HasArg(int block_idx, const std::string& var_name) {
+    for (auto& node : graphs_[block_idx]->mutable_nodes()) {
+      if (node.IsArg() && node.arg()->name == var_name) return true;
+    }
+    return false;
+  }
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  std::shared_ptr<Scope> scope_;
+  std::unique_ptr<Program> program_;
+  std::vector<std::unique_ptr<SSAGraph>> graphs_;
+};
+
+// feed -> x -> scale -> y -> fetch, and x -> scale -> a -> scale -> b which
+// never reaches the fetch.
+TEST_F(DeadCodeEliminationPassTest, remove_dead_branch) {
+  auto* block = AddBlock({"x", "y", "a", "b"});
+  AddOpDesc(block, "feed", "feed", "x");
+  AddOpDesc(block, "scale", "x", "a");
+  AddOpDesc(block, "scale", "a", "b");
+  AddOpDesc(block, "scale", "x", "y");
+  AddOpDesc(block, "fetch", "y", "fetch");
+  ApplyPass();
+
+  EXPECT_EQ(StmtOutputs(kRootBlockIdx),
+            std::vector<std::string>({"fetch", "x", "y"}));
+  EXPECT_FALSE(HasArg(kRootBlockIdx, "a"));
+  EXPECT_FALSE(HasArg(kRootBlockIdx, "b"));
+}
+
+TEST_F(DeadCodeEliminationPassTest, skip_root_block_without_fetch) {
+  auto* block = AddBlock({"x", "a"});
+  AddOpDesc(block, "scale", "x", "a");
+  ApplyPass();
+
+  EXPECT_EQ(StmtOutputs(kRootBlockIdx), std::vector<std::string>({"a"}));
+}
+
+// The loop body in the block 1:
+//   carry -> scale -> tmp -> assign -> carry, carried to the next iteration
+//   x -> scale -> to_parent, read by the block 0
+//   x -> scale -> dead, never read
+TEST_F(DeadCodeEliminationPassTest, keep_loop_carried_and_shared_vars) {
+  auto* block = AddBlock({"x", "to_parent", "y"});
+  AddOpDesc(block, "feed", "feed", "x");
+  AddOpDesc(block, "scale", "to_parent", "y");
+  AddOpDesc(block, "fetch", "y", "fetch");
+  auto* sub_block = AddBlock({"carry", "tmp", "dead"});
+  AddOpDesc(sub_block, "scale", "carry", "tmp");
+  AddOpDesc(sub_block, "assign", "tmp", "carry");
+  AddOpDesc(sub_block, "scale", "x", "to_parent");
+  AddOpDesc(sub_block, "scale", "x", "dead");
+  ApplyPass();
+
+  EXPECT_EQ(StmtOutputs(kRootBlockIdx),
+            std::vector<std::string>({"fetch", "x", "y"}));
+  EXPECT_EQ(StmtOutputs(1),
+            std::vector<std::string>({"carry", "tmp", "to_parent"}));
+  EXPECT_FALSE(HasArg(1, "dead"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed);
+USE_LITE_OP(fetch);
+USE_LITE_OP(scale);
+USE_LITE_OP(assign);
+USE_LITE_KERNEL(feed, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(fetch, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(scale, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(assign, kHost, kAny, kAny, def);
+USE_MIR_PASS(dead_code_elimination_pass);
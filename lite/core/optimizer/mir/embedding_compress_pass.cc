@@ -0,0 +1,153 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/embedding_compress_pass.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+#include "lite/utils/float16.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::vector<std::string> EmbeddingCompressPass::compress_ops = {
+    "lookup_table", "lookup_table_v2", "fused_embedding_seq_pool"};
+
+static bool IsCompressibleLookup(Node* node, const std::string& table_name) {
+  auto& stmt = node->AsStmt();
+  auto* op_info = stmt.op_info();
+  if (std::find(EmbeddingCompressPass::compress_ops.begin(),
+                EmbeddingCompressPass::compress_ops.end(),
+                op_info->Type()) == EmbeddingCompressPass::compress_ops.end()) {
+    return false;
+  }
+  if (op_info->Input("W") != std::vector<std::string>{table_name}) {
+    return false;
+  }
+  // The kernels of the other targets read the fp32 tables only.
+  for (auto& kernel : stmt.kernels()) {
+    if (kernel->target() != TARGET(kX86)) {
+      return false;
+    }
+  }
+  return !stmt.kernels().empty();
+}
+
+// table[row] = q[row] * scale[row], q is in [-127, 127].
+static void QuantizeTableRowwise(const Tensor& src,
+                                 Tensor* table,
+                                 Tensor* scale) {
+  const int64_t rows = src.dims()[0];
+  const int64_t width = src.dims()[1];
+  const float* src_data = src.data<float>();
+  table->Resize(src.dims());
+  table->set_precision(PRECISION(kInt8));
+  int8_t* table_data = table->mutable_data<int8_t>();
+  scale->Resize({rows});
+  float* scale_data = scale->mutable_data<float>();
+  for (int64_t i = 0; i < rows; i++) {
+    const float* row = src_data + i * width;
+    float abs_max = 0.f;
+    for (int64_t j = 0; j < width; j++) {
+      abs_max = std::max(abs_max, std::fabs(row[j]));
+    }
+    float row_scale = abs_max / 127.f;
+    float inv_scale = abs_max > 0.f ? 1.f / row_scale : 0.f;
+    for (int64_t j = 0; j < width; j++) {
+      float q = std::round(row[j] * inv_scale);
+      table_data[i * width + j] =
+          static_cast<int8_t>(std::min(std::max(q, -127.f), 127.f));
+    }
+    scale_data[i] = row_scale;
+  }
+}
+
+static void ConvertTableToFP16(const Tensor& src, Tensor* table) {
+  const float* src_data = src.data<float>();
+  table->Resize(src.dims());
+  // mutable_data resets the precision of the non-arithmetic types to kUnk.
+  float16* table_data = table->mutable_data<float16>();
+  for (int64_t i = 0; i < src.numel(); i++) {
+    table_data[i] = float16(src_data[i]);
+  }
+  table->set_precision(PRECISION(kFP16));
+}
+
+void EmbeddingCompressPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  if (compress_type_ == lite_api::EmbeddingCompressType::COMPRESS_NONE) {
+    return;
+  }
+  std::vector<Node*> tables;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg() || !node.arg()->is_weight || node.outlinks.empty()) {
+      continue;
+    }
+    const std::string& name = node.arg()->name;
+    bool compressible = true;
+    for (auto* op_node : node.outlinks) {
+      compressible = compressible && IsCompressibleLookup(op_node, name);
+    }
+    if (compressible) {
+      tables.push_back(&node);
+    }
+  }
+
+  for (auto* table_node : tables) {
+    const std::string table_name = table_node->arg()->name;
+    auto* scope = table_node->outlinks.front()->stmt()->op()->scope();
+    auto* table = scope->FindMutableTensor(table_name);
+    CHECK(table) << "Can not find the table " << table_name << " in scope.";
+    if (table->precision() != PRECISION(kFloat) || table->dims().size() != 2) {
+      LOG(INFO) << "The table " << table_name << " is not a 2-D fp32 tensor, "
+                << "so skip compressing it.";
+      continue;
+    }
+    Tensor fp32_table;
+    fp32_table.CopyDataFrom(*table);
+    table->clear();
+    if (compress_type_ == lite_api::EmbeddingCompressType::COMPRESS_FP16) {
+      ConvertTableToFP16(fp32_table, table);
+      continue;
+    }
+
+    std::string scale_name = table_name + "_row_scale";
+    auto* scale_node = graph->NewArgumentNode(scale_name);
+    scale_node->arg()->is_weight = true;
+    scale_node->arg()->type = LiteType::GetTensorTy(
+        TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW));
+    auto* scale = scope->NewTensor(scale_name);
+    scale->set_persistable(true);
+    QuantizeTableRowwise(fp32_table, table, scale);
+    for (auto* op_node : table_node->outlinks) {
+      auto& stmt = op_node->AsStmt();
+      auto op_desc = *stmt.op_info();
+      op_desc.SetInput("WScale", {scale_name});
+      stmt.ResetOp(op_desc, graph->valid_places());
+      IR_NODE_LINK_TO(scale_node, op_node);
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(embedding_compress_pass,
+                  paddle::lite::mir::EmbeddingCompressPass)
+    .BindTargets({TARGET(kX86)});
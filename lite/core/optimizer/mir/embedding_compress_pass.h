@@ -0,0 +1,53 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_place.h"
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Compress the fp32 tables of the embedding lookups run by the x86 kernels,
+ * which gather and dequantize the rows at runtime, so the tables are kept
+ * compressed in memory:
+ *   COMPRESS_INT8: the rows are quantized symmetrically to int8 by the scales
+ *                  of their abs max, which are added as the input WScale.
+ *   COMPRESS_FP16: the values are converted to fp16.
+ * A table is compressed only if all of its consumers are such lookups.
+ */
+class EmbeddingCompressPass : public ProgramPass {
+ public:
+  // The ops whose table W can be compressed.
+  static const std::vector<std::string> compress_ops;
+
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  void SetCompressType(lite_api::EmbeddingCompressType compress_type) {
+    compress_type_ = compress_type;
+  }
+
+ private:
+  lite_api::EmbeddingCompressType compress_type_{
+      lite_api::EmbeddingCompressType::COMPRESS_NONE};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,173 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/embedding_compress_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+class EmbeddingCompressPassTest : public ::testing::Test {
+ protected:
+  static constexpr int kVocabSize = 37;
+  static constexpr int kEmbSize = 21;
+  static constexpr int kIdsNum = 50;
+
+  // ids -> lookup_table_v2(w) -> out, where w is a fp32 table whose rows have
+  // the different ranges.
+  void SetUp() override {
+    auto program_desc = std::make_shared<cpp::ProgramDesc>();
+    auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+    block_desc->ClearOps();
+    block_desc->ClearVars();
+    for (auto name : {"w", "ids", "out"}) {
+      auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+      var_desc->SetName(name);
+      var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+      var_desc->SetDataType(std::string(name) == "ids"
+                                ? VarDescAPI::Type::INT64
+                                : VarDescAPI::Type::FP32);
+      var_desc->SetPersistable(std::string(name) == "w");
+    }
+    auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+    op_desc->SetType("lookup_table_v2");
+    op_desc->SetInput("W", {"w"});
+    op_desc->SetInput("Ids", {"ids"});
+    op_desc->SetOutput("Out", {"out"});
+    op_desc->SetAttr<int64_t>("padding_idx", -1);
+
+    scope_ = std::make_shared<Scope>();
+    auto* w = scope_->Var("w")->GetMutable<Tensor>();
+    w->Resize({kVocabSize, kEmbSize});
+    auto* w_data = w->mutable_data<float>();
+    for (int i = 0; i < kVocabSize; i++) {
+      for (int j = 0; j < kEmbSize; j++) {
+        w_data[i * kEmbSize + j] =
+            std::sin(i * 0.7f + j * 1.3f) * (i + 1) * 0.05f;
+      }
+    }
+    w->set_persistable(true);
+    fp32_table_.CopyDataFrom(*w);
+
+    std::vector<Place> valid_places{{TARGET(kX86), PRECISION(kFloat)},
+                                    {TARGET(kHost), PRECISION(kAny)}};
+    program_.reset(new Program(program_desc, scope_, valid_places));
+    auto* ids = program_->exec_scope()->FindMutableTensor("ids");
+    ids->Resize({kIdsNum, 1});
+    auto* ids_data = ids->mutable_data<int64_t>();
+    for (int i = 0; i < kIdsNum; i++) {
+      ids_data[i] = (i * 11) % kVocabSize;
+    }
+    graph_.reset(new SSAGraph);
+    graph_->Build(*program_, valid_places);
+    graph_->SetValidPlaces(valid_places);
+  }
+
+  void ApplyPass(lite_api::EmbeddingCompressType compress_type) {
+    auto* pass = PassManager::Global().LookUp<EmbeddingCompressPass>(
+        "embedding_compress_pass");
+    ASSERT_TRUE(pass);
+    pass->SetCompressType(compress_type);
+    pass->Apply(graph_);
+  }
+
+  // Run the lookup by the kernel of the op, which may be reset by the pass.
+  const Tensor* RunLookup() {
+    for (auto* op_node : graph_->StmtTopologicalOrder()) {
+      auto& stmt = op_node->AsStmt();
+      CHECK(stmt.op()->CheckShape());
+      CHECK(stmt.op()->InferShape());
+      auto& kernel = stmt.kernels().front();
+      kernel->PrepareForRun();
+      kernel->Run();
+    }
+    return program_->exec_scope()->FindTensor("out");
+  }
+
+  // Compare the gathered rows with the rows of the fp32 table, the tolerance
+  // of each row is relative to its abs max.
+  void CheckOutput(const Tensor& out, float tolerance) {
+    ASSERT_EQ(out.dims(), DDim({kIdsNum, 1, kEmbSize}));
+    const float* out_data = out.data<float>();
+    const auto* ids_data =
+        program_->exec_scope()->FindTensor("ids")->data<int64_t>();
+    const float* w_data = fp32_table_.data<float>();
+    for (int i = 0; i < kIdsNum; i++) {
+      const float* row = w_data + ids_data[i] * kEmbSize;
+      float abs_max = 0.f;
+      for (int j = 0; j < kEmbSize; j++) {
+        abs_max = std::max(abs_max, std::fabs(row[j]));
+      }
+      for (int j = 0; j < kEmbSize; j++) {
+        EXPECT_NEAR(out_data[i * kEmbSize + j], row[j], abs_max * tolerance);
+      }
+    }
+  }
+
+  std::shared_ptr<Scope> scope_;
+  std::unique_ptr<Program> program_;
+  std::unique_ptr<SSAGraph> graph_;
+  Tensor fp32_table_;
+};
+
+TEST_F(EmbeddingCompressPassTest, compress_int8) {
+  ApplyPass(lite_api::EmbeddingCompressType::COMPRESS_INT8);
+
+  const auto* w = scope_->FindTensor("w");
+  ASSERT_EQ(w->precision(), PRECISION(kInt8));
+  ASSERT_EQ(w->dims(), DDim({kVocabSize, kEmbSize}));
+  const auto* w_scale = program_->exec_scope()->FindTensor("w_row_scale");
+  ASSERT_TRUE(w_scale);
+  ASSERT_EQ(w_scale->dims(), DDim({kVocabSize}));
+  EXPECT_TRUE(w_scale->persistable());
+  // The rounding error of the rows is at most a half of their scales.
+  CheckOutput(*RunLookup(), 0.5f / 127.f + 1e-6f);
+}
+
+TEST_F(EmbeddingCompressPassTest, compress_fp16) {
+  ApplyPass(lite_api::EmbeddingCompressType::COMPRESS_FP16);
+
+  const auto* w = scope_->FindTensor("w");
+  ASSERT_EQ(w->precision(), PRECISION(kFP16));
+  ASSERT_EQ(w->dims(), DDim({kVocabSize, kEmbSize}));
+  EXPECT_FALSE(program_->exec_scope()->FindVar("w_row_scale"));
+  // The fp16 values have 11 significant bits.
+  CheckOutput(*RunLookup(), 1e-3f);
+}
+
+TEST_F(EmbeddingCompressPassTest, compress_none) {
+  ApplyPass(lite_api::EmbeddingCompressType::COMPRESS_NONE);
+
+  ASSERT_EQ(scope_->FindTensor("w")->precision(), PRECISION(kFloat));
+  CheckOutput(*RunLookup(), 0.f);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(lookup_table_v2);
+USE_LITE_KERNEL(lookup_table_v2, kX86, kFloat, kNCHW, def);
+USE_MIR_PASS(embedding_compress_pass);
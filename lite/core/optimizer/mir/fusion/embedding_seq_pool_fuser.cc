@@ -0,0 +1,100 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/embedding_seq_pool_fuser.h"
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void EmbeddingSeqPoolFuser::BuildPattern() {
+  // create input nodes.
+  auto* ids = VarNode("ids")->assert_is_op_input("lookup_table", "Ids");
+  auto* w = VarNode("w")->assert_is_op_input("lookup_table", "W");
+
+  // create op nodes
+  auto* lookup_table = OpNode("lookup_table", "lookup_table")
+                           ->assert_is_op("lookup_table")
+                           ->AsIntermediate();
+  auto pool_type_teller = [](const std::string& pool_type) {
+    return pool_type == "SUM" || pool_type == "AVERAGE" || pool_type == "SQRT";
+  };
+  auto* sequence_pool =
+      OpNode("sequence_pool", "sequence_pool")
+          ->assert_is_op("sequence_pool")
+          ->assert_op_attr_satisfied<std::string>("pooltype", pool_type_teller)
+          ->AsIntermediate();
+
+  // create intermediate nodes
+  auto* lookup_table_out = VarNode("lookup_table_out")
+                               ->assert_is_op_output("lookup_table", "Out")
+                               ->assert_is_op_input("sequence_pool", "X")
+                               ->AsIntermediate();
+  auto* max_index = VarNode("max_index")
+                        ->assert_is_op_output("sequence_pool", "MaxIndex")
+                        ->AsIntermediate();
+
+  // create output node
+  auto* out =
+      VarNode("out")->assert_is_op_output("sequence_pool", "Out")->AsOutput();
+
+  // create topology.
+  std::vector<PMNode*> lookup_table_inputs{ids, w};
+  lookup_table_inputs >> *lookup_table >> *lookup_table_out >> *sequence_pool;
+  *sequence_pool >> *out;
+  *sequence_pool >> *max_index;
+}
+
+void EmbeddingSeqPoolFuser::InsertNewNode(SSAGraph* graph,
+                                          const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fuse_op = LiteOpRegistry::Global().Create("fused_embedding_seq_pool");
+  auto lookup_table = matched.at("lookup_table")->stmt()->op();
+  auto* scope = lookup_table->scope();
+  auto& valid_places = lookup_table->valid_places();
+  fuse_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fuse_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("ids"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("w"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc EmbeddingSeqPoolFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto* lookup_table_info = matched.at("lookup_table")->stmt()->op_info();
+  auto* sequence_pool_info = matched.at("sequence_pool")->stmt()->op_info();
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fused_embedding_seq_pool");
+  op_desc.SetInput("Ids", {matched.at("ids")->arg()->name});
+  op_desc.SetInput("W", {matched.at("w")->arg()->name});
+  op_desc.SetOutput("Out", {matched.at("out")->arg()->name});
+  op_desc.SetAttr<int64_t>(
+      "padding_idx", lookup_table_info->GetAttr<int64_t>("padding_idx"));
+  std::string combiner = sequence_pool_info->GetAttr<std::string>("pooltype");
+  std::transform(
+      combiner.begin(), combiner.end(), combiner.begin(), ::tolower);
+  op_desc.SetAttr<std::string>("combiner", combiner);
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,383 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/fused_multihead_attention_fuser.h"
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+namespace {
+
+bool DropoutIsTest(const Node* x) {
+  if (x && x->IsStmt()) {
+    auto* op_info = x->stmt()->op_info();
+    if (op_info->HasAttr("is_test")) {
+      auto attr_type = op_info->GetAttrType("is_test");
+      if (attr_type == paddle::lite::OpDescAPI::AttrType::INT) {
+        return op_info->GetAttr<int>("is_test") == 1;
+      } else if (attr_type == paddle::lite::OpDescAPI::AttrType::BOOLEAN) {
+        return op_info->GetAttr<bool>("is_test");
+      }
+    }
+  }
+  return false;
+}
+
+// The transpose2 between [batch, seq_len, head_number, size_per_head] and
+// [batch, head_number, seq_len, size_per_head].
+bool IsHeadTranspose(const std::vector<int>& axis) {
+  return axis == std::vector<int>({0, 2, 1, 3});
+}
+
+// The bias of hidden is added to [batch, seq_len, hidden].
+bool IsBiasAxis(int axis) { return axis == -1 || axis == 2; }
+
+// The op which produces the input `arg` of the op node.
+const Node* GetInputProducer(const Node* op_node, const std::string& arg) {
+  auto* op_info = op_node->stmt()->op_info();
+  if (!op_info->HasInput(arg) || op_info->Input(arg).size() != 1) {
+    return nullptr;
+  }
+  const auto& var_name = op_info->Input(arg).front();
+  for (auto* var_node : op_node->inlinks) {
+    if (var_node->IsArg() && var_node->arg()->name == var_name &&
+        var_node->inlinks.size() == 1) {
+      return var_node->inlinks.front();
+    }
+  }
+  return nullptr;
+}
+
+// The shape of the reshape2 which splits the heads of Q, K or V, the input
+// `arg` of the matmul is produced by reshape2 -> transpose2 -> (scale).
+std::vector<int> GetHeadShape(const Node* matmul, const std::string& arg) {
+  auto* op_node = GetInputProducer(matmul, arg);
+  while (op_node && op_node->stmt()->op_type() != "reshape2") {
+    auto op_type = op_node->stmt()->op_type();
+    if (op_type != "transpose2" && op_type != "scale") return {};
+    op_node = GetInputProducer(op_node, "X");
+  }
+  if (!op_node || !op_node->stmt()->op_info()->HasAttr("shape")) return {};
+  return op_node->stmt()->op_info()->GetAttr<std::vector<int>>("shape");
+}
+
+// The Q, K and V must be split into the same heads, the matmul of Q and K is
+// found from the scores, which are the input X of the matmul with V.
+bool HasSameHeads(const Node* qkv_matmul) {
+  auto* qk_matmul = GetInputProducer(qkv_matmul, "X");
+  while (qk_matmul && qk_matmul->stmt()->op_type() != "matmul") {
+    auto op_type = qk_matmul->stmt()->op_type();
+    if (op_type != "dropout" && op_type != "softmax" &&
+        op_type != "elementwise_add") {
+      return false;
+    }
+    qk_matmul = GetInputProducer(qk_matmul, "X");
+  }
+  if (!qk_matmul) return false;
+  auto v_shape = GetHeadShape(qkv_matmul, "Y");
+  return !v_shape.empty() && GetHeadShape(qk_matmul, "X") == v_shape &&
+         GetHeadShape(qk_matmul, "Y") == v_shape;
+}
+
+}  // namespace
+
+PMNode* FusedMultiheadAttentionFuser::BuildProjection(const std::string& prefix,
+                                                      PMNode* input) {
+  auto* mul_y = VarNode(prefix + "_mul_y")
+                    ->assert_is_op_input(mul_type_, "Y")
+                    ->assert_is_persistable_var()
+                    ->AsInput();
+  auto* mul = OpNode(prefix + "_mul", mul_type_)->AsIntermediate();
+  if (mul_type_ == "mul") {
+    mul->assert_op_attr<int>("x_num_col_dims", 2);
+  } else {
+    mul->assert_op_attr<bool>("transpose_X", false)
+        ->assert_op_attr<bool>("transpose_Y", false)
+        ->assert_op_attr_satisfied<float>(
+            "alpha", [](float attr) { return std::fabs(attr - 1.f) < 1e-6f; });
+  }
+  auto* mul_out = VarNode(prefix + "_mul_out")
+                      ->assert_is_op_output(mul_type_, "Out")
+                      ->assert_is_op_input("elementwise_add", "X")
+                      ->AsIntermediate();
+  auto* add_y = VarNode(prefix + "_add_y")
+                    ->assert_is_op_input("elementwise_add", "Y")
+                    ->assert_is_persistable_var()
+                    ->AsInput();
+  auto* add = OpNode(prefix + "_add", "elementwise_add")
+                  ->assert_op_attr_satisfied<int>("axis", IsBiasAxis)
+                  ->AsIntermediate();
+  auto* add_out = VarNode(prefix + "_add_out")
+                      ->assert_is_op_output("elementwise_add", "Out")
+                      ->assert_is_op_input("reshape2", "X")
+                      ->AsIntermediate();
+  // The hidden dim is split into [head_number, size_per_head].
+  auto* reshape2 =
+      OpNode(prefix + "_reshape2", "reshape2")
+          ->assert_op_attr_satisfied<std::vector<int>>(
+              "shape",
+              [](const std::vector<int>& attr) {
+                return attr.size() == 4 && attr[0] == 0 && attr[1] == 0 &&
+                       attr[2] > 0;
+              })
+          ->AsIntermediate();
+  auto* reshape2_out = VarNode(prefix + "_reshape2_out")
+                           ->assert_is_op_output("reshape2", "Out")
+                           ->assert_is_op_input("transpose2", "X")
+                           ->AsIntermediate();
+  auto* reshape2_xshape = VarNode(prefix + "_reshape2_xshape")
+                              ->assert_is_op_output("reshape2", "XShape")
+                              ->AsIntermediate();
+  auto* transpose2 =
+      OpNode(prefix + "_transpose2", "transpose2")
+          ->assert_op_attr_satisfied<std::vector<int>>("axis", IsHeadTranspose)
+          ->AsIntermediate();
+  auto* transpose2_out = VarNode(prefix + "_transpose2_out")
+                             ->assert_is_op_output("transpose2", "Out")
+                             ->AsIntermediate();
+  auto* transpose2_xshape = VarNode(prefix + "_transpose2_xshape")
+                                ->assert_is_op_output("transpose2", "XShape")
+                                ->AsIntermediate();
+
+  std::vector<PMNode*> mul_inputs{input, mul_y};
+  std::vector<PMNode*> add_inputs{mul_out, add_y};
+  mul_inputs >> *mul >> *mul_out;
+  add_inputs >> *add >> *add_out >> *reshape2 >> *reshape2_out >> *transpose2 >>
+      *transpose2_out;
+  *reshape2 >> *reshape2_xshape;
+  *transpose2 >> *transpose2_xshape;
+  return transpose2_out;
+}
+
+void FusedMultiheadAttentionFuser::BuildPattern() {
+  auto* input = VarNode("input")->assert_is_op_input(mul_type_, "X")->AsInput();
+  auto* q = BuildProjection("q", input);
+  auto* k = BuildProjection("k", input);
+  auto* v = BuildProjection("v", input);
+
+  // scores = softmax(Q * K^T + mask)
+  if (with_q_scale_) {
+    q->assert_is_op_input("scale", "X");
+    auto* q_scale = OpNode("q_scale", "scale")
+                        ->assert_op_attr_satisfied<float>(
+                            "bias",
+                            [](float attr) { return std::fabs(attr) < 1e-6f; })
+                        ->AsIntermediate();
+    auto* q_scale_out = VarNode("q_scale_out")
+                            ->assert_is_op_output("scale", "Out")
+                            ->AsIntermediate();
+    *q >> *q_scale >> *q_scale_out;
+    q = q_scale_out;
+  }
+  q->assert_is_op_input("matmul", "X");
+  k->assert_is_op_input("matmul", "Y");
+  auto* qk_matmul = OpNode("qk_matmul", "matmul")
+                        ->assert_op_attr<bool>("transpose_X", false)
+                        ->assert_op_attr<bool>("transpose_Y", true)
+                        ->AsIntermediate();
+  auto* qk_matmul_out = VarNode("qk_matmul_out")
+                            ->assert_is_op_output("matmul", "Out")
+                            ->assert_is_op_input("elementwise_add", "X")
+                            ->AsIntermediate();
+  auto* qk_mask = VarNode("qk_mask")
+                      ->assert_is_op_input("elementwise_add", "Y")
+                      ->AsInput();
+  auto* qk_add = OpNode("qk_add", "elementwise_add")
+                     ->assert_op_attr<int>("axis", -1)
+                     ->AsIntermediate();
+  auto* qk_add_out = VarNode("qk_add_out")
+                         ->assert_is_op_output("elementwise_add", "Out")
+                         ->assert_is_op_input("softmax", "X")
+                         ->AsIntermediate();
+  auto* qk_softmax =
+      OpNode("qk_softmax", "softmax")
+          ->assert_op_attr_satisfied<int>(
+              "axis", [](int attr) { return attr == -1 || attr == 3; })
+          ->AsIntermediate();
+  auto* qk_softmax_out = VarNode("qk_softmax_out")
+                             ->assert_is_op_output("softmax", "Out")
+                             ->AsIntermediate();
+  std::vector<PMNode*> qk_inputs{q, k};
+  std::vector<PMNode*> qk_add_inputs{qk_matmul_out, qk_mask};
+  qk_inputs >> *qk_matmul >> *qk_matmul_out;
+  qk_add_inputs >> *qk_add >> *qk_add_out >> *qk_softmax >> *qk_softmax_out;
+  auto* scores = qk_softmax_out;
+  if (with_dropout_) {
+    // Only the dropout which is identity in inference can be fused.
+    scores->assert_is_op_input("dropout", "X");
+    auto* qk_dropout = OpNode("qk_dropout", "dropout")
+                           ->assert_node_satisfied(DropoutIsTest)
+                           ->assert_op_attr<std::string>(
+                               "dropout_implementation", "upscale_in_train")
+                           ->AsIntermediate();
+    auto* qk_dropout_out = VarNode("qk_dropout_out")
+                               ->assert_is_op_output("dropout", "Out")
+                               ->AsIntermediate();
+    auto* qk_dropout_mask = VarNode("qk_dropout_mask")
+                                ->assert_is_op_output("dropout", "Mask")
+                                ->AsIntermediate();
+    *scores >> *qk_dropout >> *qk_dropout_out;
+    *qk_dropout >> *qk_dropout_mask;
+    scores = qk_dropout_out;
+  }
+
+  // out = transpose(scores * V) * W + b
+  scores->assert_is_op_input("matmul", "X");
+  v->assert_is_op_input("matmul", "Y");
+  auto* qkv_matmul =
+      OpNode("qkv_matmul", "matmul")
+          ->assert_node_satisfied(HasSameHeads)
+          ->assert_op_attr<bool>("transpose_X", false)
+          ->assert_op_attr<bool>("transpose_Y", false)
+          ->assert_op_attr_satisfied<float>(
+              "alpha", [](float attr) { return std::fabs(attr - 1.f) < 1e-6f; })
+          ->AsIntermediate();
+  auto* qkv_matmul_out = VarNode("qkv_matmul_out")
+                             ->assert_is_op_output("matmul", "Out")
+                             ->assert_is_op_input("transpose2", "X")
+                             ->AsIntermediate();
+  auto* qkv_transpose2 =
+      OpNode("qkv_transpose2", "transpose2")
+          ->assert_op_attr_satisfied<std::vector<int>>("axis", IsHeadTranspose)
+          ->AsIntermediate();
+  auto* qkv_transpose2_out = VarNode("qkv_transpose2_out")
+                                 ->assert_is_op_output("transpose2", "Out")
+                                 ->assert_is_op_input("reshape2", "X")
+                                 ->AsIntermediate();
+  auto* qkv_transpose2_xshape =
+      VarNode("qkv_transpose2_xshape")
+          ->assert_is_op_output("transpose2", "XShape")
+          ->AsIntermediate();
+  auto* qkv_reshape2 =
+      OpNode("qkv_reshape2", "reshape2")
+          ->assert_op_attr_satisfied<std::vector<int>>(
+              "shape",
+              [](const std::vector<int>& attr) {
+                return attr.size() == 3 && attr[0] == 0 && attr[1] == 0;
+              })
+          ->AsIntermediate();
+  auto* qkv_reshape2_out = VarNode("qkv_reshape2_out")
+                               ->assert_is_op_output("reshape2", "Out")
+                               ->assert_is_op_input(mul_type_, "X")
+                               ->AsIntermediate();
+  auto* qkv_reshape2_xshape = VarNode("qkv_reshape2_xshape")
+                                  ->assert_is_op_output("reshape2", "XShape")
+                                  ->AsIntermediate();
+  auto* out_mul_y = VarNode("out_mul_y")
+                        ->assert_is_op_input(mul_type_, "Y")
+                        ->assert_is_persistable_var()
+                        ->AsInput();
+  auto* out_mul = OpNode("out_mul", mul_type_)->AsIntermediate();
+  if (mul_type_ == "mul") {
+    out_mul->assert_op_attr<int>("x_num_col_dims", 2);
+  } else {
+    out_mul->assert_op_attr<bool>("transpose_X", false)
+        ->assert_op_attr<bool>("transpose_Y", false)
+        ->assert_op_attr_satisfied<float>(
+            "alpha", [](float attr) { return std::fabs(attr - 1.f) < 1e-6f; });
+  }
+  auto* out_mul_out = VarNode("out_mul_out")
+                          ->assert_is_op_output(mul_type_, "Out")
+                          ->assert_is_op_input("elementwise_add", "X")
+                          ->AsIntermediate();
+  auto* out_add_y = VarNode("out_add_y")
+                        ->assert_is_op_input("elementwise_add", "Y")
+                        ->assert_is_persistable_var()
+                        ->AsInput();
+  auto* out_add = OpNode("out_add", "elementwise_add")
+                      ->assert_op_attr_satisfied<int>("axis", IsBiasAxis)
+                      ->AsIntermediate();
+  auto* out_add_out = VarNode("out_add_out")
+                          ->assert_is_op_output("elementwise_add", "Out")
+                          ->AsOutput();
+
+  std::vector<PMNode*> qkv_inputs{scores, v};
+  std::vector<PMNode*> out_mul_inputs{qkv_reshape2_out, out_mul_y};
+  std::vector<PMNode*> out_add_inputs{out_mul_out, out_add_y};
+  qkv_inputs >> *qkv_matmul >> *qkv_matmul_out >> *qkv_transpose2 >>
+      *qkv_transpose2_out >> *qkv_reshape2 >> *qkv_reshape2_out;
+  *qkv_transpose2 >> *qkv_transpose2_xshape;
+  *qkv_reshape2 >> *qkv_reshape2_xshape;
+  out_mul_inputs >> *out_mul >> *out_mul_out;
+  out_add_inputs >> *out_add >> *out_add_out;
+}
+
+void FusedMultiheadAttentionFuser::InsertNewNode(SSAGraph* graph,
+                                                 const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto attention_op =
+      LiteOpRegistry::Global().Create("fused_multihead_attention");
+  auto q_mul = matched.at("q_mul")->stmt()->op();
+  auto* scope = q_mul->scope();
+  auto& valid_places = q_mul->valid_places();
+  attention_op->Attach(op_desc, scope);
+
+  auto* new_op_node =
+      graph->GraphCreateInstructNode(attention_op, valid_places);
+
+  for (auto* name : {"input",
+                     "qk_mask",
+                     "q_mul_y",
+                     "q_add_y",
+                     "k_mul_y",
+                     "k_add_y",
+                     "v_mul_y",
+                     "v_add_y",
+                     "out_mul_y",
+                     "out_add_y"}) {
+    IR_NODE_LINK_TO(matched.at(name), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("out_add_out"));
+}
+
+cpp::OpDesc FusedMultiheadAttentionFuser::GenOpDesc(
+    const key2nodes_t& matched) {
+  auto shape = matched.at("q_reshape2")
+                   ->stmt()
+                   ->op_info()
+                   ->GetAttr<std::vector<int>>("shape");
+  float alpha =
+      matched.at("qk_matmul")->stmt()->op_info()->GetAttr<float>("alpha");
+  if (with_q_scale_) {
+    alpha *= matched.at("q_scale")->stmt()->op_info()->GetAttr<float>("scale");
+  }
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fused_multihead_attention");
+  op_desc.SetInput("Input", {matched.at("input")->arg()->name});
+  op_desc.SetInput("Mask", {matched.at("qk_mask")->arg()->name});
+  op_desc.SetInput("QWeight", {matched.at("q_mul_y")->arg()->name});
+  op_desc.SetInput("QBias", {matched.at("q_add_y")->arg()->name});
+  op_desc.SetInput("KWeight", {matched.at("k_mul_y")->arg()->name});
+  op_desc.SetInput("KBias", {matched.at("k_add_y")->arg()->name});
+  op_desc.SetInput("VWeight", {matched.at("v_mul_y")->arg()->name});
+  op_desc.SetInput("VBias", {matched.at("v_add_y")->arg()->name});
+  op_desc.SetInput("OutWeight", {matched.at("out_mul_y")->arg()->name});
+  op_desc.SetInput("OutBias", {matched.at("out_add_y")->arg()->name});
+  op_desc.SetOutput("Out", {matched.at("out_add_out")->arg()->name});
+  op_desc.SetAttr<int>("head_number", shape[2]);
+  op_desc.SetAttr<float>("alpha", alpha);
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
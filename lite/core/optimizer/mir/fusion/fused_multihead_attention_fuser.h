@@ -0,0 +1,73 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+/*
+ * Fuse the multi-head attention of the BERT/ERNIE encoder layer:
+ *
+ *        input ---------------+-------------------+
+ *          |                  |                   |
+ *   mul + elementwise_add     | (K)               | (V)
+ *   reshape2 + transpose2    ...                 ...
+ *          |                  |                   |
+ *   [scale] (Q)               |                   |
+ *          +--- matmul -------+                   |
+ *                 |                               |
+ *   elementwise_add(mask) + softmax + [dropout]   |
+ *                 +--------- matmul --------------+
+ *                              |
+ *               transpose2 + reshape2 + mul + elementwise_add
+ *                              |
+ *                            output
+ *
+ * into one fused_multihead_attention op. The projections are mul with
+ * x_num_col_dims 2 or matmul of the 2-D persistable weights.
+ */
+class FusedMultiheadAttentionFuser : public FuseBase {
+ public:
+  FusedMultiheadAttentionFuser(const std::string& mul_type,
+                               bool with_q_scale,
+                               bool with_dropout)
+      : mul_type_(mul_type),
+        with_q_scale_(with_q_scale),
+        with_dropout_(with_dropout) {}
+
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  // Build the projection of the input and the following reshape2 and
+  // transpose2 of Q, K or V, the output of transpose2 is returned.
+  PMNode* BuildProjection(const std::string& prefix, PMNode* input);
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+
+  std::string mul_type_;
+  bool with_q_scale_;
+  bool with_dropout_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -29,11 +29,48 @@ typedef struct {
   std::string name;
   int cluster;
   std::pair<int, int> lifetime;
-  std::set<std::string> adj;
+  size_t size;
 } MemNode;
 
+typedef struct {
+  std::string name;
+  size_t size;
+  std::vector<std::pair<int, int>> lifetimes;
+  std::vector<std::string> var_names;
+} MemCluster;
+
+// Estimate the memory size of the var according to the shape declared in the
+// model, the dynamic dims(such as the batch size -1) are regarded as 1.
+static size_t EstimateVarMemSize(Node* op_node, Node* var_node) {
+  auto& arg = var_node->AsArg();
+  auto* scope = op_node->AsStmt().op()->scope();
+  if (scope == nullptr) return 0;
+  auto* var = scope->FindVar(arg.name);
+  if (var == nullptr || !var->IsType<Tensor>()) return 0;
+  const auto& tensor = var->Get<Tensor>();
+  const auto& dims = tensor.dims();
+  if (dims.empty()) return 0;
+  size_t numel = 1;
+  for (size_t i = 0; i < dims.size(); i++) {
+    numel *= static_cast<size_t>((std::max)(dims[i], static_cast<int64_t>(1)));
+  }
+  size_t precision_size = 0;
+  if (arg.type != nullptr) {
+    precision_size = PrecisionTypeLength(arg.type->precision());
+  }
+  if (precision_size == 0) {
+    precision_size = PrecisionTypeLength(tensor.precision());
+  }
+  if (precision_size == 0) {
+    precision_size = sizeof(float);
+  }
+  return numel * precision_size;
+}
+
 void MemoryOptimizePass::CollectLifeCycleByDevice(
-    std::map<std::string, lifecycle_map_t>* lifecycles, SSAGraph* graph) {
+    std::map<std::string, lifecycle_map_t>* lifecycles,
+    std::map<std::string, memsize_map_t>* memsizes,
+    SSAGraph* graph) {
   max_lifecycle_ = 0;
 
   auto is_host = [](TargetType x) -> bool {
@@ -162,8 +199,27 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
     }
   }
 
+  op_ancestors_.clear();
+  var_accessors_.clear();
+  std::map<Node*, int> op_indices;
   for (auto& op_node : graph->StmtTopologicalOrder()) {
     if (op_node->IsStmt()) {
+      if (inter_op_parallel_) {
+        op_indices[op_node] = max_lifecycle_;
+        std::vector<bool> ancestors(max_lifecycle_, false);
+        for (auto* in_var_node : op_node->inlinks) {
+          for (auto* producer : in_var_node->inlinks) {
+            if (!op_indices.count(producer)) continue;
+            int idx = op_indices[producer];
+            ancestors[idx] = true;
+            const auto& producer_ancestors = op_ancestors_[idx];
+            for (int i = 0; i < idx; i++) {
+              if (producer_ancestors[i]) ancestors[i] = true;
+            }
+          }
+        }
+        op_ancestors_.push_back(std::move(ancestors));
+      }
       std::vector<Node*> var_nodes(op_node->inlinks.begin(),
                                    op_node->inlinks.end());
       var_nodes.insert(
@@ -176,10 +232,18 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
         if (invalid_var_names.count(var_name)) continue;
         TargetType target_type = arg.type->target();
         if (is_host(target_type)) target_type = TARGET(kHost);
+        if (inter_op_parallel_) {
+          auto& accessors = var_accessors_[var_name];
+          if (accessors.empty() || accessors.back() != max_lifecycle_) {
+            accessors.push_back(max_lifecycle_);
+          }
+        }
 
         if (!(*lifecycles)[TargetToStr(target_type)].count(var_name)) {
           (*lifecycles)[TargetToStr(target_type)].emplace(
               var_name, std::make_pair(max_lifecycle_, max_lifecycle_));
+          (*memsizes)[TargetToStr(target_type)].emplace(
+              var_name, EstimateVarMemSize(op_node, var_node));
         } else {
           int cur_life =
               (*lifecycles)[TargetToStr(target_type)][var_name].second;
@@ -195,52 +259,108 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
 
 void MemoryOptimizePass::MakeReusePlan(
     const lifecycle_map_t& lifecycles,
-    std::map<std::string, std::string>* node2cluster) {
+    const memsize_map_t& memsizes,
+    std::map<std::string, std::string>* node2cluster,
+    ReusePlanStats* stats) {
   std::vector<MemNode> mem_nodes;
-  std::vector<std::string> cluster;
+  std::vector<MemCluster> clusters;
   for (auto& data : lifecycles) {
     MemNode temp_node;
     temp_node.name = data.first;
     temp_node.cluster = -1;
     temp_node.lifetime = data.second;
+    auto it = memsizes.find(data.first);
+    temp_node.size = it != memsizes.end() ? it->second : 0;
     mem_nodes.push_back(temp_node);
   }
   auto overlap = [](std::pair<int, int> a, std::pair<int, int> b) -> bool {
     return b.second >= a.first && a.second >= b.first;
   };
-  // If the lifetime of two nodes is overwritten, we set them as adjacent nodes.
-  for (size_t i = 0; i < mem_nodes.size(); i++) {
-    for (size_t j = i + 1; j < mem_nodes.size(); j++) {
-      if (overlap(mem_nodes[i].lifetime, mem_nodes[j].lifetime)) {
-        mem_nodes[i].adj.insert(mem_nodes[j].name);
-        mem_nodes[j].adj.insert(mem_nodes[i].name);
+  // Whether all of the accesses of the var `a` are the ancestors of the first
+  // access of the var `b`.
+  auto happens_before = [&](const std::string& a,
+                            const std::string& b) -> bool {
+    int first = var_accessors_.at(b).front();
+    for (int op : var_accessors_.at(a)) {
+      if (op >= first || !op_ancestors_[first][op]) return false;
+    }
+    return true;
+  };
+
+  // Generating Memory Reuse Strategy Based on Greedy-by-Size Way
+  // The vars are visited in descending order of their sizes, and the var is
+  // assigned to the smallest cluster which has no lifetime overlap with it, so
+  // the size of the cluster never grows and the large vars are not wasted for
+  // the small ones. A new cluster is created if no cluster is available.
+  std::stable_sort(mem_nodes.begin(),
+                   mem_nodes.end(),
+                   [](const MemNode& a, const MemNode& b) {
+                     if (a.size != b.size) return a.size > b.size;
+                     return a.lifetime.first < b.lifetime.first;
+                   });
+  size_t origin_size = 0;
+  for (auto& mem_node : mem_nodes) {
+    origin_size += mem_node.size;
+    int best_cluster = -1;
+    for (size_t i = 0; i < clusters.size(); i++) {
+      bool available = true;
+      for (size_t j = 0; j < clusters[i].lifetimes.size(); j++) {
+        if (overlap(clusters[i].lifetimes[j], mem_node.lifetime)) {
+          available = false;
+          break;
+        }
+        const auto& var_name = clusters[i].var_names[j];
+        if (inter_op_parallel_ && !happens_before(var_name, mem_node.name) &&
+            !happens_before(mem_node.name, var_name)) {
+          available = false;
+          break;
+        }
+      }
+      if (!available) continue;
+      if (best_cluster < 0 || clusters[i].size < clusters[best_cluster].size) {
+        best_cluster = i;
       }
     }
+    if (best_cluster < 0) {
+      best_cluster = clusters.size();
+      MemCluster cluster;
+      cluster.name = mem_node.name;
+      cluster.size = mem_node.size;
+      clusters.push_back(cluster);
+    }
+    auto& cluster = clusters[best_cluster];
+    cluster.size = (std::max)(cluster.size, mem_node.size);
+    cluster.lifetimes.push_back(mem_node.lifetime);
+    cluster.var_names.push_back(mem_node.name);
+    mem_node.cluster = best_cluster;
+    (*node2cluster)[mem_node.name] = cluster.name;
   }
 
-  // Generating Memory Reuse Strategy Based on Greedy Way
-  // The vars can be reused if there is no overlap between them.
-  for (size_t i = 0; i < mem_nodes.size(); i++) {
-    if (mem_nodes[i].cluster >= 0) continue;
-    int cluster_index = cluster.size();
-    mem_nodes[i].cluster = cluster_index;
-    (*node2cluster)[mem_nodes[i].name] = mem_nodes[i].name;
-    cluster.push_back(mem_nodes[i].name);
-    std::set<std::string> cluster_adj = mem_nodes[i].adj;
-    for (size_t j = i + 1; j < mem_nodes.size(); j++) {
-      if (mem_nodes[j].cluster < 0 &&
-          (cluster_adj.find(mem_nodes[j].name) == cluster_adj.end())) {
-        (*node2cluster)[mem_nodes[j].name] = mem_nodes[i].name;
-        mem_nodes[j].cluster = cluster_index;
-        for (auto& n : mem_nodes[j].adj) {
-          cluster_adj.insert(n);
-        }
+  // The peak memory is the lower bound of any reuse plan, it's the maximum
+  // total size of the vars which are alive at the same time.
+  size_t peak_size = 0;
+  for (int life = 0; life < max_lifecycle_; life++) {
+    size_t live_size = 0;
+    for (auto& mem_node : mem_nodes) {
+      if (mem_node.lifetime.first <= life && mem_node.lifetime.second >= life) {
+        live_size += mem_node.size;
       }
     }
+    peak_size = (std::max)(peak_size, live_size);
   }
-  for (auto& name : cluster) {
-    LOG(INFO) << "cluster: " << name;
+  size_t planned_size = 0;
+  for (auto& cluster : clusters) {
+    planned_size += cluster.size;
+    LOG(INFO) << "cluster: " << cluster.name << " size: " << cluster.size;
   }
+  LOG(INFO) << "Activation memory of " << mem_nodes.size()
+            << " vars: " << origin_size << " bytes before the reuse plan, "
+            << planned_size << " bytes in " << clusters.size()
+            << " clusters after the reuse plan, the lower bound is "
+            << peak_size << " bytes.";
+  stats->origin_size = origin_size;
+  stats->planned_size = planned_size;
+  stats->peak_size = peak_size;
 }
 
 void MemoryOptimizePass::PerformReusePlan(
@@ -319,7 +439,40 @@ void MemoryOptimizePass::PerformReusePlan(
   }
 }
 
+// The reuse plan of X86 is only validated with the host targets, so the pass
+// is skipped if X86 is mixed with the targets which aren't bound to the pass,
+// e.g. CUDA+X86 or FPGA+X86.
+static bool HasUnvalidatedX86Places(const std::vector<Place>& valid_places) {
+  bool has_x86 = false;
+  bool has_bound_target = false;
+  bool has_other_target = false;
+  for (auto& place : valid_places) {
+    switch (place.target) {
+      case TARGET(kX86):
+        has_x86 = true;
+        break;
+      case TARGET(kARM):
+      case TARGET(kOpenCL):
+      case TARGET(kXPU):
+        has_bound_target = true;
+        break;
+      case TARGET(kHost):
+      case TARGET(kAny):
+        break;
+      default:
+        has_other_target = true;
+        break;
+    }
+  }
+  return has_x86 && !has_bound_target && has_other_target;
+}
+
 void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  if (HasUnvalidatedX86Places(graph->valid_places())) {
+    VLOG(3) << "Skip memory_optimize_pass as X86 is mixed with the targets "
+            << "which aren't validated.";
+    return;
+  }
 #ifdef LITE_WITH_XPU
   const char* xpu_mem_optimize = std::getenv("XPU_MEMORY_OPTIMIZE");
   if (xpu_mem_optimize == nullptr || std::strlen(xpu_mem_optimize) != 1 ||
@@ -333,16 +486,24 @@ void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   // 1. Collect all var's lifetime, then classify them according to the device.
   // Only the vars on the same device can be reused.
   // 2. Make reuse plan: the vars can be reused if there is no overlap between
-  // them.
+  // them, and the vars of the similar sizes are preferred to share the same
+  // buffer according to the sizes estimated from the shapes of the vars.
   // The final plan is a mapping table in which the key represents the original
   // name of var and the value in the table represents the current name of var.
   // 3. Perform reuse plan: Replace all var's name in the model according to the
   // mapping table.
+  inter_op_parallel_ =
+      HasAttr("inter_op_parallel") && GetAttr<bool>("inter_op_parallel");
   std::map<std::string, lifecycle_map_t> lifecycles;
-  CollectLifeCycleByDevice(&lifecycles, graph.get());
+  std::map<std::string, memsize_map_t> memsizes;
+  reuse_plan_stats_.clear();
+  CollectLifeCycleByDevice(&lifecycles, &memsizes, graph.get());
   for (auto& ele : lifecycles) {
     std::map<std::string, std::string> node2cluster;
-    MakeReusePlan(ele.second, &node2cluster);
+    MakeReusePlan(ele.second,
+                  memsizes[ele.first],
+                  &node2cluster,
+                  &reuse_plan_stats_[ele.first]);
     PerformReusePlan(graph.get(), node2cluster);
   }
 }
@@ -352,7 +513,8 @@ void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 }  // namespace paddle
 
 REGISTER_MIR_PASS(memory_optimize_pass, paddle::lite::mir::MemoryOptimizePass)
-    .BindTargets({TARGET(kARM), TARGET(kOpenCL), TARGET(kXPU)})
+    .BindTargets(
+        {TARGET(kARM), TARGET(kOpenCL), TARGET(kXPU), TARGET(kX86)})
     .ExcludeTargets({TARGET(kNPU),
                      TARGET(kBM),
                      TARGET(kRKNPU),
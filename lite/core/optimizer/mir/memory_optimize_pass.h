@@ -32,24 +32,54 @@ namespace lite {
 namespace mir {
 
 /*
- * MemoryOptimizePass will
+ * MemoryOptimizePass will make the non-persistable vars whose lifetimes do not
+ * overlap share the same var(and its buffer). The reuse plan is size-aware:
+ * the vars are assigned to the shared vars in descending order of their
+ * estimated sizes, and each var is put into the smallest compatible shared var,
+ * so that the peak activation memory of each device is minimized.
+ * If the attribute "inter_op_parallel" is true, only the vars whose accesses
+ * are ordered by the data dependencies share the same var, so the reuse plan
+ * doesn't serialize the independent ops which run concurrently.
  */
 class MemoryOptimizePass : public ProgramPass {
  public:
   using lifecycle_t = std::pair<int, int>;
   using lifecycle_map_t = std::map<std::string, lifecycle_t>;
+  using memsize_map_t = std::map<std::string, size_t>;
+  // The activation memory of a device in bytes: the total size of the vars,
+  // the size after the reuse plan and the lower bound of any reuse plan.
+  struct ReusePlanStats {
+    size_t origin_size{0};
+    size_t planned_size{0};
+    size_t peak_size{0};
+  };
   void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+  // The stats of the reuse plans of the last applied graph by the device.
+  const std::map<std::string, ReusePlanStats>& reuse_plan_stats() const {
+    return reuse_plan_stats_;
+  }
 
  private:
   void CollectLifeCycleByDevice(
-      std::map<std::string, lifecycle_map_t>* lifecycles, SSAGraph*);
+      std::map<std::string, lifecycle_map_t>* lifecycles,
+      std::map<std::string, memsize_map_t>* memsizes,
+      SSAGraph*);
   void MakeReusePlan(const lifecycle_map_t& lifecycles,
-                     std::map<std::string, std::string>* node2cluster);
+                     const memsize_map_t& memsizes,
+                     std::map<std::string, std::string>* node2cluster,
+                     ReusePlanStats* stats);
   void PerformReusePlan(SSAGraph* graph,
                         const std::map<std::string, std::string>& reuse_table);
 
  private:
   int max_lifecycle_{-1};
+  bool inter_op_parallel_{false};
+  // The ancestors of each op in the topological order, op_ancestors_[i][j] is
+  // true if the i-th op depends on the j-th op(j < i).
+  std::vector<std::vector<bool>> op_ancestors_;
+  // The indices of the ops which access the var, in ascending order.
+  std::map<std::string, std::vector<int>> var_accessors_;
+  std::map<std::string, ReusePlanStats> reuse_plan_stats_;
 };
 
 }  // namespace mir
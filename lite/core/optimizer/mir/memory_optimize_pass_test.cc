@@ -0,0 +1,148 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/memory_optimize_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/pass_utils.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static void AddTensorVarDesc(cpp::BlockDesc* block_desc,
+                             const std::string& name,
+                             const std::vector<int64_t>& shape) {
+  auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+  var_desc->SetName(name);
+  var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+  var_desc->SetDataType(VarDescAPI::Type::FP32);
+  var_desc->SetShape(shape);
+}
+
+static void AddOpDesc(cpp::BlockDesc* block_desc,
+                      const std::string& type,
+                      const std::string& x,
+                      const std::string& out) {
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType(type);
+  op_desc->SetInput("X", {x});
+  op_desc->SetOutput("Out", {out});
+  if (type == "scale") {
+    op_desc->SetAttr<float>("scale", 1.f);
+    op_desc->SetAttr<float>("bias", 0.f);
+    op_desc->SetAttr<bool>("bias_after_scale", true);
+  } else {
+    op_desc->SetAttr<int>("col", 0);
+  }
+}
+
+// feed -> x -> scale -> a -> scale -> b -> scale -> c -> scale -> d -> scale
+// -> out -> fetch, where a and c have 100 floats, b and d have 400 floats.
+static std::unique_ptr<SSAGraph> BuildScaleChain(
+    const std::vector<Place>& valid_places, std::unique_ptr<Program>* program) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  block_desc->ClearOps();
+  block_desc->ClearVars();
+  const std::vector<std::string> var_names{"x", "a", "b", "c", "d", "out"};
+  const std::vector<int64_t> var_sizes{100, 100, 400, 100, 400, 100};
+  for (size_t i = 0; i < var_names.size(); i++) {
+    AddTensorVarDesc(block_desc, var_names[i], {1, var_sizes[i]});
+  }
+  AddOpDesc(block_desc, "feed", "feed", "x");
+  for (size_t i = 0; i + 1 < var_names.size(); i++) {
+    AddOpDesc(block_desc, "scale", var_names[i], var_names[i + 1]);
+  }
+  AddOpDesc(block_desc, "fetch", "out", "fetch");
+
+  auto scope = std::make_shared<Scope>();
+  program->reset(new Program(program_desc, scope, valid_places));
+  std::unique_ptr<SSAGraph> graph(new SSAGraph);
+  graph->Build(**program, valid_places);
+  graph->SetValidPlaces(valid_places);
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) {
+      node.arg()->type = LiteType::GetTensorTy(TARGET(kX86));
+    }
+  }
+  return graph;
+}
+
+static std::vector<std::string> StmtOutputs(SSAGraph* graph) {
+  std::vector<std::string> outputs;
+  for (auto* op_node : graph->StmtTopologicalOrder()) {
+    outputs.push_back(op_node->AsStmt().op_info()->Output("Out").front());
+  }
+  return outputs;
+}
+
+TEST(memory_optimize_pass, size_aware_reuse_plan) {
+  std::unique_ptr<Program> program;
+  auto graph = BuildScaleChain({{TARGET(kX86), PRECISION(kFloat)},
+                                {TARGET(kHost), PRECISION(kAny)}},
+                               &program);
+
+  auto* pass =
+      PassManager::Global().LookUp<MemoryOptimizePass>("memory_optimize_pass");
+  ASSERT_TRUE(pass);
+  EXPECT_TRUE(PassMatchesTarget(*pass, {TARGET(kX86)}));
+  pass->Apply(graph);
+
+  // The feed and fetch vars are never reused. The lifetimes of b and d don't
+  // overlap, so d reuses the larger buffer, and c reuses a.
+  EXPECT_EQ(StmtOutputs(graph.get()),
+            std::vector<std::string>({"x", "a", "b", "a", "b", "out", "fetch"}));
+  auto stats = pass->reuse_plan_stats().at(TargetToStr(TARGET(kHost)));
+  EXPECT_EQ(stats.origin_size, (100 + 400 + 100 + 400) * sizeof(float));
+  EXPECT_EQ(stats.planned_size, (100 + 400) * sizeof(float));
+  EXPECT_EQ(stats.peak_size, (100 + 400) * sizeof(float));
+}
+
+// The reuse of X86 isn't validated with CUDA, so nothing is reused.
+TEST(memory_optimize_pass, skip_x86_mixed_with_cuda) {
+  std::unique_ptr<Program> program;
+  auto graph = BuildScaleChain({{TARGET(kCUDA), PRECISION(kFloat)},
+                                {TARGET(kX86), PRECISION(kFloat)},
+                                {TARGET(kHost), PRECISION(kAny)}},
+                               &program);
+
+  auto* pass =
+      PassManager::Global().LookUp<MemoryOptimizePass>("memory_optimize_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  EXPECT_EQ(StmtOutputs(graph.get()),
+            std::vector<std::string>({"x", "a", "b", "c", "d", "out", "fetch"}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed);
+USE_LITE_OP(fetch);
+USE_LITE_OP(scale);
+USE_LITE_KERNEL(feed, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(fetch, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(scale, kX86, kFloat, kNCHW, def);
+USE_MIR_PASS(memory_optimize_pass);
@@ -16,6 +16,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 #include "lite/core/op_registry.h"
 
 namespace paddle {
@@ -89,5 +90,19 @@ bool PassMatchesKernels(const mir::Pass& pass) {
   return true;
 }
 
+std::set<std::string> CollectVarNamesOfOtherBlocks(
+    const std::vector<std::unique_ptr<mir::SSAGraph>>& graphs, int block_idx) {
+  std::set<std::string> var_names;
+  for (size_t i = 0; i < graphs.size(); i++) {
+    if (static_cast<int>(i) == block_idx) continue;
+    for (auto& node : graphs[i]->mutable_nodes()) {
+      if (node.IsArg()) {
+        var_names.insert(node.arg()->name);
+      }
+    }
+  }
+  return var_names;
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 #include "lite/core/optimizer/mir/pass.h"
 
 namespace paddle {
@@ -31,5 +32,10 @@ bool PassMatchesTarget(const mir::Pass& pass,
 // Check if the pass hits all necessary operators.
 bool PassMatchesKernels(const mir::Pass& pass);
 
+// Collect the names of the vars referred by the blocks except the
+// `block_idx`th one, the vars shared between the blocks are accessed by name.
+std::set<std::string> CollectVarNamesOfOtherBlocks(
+    const std::vector<std::unique_ptr<mir::SSAGraph>>& graphs, int block_idx);
+
 }  // namespace lite
 }  // namespace paddle
@@ -97,6 +97,14 @@ void TypeLayoutTransformPass::ComplementInputs(
     VLOG(4) << "found Layout unmatched tensor: " << in->AsArg().name
             << " for kernel " << inst.op()->DebugString() << " "
             << *in->AsArg().type << " -> " << *decl_arg_type;
+    // The blocked tensor is restored to NCHW for the kernels of any layout,
+    // so the activations stay blocked until the end of the x86 conv chain.
+    if (in_arg_type->layout() == DATALAYOUT(kNCHW8c) &&
+        decl_arg_type->layout() == DATALAYOUT(kAny)) {
+      decl_arg_type = LiteType::GetTensorTy(decl_arg_type->target(),
+                                            decl_arg_type->precision(),
+                                            DATALAYOUT(kNCHW));
+    }
     AddLayoutInst(*in->AsArg().type,
                   *decl_arg_type,
                   in,
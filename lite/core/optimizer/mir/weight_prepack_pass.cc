@@ -0,0 +1,104 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/weight_prepack_pass.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::map<std::string, std::string> WeightPrepackPass::prepack_weight_ops =
+    {{"fc", "W"},
+     {"mul", "Y"},
+     {"matmul", "Y"},
+     {"conv2d", "Filter"},
+     {"depthwise_conv2d", "Filter"}};
+
+// The weight node which is the input `arg_name` of the op node, nullptr is
+// returned if the input isn't a weight.
+static Node* FindWeightNode(Node* op_node, const std::string& arg_name) {
+  auto* op_info = op_node->AsStmt().op_info();
+  if (!op_info->HasInput(arg_name) || op_info->Input(arg_name).size() != 1) {
+    return nullptr;
+  }
+  const std::string& weight_name = op_info->Input(arg_name).front();
+  for (auto* in : op_node->inlinks) {
+    if (in->IsArg() && in->arg()->name == weight_name) {
+      return in->arg()->is_weight ? in : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+void WeightPrepackPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto* op_node : graph->StmtTopologicalOrder()) {
+    auto& stmt = op_node->AsStmt();
+    auto iter = prepack_weight_ops.find(stmt.op_type());
+    if (iter == prepack_weight_ops.end() ||
+        stmt.op_info()->HasInput(kPrepackedWeightInput)) {
+      continue;
+    }
+    auto* weight_node = FindWeightNode(op_node, iter->second);
+    if (weight_node == nullptr) {
+      continue;
+    }
+    auto& kernel = stmt.picked_kernel();
+    Tensor prepacked;
+    std::string key = kernel.PrepackWeights(&prepacked);
+    if (key.empty()) {
+      continue;
+    }
+
+    // The weights shared by several ops are prepacked for each of them, as
+    // the transform may depend on the attrs of the op.
+    auto* scope = stmt.op()->scope();
+    const std::string& weight_name = weight_node->arg()->name;
+    std::string prepacked_name = weight_name + "_prepacked";
+    for (int i = 1; scope->FindVar(prepacked_name); i++) {
+      prepacked_name = weight_name + "_prepacked_" + std::to_string(i);
+    }
+    auto* prepacked_node = graph->NewArgumentNode(prepacked_name);
+    prepacked_node->arg()->is_weight = true;
+    prepacked_node->arg()->type = LiteType::GetTensorTy(
+        kernel.target(), prepacked.precision(), DATALAYOUT(kNCHW));
+    auto* prepacked_weight = scope->NewTensor(prepacked_name);
+    prepacked_weight->ShareDataWith(prepacked);
+    prepacked_weight->set_persistable(true);
+
+    // Attach the op and the picked kernel again, the kernel is kept as its
+    // context has been assigned.
+    auto op_desc = *stmt.op_info();
+    op_desc.SetInput(kPrepackedWeightInput, {prepacked_name});
+    op_desc.SetAttr<std::string>(kPrepackedWeightKeyAttr, key);
+    stmt.op()->Attach(op_desc, scope);
+    stmt.op()->AttachKernel(&kernel);
+    IR_NODE_LINK_TO(prepacked_node, op_node);
+    VLOG(4) << "Prepack the weight " << weight_name << " of "
+            << stmt.op_type() << " as " << prepacked_name << " with the key "
+            << key;
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(weight_prepack_pass, paddle::lite::mir::WeightPrepackPass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,48 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Run the weight transform of the picked kernels ahead of time, so the
+ * weights are not transformed again by PrepareForRun on every start:
+ *   fc: W
+ *   mul, matmul: the persistable Y
+ *   conv2d, depthwise_conv2d: Filter
+ * The transformed weights are added as the persistable "PrepackedWeight"
+ * input of the op, which is saved to the optimized model, and the key of
+ * their layout is set to the attr "prepacked_weight_key". The kernels adopt
+ * them only if the key matches, see KernelBase::PrepackWeights. The pass
+ * is run by the CxxConfig predictor only, the x86 kernels of the opt tool
+ * are built without the packed sgemm and transform nothing.
+ */
+class WeightPrepackPass : public ProgramPass {
+ public:
+  // The ops and the names of their weight inputs.
+  static const std::map<std::string, std::string> prepack_weight_ops;
+
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -54,6 +54,8 @@ std::unique_ptr<RuntimeProgram> Optimizer::Run(Program&& program) {
   InitTargetTypeTransformPass();
   InitControlFlowOpUnusedInputsAndOutputsEliminatePass();
   InitControlFlowOpSharedInputsAndOutputsPlaceSyncPass();
+  InitCommonSubexpressionEliminationPass();
+  InitDeadCodeEliminationPass();
 
   ApplyPasses(&graphs_);
 
@@ -98,6 +100,25 @@ void Optimizer::InitControlFlowOpSharedInputsAndOutputsPlaceSyncPass() {
   pass->SetAllGraphs(&graphs_);
 }
 
+void Optimizer::InitCommonSubexpressionEliminationPass() {
+  auto* pass =
+      mir::PassManager::Global()
+          .LookUp<mir::CommonSubexpressionEliminationPass>(
+              "common_subexpression_elimination_pass");
+  CHECK(pass);
+  CHECK(!graphs_.empty());
+  pass->SetAllGraphs(&graphs_);
+}
+
+void Optimizer::InitDeadCodeEliminationPass() {
+  auto* pass =
+      mir::PassManager::Global().LookUp<mir::DeadCodeEliminationPass>(
+          "dead_code_elimination_pass");
+  CHECK(pass);
+  CHECK(!graphs_.empty());
+  pass->SetAllGraphs(&graphs_);
+}
+
 void Optimizer::ApplyPasses(
     std::vector<std::unique_ptr<mir::SSAGraph>>* graphes) {
   for (auto& pass : passes_) {
@@ -137,7 +158,10 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "weight_quantization_preprocess_pass",      //
        "op_transformation_pass",                   //
        "remove_scale1_pass",                       //
+       "constant_folding_pass",                    //
        "adaptive_1x1_pool2d_convert_global_pass",  //
+       // Before the matmul fusions which break the attention pattern.
+       "lite_fused_multihead_attention_fuse_pass",
        "lite_conv_elementwise_fuse_pass",          // conv-elemwise-bn
        "lite_conv_bn_fuse_pass",                   //
        "lite_conv_elementwise_fuse_pass",          // conv-bn-elemwise
@@ -160,6 +184,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_sequence_reverse_embedding_fuse_pass",   //
        "elementwise_mul_constant_eliminate_pass",     //
        "lite_sequence_pool_concat_fuse_pass",         //
+       "lite_embedding_seq_pool_fuse_pass",           //
        "lite_scale_activation_fuse_pass",             //
        "lite_scaleacts_fuse_pass",                    //
        "lite_elementwise_scale_fuse_pass",            //
@@ -201,6 +226,11 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "fix_mismatched_precision_pass",
        "__xpu__dynamic_lstm_fuse_pass",
        "ssd_boxes_calc_offline_pass",
+       // Merge the duplicated ops and remove the unused ones left by the
+       // fusions before the subgraphs are partitioned and the kernels are
+       // picked.
+       "common_subexpression_elimination_pass",
+       "dead_code_elimination_pass",
        // Only for fully quantized model, infer the output scale and fix the
        // attribute 'enable_int8' for all of the quantized ops.
        "quantized_op_attributes_inference_pass",
@@ -288,11 +318,18 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
   // runtime_context_assign_pass
   // post_quant_dynamic_pass must be in the behind of
   // lite_quant_dequant_fuse_pass
+  // embedding_compress_pass must be in the front of static_kernel_pick_pass
+  // as it resets the ops
+  // bf16_weight_pass must be in the front of static_kernel_pick_pass, and in
+  // the behind of embedding_compress_pass to skip the compressed tables
   const std::string msa_pass{"multi_stream_analysis_pass"};
   const std::string msa_depend_pass{"runtime_context_assign_pass"};
   const std::string pqd_pass{"post_quant_dynamic_pass"};
   const std::string pqd_depend_pass{"lite_quant_dequant_fuse_pass"};
   const std::string fp16_pass{"fp16_attribute_pass"};
+  const std::string ec_pass{"embedding_compress_pass"};
+  const std::string ec_depend_pass{"static_kernel_pick_pass"};
+  const std::string bf16_pass{"bf16_weight_pass"};
 
   for (const std::string& pass : passes) {
     if (pass == msa_pass) {
@@ -305,6 +342,16 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
           std::find(passes_local.begin(), passes_local.end(), pqd_depend_pass);
       CHECK(iter != passes_local.end()) << "No find " << pqd_depend_pass;
       passes_local.insert(iter + 1, pqd_pass);
+    } else if (pass == ec_pass) {
+      auto iter =
+          std::find(passes_local.begin(), passes_local.end(), ec_depend_pass);
+      CHECK(iter != passes_local.end()) << "No find " << ec_depend_pass;
+      passes_local.insert(iter, ec_pass);
+    } else if (pass == bf16_pass) {
+      auto iter =
+          std::find(passes_local.begin(), passes_local.end(), ec_depend_pass);
+      CHECK(iter != passes_local.end()) << "No find " << ec_depend_pass;
+      passes_local.insert(iter, bf16_pass);
     } else {
       passes_local.push_back(pass);
     }
@@ -20,7 +20,9 @@
 #include <utility>
 #include <vector>
 #include "lite/core/optimizer/mir/control_flow_op_shared_inputs_and_outputs_place_sync_pass.h"
+#include "lite/core/optimizer/mir/elimination/common_subexpression_elimination_pass.h"
 #include "lite/core/optimizer/mir/elimination/control_flow_op_unused_inputs_and_outputs_eliminate_pass.h"
+#include "lite/core/optimizer/mir/elimination/dead_code_elimination_pass.h"
 #include "lite/core/optimizer/mir/fp16_attribute_pass.h"
 #include "lite/core/optimizer/mir/generate_program_pass.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
@@ -38,7 +40,7 @@ namespace lite {
 
 // TODO(hong1986032) Support the following passes for the subblocks
 const std::set<std::string> kSubblockUnsupportedPasses(
-    {"memory_optimize_pass"});
+    {"memory_optimize_pass", "constant_folding_pass"});
 
 /*
  * lite::Optimizer optimize a program. It utilize the mir passes to analysis the
@@ -75,6 +77,8 @@ class Optimizer {
   void InitTargetTypeTransformPass();
   void InitControlFlowOpUnusedInputsAndOutputsEliminatePass();
   void InitControlFlowOpSharedInputsAndOutputsPlaceSyncPass();
+  void InitCommonSubexpressionEliminationPass();
+  void InitDeadCodeEliminationPass();
   void SpecifyKernelPickTactic(core::KernelPickFactor factor);
   Scope* exec_scope() { return exec_scope_; }
 
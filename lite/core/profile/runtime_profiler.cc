@@ -0,0 +1,138 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/runtime_profiler.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+namespace {
+
+std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+std::string ShapesToStr(const std::vector<lite_api::shape_t>& shapes) {
+  std::string str;
+  for (size_t i = 0; i < shapes.size(); i++) {
+    if (i > 0) str += ",";
+    str += "[";
+    for (size_t j = 0; j < shapes[i].size(); j++) {
+      if (j > 0) str += ",";
+      str += std::to_string(shapes[i][j]);
+    }
+    str += "]";
+  }
+  return str;
+}
+
+}  // namespace
+
+void RuntimeProfiler::Enable(int sample_interval, int max_records) {
+  CHECK_GT(sample_interval, 0) << "The sample interval should be positive.";
+  CHECK_GT(max_records, 0) << "The max number of records should be positive.";
+  std::lock_guard<std::mutex> lock(mutex_);
+  sample_interval_ = sample_interval;
+  max_records_ = static_cast<size_t>(max_records);
+  num_runs_ = 0;
+  run_id_ = -1;
+  num_dropped_records_ = 0;
+  records_.clear();
+  start_ = std::chrono::steady_clock::now();
+  enabled_ = true;
+}
+
+void RuntimeProfiler::Disable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_ = false;
+  run_id_ = -1;
+}
+
+bool RuntimeProfiler::StartRun() {
+  if (!enabled_) return false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!enabled_) return false;
+  bool sampled = num_runs_ % sample_interval_ == 0;
+  num_runs_++;
+  if (sampled) run_id_++;
+  return sampled;
+}
+
+double RuntimeProfiler::Now() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start_)
+      .count();
+}
+
+void RuntimeProfiler::AddRecord(Record&& record) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The run was started before the profiling is disabled or enabled again.
+  if (!enabled_ || run_id_ < 0) return;
+  record.run_id = run_id_;
+  if (records_.size() >= max_records_) {
+    records_.pop_front();
+    num_dropped_records_++;
+  }
+  records_.push_back(std::move(record));
+}
+
+std::vector<RuntimeProfiler::Record> RuntimeProfiler::records() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::vector<Record>(records_.begin(), records_.end());
+}
+
+int64_t RuntimeProfiler::num_dropped_records() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_dropped_records_;
+}
+
+std::string RuntimeProfiler::ChromeTrace() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string trace = "{\"traceEvents\":[";
+  for (auto it = records_.begin(); it != records_.end(); ++it) {
+    const auto& record = *it;
+    if (it != records_.begin()) trace += ",";
+    trace += "{\"name\":\"" + EscapeJson(record.op_type) + "\"";
+    trace += ",\"cat\":\"op\",\"ph\":\"X\",\"pid\":0";
+    trace += ",\"tid\":" + std::to_string(record.run_id);
+    trace += ",\"ts\":" + std::to_string(record.start_us);
+    trace += ",\"dur\":" + std::to_string(record.duration_us);
+    trace += ",\"args\":{\"kernel\":\"" + EscapeJson(record.kernel) + "\"";
+    trace += ",\"inputs\":\"" + ShapesToStr(record.input_shapes) + "\"";
+    trace += ",\"outputs\":\"" + ShapesToStr(record.output_shapes) + "\"";
+    trace += ",\"gops\":" + std::to_string(record.gops);
+    trace += ",\"allocated_bytes\":" + std::to_string(record.allocated_bytes);
+    trace += "}}";
+  }
+  trace += "],\"displayTimeUnit\":\"ms\"}";
+  return trace;
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
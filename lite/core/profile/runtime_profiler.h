@@ -0,0 +1,80 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <deque>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+/*
+ * RuntimeProfiler collects the op level records of the sampled runs of a
+ * RuntimeProgram. Unlike Profiler, it's always compiled and switched at
+ * runtime, so the release builds can be profiled without rebuilding.
+ * All the methods are guarded by a mutex, so the profiling can be switched
+ * and the records can be read while the predictor is running on another
+ * thread. The records of a run which is in flight when the profiling is
+ * disabled or enabled again are dropped.
+ */
+class RuntimeProfiler {
+ public:
+  using Record = lite_api::OpProfileRecord;
+
+  // Enable the profiling, one of every `sample_interval` runs is profiled.
+  // At most `max_records` records are kept, the oldest ones are dropped when
+  // the limit is reached so that a long running service doesn't run out of
+  // memory.
+  void Enable(int sample_interval,
+              int max_records = lite_api::kDefaultMaxProfileRecords);
+  void Disable();
+  bool enabled() const { return enabled_; }
+
+  // Called at the beginning of each run, return true if the run is profiled.
+  bool StartRun();
+  // The microseconds since the profiling is enabled.
+  double Now() const;
+  void AddRecord(Record&& record);
+  // The kept records in the order they are added.
+  std::vector<Record> records() const;
+  // The number of the records dropped since the profiling is enabled.
+  int64_t num_dropped_records() const;
+
+  // Export the records as the Chrome trace events, each profiled run is
+  // shown as a separate thread.
+  std::string ChromeTrace() const;
+
+ private:
+  // The unsampled runs only check it, without taking the mutex.
+  std::atomic<bool> enabled_{false};
+  mutable std::mutex mutex_;
+  int sample_interval_{1};
+  int64_t num_runs_{0};
+  int run_id_{-1};
+  std::chrono::steady_clock::time_point start_;
+  size_t max_records_{static_cast<size_t>(lite_api::kDefaultMaxProfileRecords)};
+  int64_t num_dropped_records_{0};
+  std::deque<Record> records_;
+};
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,92 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/runtime_profiler.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+// Record the ops of a run like RuntimeProgram::Run.
+static void ProfileRun(RuntimeProfiler* profiler, int num_ops) {
+  if (!profiler->StartRun()) return;
+  for (int i = 0; i < num_ops; i++) {
+    RuntimeProfiler::Record record;
+    record.op_type = "op" + std::to_string(i);
+    record.start_us = profiler->Now();
+    record.duration_us = profiler->Now() - record.start_us;
+    profiler->AddRecord(std::move(record));
+  }
+}
+
+TEST(runtime_profiler, sample_runs) {
+  RuntimeProfiler profiler;
+  ProfileRun(&profiler, 3);
+  EXPECT_TRUE(profiler.records().empty());
+  profiler.Enable(2);
+  for (int i = 0; i < 4; i++) {
+    ProfileRun(&profiler, 3);
+  }
+  auto records = profiler.records();
+  ASSERT_EQ(records.size(), 6u);
+  for (size_t i = 0; i < records.size(); i++) {
+    EXPECT_EQ(records[i].run_id, static_cast<int>(i / 3));
+  }
+}
+
+// The records of the run in flight are dropped when the profiling is
+// switched.
+TEST(runtime_profiler, switch_during_run) {
+  RuntimeProfiler profiler;
+  profiler.Enable(1);
+  ASSERT_TRUE(profiler.StartRun());
+  profiler.Enable(1);
+  profiler.AddRecord(RuntimeProfiler::Record());
+  EXPECT_TRUE(profiler.records().empty());
+  ASSERT_TRUE(profiler.StartRun());
+  profiler.Disable();
+  profiler.AddRecord(RuntimeProfiler::Record());
+  EXPECT_TRUE(profiler.records().empty());
+}
+
+// The profiling is switched and the records are read while the runs are
+// recorded on another thread.
+TEST(runtime_profiler, concurrent_access) {
+  RuntimeProfiler profiler;
+  std::atomic<bool> stop{false};
+  std::thread runner([&] {
+    while (!stop) {
+      ProfileRun(&profiler, 5);
+    }
+  });
+  for (int i = 0; i < 200; i++) {
+    profiler.Enable(1 + i % 3, 64);
+    for (auto& record : profiler.records()) {
+      EXPECT_GE(record.run_id, 0);
+    }
+    EXPECT_GE(profiler.num_dropped_records(), 0);
+    EXPECT_FALSE(profiler.ChromeTrace().empty());
+    if (i % 2) profiler.Disable();
+  }
+  stop = true;
+  runner.join();
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
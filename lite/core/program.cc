@@ -15,9 +15,12 @@
 #include "lite/core/program.h"
 
 #include <algorithm>
+#include <condition_variable>  // NOLINT
 #include <map>
+#include <mutex>  // NOLINT
 #include <set>
 
+#include "lite/core/memory.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/conditional_block_op.h"
 #include "lite/operators/subgraph_op.h"
@@ -28,9 +31,84 @@
 #ifdef LITE_WITH_FPGA
 #include "lite/backends/fpga/monitor.hpp"
 #endif
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#endif
 
 namespace paddle {
 namespace lite {
+namespace {
+// The ops which contain sub-blocks or whose output shapes depend on the data
+// of the inputs, the shapes of their outputs can't be replayed.
+const std::set<std::string> kShapeReplayUnsupportedOps = {
+    "while",
+    "conditional_block",
+    "conditional_block_infer",
+    "subgraph",
+    "write_to_array",
+    "read_from_array",
+    "tensor_array_to_tensor",
+    "lod_array_length",
+    "merge_lod_tensor",
+    "split_lod_tensor",
+    "beam_search",
+    "beam_search_decode",
+    "lod_reset",
+    "where_index",
+    "range",
+    "linspace",
+    "multiclass_nms",
+    "multiclass_nms2",
+    "multiclass_nms3",
+    "matrix_nms",
+    "generate_proposals",
+    "generate_proposals_v2",
+    "distribute_fpn_proposals",
+    "collect_fpn_proposals",
+    "retinanet_detection_output",
+    "unique_with_counts",
+    "select_input",
+    "write_back",
+    "im2sequence",
+    "sequence_mask",
+    "sequence_unpad",
+    "ctc_align",
+    "crop",
+};
+
+// The input arguments which carry the output shapes as data, such as
+// reshape2's ShapeTensor and slice's StartsTensor.
+const std::set<std::string> kShapeTensorArguments = {
+    "Shape",
+    "ShapeTensor",
+    "ShapeTensorList",
+    "StartsTensor",
+    "StartsTensorList",
+    "EndsTensor",
+    "EndsTensorList",
+    "StridesTensor",
+    "StridesTensorList",
+    "AxesTensor",
+    "AxesTensorList",
+    "AxisTensor",
+    "SectionsTensorList",
+    "ExpandTimes",
+    "RepeatTimes",
+    "OutSize",
+    "SizeTensor",
+    "Offsets",
+    "OffsetsTensor",
+    "Paddings",
+    "K",
+    "depth_tensor",
+    "repeat_times_tensor",
+    "expand_times_tensor",
+    "expand_shapes_tensor",
+    "OutputShape",
+    "Axis",
+};
+}  // namespace
+
 #ifndef LITE_ON_TINY_PUBLISH
 namespace {
 // Verify the validity of ProgramDesc
@@ -97,6 +175,7 @@ void UpdateVarDescFromTensorInfo(cpp::VarDesc* var,
     break
       SET_DATATYPE(kBool, VarDescAPI::VarDataType::BOOL);
       SET_DATATYPE(kFP16, VarDescAPI::VarDataType::FP16);
+      SET_DATATYPE(kBF16, VarDescAPI::VarDataType::BF16);
       SET_DATATYPE(kFloat, VarDescAPI::VarDataType::FP32);
       SET_DATATYPE(kFP64, VarDescAPI::VarDataType::FP64);
       SET_DATATYPE(kUInt8, VarDescAPI::VarDataType::UINT8);
@@ -459,6 +538,21 @@ void RuntimeProgram::Run() {
   monitor.inferStart();
 #endif
 
+  bool replay_shape = enable_shape_replay_ && !FeedShapesChanged();
+
+  const bool profiling = runtime_profiler_ && runtime_profiler_->StartRun();
+  double start_us = 0.;
+  size_t malloc_bytes = 0;
+
+#if defined(LITE_WITH_X86) && !defined(LITE_WITH_PROFILE) && \
+    !defined(LITE_WITH_PRECISION_PROFILE)
+  // The profiled runs are serial to get the exclusive time of each op.
+  if (inter_op_parallel_ && !profiling && x86::GetMaxThreads() > 1) {
+    RunInterOpParallel(replay_shape);
+    return;
+  }
+#endif
+
   int idx = -1;
 
   auto& insts = instructions_[kRootBlockIdx];
@@ -467,6 +561,7 @@ void RuntimeProgram::Run() {
 #if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
     if (inst.is_feed_fetch_op()) continue;
 #endif
+    inst.set_replay_shape(replay_shape);
 #ifdef LITE_WITH_NVTX
     NVTXRangeAnnotation annotation = annotator.AnnotateBlock();
     nvtxStringHandle_t registered_name = register_layer_names_[idx];
@@ -484,8 +579,17 @@ void RuntimeProgram::Run() {
     monitor.preRun(inst);
 #endif
 
+    if (profiling) {
+      start_us = runtime_profiler_->Now();
+      malloc_bytes = TargetMallocBytes();
+    }
+
     inst.Run();
 
+    if (profiling) {
+      AddProfileRecord(inst, start_us, malloc_bytes);
+    }
+
 #ifdef LITE_WITH_FPGA
     monitor.postRun(inst);
 #endif
@@ -520,6 +624,195 @@ void RuntimeProgram::Run() {
 #endif
 }
 
+void RuntimeProgram::InitShapeReplay() {
+  enable_shape_replay_ = false;
+  feed_tensors_.clear();
+  feed_shapes_.clear();
+  feed_lods_.clear();
+#if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    auto* op = const_cast<OpLite*>(inst.op());
+    if (op->Type() == "feed") {
+      for (auto& var_name : op->op_info()->Output("Out")) {
+        auto* var = op->scope()->FindVar(var_name);
+        if (var == nullptr) return;
+        feed_tensors_.push_back(var->GetMutable<Tensor>());
+      }
+      continue;
+    }
+    if (inst.is_feed_fetch_op()) continue;
+    if (!inst.SupportShapeReplay()) {
+      VLOG(4) << "Disable the shape replay because of " << op->Type();
+      return;
+    }
+  }
+  if (feed_tensors_.empty()) return;
+  enable_shape_replay_ = true;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    inst.set_record_shape(true);
+  }
+#endif
+}
+
+bool RuntimeProgram::FeedShapesChanged() {
+  bool changed = feed_shapes_.size() != feed_tensors_.size();
+  for (size_t i = 0; i < feed_tensors_.size() && !changed; i++) {
+    changed = feed_tensors_[i]->dims() != feed_shapes_[i] ||
+              feed_tensors_[i]->lod() != feed_lods_[i];
+  }
+  if (!changed) return false;
+  feed_shapes_.resize(feed_tensors_.size());
+  feed_lods_.resize(feed_tensors_.size());
+  for (size_t i = 0; i < feed_tensors_.size(); i++) {
+    feed_shapes_[i] = feed_tensors_[i]->dims();
+    feed_lods_[i] = feed_tensors_[i]->lod();
+  }
+  return true;
+}
+
+void RuntimeProgram::set_inter_op_parallel(bool enable) {
+#ifdef LITE_WITH_X86
+  inter_op_parallel_ = enable && InitInterOpParallel();
+#endif
+}
+
+bool RuntimeProgram::InitInterOpParallel() {
+  auto& insts = instructions_[kRootBlockIdx];
+  const int num_insts = static_cast<int>(insts.size());
+  inst_successors_.assign(num_insts, {});
+  inst_num_deps_.assign(num_insts, 0);
+  inst_priorities_.assign(num_insts, 1);
+  num_parallel_insts_ = 0;
+  std::vector<std::set<int>> successors(num_insts);
+  // The last writer and the readers after it of each var.
+  std::map<std::string, int> writers;
+  std::map<std::string, std::vector<int>> readers;
+  for (int i = 0; i < num_insts; i++) {
+    auto& inst = insts[i];
+    if (inst.is_feed_fetch_op()) continue;
+    auto target = inst.kernel()->target();
+    if (target != TARGET(kHost) && target != TARGET(kX86) &&
+        target != TARGET(kAny)) {
+      VLOG(4) << "Disable the inter-op parallel because of the target "
+              << TargetToStr(target) << " of " << inst.op()->Type();
+      return false;
+    }
+    auto* op_info = inst.op()->op_info();
+    if (op_info->HasAttr("sub_block") || inst.op()->Type() == "subgraph") {
+      VLOG(4) << "Disable the inter-op parallel because of "
+              << inst.op()->Type();
+      return false;
+    }
+    num_parallel_insts_++;
+    // Read after write.
+    for (auto& var_name : op_info->input_names()) {
+      if (writers.count(var_name) && writers[var_name] != i) {
+        successors[writers[var_name]].insert(i);
+      }
+      readers[var_name].push_back(i);
+    }
+    // Write after write and write after read, the vars which share the same
+    // buffer by the memory reuse plan are handled here too.
+    for (auto& var_name : op_info->output_names()) {
+      if (writers.count(var_name) && writers[var_name] != i) {
+        successors[writers[var_name]].insert(i);
+      }
+      for (int reader : readers[var_name]) {
+        if (reader != i) successors[reader].insert(i);
+      }
+      writers[var_name] = i;
+      readers[var_name].clear();
+    }
+  }
+  for (int i = num_insts - 1; i >= 0; i--) {
+    for (int next : successors[i]) {
+      inst_successors_[i].push_back(next);
+      inst_num_deps_[next]++;
+      inst_priorities_[i] =
+          (std::max)(inst_priorities_[i], inst_priorities_[next] + 1);
+    }
+  }
+  return num_parallel_insts_ > 1;
+}
+
+void RuntimeProgram::RunInterOpParallel(bool replay_shape) {
+#ifdef LITE_WITH_X86
+  auto& insts = instructions_[kRootBlockIdx];
+  std::vector<int> num_deps(inst_num_deps_);
+  std::vector<int> ready_insts;
+  for (size_t i = 0; i < insts.size(); i++) {
+    if (insts[i].is_feed_fetch_op()) continue;
+    insts[i].set_replay_shape(replay_shape);
+    if (num_deps[i] == 0) ready_insts.push_back(i);
+  }
+  int num_remaining = num_parallel_insts_;
+  std::mutex mutex;
+  std::condition_variable cond;
+  // Each thread takes the ready instruction with the highest priority, and
+  // releases its successors after running it, until all of the instructions
+  // are finished. The kernels run single-threaded in the parallel region.
+  auto run_insts = [&](int64_t begin, int64_t end) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cond.wait(lock, [&] { return !ready_insts.empty() || !num_remaining; });
+      if (num_remaining == 0) break;
+      auto iter = std::max_element(
+          ready_insts.begin(), ready_insts.end(), [&](int a, int b) {
+            return inst_priorities_[a] < inst_priorities_[b];
+          });
+      int idx = *iter;
+      ready_insts.erase(iter);
+      lock.unlock();
+      insts[idx].Run();
+      lock.lock();
+      num_remaining--;
+      for (int next : inst_successors_[idx]) {
+        if (--num_deps[next] == 0) ready_insts.push_back(next);
+      }
+      if (num_remaining == 0 || !ready_insts.empty()) cond.notify_all();
+    }
+  };
+  x86::RunParallelFor(0, x86::GetMaxThreads(), run_insts, 1);
+#endif
+}
+
+void RuntimeProgram::AddProfileRecord(const Instruction& inst,
+                                      double start_us,
+                                      size_t malloc_bytes) {
+#ifdef LITE_WITH_CUDA
+  if (inst.need_sync()) {
+    inst.Sync();
+  }
+#endif
+  profile::RuntimeProfiler::Record record;
+  record.start_us = start_us;
+  record.duration_us = runtime_profiler_->Now() - start_us;
+  record.allocated_bytes =
+      static_cast<int64_t>(TargetMallocBytes() - malloc_bytes);
+  auto* op = const_cast<OpLite*>(inst.op());
+  record.op_type = op->Type();
+  record.kernel = inst.kernel()->summary();
+  auto get_shapes = [&](const std::vector<std::string>& var_names) {
+    std::vector<lite_api::shape_t> shapes;
+    for (auto& var_name : var_names) {
+      auto* var = op->scope()->FindVar(var_name);
+      if (var != nullptr && var->IsType<Tensor>()) {
+        shapes.push_back(var->Get<Tensor>().dims().Vectorize());
+      }
+    }
+    return shapes;
+  };
+  record.input_shapes = get_shapes(op->op_info()->input_names());
+  record.output_shapes = get_shapes(op->op_info()->output_names());
+#ifdef LITE_WITH_PROFILE
+  profile::OpCharacter ch;
+  ch.op_lite = static_cast<void*>(op);
+  op->GetOpRuntimeInfo(&ch);
+  record.gops = ch.macs * 1e-9f;
+#endif
+  runtime_profiler_->AddRecord(std::move(record));
+}
+
 void Program::Build(const std::shared_ptr<cpp::ProgramDesc>& program_desc) {
   CHECK(ops_.empty()) << "Executor duplicate Build found";
 
@@ -572,6 +865,8 @@ void Program::PrepareWorkspace(
         return PRECISION(kFloat);
       case lite::VarDescAPI::Type::FP16:
         return PRECISION(kFP16);
+      case lite::VarDescAPI::Type::BF16:
+        return PRECISION(kBF16);
       case lite::VarDescAPI::Type::INT8:
         return PRECISION(kInt8);
       case lite::VarDescAPI::Type::INT16:
@@ -692,7 +987,14 @@ void Instruction::Run() {
     return;
   }
 
-  op_->InferShape();
+  if (replay_shape_ || (replay_shape_by_inputs_ && !InputShapesChanged())) {
+    ReplayOutputShapes();
+  } else {
+    op_->InferShape();
+    if (record_shape_ || replay_shape_by_inputs_) {
+      RecordOutputShapes();
+    }
+  }
   kernel_->Launch();
   has_run_ = true;
 
@@ -706,6 +1008,82 @@ void Instruction::Run() {
 #endif
 }
 
+bool Instruction::SupportShapeReplay() const {
+  if (kShapeReplayUnsupportedOps.count(op_->Type())) return false;
+  auto* op_info = op_->op_info();
+  for (auto& arg_name : op_info->InputArgumentNames()) {
+    if (kShapeTensorArguments.count(arg_name) &&
+        !op_info->Input(arg_name).empty()) {
+      return false;
+    }
+  }
+  // The output shape of the interpolate ops may be given by the data of the
+  // input Scale.
+  if (op_->Type().find("interp") != std::string::npos &&
+      op_info->HasInput("Scale") && !op_info->Input("Scale").empty()) {
+    return false;
+  }
+  for (auto& var_name : op_info->output_names()) {
+    auto* var = op_->scope()->FindVar(var_name);
+    if (var == nullptr || !var->IsType<Tensor>()) return false;
+  }
+  return true;
+}
+
+void Instruction::RecordOutputShapes() {
+  if (output_tensors_.empty()) {
+    for (auto& var_name : op_->op_info()->output_names()) {
+      output_tensors_.push_back(
+          op_->scope()->FindVar(var_name)->GetMutable<Tensor>());
+    }
+  }
+  output_shapes_.resize(output_tensors_.size());
+  output_lods_.resize(output_tensors_.size());
+  for (size_t i = 0; i < output_tensors_.size(); i++) {
+    output_shapes_[i] = output_tensors_[i]->dims();
+    output_lods_[i] = output_tensors_[i]->lod();
+  }
+}
+
+void Instruction::ReplayOutputShapes() {
+  CHECK_EQ(output_shapes_.size(), output_tensors_.size())
+      << "The shapes of the outputs of " << op_->Type()
+      << " should be recorded before being replayed.";
+  for (size_t i = 0; i < output_tensors_.size(); i++) {
+    output_tensors_[i]->Resize(output_shapes_[i]);
+    output_tensors_[i]->set_lod(output_lods_[i]);
+  }
+}
+
+bool Instruction::InputShapesChanged() {
+  if (input_tensors_.empty()) {
+    for (auto& var_name : op_->op_info()->input_names()) {
+      auto* var = op_->scope()->FindVar(var_name);
+      if (var == nullptr || !var->IsType<Tensor>()) {
+        // The shapes of the outputs may depend on the tensor arrays.
+        replay_shape_by_inputs_ = false;
+        input_tensors_.clear();
+        return true;
+      }
+      input_tensors_.push_back(&var->Get<Tensor>());
+    }
+    input_shapes_.resize(input_tensors_.size());
+    input_lods_.resize(input_tensors_.size());
+  } else {
+    bool changed = false;
+    for (size_t i = 0; i < input_tensors_.size() && !changed; i++) {
+      changed = input_tensors_[i]->dims() != input_shapes_[i] ||
+                input_tensors_[i]->lod() != input_lods_[i];
+    }
+    if (!changed) return false;
+  }
+  for (size_t i = 0; i < input_tensors_.size(); i++) {
+    input_shapes_[i] = input_tensors_[i]->dims();
+    input_lods_[i] = input_tensors_[i]->lod();
+  }
+  return true;
+}
+
 STL::ostream& operator<<(STL::ostream& os, const Instruction& other) {
   os << other.kernel_->summary() << "\t(" << other.kernel_->doc() << ")";
   return os;
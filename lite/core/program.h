@@ -20,8 +20,10 @@
 #include <utility>
 #include <vector>
 #include "lite/core/kernel.h"
+#include "lite/core/kernel_tuner.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/profile/runtime_profiler.h"
 #include "lite/model_parser/cpp_desc.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
@@ -130,6 +132,18 @@ struct Instruction {
 
   bool is_feed_fetch_op() const { return is_feed_fetch_op_; }
 
+  // Whether the shapes and lods of the outputs only depend on the shapes and
+  // lods of the inputs, so they can be replayed instead of InferShape.
+  bool SupportShapeReplay() const;
+  // Record the shapes and lods of the outputs after InferShape.
+  void set_record_shape(bool x) { record_shape_ = x; }
+  // Replay the recorded shapes and lods of the outputs instead of InferShape.
+  void set_replay_shape(bool x) { replay_shape_ = x; }
+  // Replay the recorded shapes and lods of the outputs if the shapes and lods
+  // of the inputs are the same as the last InferShape, it's used by the
+  // instructions of the loop bodies which are run for every step.
+  void set_replay_shape_by_inputs(bool x) { replay_shape_by_inputs_ = x; }
+
 #ifdef LITE_WITH_CUDA
   bool need_sync() const {
     if (kernel_->target() == TargetType::kCUDA) {
@@ -180,11 +194,29 @@ struct Instruction {
 #endif
 
  private:
+  void RecordOutputShapes();
+  void ReplayOutputShapes();
+  // Return true and record the shapes and lods of the inputs if any of them
+  // is changed since the last call.
+  bool InputShapesChanged();
+
   std::shared_ptr<OpLite> op_;
   std::unique_ptr<KernelBase> kernel_;
   bool is_feed_fetch_op_{false};
   bool first_epoch_{true};
   bool has_run_{false};
+  bool record_shape_{false};
+  bool replay_shape_{false};
+  bool replay_shape_by_inputs_{false};
+  // The input tensors and their shapes and lods of the last InferShape.
+  std::vector<const Tensor*> input_tensors_;
+  std::vector<DDim> input_shapes_;
+  std::vector<LoD> input_lods_;
+  // The output tensors and their shapes and lods recorded by the last
+  // InferShape.
+  std::vector<Tensor*> output_tensors_;
+  std::vector<DDim> output_shapes_;
+  std::vector<LoD> output_lods_;
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_;
@@ -212,6 +244,10 @@ class LITE_API RuntimeProgram {
     CLRuntime::Global()->SaveProgram();
     CLRuntime::Global()->SaveTuned();
 #endif  // LITE_WITH_OPENCL
+#ifdef LITE_WITH_X86
+    // save the variants tuned for the x86 kernels
+    KernelTuner::Global().Save();
+#endif  // LITE_WITH_X86
 #ifdef LITE_WITH_PROFILE
     LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kCreate);
     LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kDispatch);
@@ -222,6 +258,7 @@ class LITE_API RuntimeProgram {
     if (instructions_.empty()) {
       LOG(FATAL) << "no instructions";
     }
+    InitShapeReplay();
 #ifdef LITE_WITH_PROFILE
     set_profiler();
 #endif
@@ -256,6 +293,17 @@ class LITE_API RuntimeProgram {
 
   size_t block_size() { return instructions_.size(); }
 
+  // Set the op level profiler which is switched at runtime, it's owned by the
+  // predictor.
+  void set_runtime_profiler(profile::RuntimeProfiler* profiler) {
+    runtime_profiler_ = profiler;
+  }
+
+  // Run the independent instructions of the root block concurrently on the
+  // x86 math threads, it's ignored if any instruction is not on the host or
+  // has sub-blocks.
+  void set_inter_op_parallel(bool enable);
+
 #ifndef LITE_ON_TINY_PUBLISH
   // Update the ops and vars of all of blocks to the given program_desc
   // according to the instructions
@@ -271,8 +319,41 @@ class LITE_API RuntimeProgram {
 
  private:
   RuntimeProgram(const RuntimeProgram&) = delete;
+  // Enable the shape replay if the shapes of all of the instructions only
+  // depend on the shapes and lods of the feed tensors.
+  void InitShapeReplay();
+  // Return true and record the shapes and lods of the feed tensors if any of
+  // them is changed since the last run.
+  bool FeedShapesChanged();
+  // Build the dependencies between the instructions of the root block from
+  // their input and output vars, return false if they can't run concurrently.
+  bool InitInterOpParallel();
+  void RunInterOpParallel(bool replay_shape);
+  // Add the record of the instruction which has just been run to the runtime
+  // profiler.
+  void AddProfileRecord(const Instruction& inst,
+                        double start_us,
+                        size_t malloc_bytes);
+
   std::vector<std::vector<Instruction>> instructions_;
   Scope* exec_scope_{};
+  // If the shapes and lods of the feed tensors are the same as the last run,
+  // the shapes and lods of the outputs recorded in the last run are replayed
+  // instead of calling InferShape for all of the instructions.
+  bool enable_shape_replay_{false};
+  std::vector<const Tensor*> feed_tensors_;
+  std::vector<DDim> feed_shapes_;
+  std::vector<LoD> feed_lods_;
+  profile::RuntimeProfiler* runtime_profiler_{nullptr};
+  // The dependency graph of the root block instructions for the inter-op
+  // parallel run, the feed and fetch instructions are excluded.
+  bool inter_op_parallel_{false};
+  std::vector<std::vector<int>> inst_successors_;
+  std::vector<int> inst_num_deps_;
+  // The length of the longest path from the instruction to the end, the
+  // ready instruction on the critical path is launched first.
+  std::vector<int> inst_priorities_;
+  int num_parallel_insts_{0};
 
 #ifdef LITE_WITH_METAL
   std::unique_ptr<KernelContext> metal_ctx_{nullptr};
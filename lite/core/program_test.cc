@@ -0,0 +1,177 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/program.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+std::shared_ptr<OpLite> CreateOp(const cpp::OpDesc& op_desc, Scope* scope) {
+  for (auto& arg_name : op_desc.InputArgumentNames()) {
+    for (auto& var_name : op_desc.Input(arg_name)) {
+      scope->Var(var_name)->GetMutable<Tensor>()->Resize({1});
+    }
+  }
+  for (auto& arg_name : op_desc.OutputArgumentNames()) {
+    for (auto& var_name : op_desc.Output(arg_name)) {
+      scope->Var(var_name)->GetMutable<Tensor>();
+    }
+  }
+  auto op = LiteOpRegistry::Global().Create(op_desc.Type());
+  CHECK(op) << "No op found for " << op_desc.Type();
+  op->Attach(op_desc, scope);
+  return op;
+}
+
+Instruction CreateInstruction(const cpp::OpDesc& op_desc, Scope* scope) {
+  auto op = CreateOp(op_desc, scope);
+  auto kernels = op->CreateKernels(
+      {Place{TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW)}});
+  CHECK(!kernels.empty()) << "No kernel found for " << op_desc.Type();
+  auto kernel = std::move(kernels.front());
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  return Instruction(op, std::move(kernel));
+}
+
+cpp::OpDesc FeedOpDesc(const std::string& out_name, int col) {
+  cpp::OpDesc op_desc;
+  op_desc.SetType("feed");
+  op_desc.SetInput("X", {"feed"});
+  op_desc.SetOutput("Out", {out_name});
+  op_desc.SetAttr<int>("col", col);
+  return op_desc;
+}
+
+bool SupportShapeReplay(const cpp::OpDesc& op_desc) {
+  Scope scope;
+  Instruction inst(CreateOp(op_desc, &scope), std::unique_ptr<KernelBase>());
+  return inst.SupportShapeReplay();
+}
+}  // namespace
+
+TEST(RuntimeProgram, replay_shapes_until_feed_shapes_change) {
+  Scope scope;
+  scope.Var("feed")->GetMutable<std::vector<Tensor>>()->resize(1);
+  auto* x = scope.Var("x")->GetMutable<Tensor>();
+  auto* out = scope.Var("out")->GetMutable<Tensor>();
+
+  cpp::OpDesc reshape_desc;
+  reshape_desc.SetType("reshape");
+  reshape_desc.SetInput("X", {"x"});
+  reshape_desc.SetOutput("Out", {"out"});
+  reshape_desc.SetAttr<std::vector<int>>("shape", {3, 4});
+
+  std::vector<std::vector<Instruction>> insts(1);
+  insts[0].push_back(CreateInstruction(FeedOpDesc("x", 0), &scope));
+  insts[0].push_back(CreateInstruction(reshape_desc, &scope));
+  RuntimeProgram program(std::move(insts));
+  auto* reshape_op = const_cast<OpLite*>(program.instructions()[1].op());
+  auto attach_shape = [&](const std::vector<int>& shape) {
+    reshape_desc.SetAttr<std::vector<int>>("shape", shape);
+    reshape_op->Attach(reshape_desc, &scope);
+  };
+
+  x->Resize({2, 6});
+  x->mutable_data<float>();
+  program.Run();
+  EXPECT_EQ(out->dims().Vectorize(), std::vector<int64_t>({3, 4}));
+
+  // The feed shapes are unchanged, so the recorded shapes are replayed and
+  // the new shape attribute isn't seen by InferShape.
+  attach_shape({4, 3});
+  program.Run();
+  EXPECT_EQ(out->dims().Vectorize(), std::vector<int64_t>({3, 4}));
+
+  // A different lod of the feed tensor invalidates the recorded shapes.
+  x->set_lod({{0, 1, 2}});
+  program.Run();
+  EXPECT_EQ(out->dims().Vectorize(), std::vector<int64_t>({4, 3}));
+  EXPECT_EQ(out->lod(), x->lod());
+
+  // So does a different shape of the feed tensor with the same numel.
+  attach_shape({2, 6});
+  x->Resize({3, 4});
+  program.Run();
+  EXPECT_EQ(out->dims().Vectorize(), std::vector<int64_t>({2, 6}));
+
+  attach_shape({6, 2});
+  program.Run();
+  EXPECT_EQ(out->dims().Vectorize(), std::vector<int64_t>({2, 6}));
+}
+
+TEST(RuntimeProgram, disable_shape_replay_for_shape_tensors) {
+  cpp::OpDesc tile_desc;
+  tile_desc.SetType("tile");
+  tile_desc.SetInput("X", {"x"});
+  tile_desc.SetOutput("Out", {"out"});
+  tile_desc.SetAttr<std::vector<int>>("repeat_times", {2});
+  EXPECT_TRUE(SupportShapeReplay(tile_desc));
+  tile_desc.SetInput("repeat_times_tensor", {"repeat_times"});
+  EXPECT_FALSE(SupportShapeReplay(tile_desc));
+
+  cpp::OpDesc expand_desc;
+  expand_desc.SetType("expand");
+  expand_desc.SetInput("X", {"x"});
+  expand_desc.SetOutput("Out", {"out"});
+  expand_desc.SetAttr<std::vector<int>>("expand_times", {2});
+  EXPECT_TRUE(SupportShapeReplay(expand_desc));
+  expand_desc.SetInput("expand_times_tensor", {"expand_times"});
+  EXPECT_FALSE(SupportShapeReplay(expand_desc));
+
+  cpp::OpDesc expand_v2_desc;
+  expand_v2_desc.SetType("expand_v2");
+  expand_v2_desc.SetInput("X", {"x"});
+  expand_v2_desc.SetOutput("Out", {"out"});
+  expand_v2_desc.SetAttr<std::vector<int>>("shape", {2});
+  EXPECT_TRUE(SupportShapeReplay(expand_v2_desc));
+  expand_v2_desc.SetInput("expand_shapes_tensor", {"expand_shapes"});
+  EXPECT_FALSE(SupportShapeReplay(expand_v2_desc));
+
+  cpp::OpDesc gather_desc;
+  gather_desc.SetType("gather");
+  gather_desc.SetInput("X", {"x"});
+  gather_desc.SetInput("Index", {"index"});
+  gather_desc.SetOutput("Out", {"out"});
+  EXPECT_TRUE(SupportShapeReplay(gather_desc));
+  gather_desc.SetInput("Axis", {"axis"});
+  EXPECT_FALSE(SupportShapeReplay(gather_desc));
+
+  cpp::OpDesc affine_grid_desc;
+  affine_grid_desc.SetType("affine_grid");
+  affine_grid_desc.SetInput("Theta", {"theta"});
+  affine_grid_desc.SetInput("OutputShape", {"output_shape"});
+  affine_grid_desc.SetOutput("Output", {"out"});
+  affine_grid_desc.SetAttr<std::vector<int>>("output_shape", {});
+  EXPECT_FALSE(SupportShapeReplay(affine_grid_desc));
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed);
+USE_LITE_OP(reshape);
+USE_LITE_OP(tile);
+USE_LITE_OP(expand);
+USE_LITE_OP(expand_v2);
+USE_LITE_OP(gather);
+USE_LITE_OP(affine_grid);
+USE_LITE_KERNEL(feed, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(reshape, kHost, kAny, kAny, def);
@@ -49,6 +49,9 @@ std::shared_ptr<lite::OpLite> TestCase::CreateSubgraphOp() {
                                                        {"imagination_nna"});
 #elif defined(NNADAPTER_WITH_AMLOGIC_NPU)
   ctx_->As<NNAdapterContext>().SetNNAdapterDeviceNames(scope, {"amlogic_npu"});
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  ctx_->As<NNAdapterContext>().SetNNAdapterDeviceNames(scope,
+                                                       {"x86_reference"});
 #endif
   // Create a new block desc to wrap the original op desc
   auto sub_program_desc = std::make_shared<cpp::ProgramDesc>();
@@ -190,19 +190,23 @@ static bool TargetCompatibleTo(const Type& a, const Type& b) {
   return true;
 }
 
+// The layouts whose storage differs from the plain one, they can't be passed
+// to the kernels of any layout directly.
+static bool IsOpaqueLayout(DataLayoutType layout) {
+  return layout == DATALAYOUT(kImageDefault) ||
+         layout == DATALAYOUT(kNCHW8c);
+}
+
 static bool DataLayoutCompatibleTo(const Type& a, const Type& b) {
   return a.IsVoid() ||                 //
          (a.layout() == b.layout() ||  //
-          ((b.layout() == DATALAYOUT(kAny)) &&
-           (a.layout() != DATALAYOUT(kImageDefault))));
+          ((b.layout() == DATALAYOUT(kAny)) && !IsOpaqueLayout(a.layout())));
 }
 static bool DataLayoutCompatible(const Type& a, const Type& b) {
   return a.IsVoid() || b.IsVoid() ||   //
          (a.layout() == b.layout() ||  //
-          ((b.layout() == DATALAYOUT(kAny)) &&
-           (a.layout() != DATALAYOUT(kImageDefault))) ||
-          ((a.layout() == DATALAYOUT(kAny)) &&
-           (b.layout() != DATALAYOUT(kImageDefault))));
+          ((b.layout() == DATALAYOUT(kAny)) && !IsOpaqueLayout(a.layout())) ||
+          ((a.layout() == DATALAYOUT(kAny)) && !IsOpaqueLayout(b.layout())));
 }
 
 static bool PrecisionCompatibleTo(const Type& a, const Type& b) {
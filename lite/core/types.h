@@ -61,6 +61,7 @@ enum class FluidType {
   SIZE_T = 19,
   UINT8 = 20,
   INT8 = 21,
+  BF16 = 22,
 
   // Other types that may need additional descriptions
   LOD_TENSOR = 7,
@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #include "lite/kernels/host/generate_proposals_compute.h"
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
 #include "lite/backends/host/math/bbox_util.h"
 #include "lite/backends/host/math/gather.h"
+#include "lite/backends/host/math/nms.h"
 #include "lite/backends/host/math/nms_util.h"
 #include "lite/backends/host/math/transpose.h"
 #include "lite/core/op_registry.h"
@@ -89,11 +91,26 @@ std::pair<Tensor, Tensor> ProposalForOneImage(
     return std::make_pair(bbox_sel, scores_filter);
   }
 
+  // Only the first post_nms_top_n kept boxes are needed, so the NMS stops
+  // once they are found.
+  std::vector<int> candidates;
+  lite::host::math::NmsTopK(scores_filter.data<float>(),
+                            1,
+                            scores_filter.numel(),
+                            std::numeric_limits<float>::lowest(),
+                            -1,
+                            &candidates);
+  std::vector<int> selected;
+  lite::host::math::NmsGreedy(bbox_sel.data<float>(),
+                              4,
+                              candidates,
+                              nms_thresh,
+                              eta,
+                              false,
+                              &selected,
+                              post_nms_top_n > 0 ? post_nms_top_n : -1);
   Tensor keep_nms =
-      lite::host::math::NMS<float>(&bbox_sel, &scores_filter, nms_thresh, eta);
-  if (post_nms_top_n > 0 && post_nms_top_n < keep_nms.numel()) {
-    keep_nms.Resize(std::vector<int64_t>({post_nms_top_n}));
-  }
+      lite::host::math::VectorToTensor(selected, selected.size());
   proposals.Resize(std::vector<int64_t>({keep_nms.numel(), 4}));
   scores_sel.Resize(std::vector<int64_t>({keep_nms.numel(), 1}));
   lite::host::math::Gather<float>(bbox_sel, keep_nms, &proposals);
@@ -145,8 +162,9 @@ void GenerateProposalsCompute::Run() {
   std::vector<int64_t> tmp_lod;
   std::vector<int64_t> tmp_num;
 
-  int64_t num_proposals = 0;
-  for (int64_t i = 0; i < num; ++i) {
+  // The proposals of the images are generated in parallel.
+  std::vector<std::pair<Tensor, Tensor>> image_proposals(num);
+  lite::host::math::NmsParallelFor(num, [&](int64_t i) {
     Tensor im_info_slice = im_info->Slice<float>(i, i + 1);
     Tensor bbox_deltas_slice = bbox_deltas_swap.Slice<float>(i, i + 1);
     Tensor scores_slice = scores_swap.Slice<float>(i, i + 1);
@@ -155,19 +173,22 @@ void GenerateProposalsCompute::Run() {
         std::vector<int64_t>({c_bbox * h_bbox * w_bbox / 4, 4}));
     scores_slice.Resize(std::vector<int64_t>({c_score * h_score * w_score, 1}));
 
-    std::pair<Tensor, Tensor> tensor_pair =
-        ProposalForOneImage(im_info_slice,
-                            *anchors,
-                            *variances,
-                            bbox_deltas_slice,
-                            scores_slice,
-                            pre_nms_top_n,
-                            post_nms_top_n,
-                            nms_thresh,
-                            min_size,
-                            eta);
-    Tensor &proposals = tensor_pair.first;
-    Tensor &scores = tensor_pair.second;
+    image_proposals[i] = ProposalForOneImage(im_info_slice,
+                                             *anchors,
+                                             *variances,
+                                             bbox_deltas_slice,
+                                             scores_slice,
+                                             pre_nms_top_n,
+                                             post_nms_top_n,
+                                             nms_thresh,
+                                             min_size,
+                                             eta);
+  });
+
+  int64_t num_proposals = 0;
+  for (int64_t i = 0; i < num; ++i) {
+    Tensor &proposals = image_proposals[i].first;
+    Tensor &scores = image_proposals[i].second;
 
     lite::host::math::AppendTensor<float>(
         rpn_rois, 4 * num_proposals, proposals);
@@ -13,63 +13,18 @@
 // limitations under the License.
 
 #include "lite/kernels/host/matrix_nms_compute.h"
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <utility>
 #include <vector>
+#include "lite/backends/host/math/nms.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace host {
 
-template <class T>
-static T BBoxArea(const T* box, const bool normalized) {
-  if (box[2] < box[0] || box[3] < box[1]) {
-    // If coordinate values are is invalid
-    // (e.g. xmax < xmin or ymax < ymin), return 0.
-    return static_cast<T>(0.);
-  } else {
-    const T w = box[2] - box[0];
-    const T h = box[3] - box[1];
-    if (normalized) {
-      return w * h;
-    } else {
-      // If coordinate values are not within range [0, 1].
-      return (w + 1) * (h + 1);
-    }
-  }
-}
-
-template <class T>
-static T JaccardOverlap(const T* box1, const T* box2, const bool normalized) {
-  if (box2[0] > box1[2] || box2[2] < box1[0] || box2[1] > box1[3] ||
-      box2[3] < box1[1]) {
-    return static_cast<T>(0.);
-  } else {
-    const T inter_xmin = (std::max)(box1[0], box2[0]);
-    const T inter_ymin = (std::max)(box1[1], box2[1]);
-    const T inter_xmax = (std::min)(box1[2], box2[2]);
-    const T inter_ymax = (std::min)(box1[3], box2[3]);
-    T norm = normalized ? static_cast<T>(0.) : static_cast<T>(1.);
-    T inter_w = inter_xmax - inter_xmin + norm;
-    T inter_h = inter_ymax - inter_ymin + norm;
-    const T inter_area = inter_w * inter_h;
-    const T bbox1_area = BBoxArea<T>(box1, normalized);
-    const T bbox2_area = BBoxArea<T>(box2, normalized);
-    return inter_area / (bbox1_area + bbox2_area - inter_area);
-  }
-}
-
-template <class T>
-T PolyIoU(const T* box1,
-          const T* box2,
-          const size_t box_size,
-          const bool normalized) {
-  LOG(FATAL) << "PolyIoU not implement.";
-  return *box1;
-}
-
 template <typename T, bool gaussian>
 struct decay_score;
 
@@ -87,9 +42,13 @@ struct decay_score<T, false> {
   }
 };
 
+// The matrix NMS of a class, the scores of the boxes are decayed by their IoU
+// with the boxes of the higher scores.
 template <typename T, bool gaussian>
-void NMSMatrix(const Tensor& bbox,
-               const Tensor& scores,
+void NMSMatrix(const T* bbox_ptr,
+               const int64_t box_size,
+               const T* score_ptr,
+               const int64_t num_boxes,
                const T score_threshold,
                const T post_threshold,
                const float sigma,
@@ -97,44 +56,31 @@ void NMSMatrix(const Tensor& bbox,
                const bool normalized,
                std::vector<int>* selected_indices,
                std::vector<T>* decayed_scores) {
-  int64_t num_boxes = bbox.dims()[0];
-  int64_t box_size = bbox.dims()[1];
-
-  auto score_ptr = scores.data<T>();
-  auto bbox_ptr = bbox.data<T>();
-
-  std::vector<int32_t> perm(num_boxes);
-  std::iota(perm.begin(), perm.end(), 0);
-  auto end = std::remove_if(
-      perm.begin(), perm.end(), [&score_ptr, score_threshold](int32_t idx) {
-        return score_ptr[idx] <= score_threshold;
-      });
-  auto sort_fn = [&score_ptr](int32_t lhs, int32_t rhs) {
-    return score_ptr[lhs] > score_ptr[rhs];
-  };
-
-  int64_t num_pre = std::distance(perm.begin(), end);
+  std::vector<int> perm;
+  lite::host::math::NmsTopK(
+      score_ptr, 1, num_boxes, score_threshold, top_k, &perm);
+  int64_t num_pre = static_cast<int64_t>(perm.size());
   if (num_pre <= 0) {
     return;
   }
-  if (top_k > -1 && num_pre > top_k) {
-    num_pre = top_k;
-  }
-  std::partial_sort(perm.begin(), perm.begin() + num_pre, end, sort_fn);
 
+  // The row i of the lower triangular matrix is the IoU of the box i with the
+  // boxes [0, i), it's computed by SIMD with the sorted boxes.
   std::vector<T> iou_matrix((num_pre * (num_pre - 1)) >> 1);
   std::vector<T> iou_max(num_pre);
+  lite::host::math::NmsBoxes sorted_boxes(normalized);
+  sorted_boxes.Reserve(num_pre);
+  sorted_boxes.Append(bbox_ptr + perm[0] * box_size);
 
   iou_max[0] = 0.;
   for (int64_t i = 1; i < num_pre; i++) {
+    const T* box = bbox_ptr + perm[i] * box_size;
+    T* iou = iou_matrix.data() + i * (i - 1) / 2;
+    sorted_boxes.IoU(box, i, iou);
+    sorted_boxes.Append(box);
     T max_iou = 0.;
-    auto idx_a = perm[i];
     for (int64_t j = 0; j < i; j++) {
-      auto idx_b = perm[j];
-      auto iou = JaccardOverlap<T>(
-          bbox_ptr + idx_a * box_size, bbox_ptr + idx_b * box_size, normalized);
-      max_iou = (std::max)(max_iou, iou);
-      iou_matrix[i * (i - 1) / 2 + j] = iou;
+      max_iou = (std::max)(max_iou, iou[j]);
     }
     iou_max[i] = max_iou;
   }
@@ -160,59 +106,28 @@ void NMSMatrix(const Tensor& bbox,
   }
 }
 
+// Keep the keep_top_k detections of the classes of an image, class_indices
+// and class_scores are the results of NMSMatrix.
 template <typename T>
-size_t MultiClassMatrixNMS(const Tensor& scores,
-                           const Tensor& bboxes,
+size_t MultiClassMatrixNMS(const Tensor& bboxes,
+                           const int64_t class_num,
+                           const std::vector<int>* class_indices,
+                           const std::vector<T>* class_scores,
                            std::vector<T>* out,
                            std::vector<int>* indices,
                            int start,
-                           int64_t background_label,
-                           int64_t nms_top_k,
-                           int64_t keep_top_k,
-                           bool normalized,
-                           T score_threshold,
-                           T post_threshold,
-                           bool use_gaussian,
-                           float gaussian_sigma) {
+                           int64_t keep_top_k) {
   std::vector<int> all_indices;
   std::vector<T> all_scores;
   std::vector<T> all_classes;
-  all_indices.reserve(scores.numel());
-  all_scores.reserve(scores.numel());
-  all_classes.reserve(scores.numel());
-
-  size_t num_det = 0;
-  auto class_num = scores.dims()[0];
-  Tensor score_slice;
   for (int64_t c = 0; c < class_num; ++c) {
-    if (c == background_label) continue;
-    score_slice = scores.Slice<float>(c, c + 1);
-    if (use_gaussian) {
-      NMSMatrix<T, true>(bboxes,
-                         score_slice,
-                         score_threshold,
-                         post_threshold,
-                         gaussian_sigma,
-                         nms_top_k,
-                         normalized,
-                         &all_indices,
-                         &all_scores);
-    } else {
-      NMSMatrix<T, false>(bboxes,
-                          score_slice,
-                          score_threshold,
-                          post_threshold,
-                          gaussian_sigma,
-                          nms_top_k,
-                          normalized,
-                          &all_indices,
-                          &all_scores);
-    }
-    for (size_t i = 0; i < all_indices.size() - num_det; i++) {
-      all_classes.push_back(static_cast<T>(c));
-    }
-    num_det = all_indices.size();
+    all_indices.insert(
+        all_indices.end(), class_indices[c].begin(), class_indices[c].end());
+    all_scores.insert(
+        all_scores.end(), class_scores[c].begin(), class_scores[c].end());
+    all_classes.resize(all_indices.size(), static_cast<T>(c));
   }
+  size_t num_det = all_indices.size();
 
   if (num_det <= 0) {
     return num_det;
@@ -272,7 +187,47 @@ void MatrixNmsCompute::Run() {
   auto box_dim = boxes->dims()[2];
   auto out_dim = box_dim + 2;
 
-  Tensor boxes_slice, scores_slice;
+  int64_t class_num = score_dims[1];
+  const float* boxes_data = boxes->data<float>();
+  const float* scores_data = scores->data<float>();
+
+  // The NMS of the classes of all the images run in parallel.
+  std::vector<std::vector<int>> class_indices(batch_size * class_num);
+  std::vector<std::vector<float>> class_scores(batch_size * class_num);
+  lite::host::math::NmsParallelFor(batch_size * class_num, [&](int64_t task) {
+    int64_t i = task / class_num;
+    int64_t c = task % class_num;
+    if (c == background_label) return;
+    const float* bbox_ptr = boxes_data + i * num_boxes * box_dim;
+    const float* score_ptr = scores_data + task * num_boxes;
+    if (use_gaussian) {
+      NMSMatrix<float, true>(bbox_ptr,
+                             box_dim,
+                             score_ptr,
+                             num_boxes,
+                             score_threshold,
+                             post_threshold,
+                             gaussian_sigma,
+                             nms_top_k,
+                             normalized,
+                             &class_indices[task],
+                             &class_scores[task]);
+    } else {
+      NMSMatrix<float, false>(bbox_ptr,
+                              box_dim,
+                              score_ptr,
+                              num_boxes,
+                              score_threshold,
+                              post_threshold,
+                              gaussian_sigma,
+                              nms_top_k,
+                              normalized,
+                              &class_indices[task],
+                              &class_scores[task]);
+    }
+  });
+
+  Tensor boxes_slice;
   int64_t num_out = 0;
   std::vector<int64_t> offsets = {0};
   std::vector<float> detections;
@@ -282,24 +237,17 @@ void MatrixNmsCompute::Run() {
   indices.reserve(num_boxes * batch_size);
   num_per_batch.reserve(batch_size);
   for (int i = 0; i < batch_size; ++i) {
-    scores_slice = scores->Slice<float>(i, i + 1);
-    scores_slice.Resize({score_dims[1], score_dims[2]});
     boxes_slice = boxes->Slice<float>(i, i + 1);
     boxes_slice.Resize({score_dims[2], box_dim});
     int start = i * score_dims[2];
-    num_out = MultiClassMatrixNMS(scores_slice,
-                                  boxes_slice,
+    num_out = MultiClassMatrixNMS(boxes_slice,
+                                  class_num,
+                                  &class_indices[i * class_num],
+                                  &class_scores[i * class_num],
                                   &detections,
                                   &indices,
                                   start,
-                                  background_label,
-                                  nms_top_k,
-                                  keep_top_k,
-                                  normalized,
-                                  score_threshold,
-                                  post_threshold,
-                                  use_gaussian,
-                                  gaussian_sigma);
+                                  keep_top_k);
     offsets.push_back(offsets.back() + num_out);
     num_per_batch.emplace_back(num_out);
   }
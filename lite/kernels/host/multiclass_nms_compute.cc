@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include "lite/kernels/host/multiclass_nms_compute.h"
+#include <algorithm>
 #include <map>
 #include <utility>
 #include <vector>
+#include "lite/backends/host/math/nms.h"
 #include "lite/backends/host/math/nms_util.h"
 
 namespace paddle {
@@ -56,111 +58,120 @@ void SliceOneClass(const Tensor& items,
   }
 }
 
-template <typename T>
-void NMSFast(const Tensor& bbox,
-             const Tensor& scores,
-             const T score_threshold,
-             const T nms_threshold,
-             const T eta,
-             const int64_t top_k,
-             std::vector<int>* selected_indices,
-             const bool normalized) {
-  // The total boxes for each instance.
-  int64_t num_boxes = bbox.dims()[0];
+// The NMS of a class, the box i is at boxes[i * box_stride] and its score is
+// scores[i * score_stride].
+void NMSFast(const float* boxes,
+             int64_t box_stride,
+             int64_t box_size,
+             const float* scores,
+             int64_t score_stride,
+             int64_t num_boxes,
+             const operators::MulticlassNmsParam& param,
+             std::vector<int>* selected_indices) {
+  std::vector<int> candidates;
+  lite::host::math::NmsTopK(scores,
+                            score_stride,
+                            num_boxes,
+                            param.score_threshold,
+                            param.nms_top_k,
+                            &candidates);
+  selected_indices->clear();
   // 4: [xmin ymin xmax ymax]
+  if (box_size == 4) {
+    lite::host::math::NmsGreedy(boxes,
+                                box_stride,
+                                candidates,
+                                param.nms_threshold,
+                                param.nms_eta,
+                                param.normalized,
+                                selected_indices);
+    return;
+  }
+
   // 8: [x1 y1 x2 y2 x3 y3 x4 y4]
   // 16, 24, or 32: [x1 y1 x2 y2 ...  xn yn], n = 8, 12 or 16
-  int64_t box_size = bbox.dims()[1];
-
-  std::vector<T> scores_data(num_boxes);
-  std::copy_n(scores.data<T>(), num_boxes, scores_data.begin());
-  std::vector<std::pair<T, int>> sorted_indices;
-  lite::host::math::GetMaxScoreIndex(
-      scores_data, score_threshold, top_k, &sorted_indices);
-
-  selected_indices->clear();
-  T adaptive_threshold = nms_threshold;
-  const T* bbox_data = bbox.data<T>();
-
-  while (sorted_indices.size() != 0) {
-    const int idx = sorted_indices.front().second;
+  bool is_poly =
+      box_size == 8 || box_size == 16 || box_size == 24 || box_size == 32;
+  float adaptive_threshold = param.nms_threshold;
+  for (int idx : candidates) {
     bool keep = true;
-    for (size_t k = 0; k < selected_indices->size(); ++k) {
-      if (keep) {
-        const int kept_idx = (*selected_indices)[k];
-        T overlap = T(0.);
-        // 4: [xmin ymin xmax ymax]
-        if (box_size == 4) {
-          overlap = lite::host::math::JaccardOverlap<T>(
-              bbox_data + idx * box_size,
-              bbox_data + kept_idx * box_size,
-              normalized);
-        }
-        // 8: [x1 y1 x2 y2 x3 y3 x4 y4] or 16, 24, 32
-        if (box_size == 8 || box_size == 16 || box_size == 24 ||
-            box_size == 32) {
-          overlap =
-              lite::host::math::PolyIoU<T>(bbox_data + idx * box_size,
-                                           bbox_data + kept_idx * box_size,
-                                           box_size,
-                                           normalized);
-        }
-        keep = overlap <= adaptive_threshold;
-      } else {
+    for (int kept_idx : *selected_indices) {
+      float overlap = 0.f;
+      if (is_poly) {
+        overlap = lite::host::math::PolyIoU<float>(
+            boxes + idx * box_stride,
+            boxes + kept_idx * box_stride,
+            box_size,
+            param.normalized);
+      }
+      if (!(overlap <= adaptive_threshold)) {
+        keep = false;
         break;
       }
     }
     if (keep) {
       selected_indices->push_back(idx);
+      if (param.nms_eta < 1 && adaptive_threshold > 0.5) {
+        adaptive_threshold *= param.nms_eta;
+      }
     }
-    sorted_indices.erase(sorted_indices.begin());
-    if (keep && eta < 1 && adaptive_threshold > 0.5) {
-      adaptive_threshold *= eta;
-    }
   }
 }
 
+// The NMS of the class c of an image.
+void ClassNMS(const operators::MulticlassNmsParam& param,
+              const Tensor& scores,
+              const Tensor& bboxes,
+              const int scores_size,
+              const int64_t c,
+              std::vector<int>* selected_indices) {
+  if (scores_size == 3) {
+    // scores: [C, M], bboxes: [M, box_size]
+    int64_t num_boxes = scores.dims()[1];
+    int64_t box_size = bboxes.dims()[1];
+    NMSFast(bboxes.data<float>(),
+            box_size,
+            box_size,
+            scores.data<float>() + c * num_boxes,
+            1,
+            num_boxes,
+            param,
+            selected_indices);
+  } else {
+    // scores: [M, C], bboxes: [M, C, 4]
+    int64_t num_boxes = scores.dims()[0];
+    int64_t class_num = scores.dims()[1];
+    NMSFast(bboxes.data<float>() + c * 4,
+            class_num * 4,
+            4,
+            scores.data<float>() + c,
+            class_num,
+            num_boxes,
+            param,
+            selected_indices);
+    std::sort(selected_indices->begin(), selected_indices->end());
+  }
+}
+
+// Keep the keep_top_k detections of the classes of an image, class_indices
+// are the results of ClassNMS.
 template <typename T>
 void MultiClassNMS(const operators::MulticlassNmsParam& param,
                    const Tensor& scores,
-                   const Tensor& bboxes,
                    const int scores_size,
+                   std::vector<int>* class_indices,
                    std::map<int, std::vector<int>>* indices,
                    int* num_nmsed_out) {
   int64_t background_label = param.background_label;
-  int64_t nms_top_k = param.nms_top_k;
   int64_t keep_top_k = param.keep_top_k;
-  bool normalized = param.normalized;
-  T nms_threshold = static_cast<T>(param.nms_threshold);
-  T nms_eta = static_cast<T>(param.nms_eta);
-  T score_threshold = static_cast<T>(param.score_threshold);
 
   int num_det = 0;
 
   int64_t class_num = scores_size == 3 ? scores.dims()[0] : scores.dims()[1];
-  Tensor bbox_slice, score_slice;
+  Tensor score_slice;
   for (int64_t c = 0; c < class_num; ++c) {
     if (c == background_label) continue;
-    if (scores_size == 3) {
-      score_slice = scores.Slice<T>(c, c + 1);
-      bbox_slice = bboxes;
-    } else {
-      score_slice.Resize({scores.dims()[0], 1});
-      bbox_slice.Resize({scores.dims()[0], 4});
-      SliceOneClass<T>(scores, c, &score_slice);
-      SliceOneClass<T>(bboxes, c, &bbox_slice);
-    }
-    NMSFast(bbox_slice,
-            score_slice,
-            score_threshold,
-            nms_threshold,
-            nms_eta,
-            nms_top_k,
-            &((*indices)[c]),
-            normalized);
-    if (scores_size == 2) {
-      std::stable_sort((*indices)[c].begin(), (*indices)[c].end());
-    }
+    (*indices)[c].swap(class_indices[c]);
     num_det += (*indices)[c].size();
   }
 
@@ -283,32 +294,54 @@ void MulticlassNmsCompute::Run() {
   int64_t box_dim = boxes->dims()[2];
   int64_t out_dim = box_dim + 2;
   int num_nmsed_out = 0;
-  Tensor boxes_slice, scores_slice;
   int n;
   if (has_roissum) {
     n = score_size == 3 ? batch_size : rois_num->numel();
   } else {
     n = score_size == 3 ? batch_size : boxes->lod().back().size() - 1;
   }
+  std::vector<uint64_t> boxes_lod;
+  if (score_size == 2) {
+    boxes_lod =
+        has_roissum ? GetNmsLodFromRoisNum(rois_num) : boxes->lod().back();
+  }
+  std::vector<Tensor> scores_slices(n);
+  std::vector<Tensor> boxes_slices(n);
   for (int i = 0; i < n; ++i) {
     if (score_size == 3) {
-      scores_slice = scores->Slice<float>(i, i + 1);
-      scores_slice.Resize({score_dims[1], score_dims[2]});
-      boxes_slice = boxes->Slice<float>(i, i + 1);
-      boxes_slice.Resize({score_dims[2], box_dim});
+      scores_slices[i] = scores->Slice<float>(i, i + 1);
+      scores_slices[i].Resize({score_dims[1], score_dims[2]});
+      boxes_slices[i] = boxes->Slice<float>(i, i + 1);
+      boxes_slices[i].Resize({score_dims[2], box_dim});
     } else {
-      std::vector<uint64_t> boxes_lod;
-      if (has_roissum) {
-        boxes_lod = GetNmsLodFromRoisNum(rois_num);
-      } else {
-        boxes_lod = boxes->lod().back();
-      }
-      scores_slice = scores->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
-      boxes_slice = boxes->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
+      scores_slices[i] = scores->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
+      boxes_slices[i] = boxes->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
     }
+  }
+
+  // The NMS of the classes of all the images run in parallel.
+  int64_t class_num = score_dims[1];
+  std::vector<std::vector<int>> class_indices(n * class_num);
+  lite::host::math::NmsParallelFor(n * class_num, [&](int64_t task) {
+    int64_t i = task / class_num;
+    int64_t c = task % class_num;
+    if (c == param.background_label) return;
+    ClassNMS(param,
+             scores_slices[i],
+             boxes_slices[i],
+             score_size,
+             c,
+             &class_indices[task]);
+  });
+
+  for (int i = 0; i < n; ++i) {
     std::map<int, std::vector<int>> indices;
-    MultiClassNMS<float>(
-        param, scores_slice, boxes_slice, score_size, &indices, &num_nmsed_out);
+    MultiClassNMS<float>(param,
+                         scores_slices[i],
+                         score_size,
+                         &class_indices[i * class_num],
+                         &indices,
+                         &num_nmsed_out);
     all_indices.push_back(indices);
     batch_starts.push_back(batch_starts.back() + num_nmsed_out);
   }
@@ -330,26 +363,9 @@ void MulticlassNmsCompute::Run() {
     int offset = 0;
     int* oindices = nullptr;
     for (int i = 0; i < n; ++i) {
-      if (score_size == 3) {
-        scores_slice = scores->Slice<float>(i, i + 1);
-        boxes_slice = boxes->Slice<float>(i, i + 1);
-        scores_slice.Resize({score_dims[1], score_dims[2]});
-        boxes_slice.Resize({score_dims[2], box_dim});
-        if (return_index) {
-          offset = i * score_dims[2];
-        }
-      } else {
-        std::vector<uint64_t> boxes_lod;
-        if (has_roissum) {
-          boxes_lod = GetNmsLodFromRoisNum(rois_num);
-        } else {
-          boxes_lod = boxes->lod().back();
-        }
-        scores_slice = scores->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
-        boxes_slice = boxes->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
-        if (return_index) {
-          offset = boxes_lod[i] * score_dims[1];
-        }
+      if (return_index) {
+        offset = score_size == 3 ? i * score_dims[2]
+                                 : boxes_lod[i] * score_dims[1];
       }
       int64_t s = static_cast<int64_t>(batch_starts[i]);
       int64_t e = static_cast<int64_t>(batch_starts[i + 1]);
@@ -360,8 +376,8 @@ void MulticlassNmsCompute::Run() {
           int* output_idx = index->mutable_data<int>();
           oindices = output_idx + s;
         }
-        MultiClassOutput<float>(scores_slice,
-                                boxes_slice,
+        MultiClassOutput<float>(scores_slices[i],
+                                boxes_slices[i],
                                 all_indices[i],
                                 score_dims.size(),
                                 &out,
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "lite/kernels/host/while_compute.h"
+#include <map>
+#include <set>
 #include <unordered_map>
 #include <utility>
 
@@ -21,18 +23,125 @@ namespace lite {
 namespace kernels {
 namespace host {
 
+// The ops which have side effects or states across the steps, they are never
+// hoisted out of the loop body.
+static const std::set<std::string> kLoopVariantOps = {"while",
+                                                      "conditional_block",
+                                                      "subgraph",
+                                                      "feed",
+                                                      "fetch",
+                                                      "write_to_array",
+                                                      "read_from_array",
+                                                      "increment",
+                                                      "beam_search",
+                                                      "beam_search_decode",
+                                                      "print",
+                                                      "uniform_random",
+                                                      "gaussian_random",
+                                                      "sampling_id"};
+
+static bool IsTensorVar(OpLite *op, const std::string &var_name) {
+  auto *var = op->scope()->FindVar(var_name);
+  return var != nullptr && var->IsType<Tensor>();
+}
+
+void WhileCompute::InitLoopExecutor() {
+  auto &insts = *program_->mutable_instructions();
+  for (auto &inst : insts) {
+    auto target = inst.kernel()->target();
+    if (target != TARGET(kHost) && target != TARGET(kX86) &&
+        target != TARGET(kARM)) {
+      VLOG(4) << "Disable the loop executor because of " << inst.op()->Type();
+      return;
+    }
+  }
+
+  std::map<std::string, int> num_writers;
+  for (auto &inst : insts) {
+    for (auto &var_name : inst.op()->op_info()->output_names()) {
+      num_writers[var_name]++;
+    }
+  }
+  // An instruction is loop invariant if its inputs are only written by the
+  // loop invariant instructions or outside the loop, and its outputs are only
+  // written by itself and aren't read by the instructions in front of it,
+  // which read the values of the last step.
+  std::set<std::string> invariant_vars;
+  std::set<std::string> read_vars;
+  for (auto &inst : insts) {
+    auto *op = const_cast<OpLite *>(inst.op());
+    auto *op_info = op->op_info();
+    bool invariant = !kLoopVariantOps.count(op->Type());
+    for (auto &var_name : op_info->input_names()) {
+      invariant = invariant && IsTensorVar(op, var_name) &&
+                  (!num_writers.count(var_name) ||
+                   invariant_vars.count(var_name));
+      read_vars.insert(var_name);
+    }
+    // The outputs which are also the inputs are excluded by read_vars.
+    for (auto &var_name : op_info->output_names()) {
+      invariant = invariant && IsTensorVar(op, var_name) &&
+                  num_writers[var_name] == 1 && !read_vars.count(var_name);
+    }
+    if (invariant) {
+      for (auto &var_name : op_info->output_names()) {
+        invariant_vars.insert(var_name);
+      }
+      invariant_insts_.push_back(&inst);
+      continue;
+    }
+    if (op->Type() == "write_to_array") {
+      auto *array = op->scope()
+                        ->FindVar(op_info->Output("Out").front())
+                        ->GetMutable<std::vector<Tensor>>();
+      step_arrays_.push_back(array);
+    }
+    inst.set_replay_shape_by_inputs(inst.SupportShapeReplay());
+    step_insts_.push_back(&inst);
+  }
+  VLOG(4) << "Hoist " << invariant_insts_.size() << " of " << insts.size()
+          << " instructions out of the loop body.";
+  enable_loop_executor_ = true;
+}
+
 void WhileCompute::PrepareForRun() {
   auto &param = this->Param<param_t>();
   if (program_ == nullptr) {
     program_.reset(new RuntimeProgram(
         param.program_desc, param.exec_scope, param.block_idx));
   }
+#ifndef LITE_WITH_PRECISION_PROFILE
+  // The precision profiler only hooks the runs of the RuntimeProgram.
+  InitLoopExecutor();
+#endif
 }
+
 void WhileCompute::Run() {
   auto &param = this->Param<param_t>();
+  if (!enable_loop_executor_) {
+    while (param.cond->data<bool>()[0]) {
+      program_->Run();
+    }
+    return;
+  }
+  for (auto *array : step_arrays_) {
+    array->reserve(max_num_steps_);
+  }
+  size_t num_steps = 0;
   while (param.cond->data<bool>()[0]) {
-    program_->Run();
+    // The loop invariant instructions are run for the first step only, so
+    // their outputs are kept if the loop isn't entered.
+    if (num_steps == 0) {
+      for (auto *inst : invariant_insts_) {
+        inst->Run();
+      }
+    }
+    for (auto *inst : step_insts_) {
+      inst->Run();
+    }
+    num_steps++;
   }
+  max_num_steps_ = std::max(max_num_steps_, num_steps);
 }
 
 }  // namespace host
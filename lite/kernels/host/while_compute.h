@@ -40,10 +40,28 @@ class WhileCompute
     program_ = std::move(*program);
   }
 
+  const std::vector<Instruction*>& invariant_insts() const {
+    return invariant_insts_;
+  }
+  const std::vector<Instruction*>& step_insts() const { return step_insts_; }
+
   virtual ~WhileCompute() = default;
 
  private:
+  // Split the instructions of the loop body into the loop invariant ones,
+  // which are run once before the first step, and the step ones, which are
+  // run directly for every step. It's disabled if any instruction isn't run
+  // on the CPU.
+  void InitLoopExecutor();
+
   std::unique_ptr<RuntimeProgram> program_;
+  bool enable_loop_executor_{false};
+  std::vector<Instruction*> invariant_insts_;
+  std::vector<Instruction*> step_insts_;
+  // The tensor arrays written for every step, they are reserved for the
+  // steps of the longest run to avoid growing them step by step.
+  std::vector<std::vector<Tensor>*> step_arrays_;
+  size_t max_num_steps_{0};
 };
 
 }  // namespace host
@@ -0,0 +1,215 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/while_compute.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+static void AddOp(cpp::BlockDesc* block,
+                  const std::string& type,
+                  const std::vector<std::string>& x,
+                  const std::string& out,
+                  const Place& place,
+                  const std::string& alias = "def") {
+  auto* op = block->AddOp<cpp::OpDesc>();
+  op->SetType(type);
+  op->SetInput("X", {x[0]});
+  if (type == "read_from_array" || type == "write_to_array") {
+    op->SetInput("I", {x[1]});
+  } else if (type == "less_than") {
+    op->SetInput("Y", {x[1]});
+    op->SetAttr<int>("axis", -1);
+    op->SetAttr<bool>("force_cpu", true);
+  } else if (type == "increment") {
+    op->SetAttr<float>("step", 1.f);
+  }
+  op->SetOutput("Out", {out});
+  op->SetAttr<std::string>(
+      kKernelTypeAttr, KernelBase::SerializeKernelType(type, alias, place));
+}
+
+static void FillTensor(Tensor* tensor,
+                       const std::vector<int64_t>& shape,
+                       float value) {
+  tensor->Resize(shape);
+  auto* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    data[i] = value + i;
+  }
+}
+
+class WhileComputeTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // The loop body of the block 1.
+    program_desc_ = std::make_shared<cpp::ProgramDesc>();
+    program_desc_->AddBlock<cpp::BlockDesc>();
+    auto* block = program_desc_->AddBlock<cpp::BlockDesc>();
+    const Place any{TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)};
+    const Place nchw{TARGET(kHost), PRECISION(kAny), DATALAYOUT(kNCHW)};
+    const Place int64{TARGET(kHost), PRECISION(kInt64), DATALAYOUT(kAny)};
+    // The steps whose shapes follow the elements of the input array.
+    AddOp(block, "read_from_array", {"arr", "i"}, "elem", any);
+    AddOp(block, "assign", {"elem"}, "elem_copy", any);
+    AddOp(block, "write_to_array", {"elem_copy", "i"}, "out_arr", any);
+    // carry is read by the step in front of its writer, so seen is the carry
+    // of the last step.
+    AddOp(block, "assign", {"carry"}, "seen", any);
+    AddOp(block, "assign", {"w"}, "carry", any);
+    // The loop invariant chain.
+    AddOp(block, "assign", {"w"}, "a", any);
+    AddOp(block, "assign", {"a"}, "b", any);
+    AddOp(block, "increment", {"i"}, "i", nchw);
+    AddOp(block, "less_than", {"i", "n"}, "cond", int64);
+
+    for (auto name : {"elem",
+                      "elem_copy",
+                      "seen",
+                      "carry",
+                      "w",
+                      "a",
+                      "b",
+                      "i",
+                      "n",
+                      "cond"}) {
+      scope_.Var(name)->GetMutable<Tensor>();
+    }
+    scope_.Var("arr")->GetMutable<std::vector<Tensor>>();
+    scope_.Var("out_arr")->GetMutable<std::vector<Tensor>>();
+    FillTensor(scope_.FindMutableTensor("w"), {2, 3}, 1.f);
+    FillTensor(scope_.FindMutableTensor("carry"), {2, 3}, -1.f);
+
+    operators::WhileParam param;
+    param.cond = scope_.FindMutableTensor("cond");
+    param.block_idx = 1;
+    param.program_desc = program_desc_;
+    param.exec_scope = &scope_;
+    while_.SetParam(param);
+    while_.PrepareForRun();
+  }
+
+  // Run the loop for num_steps steps, the element k of the input array is of
+  // k + 1 rows.
+  void Run(int64_t num_steps) {
+    auto* arr = scope_.FindVar("arr")->GetMutable<std::vector<Tensor>>();
+    arr->resize(num_steps);
+    for (int64_t k = 0; k < num_steps; k++) {
+      FillTensor(&(*arr)[k], {k + 1, 2}, 10.f * k);
+    }
+    scope_.FindVar("out_arr")->GetMutable<std::vector<Tensor>>()->clear();
+    auto* i = scope_.FindMutableTensor("i");
+    i->Resize({1});
+    i->mutable_data<int64_t>()[0] = 0;
+    auto* n = scope_.FindMutableTensor("n");
+    n->Resize({1});
+    n->mutable_data<int64_t>()[0] = num_steps;
+    auto* cond = scope_.FindMutableTensor("cond");
+    cond->Resize({1});
+    cond->mutable_data<bool>()[0] = num_steps > 0;
+    while_.Run();
+  }
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  Scope scope_;
+  WhileCompute while_;
+};
+
+TEST_F(WhileComputeTest, hoist_loop_invariant_ops) {
+  const auto& invariant_insts = while_.invariant_insts();
+  ASSERT_EQ(invariant_insts.size(), 2u);
+  EXPECT_EQ(invariant_insts[0]->op()->op_info()->Output("Out").front(), "a");
+  EXPECT_EQ(invariant_insts[1]->op()->op_info()->Output("Out").front(), "b");
+
+  // The in-place and the loop carried ops stay in the loop.
+  std::vector<std::string> step_outputs;
+  for (auto* inst : while_.step_insts()) {
+    step_outputs.push_back(inst->op()->op_info()->Output("Out").front());
+  }
+  EXPECT_EQ(step_outputs,
+            std::vector<std::string>({"elem",
+                                      "elem_copy",
+                                      "out_arr",
+                                      "seen",
+                                      "carry",
+                                      "i",
+                                      "cond"}));
+
+  Run(1);
+  auto* w = scope_.FindTensor("w");
+  auto* b = scope_.FindTensor("b");
+  auto* seen = scope_.FindTensor("seen");
+  ASSERT_EQ(b->dims(), w->dims());
+  for (int64_t k = 0; k < w->numel(); k++) {
+    EXPECT_EQ(b->data<float>()[k], w->data<float>()[k]);
+    EXPECT_EQ(seen->data<float>()[k], -1.f + k);
+  }
+  Run(2);
+  for (int64_t k = 0; k < w->numel(); k++) {
+    EXPECT_EQ(seen->data<float>()[k], w->data<float>()[k]);
+  }
+}
+
+TEST_F(WhileComputeTest, run_zero_steps) {
+  Run(0);
+  EXPECT_EQ(scope_.FindTensor("i")->data<int64_t>()[0], 0);
+  EXPECT_FALSE(scope_.FindTensor("b")->IsInitialized());
+  EXPECT_TRUE(
+      scope_.FindVar("out_arr")->GetMutable<std::vector<Tensor>>()->empty());
+
+  // The invariant ops are run by the first step of the next run.
+  Run(1);
+  EXPECT_EQ(scope_.FindTensor("i")->data<int64_t>()[0], 1);
+  EXPECT_EQ(scope_.FindTensor("b")->dims(), scope_.FindTensor("w")->dims());
+}
+
+TEST_F(WhileComputeTest, change_step_shapes) {
+  for (int64_t num_steps : {3, 5, 2}) {
+    Run(num_steps);
+    EXPECT_EQ(scope_.FindTensor("i")->data<int64_t>()[0], num_steps);
+    auto& out_arr =
+        *scope_.FindVar("out_arr")->GetMutable<std::vector<Tensor>>();
+    ASSERT_EQ(out_arr.size(), static_cast<size_t>(num_steps));
+    for (int64_t k = 0; k < num_steps; k++) {
+      ASSERT_EQ(out_arr[k].dims().Vectorize(),
+                std::vector<int64_t>({k + 1, 2}));
+      for (int64_t j = 0; j < out_arr[k].numel(); j++) {
+        EXPECT_EQ(out_arr[k].data<float>()[j], 10.f * k + j);
+      }
+    }
+  }
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(read_from_array);
+USE_LITE_OP(write_to_array);
+USE_LITE_OP(assign);
+USE_LITE_OP(increment);
+USE_LITE_OP(less_than);
+USE_LITE_KERNEL(read_from_array, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(write_to_array, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(assign, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(increment, kHost, kAny, kNCHW, def);
+USE_LITE_KERNEL(less_than, kHost, kInt64, kAny, def);
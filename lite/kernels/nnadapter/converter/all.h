@@ -18,32 +18,36 @@
 REGISTER_CONVERTER(conv2d,
                    ConvertConv2D,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-                   "npu,amlogic_npu,imagination_nna");
+                   "npu,amlogic_npu,imagination_nna,x86_reference");
 REGISTER_CONVERTER(depthwise_conv2d,
                    ConvertConv2D,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-                   "npu,amlogic_npu,imagination_nna");
+                   "npu,amlogic_npu,imagination_nna,x86_reference");
 REGISTER_CONVERTER(softmax,
                    ConvertSoftmax,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-                   "npu,amlogic_npu,imagination_nna");
-REGISTER_CONVERTER(
-    sigmoid,
-    ConvertUnaryActivations,
-    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_npu,amlogic_npu");
+                   "npu,amlogic_npu,imagination_nna,x86_reference");
+REGISTER_CONVERTER(sigmoid,
+                   ConvertUnaryActivations,
+                   "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
+                   "npu,amlogic_npu,x86_reference");
 REGISTER_CONVERTER(relu,
                    ConvertUnaryActivations,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-                   "npu,amlogic_npu,imagination_nna");
+                   "npu,amlogic_npu,imagination_nna,x86_reference");
 REGISTER_CONVERTER(relu6,
                    ConvertUnaryActivations,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-                   "npu,amlogic_npu,imagination_nna");
-REGISTER_CONVERTER(
-    tanh,
-    ConvertUnaryActivations,
-    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_npu,amlogic_npu");
-REGISTER_CONVERTER(abs, ConvertUnaryActivations, "huawei_ascend_npu");
-REGISTER_CONVERTER(log, ConvertUnaryActivations, "huawei_ascend_npu");
+                   "npu,amlogic_npu,imagination_nna,x86_reference");
+REGISTER_CONVERTER(tanh,
+                   ConvertUnaryActivations,
+                   "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
+                   "npu,amlogic_npu,x86_reference");
+REGISTER_CONVERTER(abs,
+                   ConvertUnaryActivations,
+                   "huawei_ascend_npu,x86_reference");
+REGISTER_CONVERTER(log,
+                   ConvertUnaryActivations,
+                   "huawei_ascend_npu,x86_reference");
 
 #endif  // NOLINT
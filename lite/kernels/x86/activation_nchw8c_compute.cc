@@ -0,0 +1,122 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/activation_nchw8c_compute.h"
+#include "lite/backends/x86/math/nchw8c.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void ActivationNCHW8cCompute::Run() {
+  auto& param = this->Param<param_t>();
+  float alpha = 0.f;
+  if (param.active_type == lite_api::ActivationType::kLeakyRelu) {
+    alpha = param.Leaky_relu_alpha;
+  } else if (param.active_type == lite_api::ActivationType::kRelu6) {
+    alpha = param.threshold;
+  }
+  lite::x86::math::activation_nchw8c(
+      param.X->data<float>(),
+      lite::x86::math::nchw8c_mutable_data(param.Out),
+      lite::x86::math::nchw8c_size(param.X->dims()),
+      param.active_type,
+      alpha);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(relu,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::ActivationNCHW8cCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(relu6,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::ActivationNCHW8cCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(leaky_relu,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::ActivationNCHW8cCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(sigmoid,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::ActivationNCHW8cCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(tanh,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::ActivationNCHW8cCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/batch_norm_nchw8c_compute.h"
+#include <cmath>
+#include "lite/backends/x86/math/nchw8c.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void BatchNormNCHW8cCompute::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  const int channel = param.scale->numel();
+  const float* scale = param.scale->data<float>();
+  const float* bias = param.bias->data<float>();
+  const float* mean = param.mean->data<float>();
+  const float* variance = param.variance->data<float>();
+  Tensor scale_folded, bias_folded;
+  scale_folded.Resize({channel});
+  bias_folded.Resize({channel});
+  float* scale_data = scale_folded.mutable_data<float>();
+  float* bias_data = bias_folded.mutable_data<float>();
+  for (int c = 0; c < channel; c++) {
+    scale_data[c] = scale[c] / std::sqrt(variance[c] + param.epsilon);
+    bias_data[c] = bias[c] - mean[c] * scale_data[c];
+  }
+  lite::x86::math::pad_channel_nchw8c(scale_folded, &new_scale_);
+  lite::x86::math::pad_channel_nchw8c(bias_folded, &new_bias_);
+}
+
+void BatchNormNCHW8cCompute::Run() {
+  auto& param = this->Param<param_t>();
+  lite::x86::math::scale_bias_nchw8c(*param.x,
+                                     new_scale_.data<float>(),
+                                     new_bias_.data<float>(),
+                                     param.y);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(batch_norm,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::BatchNormNCHW8cCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Mean", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Variance", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Y",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .BindOutput("MeanOut", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("VarianceOut", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("SavedMean", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("SavedVariance", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -13,8 +13,14 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/conv_compute.h"
+#include <functional>
+#include <memory>
+#include <string>
 #include <utility>
+#include "lite/backends/x86/math/conv_int8.h"
 #include "lite/backends/x86/math/fill_bias_activate.h"
+#include "lite/backends/x86/math/sgemm_packed.h"
+#include "lite/core/kernel_tuner.h"
 #include "lite/kernels/x86/conv_depthwise.h"
 
 namespace paddle {
@@ -40,13 +46,34 @@ namespace x86 {
   int n = hout * wout;                  \
   int k = chin * kw * kh / group;
 
-template <>
-void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
-  auto& param = this->Param<param_t>();
+// The signature of the conv for the kernel tuning.
+static std::string ConvSignature(const operators::ConvParam& param) {
+  auto join = [](const std::vector<int64_t>& values) {
+    std::string str;
+    for (size_t i = 0; i < values.size(); i++) {
+      str += (i == 0 ? "" : "x") + std::to_string(values[i]);
+    }
+    return str;
+  };
+  std::vector<int64_t> strides(param.strides.begin(), param.strides.end());
+  std::vector<int64_t> paddings(param.paddings->begin(),
+                                param.paddings->end());
+  std::vector<int64_t> dilations(param.dilations->begin(),
+                                 param.dilations->end());
+  return "conv2d/x86/fp32/in_" + join(param.x->dims().Vectorize()) +
+         "/filter_" + join(param.filter->dims().Vectorize()) + "/stride_" +
+         join(strides) + "/pad_" + join(paddings) + "/dilation_" +
+         join(dilations) + "/group_" + std::to_string(param.groups);
+}
 
-  const int input_channel = param.x->dims()[1];
-  const int output_channel = param.filter->dims()[0];
+// The conv algorithms which are valid for the param, the last one is picked
+// by default, and the im2col + gemm is valid for all of the convs.
+static std::vector<std::string> ConvAlgos(const operators::ConvParam& param) {
+  // The input channel is got from the filter, as the shape of the input is
+  // unknown when the filter is prepacked by opt.
   const int groups = param.groups;
+  const int input_channel = param.filter->dims()[1] * groups;
+  const int output_channel = param.filter->dims()[0];
 
   const int kernel_h = param.filter->dims()[2];
   const int kernel_w = param.filter->dims()[3];
@@ -68,24 +95,133 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   // todo add conv_5x5_depthwise implement
   flag_dw_5x5 = false;
   bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
-  if (kernel_w == 1 && stride_w == 1 && paddings[0] == 0 && kps_equal &&
-      pads_equal) {
-    flag_1x1gemm_ = true;
-  } else {
-    flag_1x1gemm_ = false;
+  bool flag_1x1 = kernel_w == 1 && stride_w == 1 && paddings[0] == 0 &&
+                  kps_equal && pads_equal;
+  bool flag_dw_impl =
+      dw_kernel && kps_equal && no_dilation && flag_dw && (groups & 3) == 0;
+
+  std::vector<std::string> algos{"gemm"};
+  if (flag_1x1) {
+    algos.push_back("gemm_1x1");
   }
+  if (flag_dw_impl) {
+    algos.push_back("depthwise");
+  }
+  return algos;
+}
 
-  /// select conv impl
-  if (dw_kernel && kps_equal && no_dilation && flag_dw && (groups & 3) == 0) {
-    impl_ = new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
+#ifndef PADDLE_WITH_MKLML
+static int PackedConvWeightsSize(const operators::ConvParam& param) {
+  const int m = param.filter->dims()[0] / param.groups;
+  const int k = param.filter->numel() / param.filter->dims()[0];
+  return param.groups * lite::x86::math::sgemm_packed_a_size(m, k);
+}
+
+// Pack the weights of each group as A of the packed sgemm.
+static void PackConvWeights(const operators::ConvParam& param,
+                            Tensor* packed_weights) {
+  const int groups = param.groups;
+  const int m = param.filter->dims()[0] / groups;
+  const int k = param.filter->numel() / param.filter->dims()[0];
+  const int packed_size = lite::x86::math::sgemm_packed_a_size(m, k);
+  packed_weights->Resize({groups, packed_size});
+  auto weights = param.filter->data<float>();
+  auto packed = packed_weights->mutable_data<float>();
+  for (int g = 0; g < groups; g++) {
+    lite::x86::math::sgemm_pack_a(
+        false, weights + g * m * k, m, k, k, packed + g * packed_size);
   }
+}
+#endif
 
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::SelectAlgo(
+    const std::string& algo) {
+  auto& param = this->Param<param_t>();
   if (impl_) {
-    impl_->SetContext(std::move(this->ctx_));
+    delete impl_;
+    impl_ = nullptr;
+  }
+  flag_1x1gemm_ = algo == "gemm_1x1";
+  if (algo == "depthwise") {
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    impl_ = new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
+    impl_->SetContext(std::move(ctx));
     impl_->SetParam(param);
     impl_->PrepareForRun();
-    is_first_epoch_ = false;
+    return;
+  }
+#ifndef PADDLE_WITH_MKLML
+  if (packed_weights_.dims().empty()) {
+    PackConvWeights(param, &packed_weights_);
+  }
+#endif
+}
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run();
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareBf16();
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareWeightQuant();
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::RunPackedFilter();
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  if (param.filter->precision() == PRECISION(kBF16)) {
+    PrepareBf16();
+    return;
+  }
+  if (param.filter->precision() == PRECISION(kInt8) ||
+      param.filter->precision() == PRECISION(kInt16)) {
+    PrepareWeightQuant();
+    return;
+  }
+#ifndef PADDLE_WITH_MKLML
+  if (param.prepacked_weight != nullptr &&
+      param.prepacked_weight_key == lite::x86::math::sgemm_packed_a_layout()) {
+    CHECK_EQ(param.prepacked_weight->numel(), PackedConvWeightsSize(param))
+        << "The prepacked filter of conv mismatches the filter";
+    packed_weights_.ShareDataWith(*param.prepacked_weight);
+  }
+#endif
+
+  /// select conv impl
+  std::vector<std::string> algos = ConvAlgos(param);
+  std::string algo = algos.back();
+  auto& tuner = KernelTuner::Global();
+  if (tuner.enabled() && algos.size() > 1) {
+    std::vector<std::function<void()>> variants;
+    for (auto& candidate : algos) {
+      variants.push_back([this, candidate] {
+        SelectAlgo(candidate);
+        Run();
+      });
+    }
+    algo = tuner.Tune(ConvSignature(param), algos, variants, algo);
+  }
+  SelectAlgo(algo);
+}
+
+// The filter is prepacked only if the packed sgemm may run it.
+template <>
+std::string Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepackWeights(
+    Tensor* prepacked) {
+#ifndef PADDLE_WITH_MKLML
+  auto& param = this->Param<param_t>();
+  if (param.filter->precision() == PRECISION(kFloat) &&
+      ConvAlgos(param).back() != "depthwise") {
+    PackConvWeights(param, prepacked);
+    return lite::x86::math::sgemm_packed_a_layout();
   }
+#endif
+  return "";
 }
 
 template <>
@@ -93,11 +229,13 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   if (impl_) {
     return impl_->Run();
   }
+  if (flag_bf16_ || flag_weight_quant_) {
+    return RunPackedFilter();
+  }
   auto& ctx = ctx_->As<X86Context>();
   INIT_PARAM
   bool flag_bias = (param.bias != nullptr);
   int group_size_out = m * n;
-  int group_size_weights = m * k;
   int group_size_coldata = n * k;
   int channel_in_size = chin * hin * win;
   int channel_out_size = chout * hout * wout;
@@ -106,17 +244,30 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
 
   auto din = param.x->data<float>();
   auto dout = param.output->mutable_data<float>();
-  auto weights = param.filter->data<float>();
   const float* bias_ptr =
       flag_bias ? static_cast<const float*>(param.bias->data<float>())
                 : nullptr;
   float* col_data = nullptr;
-
+  int col_size = flag_1x1gemm_ ? 0 : group * group_size_coldata;
+#ifdef PADDLE_WITH_MKLML
+  auto weights = param.filter->data<float>();
   if (!flag_1x1gemm_) {
-    int col_size = group * group_size_coldata;
-    col_data = static_cast<float*>(
-        TargetMalloc(TARGET(kX86), col_size * sizeof(float)));
+    ctx.ExtendWorkspace(col_size * sizeof(float));
+    col_data = ctx.workspace_data<float>();
+  }
+#else
+  // Without MKL, the weights are multiplied by the packed sgemm, and the
+  // columns are packed after the im2col data in the workspace.
+  if (packed_weights_.dims().empty()) {
+    PackConvWeights(param, &packed_weights_);
   }
+  const float* packed_weights = packed_weights_.data<float>();
+  const int packed_a_size = packed_weights_.dims()[1];
+  ctx.ExtendWorkspace(
+      (col_size + lite::x86::math::sgemm_packed_b_size(k, n)) * sizeof(float));
+  col_data = ctx.workspace_data<float>();
+  float* packed_col = col_data + col_size;
+#endif
   auto act_param = param.activation_param;
   paddle::lite::x86::math::Blas<lite::TargetType::kX86> matmul(ctx);
   for (int i = 0; i < num; i++) {
@@ -144,8 +295,9 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
 
     for (int g = 0; g < group; g++) {
       const float* col_data_group = din_data + g * group_size_coldata;
-      const float* weights_group = weights + g * group_size_weights;
       float* dout_group = dout_batch + g * group_size_out;
+#ifdef PADDLE_WITH_MKLML
+      const float* weights_group = weights + g * m * k;
       if (n == 1) {
         matmul.GEMV<float>(
             false, m, k, 1.f, weights_group, col_data_group, 0.f, dout_group);
@@ -164,12 +316,364 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                            dout_group,
                            n);
       }
+#else
+      lite::x86::math::sgemm_pack_b(false, col_data_group, k, n, n, packed_col);
+      lite::x86::math::sgemm_packed(packed_weights + g * packed_a_size,
+                                    packed_col,
+                                    m,
+                                    n,
+                                    k,
+                                    dout_group,
+                                    n);
+#endif
     }
     // bias and activate
     lite::x86::math::fill_bias_act(
         dout_batch, bias_ptr, chout, wout * hout, flag_bias, &act_param);
   }
-  if (!flag_1x1gemm_) TargetFree(TARGET(kX86), col_data);
+}
+
+// The filter of each group is packed as B of bf16 gemm, and the transposed
+// columns are multiplied with it as A, so the fp32 output of the group is the
+// transposed C.
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareBf16() {
+  auto& param = this->Param<param_t>();
+  flag_bf16_ = true;
+  const int groups = param.groups;
+  const int m = param.filter->dims()[0] / groups;
+  const int k = param.filter->numel() / param.filter->dims()[0];
+  const int packed_size = lite::x86::math::gemm_bf16_packed_b_size(k, m);
+  packed_weights_.Resize({groups, packed_size});
+  auto weights = param.filter->data<bfloat16>();
+  auto packed = packed_weights_.mutable_data<bfloat16>();
+  for (int g = 0; g < groups; g++) {
+    lite::x86::math::gemm_bf16_pack_b(
+        true, weights + g * m * k, k, m, k, packed + g * packed_size);
+  }
+}
+
+// The weight-only quantized filter of each group is packed as B of the
+// weight-only quantized gemm as the bf16 filter, and the scale of each output
+// channel is applied to the output of the gemm.
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareWeightQuant() {
+  auto& param = this->Param<param_t>();
+  flag_weight_quant_ = true;
+  const int groups = param.groups;
+  const int chout = param.filter->dims()[0];
+  const int m = chout / groups;
+  const int k = param.filter->numel() / chout;
+  CHECK(param.weight_scale.size() == 1 ||
+        param.weight_scale.size() == static_cast<size_t>(chout))
+      << "The weight scale of conv should be 1 or " << chout << ", but got "
+      << param.weight_scale.size();
+  quant_scale_.resize(chout);
+  for (int i = 0; i < chout; i++) {
+    quant_scale_[i] = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                     : param.weight_scale[i];
+  }
+  const int packed_size =
+      lite::x86::math::gemm_weight_quant_packed_b_size(k, m);
+  packed_weights_.Resize({groups, packed_size});
+  for (int g = 0; g < groups; g++) {
+    if (param.filter->precision() == PRECISION(kInt8)) {
+      lite::x86::math::gemm_weight_quant_pack_b(
+          true,
+          param.filter->data<int8_t>() + g * m * k,
+          k,
+          m,
+          k,
+          packed_weights_.mutable_data<int8_t>() + g * packed_size);
+    } else {
+      lite::x86::math::gemm_weight_quant_pack_b(
+          true,
+          param.filter->data<int16_t>() + g * m * k,
+          k,
+          m,
+          k,
+          packed_weights_.mutable_data<int16_t>() + g * packed_size);
+    }
+  }
+}
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::RunPackedFilter() {
+  auto& ctx = ctx_->As<X86Context>();
+  INIT_PARAM
+  auto paddings = *param.paddings;
+  auto dilations = *param.dilations;
+  bool flag_1x1 = kh == 1 && kw == 1 && param.strides[0] == 1 &&
+                  param.strides[1] == 1 && paddings[0] == 0 &&
+                  paddings[1] == 0 && paddings[2] == 0 && paddings[3] == 0 &&
+                  dilations[0] == 1 && dilations[1] == 1;
+  int col_size = flag_1x1 ? 0 : group * n * k;
+  int packed_col_size =
+      flag_bf16_ ? lite::x86::math::gemm_bf16_packed_a_size(n, k)
+                 : lite::x86::math::gemm_weight_quant_packed_a_size(n, k);
+  ctx.ExtendWorkspace((col_size + packed_col_size) * sizeof(float));
+  float* col_data = ctx.workspace_data<float>();
+  float* packed_col = col_data + col_size;
+
+  auto din = param.x->data<float>();
+  auto dout = param.output->mutable_data<float>();
+  const int packed_b_size = packed_weights_.dims()[1];
+  bool flag_bias = param.bias != nullptr;
+  const float* bias_ptr = flag_bias ? param.bias->data<float>() : nullptr;
+  auto act_param = param.activation_param;
+  lite::x86::math::GemmBf16Epilogue bf16_epilogue;
+  bf16_epilogue.trans_c = true;
+  lite::x86::math::GemmWeightQuantEpilogue quant_epilogue;
+  quant_epilogue.trans_c = true;
+  for (int i = 0; i < num; i++) {
+    const float* din_batch = din + i * chin * hin * win;
+    float* dout_batch = dout + i * chout * n;
+    const float* din_data = din_batch;
+    if (!flag_1x1) {
+      lite::x86::math::im2col<float>(din_batch,
+                                     chin,
+                                     hin,
+                                     win,
+                                     kh,
+                                     kw,
+                                     paddings[0],
+                                     paddings[1],
+                                     paddings[2],
+                                     paddings[3],
+                                     param.strides[0],
+                                     param.strides[1],
+                                     dilations[0],
+                                     dilations[1],
+                                     col_data);
+      din_data = col_data;
+    }
+    for (int g = 0; g < group; g++) {
+      float* dout_group = dout_batch + g * m * n;
+      if (flag_bf16_) {
+        lite::x86::math::gemm_bf16_pack_a(
+            true, din_data + g * k * n, n, k, n, packed_col);
+        lite::x86::math::gemm_bf16(
+            packed_col,
+            packed_weights_.data<bfloat16>() + g * packed_b_size,
+            n,
+            m,
+            k,
+            bf16_epilogue,
+            dout_group,
+            n);
+        continue;
+      }
+      lite::x86::math::gemm_weight_quant_pack_a(
+          true, din_data + g * k * n, n, k, n, packed_col);
+      quant_epilogue.scale = quant_scale_.data() + g * m;
+      if (param.filter->precision() == PRECISION(kInt8)) {
+        lite::x86::math::gemm_weight_quant(
+            packed_col,
+            packed_weights_.data<int8_t>() + g * packed_b_size,
+            n,
+            m,
+            k,
+            quant_epilogue,
+            dout_group,
+            n);
+      } else {
+        lite::x86::math::gemm_weight_quant(
+            packed_col,
+            packed_weights_.data<int16_t>() + g * packed_b_size,
+            n,
+            m,
+            k,
+            quant_epilogue,
+            dout_group,
+            n);
+      }
+    }
+    // bias and activate
+    lite::x86::math::fill_bias_act(
+        dout_batch, bias_ptr, chout, n, flag_bias, &act_param);
+  }
+}
+
+template <PrecisionType Ptype, PrecisionType OutType>
+void Conv2dCompute<Ptype, OutType>::PrepareInt8() {
+  auto& param = this->template Param<param_t>();
+  const int input_channel = param.x->dims()[1];
+  const int output_channel = param.filter->dims()[0];
+  const int groups = param.groups;
+  flag_dw_int8_ = (input_channel == groups && output_channel == groups);
+
+  // The int32 accumulators are dequantized by input_scale * weight_scale, and
+  // requantized by output_scale if the output is int8.
+  CHECK(!param.weight_scale.empty()) << "The weight scale of conv is empty";
+  float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+  w_scale_.resize(output_channel);
+  for (int i = 0; i < output_channel; i++) {
+    float w_scale = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                   : param.weight_scale[i];
+    w_scale_[i] = param.input_scale * w_scale / out_scale;
+  }
+  bias_.clear();
+  if (param.bias) {
+    auto bias_data = param.bias->template data<float>();
+    bias_.resize(output_channel);
+    for (int i = 0; i < output_channel; i++) {
+      bias_[i] = bias_data[i] / out_scale;
+    }
+  }
+
+  auto& act_param = param.activation_param;
+  if (act_param.has_active) {
+    epilogue_.act_type = act_param.active_type;
+    epilogue_.relu6_threshold = act_param.Relu_clipped_coef / out_scale;
+    epilogue_.leaky_alpha = act_param.Leaky_relu_alpha;
+  }
+
+  if (flag_dw_int8_) return;
+  // Pack the weights of each group as A of int8 gemm once.
+  const int m = output_channel / groups;
+  const int k = param.filter->numel() / output_channel;
+  const int packed_size = lite::x86::math::gemm_s8_packed_a_size(m, k);
+  packed_weights_.Resize({groups, packed_size});
+  auto weights = param.filter->template data<int8_t>();
+  auto packed = packed_weights_.mutable_data<int16_t>();
+  for (int g = 0; g < groups; g++) {
+    lite::x86::math::gemm_s8_pack_a(
+        weights + g * m * k, m, k, k, packed + g * packed_size);
+  }
+}
+
+template <PrecisionType Ptype, PrecisionType OutType>
+template <typename Dtype>
+void Conv2dCompute<Ptype, OutType>::RunInt8() {
+  auto& ctx = this->ctx_->template As<X86Context>();
+  auto& param = this->template Param<param_t>();
+  auto x_dims = param.x->dims();
+  auto w_dims = param.filter->dims();
+  auto o_dims = param.output->dims();
+  int win = x_dims[3];
+  int hin = x_dims[2];
+  int chin = x_dims[1];
+  int num = x_dims[0];
+  int wout = o_dims[3];
+  int hout = o_dims[2];
+  int chout = o_dims[1];
+  int kw = w_dims[3];
+  int kh = w_dims[2];
+  int group = param.groups;
+  int m = chout / group;
+  int n = hout * wout;
+  int k = chin * kw * kh / group;
+  auto paddings = *param.paddings;
+  auto dilations = *param.dilations;
+
+  auto din = param.x->template data<int8_t>();
+  auto dout = param.output->template mutable_data<Dtype>();
+  epilogue_.scale = w_scale_.data();
+  epilogue_.bias = bias_.empty() ? nullptr : bias_.data();
+  epilogue_.per_row = true;
+
+  if (flag_dw_int8_) {
+    auto weights = param.filter->template data<int8_t>();
+    for (int i = 0; i < num; i++) {
+      lite::x86::math::conv_depthwise_s8<Dtype>(din + i * chin * hin * win,
+                                                weights,
+                                                chin,
+                                                hin,
+                                                win,
+                                                hout,
+                                                wout,
+                                                kh,
+                                                kw,
+                                                paddings[0],
+                                                paddings[2],
+                                                param.strides[0],
+                                                param.strides[1],
+                                                dilations[0],
+                                                dilations[1],
+                                                epilogue_,
+                                                dout + i * chout * n);
+    }
+    return;
+  }
+
+  // The columns of each group are packed as B of int8 gemm in the workspace.
+  bool flag_1x1 = kh == 1 && kw == 1 && param.strides[0] == 1 &&
+                  param.strides[1] == 1 && paddings[0] == 0 &&
+                  paddings[1] == 0 && paddings[2] == 0 && paddings[3] == 0;
+  ctx.ExtendWorkspace(lite::x86::math::gemm_s8_packed_b_size(k, n) *
+                      sizeof(int16_t));
+  int16_t* packed_b = ctx.template workspace_data<int16_t>();
+  const int16_t* packed_weights = packed_weights_.data<int16_t>();
+  const int packed_a_size = packed_weights_.dims()[1];
+  for (int i = 0; i < num; i++) {
+    const int8_t* din_batch = din + i * chin * hin * win;
+    Dtype* dout_batch = dout + i * chout * n;
+    for (int g = 0; g < group; g++) {
+      const int8_t* din_group = din_batch + g * (chin / group) * hin * win;
+      if (flag_1x1) {
+        lite::x86::math::gemm_s8_pack_b(din_group, k, n, n, packed_b);
+      } else {
+        lite::x86::math::im2col_pack_s8(din_group,
+                                        chin / group,
+                                        hin,
+                                        win,
+                                        kh,
+                                        kw,
+                                        paddings[0],
+                                        paddings[2],
+                                        param.strides[0],
+                                        param.strides[1],
+                                        dilations[0],
+                                        dilations[1],
+                                        hout,
+                                        wout,
+                                        packed_b);
+      }
+      lite::x86::math::GemmS8Epilogue epilogue = epilogue_;
+      epilogue.scale += g * m;
+      if (epilogue.bias) epilogue.bias += g * m;
+      lite::x86::math::gemm_s8<Dtype>(packed_weights + g * packed_a_size,
+                                      packed_b,
+                                      m,
+                                      n,
+                                      k,
+                                      epilogue,
+                                      dout_batch + g * m * n,
+                                      n);
+    }
+  }
+}
+
+template <>
+void Conv2dCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
+  PrepareInt8();
+}
+
+template <>
+void Conv2dCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
+  RunInt8<float>();
+}
+
+template <>
+std::string Conv2dCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepackWeights(
+    Tensor* prepacked) {
+  return "";
+}
+
+template <>
+void Conv2dCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
+  PrepareInt8();
+}
+
+template <>
+void Conv2dCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
+  RunInt8<int8_t>();
+}
+
+template <>
+std::string Conv2dCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepackWeights(
+    Tensor* prepacked) {
+  return "";
 }
 #undef INIT_PARAM
 }  // namespace x86
@@ -188,6 +692,8 @@ REGISTER_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW, ConvFp32, def)
     .BindInput("Filter",
                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("PrepackedWeight",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
     .BindOutput("Output",
                 {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
     .BindPaddleOpVersion("conv2d", 1)
@@ -199,6 +705,57 @@ REGISTER_LITE_KERNEL(depthwise_conv2d, kX86, kFloat, kNCHW, ConvFp32, def)
     .BindInput("Filter",
                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("PrepackedWeight",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindPaddleOpVersion("depthwise_conv2d", 1)
+    .Finalize();
+
+typedef paddle::lite::kernels::x86::Conv2dCompute<PRECISION(kInt8),
+                                                  PRECISION(kFloat)>
+    ConvInt8_Fp32;
+typedef paddle::lite::kernels::x86::Conv2dCompute<PRECISION(kInt8),
+                                                  PRECISION(kInt8)>
+    ConvInt8_Int8;
+
+REGISTER_LITE_KERNEL(conv2d, kX86, kInt8, kNCHW, ConvInt8_Int8, int8_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindPaddleOpVersion("conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(conv2d, kX86, kInt8, kNCHW, ConvInt8_Fp32, fp32_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindPaddleOpVersion("conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    depthwise_conv2d, kX86, kInt8, kNCHW, ConvInt8_Int8, int8_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindPaddleOpVersion("depthwise_conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    depthwise_conv2d, kX86, kInt8, kNCHW, ConvInt8_Fp32, fp32_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
     .BindOutput("Output",
                 {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
     .BindPaddleOpVersion("depthwise_conv2d", 1)
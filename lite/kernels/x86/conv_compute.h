@@ -19,6 +19,9 @@
 #include "lite/backends/x86/math/blas.h"
 #include "lite/backends/x86/math/conv_bias.h"
 #include "lite/backends/x86/math/conv_utils.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include "lite/backends/x86/math/gemm_weight_quant.h"
+#include "lite/backends/x86/math/gemm_int8.h"
 #include "lite/backends/x86/math/im2col.h"
 #include "lite/backends/x86/math/vol2col.h"
 #include "lite/core/kernel.h"
@@ -58,6 +61,8 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
 
   virtual void Run();
 
+  virtual std::string PrepackWeights(Tensor* prepacked);
+
 #ifdef LITE_WITH_PROFILE
   std::string kernel_func_name_{"Conv2d"};
   virtual void SetProfileRuntimeKernelInfo(
@@ -74,8 +79,30 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
 
  private:
   using param_t = operators::ConvParam;
+  // Switch to the conv algorithm "gemm", "gemm_1x1" or "depthwise".
+  void SelectAlgo(const std::string& algo);
+
   KernelLite<TARGET(kX86), Ptype>* impl_{nullptr};
   bool flag_1x1gemm_{false};
+
+  // for the bf16 filter converted by opt and the weight-only quantized
+  // filter kept in int8 or int16, both are run by im2col and the packed gemm
+  void PrepareBf16();
+  void PrepareWeightQuant();
+  void RunPackedFilter();
+  bool flag_bf16_{false};
+  bool flag_weight_quant_{false};
+  std::vector<float> quant_scale_;
+
+  // for int8
+  void PrepareInt8();
+  template <typename Dtype>
+  void RunInt8();
+  bool flag_dw_int8_{false};
+  Tensor packed_weights_;
+  std::vector<float> w_scale_;
+  std::vector<float> bias_;
+  lite::x86::math::GemmS8Epilogue epilogue_;
 };
 
 }  // namespace x86
@@ -14,10 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "lite/core/kernel_tuner.h"
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/conv_compute.h"
 
@@ -92,6 +96,296 @@ TEST(conv2d_x86, run_test) {
   }
 }
 
+// The depthwise conv with the algorithm chosen by the kernel tuning.
+TEST(conv2d_x86, tuned_depthwise_run_test) {
+  const int ch = 8;
+  const int h = 10;
+  const int w = 9;
+  lite::Tensor x, filter, out;
+  x.Resize({1, ch, h, w});
+  filter.Resize({ch, 1, 3, 3});
+  out.Resize({1, ch, h, w});
+  auto x_data = x.mutable_data<float>();
+  auto filter_data = filter.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+  }
+  for (int64_t i = 0; i < filter.numel(); i++) {
+    filter_data[i] = static_cast<float>(i % 5) * 0.2f - 0.4f;
+  }
+
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.output = &out;
+  param.strides = {1, 1};
+  param.groups = ch;
+  param.paddings = std::make_shared<std::vector<int>>(4, 1);
+  param.dilations = std::make_shared<std::vector<int>>(2, 1);
+  KernelTuner::Global().Init(lite_api::CPU_TUNE_NORMAL, "", 1);
+  Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.PrepareForRun();
+  // The output of the tuning runs is overwritten.
+  float* out_ptr = out.mutable_data<float>();
+  std::fill(out_ptr, out_ptr + out.numel(), 0.f);
+  conv2d.Run();
+  KernelTuner::Global().Reset();
+
+  auto out_data = out.data<float>();
+  for (int c = 0; c < ch; c++) {
+    for (int y = 0; y < h; y++) {
+      for (int z = 0; z < w; z++) {
+        float ref = 0.f;
+        for (int i = 0; i < 3; i++) {
+          for (int j = 0; j < 3; j++) {
+            int iy = y - 1 + i;
+            int ix = z - 1 + j;
+            if (iy < 0 || iy >= h || ix < 0 || ix >= w) continue;
+            ref += x_data[(c * h + iy) * w + ix] *
+                   filter_data[(c * 3 + i) * 3 + j];
+          }
+        }
+        EXPECT_NEAR(out_data[(c * h + y) * w + z], ref, 1e-4);
+      }
+    }
+  }
+}
+
+template <PrecisionType OutType, typename Dtype>
+void test_conv2d_int8(int groups) {
+  const int batch_size = 2;
+  const int ic = 4;
+  const int oc = 4;
+  const int h = 6;
+  const int w = 5;
+  lite::Tensor x, filter, b, out;
+  x.Resize({batch_size, ic, h, w});
+  filter.Resize({oc, ic / groups, 3, 3});
+  b.Resize({oc});
+  out.Resize({batch_size, oc, h, w});
+  auto x_data = x.mutable_data<int8_t>();
+  auto filter_data = filter.mutable_data<int8_t>();
+  auto b_data = b.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<int8_t>(i % 17 - 8);
+  }
+  for (int64_t i = 0; i < filter.numel(); i++) {
+    filter_data[i] = static_cast<int8_t>(i % 7 - 3);
+  }
+  for (int i = 0; i < oc; i++) {
+    b_data[i] = 0.1f * i;
+  }
+
+  Conv2dCompute<PRECISION(kInt8), OutType> conv2d;
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.bias = &b;
+  param.output = &out;
+  param.strides = {1, 1};
+  param.groups = groups;
+  std::vector<int> paddings = {1, 1, 1, 1};
+  std::vector<int> dilations = {1, 1};
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  param.dilations = std::make_shared<std::vector<int>>(dilations);
+  param.enable_int8 = true;
+  param.input_scale = 0.02f;
+  param.weight_scale = {0.01f, 0.02f, 0.03f, 0.04f};
+  param.output_scale = 0.001f;
+  param.activation_param.has_active = true;
+  param.activation_param.active_type = lite_api::ActivationType::kRelu;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.PrepareForRun();
+  conv2d.Run();
+
+  const int icg = ic / groups;
+  const int ocg = oc / groups;
+  float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+  // The int8 output may differ by 1 because of the rounding.
+  float abs_error = OutType == PRECISION(kInt8) ? 1.f : 1e-3f;
+  auto out_data = out.data<Dtype>();
+  for (int n = 0; n < batch_size; n++) {
+    for (int o = 0; o < oc; o++) {
+      for (int y = 0; y < h; y++) {
+        for (int z = 0; z < w; z++) {
+          int acc = 0;
+          for (int c = 0; c < icg; c++) {
+            for (int i = 0; i < 3; i++) {
+              for (int j = 0; j < 3; j++) {
+                int iy = y - 1 + i;
+                int ix = z - 1 + j;
+                if (iy < 0 || iy >= h || ix < 0 || ix >= w) continue;
+                int in_c = o / ocg * icg + c;
+                acc += x_data[((n * ic + in_c) * h + iy) * w + ix] *
+                       filter_data[((o * icg + c) * 3 + i) * 3 + j];
+              }
+            }
+          }
+          float ref = acc * param.input_scale * param.weight_scale[o] +
+                      b_data[o];
+          ref = std::max(ref, 0.f) / out_scale;
+          if (OutType == PRECISION(kInt8)) {
+            ref = std::min(std::round(ref), 127.f);
+          }
+          EXPECT_NEAR(
+              out_data[((n * oc + o) * h + y) * w + z], ref, abs_error);
+        }
+      }
+    }
+  }
+}
+
+TEST(conv2d_x86, int8_run_test) {
+  for (int groups : {1, 2, 4}) {
+    test_conv2d_int8<PRECISION(kFloat), float>(groups);
+    test_conv2d_int8<PRECISION(kInt8), int8_t>(groups);
+  }
+}
+
+// Run the conv of the filter kept in bf16 or quantized by opt, and compare it
+// with the conv of ref_filter, which holds the fp32 values of the filter. The
+// input may be rounded to bf16, so the tolerance is relative to the absolute
+// products.
+void test_conv2d_packed_filter(lite::Tensor* filter,
+                               const std::vector<float>& ref_filter,
+                               const std::vector<float>& weight_scale,
+                               int groups,
+                               int ksize) {
+  const int batch_size = 2;
+  const int ic = filter->dims()[1] * groups;
+  const int oc = filter->dims()[0];
+  const int h = 6;
+  const int w = 5;
+  const int pad = ksize / 2;
+  lite::Tensor x, b, out;
+  x.Resize({batch_size, ic, h, w});
+  b.Resize({oc});
+  out.Resize({batch_size, oc, h, w});
+  auto x_data = x.mutable_data<float>();
+  auto b_data = b.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 17) * 0.1f - 0.8f;
+  }
+  for (int i = 0; i < oc; i++) {
+    b_data[i] = 0.1f * i - 0.2f;
+  }
+
+  Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = filter;
+  param.bias = &b;
+  param.output = &out;
+  param.strides = {1, 1};
+  param.groups = groups;
+  param.paddings = std::make_shared<std::vector<int>>(4, pad);
+  param.dilations = std::make_shared<std::vector<int>>(2, 1);
+  param.weight_scale = weight_scale;
+  param.activation_param.has_active = true;
+  param.activation_param.active_type = lite_api::ActivationType::kRelu;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.PrepareForRun();
+  conv2d.Run();
+
+  const int icg = ic / groups;
+  const int ocg = oc / groups;
+  auto out_data = out.data<float>();
+  for (int n = 0; n < batch_size; n++) {
+    for (int o = 0; o < oc; o++) {
+      for (int y = 0; y < h; y++) {
+        for (int z = 0; z < w; z++) {
+          float ref = 0.f;
+          float abs_sum = 0.f;
+          for (int c = 0; c < icg; c++) {
+            for (int i = 0; i < ksize; i++) {
+              for (int j = 0; j < ksize; j++) {
+                int iy = y - pad + i;
+                int ix = z - pad + j;
+                if (iy < 0 || iy >= h || ix < 0 || ix >= w) continue;
+                int in_c = o / ocg * icg + c;
+                float prod =
+                    x_data[((n * ic + in_c) * h + iy) * w + ix] *
+                    ref_filter[((o * icg + c) * ksize + i) * ksize + j];
+                ref += prod;
+                abs_sum += std::fabs(prod);
+              }
+            }
+          }
+          ref = std::max(ref + b_data[o], 0.f);
+          EXPECT_NEAR(out_data[((n * oc + o) * h + y) * w + z],
+                      ref,
+                      abs_sum / 256.f + 1e-4f)
+              << "groups=" << groups << " ksize=" << ksize;
+        }
+      }
+    }
+  }
+}
+
+TEST(conv2d_x86, bf16_run_test) {
+  const int ic = 6;
+  const int oc = 4;
+  for (int groups : {1, 2}) {
+    for (int ksize : {1, 3}) {
+      lite::Tensor filter;
+      filter.Resize({oc, ic / groups, ksize, ksize});
+      auto filter_data = filter.mutable_data<bfloat16>();
+      std::vector<float> ref_filter(filter.numel());
+      for (int64_t i = 0; i < filter.numel(); i++) {
+        filter_data[i] = bfloat16(static_cast<float>(i % 7) * 0.13f - 0.4f);
+        ref_filter[i] = static_cast<float>(filter_data[i]);
+      }
+      filter.set_precision(PRECISION(kBF16));
+      test_conv2d_packed_filter(&filter, ref_filter, {}, groups, ksize);
+    }
+  }
+}
+
+// The weight-only quantized filters kept by LightPredictor, with the scales of
+// the output channels or a single scale.
+template <typename T>
+void test_conv2d_weight_quant(int groups, int ksize, bool per_channel) {
+  const int ic = 6;
+  const int oc = 4;
+  const int max = std::numeric_limits<T>::max();
+  lite::Tensor filter;
+  filter.Resize({oc, ic / groups, ksize, ksize});
+  auto filter_data = filter.mutable_data<T>();
+  const int64_t per_oc = filter.numel() / oc;
+  std::vector<float> weight_scale;
+  for (int o = 0; o < (per_channel ? oc : 1); o++) {
+    weight_scale.push_back(0.5f * (o + 1) / max);
+  }
+  std::vector<float> ref_filter(filter.numel());
+  for (int64_t i = 0; i < filter.numel(); i++) {
+    filter_data[i] = static_cast<T>((i * 37) % (2 * max + 1) - max);
+    float scale = weight_scale[per_channel ? i / per_oc : 0];
+    ref_filter[i] = filter_data[i] * scale;
+  }
+  test_conv2d_packed_filter(&filter, ref_filter, weight_scale, groups, ksize);
+}
+
+TEST(conv2d_x86, weight_quant_run_test) {
+  for (int groups : {1, 2}) {
+    for (int ksize : {1, 3}) {
+      for (bool per_channel : {false, true}) {
+        test_conv2d_weight_quant<int8_t>(groups, ksize, per_channel);
+        test_conv2d_weight_quant<int16_t>(groups, ksize, per_channel);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
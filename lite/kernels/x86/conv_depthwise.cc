@@ -22,6 +22,24 @@ namespace lite {
 namespace kernels {
 namespace x86 {
 
+template <>
+void DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  const int input_channel = param.x->dims()[1];
+  const int pack_size =
+      input_channel % 8 == 0 ? 8 : input_channel % 4 == 0 ? 4 : 1;
+  const int pack_num = input_channel / pack_size;
+
+  // The filter is constant, so it's packed once.
+  // filter [oc, 1, ih, iw] & pack_size=8 => [oc/8, ih, iw, 8]
+  // filter [oc, 1, ih, iw] & pack_size=4 => [ic/4, ih, iw, 4]
+  if (pack_size == 8) {
+    lite::x86::math::pack8_m256(param.filter, &filter_pack_, pack_num, true);
+  } else if (pack_size == 4) {
+    lite::x86::math::pack4_m128(param.filter, &filter_pack_, pack_num, true);
+  }
+}
+
 template <>
 void DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = this->Param<param_t>();
@@ -57,14 +75,6 @@ void DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   int kernel_h = param.filter->dims()[2];
   int kernel_w = param.filter->dims()[3];
 
-  // filter [oc, 1, ih, iw] & pack_size=8 => [oc/8, ih, iw, 8]
-  // filter [oc, 1, ih, iw] & pack_size=4 => [ic/4, ih, iw, 4]
-  if (pack_size == 8) {
-    lite::x86::math::pack8_m256(param.filter, &filter_pack_, pack_num, true);
-  } else if (pack_size == 4) {
-    lite::x86::math::pack4_m128(param.filter, &filter_pack_, pack_num, true);
-  }
-
   // attributes
   const int stride_h = param.strides[0];
   const int stride_w = param.strides[1];
@@ -29,6 +29,7 @@ class DepthwiseConv : public KernelLite<TARGET(kX86), Ptype> {
  public:
   DepthwiseConv() = default;
   ~DepthwiseConv() {}
+  virtual void PrepareForRun();
   virtual void Run();
 
 #ifdef LITE_WITH_PROFILE
@@ -0,0 +1,166 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/conv_nchw8c_compute.h"
+#include "lite/backends/x86/math/conv_depthwise_pack8.h"
+#include "lite/backends/x86/math/conv_utils.h"
+#include "lite/backends/x86/math/nchw8c.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void Conv2dNCHW8cCompute::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  const int input_channel = param.x->dims()[1];
+  const int output_channel = param.filter->dims()[0];
+  is_depthwise_ = param.groups == input_channel &&
+                  param.groups == output_channel && param.groups > 1;
+  if (is_depthwise_) {
+    lite::x86::math::pack_depthwise_filter_nchw8c(*param.filter,
+                                                  &packed_filter_);
+  } else if (param.groups == 1) {
+    lite::x86::math::pack_conv_filter_nchw8c(*param.filter, &packed_filter_);
+  }
+  if (param.bias) {
+    lite::x86::math::pad_channel_nchw8c(*param.bias, &packed_bias_);
+  }
+}
+
+void Conv2dNCHW8cCompute::Run() {
+  auto& param = this->Param<param_t>();
+  CHECK_EQ(param.x->dims().size(), 4UL);
+  CHECK_EQ(param.output->dims().size(), 4UL);
+  const auto& paddings = *param.paddings;
+  const auto& dilations = *param.dilations;
+  const auto& act_param = param.activation_param;
+  const float* bias = param.bias ? packed_bias_.data<float>() : nullptr;
+
+  if (is_depthwise_) {
+    const auto& in_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    const int64_t block = lite::x86::math::kNCHW8cBlock;
+    const int64_t blocks = (in_dims[1] + block - 1) / block;
+    // The storage of NCHW8c is the layout of conv_depthwise_m256, so the
+    // tensors are viewed as [n, c / 8, h, w, 8] without the repacking.
+    input_view_.ShareDataWith(*param.x);
+    input_view_.Resize({in_dims[0], blocks, in_dims[2], in_dims[3], block});
+    lite::x86::math::padding8_m256(&input_view_, &input_padding_, paddings);
+    lite::x86::math::nchw8c_mutable_data(param.output);
+    output_view_.ShareDataWith(*param.output);
+    output_view_.Resize(
+        {out_dims[0], blocks, out_dims[2], out_dims[3], block});
+
+    const int kernel_h = param.filter->dims()[2];
+    const int kernel_w = param.filter->dims()[3];
+    const bool is_3x3 = kernel_h == 3 && kernel_w == 3 && dilations[0] == 1 &&
+                        dilations[1] == 1;
+    Tensor* bias_tensor = param.bias ? &packed_bias_ : nullptr;
+    if (is_3x3 && param.strides[0] == 1 && param.strides[1] == 1) {
+      lite::x86::math::conv_depthwise_3x3s1_m256(&input_padding_,
+                                                 &output_view_,
+                                                 &packed_filter_,
+                                                 bias_tensor,
+                                                 act_param.has_active,
+                                                 act_param.active_type);
+    } else if (is_3x3 && param.strides[0] == 2 && param.strides[1] == 2) {
+      lite::x86::math::conv_depthwise_3x3s2_m256(&input_padding_,
+                                                 &output_view_,
+                                                 &packed_filter_,
+                                                 bias_tensor,
+                                                 act_param.has_active,
+                                                 act_param.active_type);
+    } else {
+      lite::x86::math::conv_depthwise_m256(&input_padding_,
+                                           &output_view_,
+                                           &packed_filter_,
+                                           bias_tensor,
+                                           param.strides[0],
+                                           param.strides[1],
+                                           dilations[0],
+                                           dilations[1],
+                                           act_param.has_active,
+                                           act_param.active_type);
+    }
+  } else if (param.groups == 1) {
+    lite::x86::math::conv2d_nchw8c(*param.x,
+                                   packed_filter_,
+                                   bias,
+                                   param.filter->dims()[2],
+                                   param.filter->dims()[3],
+                                   param.strides,
+                                   paddings,
+                                   dilations,
+                                   act_param.has_active,
+                                   act_param.active_type,
+                                   param.output);
+  } else {
+    lite::x86::math::conv2d_group_nchw8c(*param.x,
+                                         *param.filter,
+                                         bias,
+                                         param.groups,
+                                         param.strides,
+                                         paddings,
+                                         dilations,
+                                         act_param.has_active,
+                                         act_param.active_type,
+                                         param.output);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(conv2d,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::Conv2dNCHW8cCompute,
+                     def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .BindPaddleOpVersion("conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(depthwise_conv2d,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::Conv2dNCHW8cCompute,
+                     def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .BindPaddleOpVersion("depthwise_conv2d", 1)
+    .Finalize();
@@ -0,0 +1,51 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/operators/conv_op.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// The conv2d and depthwise_conv2d of the NCHW8c input and output, the filter
+// and bias are packed once in PrepareForRun.
+class Conv2dNCHW8cCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW8c)> {
+ public:
+  using param_t = operators::ConvParam;
+
+  void PrepareForRun() override;
+  void Run() override;
+
+  virtual ~Conv2dNCHW8cCompute() = default;
+
+ private:
+  bool is_depthwise_{false};
+  Tensor packed_filter_;
+  Tensor packed_bias_;
+  // The 5-D views of the input and output for conv_depthwise_m256.
+  Tensor input_view_;
+  Tensor input_padding_;
+  Tensor output_view_;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,185 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/conv_nchw8c_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/layout_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+static void fill_random(lite::Tensor* tensor, std::mt19937* engine) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  float* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    data[i] = dist(*engine);
+  }
+}
+
+template <typename KernelType>
+static void run_layout(const lite::Tensor* x, lite::Tensor* y) {
+  KernelType layout;
+  operators::LayoutParam param;
+  param.x = x;
+  param.y = y;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  layout.SetContext(std::move(ctx));
+  layout.SetParam(param);
+  layout.Run();
+}
+
+static std::vector<float> conv_ref(const operators::ConvParam& param) {
+  const auto& in_dims = param.x->dims();
+  const auto& out_dims = param.output->dims();
+  const int batch = in_dims[0];
+  const int ic = in_dims[1];
+  const int ih = in_dims[2];
+  const int iw = in_dims[3];
+  const int oc = out_dims[1];
+  const int oh = out_dims[2];
+  const int ow = out_dims[3];
+  const int kh = param.filter->dims()[2];
+  const int kw = param.filter->dims()[3];
+  const int icg = ic / param.groups;
+  const int ocg = oc / param.groups;
+  const auto& paddings = *param.paddings;
+  const auto& dilations = *param.dilations;
+  const float* x = param.x->data<float>();
+  const float* w = param.filter->data<float>();
+  std::vector<float> out(param.output->numel());
+  for (int n = 0; n < batch; n++) {
+    for (int o = 0; o < oc; o++) {
+      for (int y = 0; y < oh; y++) {
+        for (int z = 0; z < ow; z++) {
+          float sum = param.bias ? param.bias->data<float>()[o] : 0.f;
+          for (int c = 0; c < icg; c++) {
+            for (int i = 0; i < kh; i++) {
+              for (int j = 0; j < kw; j++) {
+                int iy = y * param.strides[0] - paddings[0] + i * dilations[0];
+                int ix = z * param.strides[1] - paddings[2] + j * dilations[1];
+                if (iy < 0 || iy >= ih || ix < 0 || ix >= iw) continue;
+                int in_c = o / ocg * icg + c;
+                sum += x[((n * ic + in_c) * ih + iy) * iw + ix] *
+                       w[((o * icg + c) * kh + i) * kw + j];
+              }
+            }
+          }
+          if (param.activation_param.has_active) {
+            sum = std::max(sum, 0.f);
+          }
+          out[((n * oc + o) * oh + y) * ow + z] = sum;
+        }
+      }
+    }
+  }
+  return out;
+}
+
+// Run NCHW -> NCHW8c -> conv2d -> NCHW, and compare it with the reference.
+static void test_conv2d_nchw8c(int batch,
+                               int ic,
+                               int ih,
+                               int iw,
+                               int oc,
+                               int groups,
+                               int kernel,
+                               int stride,
+                               int padding,
+                               int dilation,
+                               bool has_act) {
+  std::mt19937 engine(0);
+  const int kernel_extent = dilation * (kernel - 1) + 1;
+  const int oh = (ih + 2 * padding - kernel_extent) / stride + 1;
+  const int ow = (iw + 2 * padding - kernel_extent) / stride + 1;
+  lite::Tensor x, filter, bias, out;
+  lite::Tensor x_8c, out_8c;
+  x.Resize({batch, ic, ih, iw});
+  filter.Resize({oc, ic / groups, kernel, kernel});
+  bias.Resize({oc});
+  out.Resize({batch, oc, oh, ow});
+  fill_random(&x, &engine);
+  fill_random(&filter, &engine);
+  fill_random(&bias, &engine);
+
+  run_layout<NCHWToNCHW8cCompute>(&x, &x_8c);
+  operators::ConvParam param;
+  param.x = &x_8c;
+  param.filter = &filter;
+  param.bias = &bias;
+  param.output = &out_8c;
+  param.strides = {stride, stride};
+  param.groups = groups;
+  std::vector<int> paddings(4, padding);
+  std::vector<int> dilations(2, dilation);
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  param.dilations = std::make_shared<std::vector<int>>(dilations);
+  param.activation_param.has_active = has_act;
+  param.activation_param.active_type = lite_api::ActivationType::kRelu;
+  out_8c.Resize({batch, oc, oh, ow});
+
+  Conv2dNCHW8cCompute conv2d;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.PrepareForRun();
+  conv2d.Run();
+  run_layout<NCHW8cToNCHWCompute>(&out_8c, &out);
+
+  param.x = &x;
+  param.output = &out;
+  auto ref = conv_ref(param);
+  const float* out_data = out.data<float>();
+  for (int64_t i = 0; i < out.numel(); i++) {
+    EXPECT_NEAR(out_data[i], ref[i], 1e-4);
+  }
+}
+
+TEST(conv2d_nchw8c_x86, retrive_op) {
+  auto conv2d = KernelRegistry::Global().Create("conv2d");
+  ASSERT_FALSE(conv2d.empty());
+  ASSERT_TRUE(conv2d.front());
+}
+
+TEST(conv2d_nchw8c_x86, run_test) {
+  // The channels which aren't the multiple of 8 are padded.
+  test_conv2d_nchw8c(2, 16, 9, 11, 24, 1, 3, 1, 1, 1, true);
+  test_conv2d_nchw8c(1, 5, 7, 20, 13, 1, 3, 2, 1, 1, false);
+  test_conv2d_nchw8c(1, 19, 6, 6, 8, 1, 1, 1, 0, 1, false);
+  test_conv2d_nchw8c(1, 8, 10, 17, 16, 1, 3, 1, 2, 2, true);
+  // depthwise
+  test_conv2d_nchw8c(2, 16, 9, 9, 16, 16, 3, 1, 1, 1, true);
+  test_conv2d_nchw8c(1, 13, 9, 9, 13, 13, 3, 2, 1, 1, false);
+  test_conv2d_nchw8c(1, 24, 11, 11, 24, 24, 5, 1, 2, 1, false);
+  // group
+  test_conv2d_nchw8c(1, 12, 7, 7, 18, 3, 3, 1, 1, 1, true);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW8c, def);
+USE_LITE_KERNEL(layout, kX86, kFloat, kNCHW, nchw2nchw8c);
+USE_LITE_KERNEL(layout, kX86, kFloat, kNCHW, nchw8c2nchw);
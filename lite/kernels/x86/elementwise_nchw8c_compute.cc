@@ -0,0 +1,73 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/elementwise_nchw8c_compute.h"
+
+typedef paddle::lite::kernels::x86::ElementwiseNCHW8cCompute<
+    paddle::lite::x86::math::ElementwiseNCHW8cType::kAdd>
+    ElementwiseAddNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHW8cCompute<
+    paddle::lite::x86::math::ElementwiseNCHW8cType::kSub>
+    ElementwiseSubNCHW8c;
+typedef paddle::lite::kernels::x86::ElementwiseNCHW8cCompute<
+    paddle::lite::x86::math::ElementwiseNCHW8cType::kMul>
+    ElementwiseMulNCHW8c;
+
+REGISTER_LITE_KERNEL(
+    elementwise_add, kX86, kFloat, kNCHW8c, ElementwiseAddNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    elementwise_sub, kX86, kFloat, kNCHW8c, ElementwiseSubNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    elementwise_mul, kX86, kFloat, kNCHW8c, ElementwiseMulNCHW8c, def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindInput("Y",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
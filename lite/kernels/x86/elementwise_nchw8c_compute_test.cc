@@ -0,0 +1,148 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/elementwise_nchw8c_compute.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/layout_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+static void fill_random(lite::Tensor* tensor, std::mt19937* engine) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  float* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    data[i] = dist(*engine);
+  }
+}
+
+template <typename KernelType>
+static void run_layout(const lite::Tensor* x, lite::Tensor* y) {
+  KernelType layout;
+  operators::LayoutParam param;
+  param.x = x;
+  param.y = y;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  layout.SetContext(std::move(ctx));
+  layout.SetParam(param);
+  layout.Run();
+}
+
+// The element of the NCHW tensor which is broadcast to the index of out, the
+// tensor of the lower rank is aligned to out by axis.
+static float broadcast_value(const lite::Tensor& tensor,
+                             const DDim& out_dims,
+                             const std::vector<int64_t>& index,
+                             int axis) {
+  const auto& dims = tensor.dims();
+  const int rank = out_dims.size();
+  const int offset = dims.size() == out_dims.size()
+                         ? 0
+                         : (axis == -1 ? rank - dims.size() : axis);
+  int64_t pos = 0;
+  for (size_t i = 0; i < dims.size(); i++) {
+    pos = pos * dims[i] + (dims[i] == 1 ? 0 : index[offset + i]);
+  }
+  return tensor.data<float>()[pos];
+}
+
+// Run NCHW -> NCHW8c -> elementwise_add -> NCHW, and compare it with the
+// reference.
+static void test_elementwise_add_nchw8c(const std::vector<int64_t>& x_shape,
+                                        const std::vector<int64_t>& y_shape,
+                                        const std::vector<int64_t>& out_shape,
+                                        int axis) {
+  std::mt19937 engine(0);
+  lite::Tensor x, y, out;
+  lite::Tensor x_8c, y_8c, out_8c;
+  x.Resize(x_shape);
+  y.Resize(y_shape);
+  fill_random(&x, &engine);
+  fill_random(&y, &engine);
+  run_layout<NCHWToNCHW8cCompute>(&x, &x_8c);
+  run_layout<NCHWToNCHW8cCompute>(&y, &y_8c);
+
+  operators::ElementwiseParam param;
+  param.X = &x_8c;
+  param.Y = &y_8c;
+  param.Out = &out_8c;
+  param.axis = axis;
+  out_8c.Resize(out_shape);
+
+  ElementwiseNCHW8cCompute<lite::x86::math::ElementwiseNCHW8cType::kAdd>
+      elementwise_add;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  elementwise_add.SetContext(std::move(ctx));
+  elementwise_add.SetParam(param);
+  elementwise_add.Run();
+  run_layout<NCHW8cToNCHWCompute>(&out_8c, &out);
+
+  const DDim out_dims(out_shape);
+  ASSERT_EQ(out.dims(), out_dims);
+  const float* out_data = out.data<float>();
+  std::vector<int64_t> index(out_shape.size(), 0);
+  for (int64_t i = 0; i < out.numel(); i++) {
+    int64_t remain = i;
+    for (int d = static_cast<int>(out_shape.size()) - 1; d >= 0; d--) {
+      index[d] = remain % out_shape[d];
+      remain /= out_shape[d];
+    }
+    float ref = broadcast_value(x, out_dims, index, axis) +
+                broadcast_value(y, out_dims, index, axis);
+    ASSERT_NEAR(out_data[i], ref, 1e-5) << "at " << i;
+  }
+}
+
+TEST(elementwise_add_nchw8c_x86, retrive_op) {
+  auto elementwise_add = KernelRegistry::Global().Create("elementwise_add");
+  ASSERT_FALSE(elementwise_add.empty());
+  ASSERT_TRUE(elementwise_add.front());
+}
+
+TEST(elementwise_add_nchw8c_x86, run_test) {
+  // The same dims, a scalar and the per channel y.
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {2, 13, 5, 7}, {2, 13, 5, 7}, -1);
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {1}, {2, 13, 5, 7}, -1);
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {13}, {2, 13, 5, 7}, 1);
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {1, 13, 1, 1}, {2, 13, 5, 7}, -1);
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {2, 13, 1, 1}, {2, 13, 5, 7}, -1);
+  // The other broadcasts of the 4-D x.
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {5, 7}, {2, 13, 5, 7}, -1);
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {13, 5}, {2, 13, 5, 7}, 1);
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {1, 1, 5, 7}, {2, 13, 5, 7}, -1);
+  test_elementwise_add_nchw8c({2, 13, 5, 7}, {2, 13, 5, 1}, {2, 13, 5, 7}, -1);
+  // The tensors whose rank isn't 4.
+  test_elementwise_add_nchw8c({4, 10}, {10}, {4, 10}, 1);
+  test_elementwise_add_nchw8c({4, 10}, {10}, {4, 10}, -1);
+  test_elementwise_add_nchw8c({4, 10}, {4, 1}, {4, 10}, -1);
+  test_elementwise_add_nchw8c({3, 4, 10}, {4}, {3, 4, 10}, 1);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(elementwise_add, kX86, kFloat, kNCHW8c, def);
+USE_LITE_KERNEL(layout, kX86, kFloat, kNCHW, nchw2nchw8c);
+USE_LITE_KERNEL(layout, kX86, kFloat, kNCHW, nchw8c2nchw);
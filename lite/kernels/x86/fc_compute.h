@@ -14,11 +14,17 @@
 
 #pragma once
 
+#include <string>
+#include <type_traits>
 #include <vector>
 #include "lite/backends/x86/jit/helper.h"
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include "lite/backends/x86/math/gemm_int8.h"
+#include "lite/backends/x86/math/gemm_weight_quant.h"
+#include "lite/backends/x86/math/sgemm_packed.h"
 #include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
@@ -34,7 +40,7 @@ namespace x86 {
 template <lite::TargetType Target, typename T>
 class FCFunctor {
  public:
-  void operator()(const lite::X86Context& context,
+  void operator()(lite::X86Context* context,
                   const int M,
                   const int N,
                   const int K,
@@ -44,7 +50,7 @@ class FCFunctor {
                   const T* B = nullptr,
                   bool relu = false,
                   bool padding_weights = false) {
-    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(*context);
     T* Y1_data = nullptr;
 
     auto compute =
@@ -67,15 +73,11 @@ class FCFunctor {
       const int NN = N + 4;
       const int KK = K + 4;
 
-      // NOTE: here need to mutable_data for temporary Tensor X1 and Y1,
-      //  the overhead is unmeasured.
-      lite::Tensor X1;
-      X1.Resize(std::vector<int64_t>{M * KK});
-      T* X1_data = X1.mutable_data<T>();
-
-      lite::Tensor Y1;
-      Y1.Resize(std::vector<int64_t>{M * NN});
-      Y1_data = Y1.mutable_data<T>();
+      // NOTE: the padded X1 and Y1 are placed in the workspace of context,
+      //  which is only reallocated when it grows.
+      context->ExtendWorkspace((M * KK + M * NN) * sizeof(T));
+      T* X1_data = context->workspace_data<T>();
+      Y1_data = X1_data + M * KK;
 
       auto parallel_memcpy_x = [&](int64_t begin, int64_t end) {
         for (int64_t i = begin; i < end; i++) {
@@ -125,8 +127,58 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::FcParam;
 
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<param_t>();
+    if (param.w->precision() == PRECISION(kBF16)) {
+      PackBf16Weights();
+      return;
+    }
+    if (param.w->precision() == PRECISION(kInt8)) {
+      PackQuantWeights<int8_t>();
+      return;
+    }
+    if (param.w->precision() == PRECISION(kInt16)) {
+      PackQuantWeights<int16_t>();
+      return;
+    }
+#ifndef PADDLE_WITH_MKLML
+    if (param.prepacked_weight != nullptr &&
+        param.prepacked_weight_key ==
+            lite::x86::math::sgemm_packed_b_layout()) {
+      CHECK_EQ(param.prepacked_weight->numel(), PackedWeightsSize())
+          << "The prepacked weights of fc mismatch the weights";
+      packed_weights_.ShareDataWith(*param.prepacked_weight);
+      return;
+    }
+    PackWeights(&packed_weights_);
+#endif
+  }
+
+  std::string PrepackWeights(Tensor* prepacked) override {
+#ifndef PADDLE_WITH_MKLML
+    auto& param = *param_.get_mutable<param_t>();
+    if (param.w->precision() == PRECISION(kFloat)) {
+      PackWeights(prepacked);
+      return lite::x86::math::sgemm_packed_b_layout();
+    }
+#endif
+    return "";
+  }
+
   void Run() override {
     auto& param = *param_.get_mutable<param_t>();
+    if (param.w->precision() == PRECISION(kBF16)) {
+      RunBf16();
+      return;
+    }
+    if (param.w->precision() == PRECISION(kInt8)) {
+      RunQuant<int8_t>();
+      return;
+    }
+    if (param.w->precision() == PRECISION(kInt16)) {
+      RunQuant<int16_t>();
+      return;
+    }
     auto* input = param.input;
     auto* w = param.w;
     auto* bias = param.bias;
@@ -145,8 +197,41 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     T* output_data = output->template mutable_data<T>();
 
     auto& context = ctx_->As<X86Context>();
+#ifndef PADDLE_WITH_MKLML
+    // Without MKL, the input is packed in the workspace and multiplied with
+    // the weights packed in PrepareForRun.
+    if (packed_weights_.dims().empty()) {
+      PackWeights(&packed_weights_);
+    }
+    const int K = w_dims0;
+    const int N = w_dims1;
+    context.ExtendWorkspace(lite::x86::math::sgemm_packed_a_size(M, K) *
+                            sizeof(T));
+    T* packed_input = context.workspace_data<T>();
+    lite::x86::math::sgemm_pack_a(false, input_data, M, K, K, packed_input);
+    lite::x86::math::sgemm_packed(packed_input,
+                                  packed_weights_.data<T>(),
+                                  M,
+                                  N,
+                                  K,
+                                  output_data,
+                                  N);
+    if (bias) {
+      using AddRelu = jit::KernelFuncs<jit::VAddReluTuple<T>, fluid::CPUPlace>;
+      using Add = jit::KernelFuncs<jit::VAddTuple<T>, fluid::CPUPlace>;
+      auto compute = with_relu ? AddRelu::Cache().At(N) : Add::Cache().At(N);
+      const T* bias_data = bias->template data<T>();
+      auto parallel_compute = [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          compute(bias_data, output_data + i * N, output_data + i * N, N);
+        }
+      };
+      lite::x86::RunParallelFor(0, M, parallel_compute);
+    }
+    return;
+#endif
     FCFunctor<lite::TargetType::kX86, T> fc;
-    fc(context,
+    fc(&context,
        M,
        w_dims1,
        w_dims0,
@@ -159,6 +244,229 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   }
 
   virtual ~FcCompute() = default;
+
+ private:
+  // The weights converted to bf16 by opt are packed as B of bf16 gemm, and
+  // multiplied with the fp32 input with the fp32 accumulation.
+  void PackBf16Weights() {
+    auto& param = *param_.get_mutable<param_t>();
+    const auto& w_dims = param.w->dims();
+    const int K = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+    const int N = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+    packed_bf16_weights_.Resize(
+        {lite::x86::math::gemm_bf16_packed_b_size(K, N)});
+    lite::x86::math::gemm_bf16_pack_b(
+        false,
+        param.w->template data<bfloat16>(),
+        K,
+        N,
+        w_dims[1],
+        packed_bf16_weights_.mutable_data<bfloat16>());
+  }
+
+  void RunBf16() {
+    auto& param = *param_.get_mutable<param_t>();
+    auto& context = ctx_->As<X86Context>();
+    const auto& w_dims = param.w->dims();
+    const int K = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+    const int N = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+    const int M = param.output->dims().production() / N;
+    if (packed_bf16_weights_.dims().empty()) {
+      PackBf16Weights();
+    }
+    context.ExtendWorkspace(lite::x86::math::gemm_bf16_packed_a_size(M, K) *
+                            sizeof(float));
+    float* packed_input = context.workspace_data<float>();
+    lite::x86::math::gemm_bf16_pack_a(
+        false, param.input->template data<float>(), M, K, K, packed_input);
+    lite::x86::math::GemmBf16Epilogue epilogue;
+    epilogue.bias = param.bias ? param.bias->template data<float>() : nullptr;
+    epilogue.relu = param.activation_type == "relu";
+    lite::x86::math::gemm_bf16(packed_input,
+                               packed_bf16_weights_.data<bfloat16>(),
+                               M,
+                               N,
+                               K,
+                               epilogue,
+                               param.output->template mutable_data<float>(),
+                               N);
+  }
+
+  Tensor packed_bf16_weights_;
+
+  // The weight-only quantized weights kept in int8 or int16 are packed as B
+  // of the weight-only quantized gemm, and their scales are applied to the
+  // columns of the output.
+  template <typename QT>
+  void PackQuantWeights() {
+    auto& param = *param_.get_mutable<param_t>();
+    CHECK(!param.padding_weights)
+        << "The padding weights isn't supported by the quantized weights";
+    const int K = param.w->dims()[0];
+    const int N = param.w->dims()[1];
+    CHECK(param.weight_scale.size() == 1 ||
+          param.weight_scale.size() == static_cast<size_t>(N))
+        << "The weight scale of fc should be 1 or " << N << ", but got "
+        << param.weight_scale.size();
+    quant_scale_.resize(N);
+    for (int i = 0; i < N; i++) {
+      quant_scale_[i] = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                       : param.weight_scale[i];
+    }
+    packed_quant_weights_.Resize(
+        {lite::x86::math::gemm_weight_quant_packed_b_size(K, N)});
+    lite::x86::math::gemm_weight_quant_pack_b(
+        false,
+        param.w->template data<QT>(),
+        K,
+        N,
+        N,
+        packed_quant_weights_.template mutable_data<QT>());
+  }
+
+  template <typename QT>
+  void RunQuant() {
+    auto& param = *param_.get_mutable<param_t>();
+    auto& context = ctx_->As<X86Context>();
+    const int K = param.w->dims()[0];
+    const int N = param.w->dims()[1];
+    const int M = param.output->dims().production() / N;
+    if (packed_quant_weights_.dims().empty()) {
+      PackQuantWeights<QT>();
+    }
+    context.ExtendWorkspace(
+        lite::x86::math::gemm_weight_quant_packed_a_size(M, K) *
+        sizeof(float));
+    float* packed_input = context.workspace_data<float>();
+    lite::x86::math::gemm_weight_quant_pack_a(
+        false, param.input->template data<float>(), M, K, K, packed_input);
+    lite::x86::math::GemmWeightQuantEpilogue epilogue;
+    epilogue.scale = quant_scale_.data();
+    epilogue.bias = param.bias ? param.bias->template data<float>() : nullptr;
+    epilogue.relu = param.activation_type == "relu";
+    lite::x86::math::gemm_weight_quant(
+        packed_input,
+        packed_quant_weights_.template data<QT>(),
+        M,
+        N,
+        K,
+        epilogue,
+        param.output->template mutable_data<float>(),
+        N);
+  }
+
+  Tensor packed_quant_weights_;
+  std::vector<float> quant_scale_;
+
+#ifndef PADDLE_WITH_MKLML
+  // The padded weights are packed without the padding.
+  int PackedWeightsSize() {
+    auto& param = *param_.get_mutable<param_t>();
+    const auto& w_dims = param.w->dims();
+    const int K = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+    const int N = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+    return lite::x86::math::sgemm_packed_b_size(K, N);
+  }
+
+  void PackWeights(Tensor* packed_weights) {
+    auto& param = *param_.get_mutable<param_t>();
+    const auto& w_dims = param.w->dims();
+    const int K = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+    const int N = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+    packed_weights->Resize({PackedWeightsSize()});
+    lite::x86::math::sgemm_pack_b(false,
+                                  param.w->template data<T>(),
+                                  K,
+                                  N,
+                                  w_dims[1],
+                                  packed_weights->template mutable_data<T>());
+  }
+
+  Tensor packed_weights_;
+#endif
+};
+
+template <PrecisionType OutType>
+class FcInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::FcParam;
+
+  void PrepareForRun() override {
+    auto& param = this->Param<param_t>();
+    CHECK(!param.padding_weights)
+        << "The padding weights isn't supported by x86 int8 fc";
+    const auto& w_dims = param.w->dims();
+    const int k = w_dims[0];
+    const int n = w_dims[1];
+    // The weights are packed as B of int8 gemm once, the scale and bias are
+    // indexed by the column of the output.
+    packed_weights_.Resize({lite::x86::math::gemm_s8_packed_b_size(k, n)});
+    lite::x86::math::gemm_s8_pack_b(param.w->data<int8_t>(),
+                                    k,
+                                    n,
+                                    n,
+                                    packed_weights_.mutable_data<int16_t>());
+    CHECK(!param.weight_scale.empty()) << "The weight scale of fc is empty";
+    float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+    scale_.resize(n);
+    for (int i = 0; i < n; i++) {
+      float w_scale = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                     : param.weight_scale[i];
+      scale_[i] = param.input_scale * w_scale / out_scale;
+    }
+    bias_.clear();
+    if (param.bias) {
+      auto bias_data = param.bias->data<float>();
+      bias_.resize(n);
+      for (int i = 0; i < n; i++) {
+        bias_[i] = bias_data[i] / out_scale;
+      }
+    }
+    if (param.activation_type == "relu") {
+      epilogue_.act_type = lite_api::ActivationType::kRelu;
+    } else if (!param.activation_type.empty()) {
+      LOG(FATAL) << "[X86] int8 fc doesn't support the activation "
+                 << param.activation_type;
+    }
+  }
+
+  void Run() override {
+    using Dtype = typename std::conditional<OutType == PRECISION(kInt8),
+                                            int8_t,
+                                            float>::type;
+    auto& param = this->Param<param_t>();
+    auto& context = ctx_->As<X86Context>();
+    const auto& w_dims = param.w->dims();
+    const int k = w_dims[0];
+    const int n = w_dims[1];
+    const int m = param.output->dims().production() / n;
+
+    // The input is packed as A of int8 gemm in the workspace.
+    context.ExtendWorkspace(lite::x86::math::gemm_s8_packed_a_size(m, k) *
+                            sizeof(int16_t));
+    int16_t* packed_input = context.workspace_data<int16_t>();
+    lite::x86::math::gemm_s8_pack_a(
+        param.input->data<int8_t>(), m, k, k, packed_input);
+    epilogue_.scale = scale_.data();
+    epilogue_.bias = bias_.empty() ? nullptr : bias_.data();
+    epilogue_.per_row = false;
+    lite::x86::math::gemm_s8<Dtype>(packed_input,
+                                    packed_weights_.data<int16_t>(),
+                                    m,
+                                    n,
+                                    k,
+                                    epilogue_,
+                                    param.output->mutable_data<Dtype>(),
+                                    n);
+  }
+
+  virtual ~FcInt8Compute() = default;
+
+ private:
+  Tensor packed_weights_;
+  std::vector<float> scale_;
+  std::vector<float> bias_;
+  lite::x86::math::GemmS8Epilogue epilogue_;
 };
 
 }  // namespace x86
@@ -0,0 +1,260 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/fc_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+TEST(fc_x86, retrive_op) {
+  auto fc = KernelRegistry::Global().Create("fc");
+  ASSERT_FALSE(fc.empty());
+  ASSERT_TRUE(fc.front());
+}
+
+// The shapes aren't multiples of the blocks of the int8 gemm, so the tails of
+// M, N and K are covered.
+template <PrecisionType OutType, typename Dtype>
+void test_fc_int8(int m, int n, int k, bool per_channel, bool with_relu) {
+  lite::Tensor x, w, b, out;
+  x.Resize({m, k});
+  w.Resize({k, n});
+  b.Resize({n});
+  out.Resize({m, n});
+  auto x_data = x.mutable_data<int8_t>();
+  auto w_data = w.mutable_data<int8_t>();
+  auto b_data = b.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<int8_t>(i % 23 - 11);
+  }
+  for (int64_t i = 0; i < w.numel(); i++) {
+    w_data[i] = static_cast<int8_t>(i % 13 - 6);
+  }
+  for (int i = 0; i < n; i++) {
+    b_data[i] = 0.05f * (i % 7) - 0.15f;
+  }
+
+  FcInt8Compute<OutType> fc;
+  operators::FcParam param;
+  param.input = &x;
+  param.w = &w;
+  param.bias = &b;
+  param.output = &out;
+  param.in_num_col_dims = 1;
+  param.activation_type = with_relu ? "relu" : "";
+  param.input_scale = 0.02f;
+  param.weight_scale.clear();
+  for (int i = 0; i < (per_channel ? n : 1); i++) {
+    param.weight_scale.push_back(0.01f + 0.002f * (i % 5));
+  }
+  param.output_scale = 0.01f;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc.SetContext(std::move(ctx));
+  fc.SetParam(param);
+  fc.PrepareForRun();
+  fc.Run();
+
+  float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+  // The int8 output may differ by 1 because of the rounding.
+  float abs_error = OutType == PRECISION(kInt8) ? 1.f : 1e-3f;
+  auto out_data = out.data<Dtype>();
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      int acc = 0;
+      for (int p = 0; p < k; p++) {
+        acc += x_data[i * k + p] * w_data[p * n + j];
+      }
+      float w_scale = param.weight_scale[per_channel ? j : 0];
+      float ref = acc * param.input_scale * w_scale + b_data[j];
+      ref = (with_relu ? std::max(ref, 0.f) : ref) / out_scale;
+      if (OutType == PRECISION(kInt8)) {
+        ref = std::min(std::max(std::round(ref), -127.f), 127.f);
+      }
+      EXPECT_NEAR(out_data[i * n + j], ref, abs_error)
+          << "m=" << m << " n=" << n << " k=" << k << " at (" << i << ", "
+          << j << ")";
+    }
+  }
+}
+
+TEST(fc_x86, int8_run_test) {
+  const int shapes[][3] = {{1, 1, 1}, {3, 9, 7}, {6, 17, 33}, {13, 40, 64}};
+  for (auto& shape : shapes) {
+    for (bool per_channel : {false, true}) {
+      for (bool with_relu : {false, true}) {
+        test_fc_int8<PRECISION(kFloat), float>(
+            shape[0], shape[1], shape[2], per_channel, with_relu);
+        test_fc_int8<PRECISION(kInt8), int8_t>(
+            shape[0], shape[1], shape[2], per_channel, with_relu);
+      }
+    }
+  }
+}
+
+// The bf16 weights are multiplied with the fp32 input, and the input may be
+// rounded to bf16 too, so the tolerance is relative to the absolute products.
+void test_fc_bf16(int m, int n, int k, bool padding_weights) {
+  const int w_rows = padding_weights ? k + 4 : k;
+  const int w_cols = padding_weights ? n + 4 : n;
+  lite::Tensor x, w, b, out;
+  x.Resize({m, k});
+  w.Resize({w_rows, w_cols});
+  b.Resize({n});
+  out.Resize({m, n});
+  auto x_data = x.mutable_data<float>();
+  auto w_data = w.mutable_data<bfloat16>();
+  auto b_data = b.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 19) * 0.1f - 0.9f;
+  }
+  for (int64_t i = 0; i < w.numel(); i++) {
+    w_data[i] = bfloat16(static_cast<float>(i % 11) * 0.13f - 0.6f);
+  }
+  w.set_precision(PRECISION(kBF16));
+  for (int i = 0; i < n; i++) {
+    b_data[i] = 0.05f * (i % 7) - 0.15f;
+  }
+
+  FcCompute<float> fc;
+  operators::FcParam param;
+  param.input = &x;
+  param.w = &w;
+  param.bias = &b;
+  param.output = &out;
+  param.in_num_col_dims = 1;
+  param.activation_type = "relu";
+  param.padding_weights = padding_weights;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc.SetContext(std::move(ctx));
+  fc.SetParam(param);
+  fc.PrepareForRun();
+  fc.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float ref = 0.f;
+      float abs_sum = 0.f;
+      for (int p = 0; p < k; p++) {
+        float prod =
+            x_data[i * k + p] * static_cast<float>(w_data[p * w_cols + j]);
+        ref += prod;
+        abs_sum += std::fabs(prod);
+      }
+      ref = std::max(ref + b_data[j], 0.f);
+      EXPECT_NEAR(out_data[i * n + j], ref, abs_sum / 256.f + 1e-4f)
+          << "m=" << m << " n=" << n << " k=" << k << " at (" << i << ", "
+          << j << ")";
+    }
+  }
+}
+
+TEST(fc_x86, bf16_run_test) {
+  const int shapes[][3] = {{1, 1, 1}, {3, 9, 7}, {6, 17, 33}, {13, 40, 64}};
+  for (auto& shape : shapes) {
+    for (bool padding_weights : {false, true}) {
+      test_fc_bf16(shape[0], shape[1], shape[2], padding_weights);
+    }
+  }
+}
+
+// The weight-only quantized weights kept by LightPredictor, with the scales of
+// the columns or a single scale.
+template <typename T>
+void test_fc_weight_quant(int m, int n, int k, bool per_channel) {
+  const int max = std::numeric_limits<T>::max();
+  lite::Tensor x, w, b, out;
+  x.Resize({m, k});
+  w.Resize({k, n});
+  b.Resize({n});
+  out.Resize({m, n});
+  auto x_data = x.mutable_data<float>();
+  auto w_data = w.mutable_data<T>();
+  auto b_data = b.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 19) * 0.1f - 0.9f;
+  }
+  for (int64_t i = 0; i < w.numel(); i++) {
+    w_data[i] = static_cast<T>((i * 37) % (2 * max + 1) - max);
+  }
+  for (int i = 0; i < n; i++) {
+    b_data[i] = 0.05f * (i % 7) - 0.15f;
+  }
+
+  FcCompute<float> fc;
+  operators::FcParam param;
+  param.input = &x;
+  param.w = &w;
+  param.bias = &b;
+  param.output = &out;
+  param.in_num_col_dims = 1;
+  param.activation_type = "relu";
+  for (int i = 0; i < (per_channel ? n : 1); i++) {
+    param.weight_scale.push_back(0.5f * (i % 5 + 1) / max);
+  }
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc.SetContext(std::move(ctx));
+  fc.SetParam(param);
+  fc.PrepareForRun();
+  fc.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float w_scale = param.weight_scale[per_channel ? j : 0];
+      float ref = 0.f;
+      for (int p = 0; p < k; p++) {
+        ref += x_data[i * k + p] * w_data[p * n + j] * w_scale;
+      }
+      ref = std::max(ref + b_data[j], 0.f);
+      EXPECT_NEAR(out_data[i * n + j], ref, 1e-4f * std::max(k, 1))
+          << "m=" << m << " n=" << n << " k=" << k << " at (" << i << ", "
+          << j << ")";
+    }
+  }
+}
+
+TEST(fc_x86, weight_quant_run_test) {
+  const int shapes[][3] = {{1, 1, 1}, {3, 9, 7}, {6, 17, 33}, {13, 40, 64}};
+  for (auto& shape : shapes) {
+    for (bool per_channel : {false, true}) {
+      test_fc_weight_quant<int8_t>(shape[0], shape[1], shape[2], per_channel);
+      test_fc_weight_quant<int16_t>(shape[0], shape[1], shape[2], per_channel);
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fc, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(fc, kX86, kInt8, kNCHW, int8out);
+USE_LITE_KERNEL(fc, kX86, kInt8, kNCHW, fp32out);
@@ -0,0 +1,108 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_embedding_seq_pool_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+TEST(fused_embedding_seq_pool_x86, retrive_op) {
+  auto kernel = KernelRegistry::Global().Create("fused_embedding_seq_pool");
+  ASSERT_FALSE(kernel.empty());
+  ASSERT_TRUE(kernel.front());
+}
+
+TEST(fused_embedding_seq_pool_x86, compute) {
+  const int vocab_size = 29;
+  const int emb_size = 19;
+  const int64_t padding_idx = 3;
+  // The empty sequence is pooled to zeros.
+  const std::vector<uint64_t> offsets{0, 4, 4, 11, 12, 30};
+  const int ids_num = offsets.back();
+  lite::Tensor w, w_int8, w_scale, ids;
+  w.Resize({vocab_size, emb_size});
+  w_int8.Resize({vocab_size, emb_size});
+  w_scale.Resize({vocab_size});
+  ids.Resize({ids_num, 1});
+  ids.set_lod({offsets});
+  auto* w_data = w.mutable_data<float>();
+  auto* int8_data = w_int8.mutable_data<int8_t>();
+  auto* scale_data = w_scale.mutable_data<float>();
+  for (int i = 0; i < vocab_size; i++) {
+    scale_data[i] = 0.02f * (i + 1);
+    for (int j = 0; j < emb_size; j++) {
+      int q = (i * 5 + j * 17) % 255 - 127;
+      int8_data[i * emb_size + j] = static_cast<int8_t>(q);
+      w_data[i * emb_size + j] = q * scale_data[i];
+    }
+  }
+  auto* ids_data = ids.mutable_data<int64_t>();
+  for (int i = 0; i < ids_num; i++) {
+    ids_data[i] = (i * 7) % vocab_size;
+  }
+
+  for (std::string pool_type : {"SUM", "AVERAGE", "SQRT"}) {
+    for (bool quantized : {false, true}) {
+      FusedEmbeddingSeqPoolCompute fused_embedding_seq_pool;
+      operators::FusedEmbeddingSeqPoolParam param;
+      lite::Tensor out;
+      out.Resize({static_cast<int64_t>(offsets.size()) - 1, emb_size});
+      param.W = quantized ? &w_int8 : &w;
+      param.WScale = quantized ? &w_scale : nullptr;
+      param.Ids = &ids;
+      param.Out = &out;
+      param.padding_idx = padding_idx;
+      param.pool_type = pool_type;
+      fused_embedding_seq_pool.SetParam(param);
+      fused_embedding_seq_pool.Run();
+
+      const float* out_data = out.data<float>();
+      for (size_t s = 0; s + 1 < offsets.size(); s++) {
+        int len = offsets[s + 1] - offsets[s];
+        for (int j = 0; j < emb_size; j++) {
+          float ref = 0.f;
+          for (uint64_t i = offsets[s]; i < offsets[s + 1]; i++) {
+            if (ids_data[i] != padding_idx) {
+              ref += w_data[ids_data[i] * emb_size + j];
+            }
+          }
+          if (len > 0 && pool_type == "AVERAGE") {
+            ref /= len;
+          } else if (len > 0 && pool_type == "SQRT") {
+            ref /= std::sqrt(static_cast<float>(len));
+          }
+          EXPECT_NEAR(out_data[s * emb_size + j],
+                      ref,
+                      1e-4 * std::max(1.f, std::fabs(ref)))
+              << pool_type << " quantized: " << quantized;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fused_embedding_seq_pool, kX86, kFloat, kNCHW, def);
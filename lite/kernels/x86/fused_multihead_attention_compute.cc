@@ -0,0 +1,35 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_multihead_attention_compute.h"
+
+REGISTER_LITE_KERNEL(
+    fused_multihead_attention,
+    kX86,
+    kFloat,
+    kNCHW,
+    paddle::lite::kernels::x86::FusedMultiheadAttentionCompute<float>,
+    def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Mask", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("QWeight", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("QBias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("KWeight", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("KBias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("VWeight", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("VBias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("OutWeight", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("OutBias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
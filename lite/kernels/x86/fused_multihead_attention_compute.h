@@ -0,0 +1,198 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/multihead_attention.h"
+#include "lite/backends/x86/math/sgemm_packed.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/operators/fused_multihead_attention_op.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+template <typename T>
+class FusedMultiheadAttentionCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusedMultiheadAttentionParam;
+
+  void PrepareForRun() override {
+    auto& param = this->Param<param_t>();
+    const int k = param.q_weight->dims()[0];
+    const int hidden = param.q_weight->dims()[1];
+    // The Q, K and V weights are concatenated as [k, 3 * hidden], so the
+    // three projections are computed by one gemm.
+    qkv_weight_.Resize({k, 3 * hidden});
+    T* qkv_weight_data = qkv_weight_.mutable_data<T>();
+    const T* weights[3] = {param.q_weight->template data<T>(),
+                           param.k_weight->template data<T>(),
+                           param.v_weight->template data<T>()};
+    for (int i = 0; i < k; i++) {
+      for (int j = 0; j < 3; j++) {
+        std::copy(weights[j] + i * hidden,
+                  weights[j] + (i + 1) * hidden,
+                  qkv_weight_data + (i * 3 + j) * hidden);
+      }
+    }
+    qkv_bias_.Resize({3 * hidden});
+    T* qkv_bias_data = qkv_bias_.mutable_data<T>();
+    const lite::Tensor* biases[3] = {param.q_bias, param.k_bias, param.v_bias};
+    for (int j = 0; j < 3; j++) {
+      if (biases[j]) {
+        const T* bias_data = biases[j]->template data<T>();
+        std::copy(bias_data, bias_data + hidden, qkv_bias_data + j * hidden);
+      } else {
+        std::fill(qkv_bias_data + j * hidden,
+                  qkv_bias_data + (j + 1) * hidden,
+                  static_cast<T>(0));
+      }
+    }
+#ifndef PADDLE_WITH_MKLML
+    // Without MKL, the weights are packed once for the packed sgemm.
+    packed_qkv_weight_.Resize(
+        {lite::x86::math::sgemm_packed_b_size(k, 3 * hidden)});
+    lite::x86::math::sgemm_pack_b(false,
+                                  qkv_weight_data,
+                                  k,
+                                  3 * hidden,
+                                  3 * hidden,
+                                  packed_qkv_weight_.mutable_data<T>());
+    qkv_weight_.clear();
+    const int n = param.out_weight->dims()[1];
+    packed_out_weight_.Resize(
+        {lite::x86::math::sgemm_packed_b_size(hidden, n)});
+    lite::x86::math::sgemm_pack_b(false,
+                                  param.out_weight->template data<T>(),
+                                  hidden,
+                                  n,
+                                  n,
+                                  packed_out_weight_.mutable_data<T>());
+#endif
+  }
+
+  void Run() override {
+    auto& param = this->Param<param_t>();
+    auto& context = ctx_->As<X86Context>();
+    const auto& in_dims = param.input->dims();
+    const int batch = in_dims[0];
+    const int seq_len = in_dims[1];
+    const int m = batch * seq_len;
+    const int k = param.q_weight->dims()[0];
+    const int hidden = param.q_weight->dims()[1];
+    const int n = param.out_weight->dims()[1];
+
+    // The workspace holds the QKV projections, the attention outputs and the
+    // packed gemm inputs.
+    int64_t workspace_size = static_cast<int64_t>(m) * 4 * hidden;
+#ifndef PADDLE_WITH_MKLML
+    const int64_t packed_size =
+        std::max(lite::x86::math::sgemm_packed_a_size(m, k),
+                 lite::x86::math::sgemm_packed_a_size(m, hidden));
+    workspace_size += packed_size;
+#endif
+    context.ExtendWorkspace(workspace_size * sizeof(T));
+    T* qkv = context.workspace_data<T>();
+    T* attention_out = qkv + static_cast<int64_t>(m) * 3 * hidden;
+    const T* input_data = param.input->template data<T>();
+    T* output_data = param.output->template mutable_data<T>();
+
+#ifdef PADDLE_WITH_MKLML
+    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+    blas.MatMul(m, 3 * hidden, k, input_data, qkv_weight_.data<T>(), qkv);
+#else
+    T* packed_input = attention_out + static_cast<int64_t>(m) * hidden;
+    lite::x86::math::sgemm_pack_a(false, input_data, m, k, k, packed_input);
+    lite::x86::math::sgemm_packed(packed_input,
+                                  packed_qkv_weight_.data<T>(),
+                                  m,
+                                  3 * hidden,
+                                  k,
+                                  qkv,
+                                  3 * hidden);
+#endif
+    AddBias(qkv_bias_.data<T>(), m, 3 * hidden, qkv);
+
+    std::vector<int64_t> mask_dims;
+    if (param.mask) {
+      mask_dims = param.mask->dims().Vectorize();
+    }
+    lite::x86::math::multihead_attention(
+        qkv,
+        batch,
+        seq_len,
+        param.head_number,
+        hidden / param.head_number,
+        param.alpha,
+        param.mask ? param.mask->template data<T>() : nullptr,
+        mask_dims,
+        attention_out);
+
+#ifdef PADDLE_WITH_MKLML
+    blas.MatMul(m,
+                n,
+                hidden,
+                attention_out,
+                param.out_weight->template data<T>(),
+                output_data);
+#else
+    lite::x86::math::sgemm_pack_a(
+        false, attention_out, m, hidden, hidden, packed_input);
+    lite::x86::math::sgemm_packed(packed_input,
+                                  packed_out_weight_.data<T>(),
+                                  m,
+                                  n,
+                                  hidden,
+                                  output_data,
+                                  n);
+#endif
+    if (param.out_bias) {
+      AddBias(param.out_bias->template data<T>(), m, n, output_data);
+    }
+  }
+
+  virtual ~FusedMultiheadAttentionCompute() = default;
+
+ private:
+  static void AddBias(const T* bias, int m, int n, T* out) {
+    auto add_rows = [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        T* out_row = out + i * n;
+        for (int j = 0; j < n; j++) {
+          out_row[j] += bias[j];
+        }
+      }
+    };
+    lite::x86::RunParallelFor(0, m, add_rows);
+  }
+
+  Tensor qkv_weight_;
+  Tensor qkv_bias_;
+#ifndef PADDLE_WITH_MKLML
+  Tensor packed_qkv_weight_;
+  Tensor packed_out_weight_;
+#endif
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
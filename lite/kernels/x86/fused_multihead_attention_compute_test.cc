@@ -0,0 +1,194 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_multihead_attention_compute.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+static void fill_random(lite::Tensor* tensor, std::mt19937* engine) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  float* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    data[i] = dist(*engine);
+  }
+}
+
+// out = x * w + b, x is [m, k] and w is [k, n].
+static std::vector<float> linear_ref(
+    const float* x, const lite::Tensor& w, const lite::Tensor& b, int m) {
+  const int k = w.dims()[0];
+  const int n = w.dims()[1];
+  std::vector<float> out(m * n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float sum = b.data<float>()[j];
+      for (int l = 0; l < k; l++) {
+        sum += x[i * k + l] * w.data<float>()[l * n + j];
+      }
+      out[i * n + j] = sum;
+    }
+  }
+  return out;
+}
+
+static std::vector<float> attention_ref(
+    const operators::FusedMultiheadAttentionParam& param) {
+  const int batch = param.input->dims()[0];
+  const int seq_len = param.input->dims()[1];
+  const int hidden = param.q_weight->dims()[1];
+  const int heads = param.head_number;
+  const int d = hidden / heads;
+  const int m = batch * seq_len;
+  const float* x = param.input->data<float>();
+  auto q = linear_ref(x, *param.q_weight, *param.q_bias, m);
+  auto k = linear_ref(x, *param.k_weight, *param.k_bias, m);
+  auto v = linear_ref(x, *param.v_weight, *param.v_bias, m);
+
+  // The mask of the lower rank is aligned to the trailing dims.
+  auto mask_dims = param.mask->dims().Vectorize();
+  mask_dims.insert(mask_dims.begin(), 4 - mask_dims.size(), 1);
+  auto mask_at = [&](int b, int h, int i, int j) {
+    int64_t index = 0;
+    int coords[4] = {b, h, i, j};
+    for (int dim = 0; dim < 4; dim++) {
+      index = index * mask_dims[dim] + (mask_dims[dim] == 1 ? 0 : coords[dim]);
+    }
+    return param.mask->data<float>()[index];
+  };
+  std::vector<float> context(m * hidden);
+  std::vector<float> scores(seq_len);
+  for (int b = 0; b < batch; b++) {
+    for (int h = 0; h < heads; h++) {
+      for (int i = 0; i < seq_len; i++) {
+        float max_val = -1e30f;
+        for (int j = 0; j < seq_len; j++) {
+          float sum = 0.f;
+          for (int c = 0; c < d; c++) {
+            sum += q[(b * seq_len + i) * hidden + h * d + c] *
+                   k[(b * seq_len + j) * hidden + h * d + c];
+          }
+          scores[j] = sum * param.alpha + mask_at(b, h, i, j);
+          max_val = std::max(max_val, scores[j]);
+        }
+        float total = 0.f;
+        for (int j = 0; j < seq_len; j++) {
+          scores[j] = std::exp(scores[j] - max_val);
+          total += scores[j];
+        }
+        for (int c = 0; c < d; c++) {
+          float sum = 0.f;
+          for (int j = 0; j < seq_len; j++) {
+            const float v_val = v[(b * seq_len + j) * hidden + h * d + c];
+            sum += scores[j] / total * v_val;
+          }
+          context[(b * seq_len + i) * hidden + h * d + c] = sum;
+        }
+      }
+    }
+  }
+  return linear_ref(context.data(), *param.out_weight, *param.out_bias, m);
+}
+
+TEST(fused_multihead_attention_x86, retrive_op) {
+  auto kernels = KernelRegistry::Global().Create("fused_multihead_attention");
+  ASSERT_FALSE(kernels.empty());
+  ASSERT_TRUE(kernels.front());
+}
+
+TEST(fused_multihead_attention_x86, run_test) {
+  std::mt19937 engine(0);
+  const int batch = 2;
+  const int seq_len = 37;
+  const int hidden = 32;
+  const int heads = 4;
+  for (auto mask_shape :
+       {std::vector<int64_t>({batch, 1, 1, 1}),
+        std::vector<int64_t>({batch, 1, 1, seq_len}),
+        std::vector<int64_t>({batch, heads, seq_len, seq_len}),
+        std::vector<int64_t>({seq_len}),
+        std::vector<int64_t>({heads, 1, seq_len})}) {
+    lite::Tensor input, mask, out;
+    lite::Tensor weights[4], biases[4];
+    input.Resize({batch, seq_len, hidden});
+    fill_random(&input, &engine);
+    for (int i = 0; i < 4; i++) {
+      weights[i].Resize({hidden, hidden});
+      biases[i].Resize({hidden});
+      fill_random(&weights[i], &engine);
+      fill_random(&biases[i], &engine);
+    }
+    mask.Resize(mask_shape);
+    fill_random(&mask, &engine);
+    float* mask_data = mask.mutable_data<float>();
+    if (mask_shape.size() < 4) {
+      // The trailing key is masked for all of the sequences.
+      mask_data[seq_len - 1] = -10000.f;
+    } else if (mask_shape[3] == 1) {
+      // All of the keys of the second sequence are masked.
+      mask_data[1] = -10000.f;
+    } else if (mask_shape[2] == 1) {
+      // The trailing keys of the second sequence are padded.
+      for (int j = seq_len - 5; j < seq_len; j++) {
+        mask_data[seq_len + j] = -10000.f;
+      }
+    }
+
+    operators::FusedMultiheadAttentionParam param;
+    param.input = &input;
+    param.mask = &mask;
+    param.q_weight = &weights[0];
+    param.q_bias = &biases[0];
+    param.k_weight = &weights[1];
+    param.k_bias = &biases[1];
+    param.v_weight = &weights[2];
+    param.v_bias = &biases[2];
+    param.out_weight = &weights[3];
+    param.out_bias = &biases[3];
+    param.output = &out;
+    param.head_number = heads;
+    param.alpha = 1.f / std::sqrt(static_cast<float>(hidden / heads));
+    out.Resize({batch, seq_len, hidden});
+
+    FusedMultiheadAttentionCompute<float> attention;
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    attention.SetContext(std::move(ctx));
+    attention.SetParam(param);
+    attention.PrepareForRun();
+    attention.Run();
+
+    auto ref = attention_ref(param);
+    const float* out_data = out.data<float>();
+    for (int64_t i = 0; i < out.numel(); i++) {
+      EXPECT_NEAR(out_data[i], ref[i], 1e-4);
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fused_multihead_attention, kX86, kFloat, kNCHW, def);
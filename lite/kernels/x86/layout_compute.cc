@@ -0,0 +1,121 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/layout_compute.h"
+#include "lite/backends/x86/math/nchw8c.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void NCHWToNCHW8cCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto& dims = param.x->dims();
+  // The tensors whose rank isn't 4 are stored as NCHW.
+  if (dims.size() != 4) {
+    param.y->ShareDataWith(*param.x);
+    return;
+  }
+  param.y->Resize(dims);
+  lite::x86::math::nchw_to_nchw8c(param.x->data<float>(),
+                                  lite::x86::math::nchw8c_mutable_data(param.y),
+                                  dims[0],
+                                  dims[1],
+                                  dims[2] * dims[3]);
+}
+
+void NCHW8cToNCHWCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto& dims = param.x->dims();
+  if (dims.size() != 4) {
+    param.y->ShareDataWith(*param.x);
+    return;
+  }
+  param.y->Resize(dims);
+  lite::x86::math::nchw8c_to_nchw(param.x->data<float>(),
+                                  param.y->mutable_data<float>(),
+                                  dims[0],
+                                  dims[1],
+                                  dims[2] * dims[3]);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(layout,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::NCHWToNCHW8cCompute,
+                     nchw2nchw8c)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(layout,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::NCHW8cToNCHWCompute,
+                     nchw8c2nchw)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(layout_once,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::NCHWToNCHW8cCompute,
+                     nchw2nchw8c)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(layout_once,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::NCHW8cToNCHWCompute,
+                     nchw8c2nchw)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW))})
+    .Finalize();
@@ -28,7 +28,8 @@ REGISTER_LITE_KERNEL(lookup_table,
                      kNCHW,
                      paddle::lite::kernels::x86::LookupTableCompute<float>,
                      def)
-    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kAny))})
+    .BindInput("WScale", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
@@ -38,7 +39,8 @@ REGISTER_LITE_KERNEL(lookup_table_v2,
                      kNCHW,
                      paddle::lite::kernels::x86::LookupTableCompute<float>,
                      def)
-    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kAny))})
+    .BindInput("WScale", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindPaddleOpVersion("lookup_table_v2", 1)
@@ -14,7 +14,7 @@
 #pragma once
 
 #include <vector>
-#include "lite/backends/x86/fluid/eigen.h"
+#include "lite/backends/x86/math/embedding.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -30,30 +30,16 @@ class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
   void Run() override {
     auto &param = *param_.get_mutable<operators::LookupTableParam>();
-    auto *ids_t = param.Ids;
-    auto *output_t = param.Out;
-    int64_t padding_idx = param.padding_idx;
-    const int64_t *ids = ids_t->template data<int64_t>();
-    int64_t ids_numel = ids_t->dims().production();
-
-    auto *table_t = param.W;
-    int64_t row_number = table_t->dims()[0];
-    int64_t row_width = table_t->dims()[1];
-
-    const T *table = table_t->template data<T>();
-    T *output = output_t->template mutable_data<T>();
-    memset(output, 0, output_t->dims().production() * sizeof(T));
-    for (int64_t i = 0; i < ids_numel; ++i) {
-      if (padding_idx != -1 && ids[i] == padding_idx) {
-        memset(output + i * row_width, 0, row_width * sizeof(T));
-      } else {
-        CHECK_LT(ids[i], row_number);
-        CHECK_GE(ids[i], 0);
-        memcpy(output + i * row_width,
-               table + ids[i] * row_width,
-               row_width * sizeof(T));
-      }
-    }
+    const int64_t *ids = param.Ids->template data<int64_t>();
+    T *output = param.Out->template mutable_data<T>();
+    // The table may be compressed to int8 or fp16 by embedding_compress_pass,
+    // the rows are dequantized and gathered in parallel.
+    lite::x86::math::embedding_lookup(*param.W,
+                                      param.WScale,
+                                      ids,
+                                      param.Ids->numel(),
+                                      param.padding_idx,
+                                      output);
   }
 
   virtual ~LookupTableCompute() = default;
@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 #include "lite/core/op_registry.h"
+#include "lite/utils/bfloat16.h"
+#include "lite/utils/float16.h"
 
 namespace paddle {
 namespace lite {
@@ -74,6 +76,67 @@ TEST(lookup_table_x86, compute) {
   }
 }
 
+TEST(lookup_table_x86, compressed_table) {
+  const int vocab_size = 37;
+  const int emb_size = 21;
+  const int ids_num = 100;
+  const int64_t padding_idx = 5;
+  lite::Tensor w_fp32, w_int8, w_fp16, w_bf16, w_scale, ids;
+  w_fp32.Resize({vocab_size, emb_size});
+  w_int8.Resize({vocab_size, emb_size});
+  w_fp16.Resize({vocab_size, emb_size});
+  w_bf16.Resize({vocab_size, emb_size});
+  w_scale.Resize({vocab_size});
+  ids.Resize({ids_num, 1});
+  auto* fp32_data = w_fp32.mutable_data<float>();
+  auto* int8_data = w_int8.mutable_data<int8_t>();
+  auto* fp16_data = w_fp16.mutable_data<float16>();
+  w_fp16.set_precision(PRECISION(kFP16));
+  auto* bf16_data = w_bf16.mutable_data<bfloat16>();
+  w_bf16.set_precision(PRECISION(kBF16));
+  auto* scale_data = w_scale.mutable_data<float>();
+  for (int i = 0; i < vocab_size; i++) {
+    scale_data[i] = 0.01f * (i + 1);
+    for (int j = 0; j < emb_size; j++) {
+      int q = (i * 7 + j * 13) % 255 - 127;
+      int8_data[i * emb_size + j] = static_cast<int8_t>(q);
+      fp32_data[i * emb_size + j] = q * scale_data[i];
+      fp16_data[i * emb_size + j] = float16(fp32_data[i * emb_size + j]);
+      bf16_data[i * emb_size + j] = bfloat16(fp32_data[i * emb_size + j]);
+    }
+  }
+  auto* ids_data = ids.mutable_data<int64_t>();
+  for (int i = 0; i < ids_num; i++) {
+    ids_data[i] = (i * 11) % vocab_size;
+  }
+
+  for (auto* w : {&w_int8, &w_fp16, &w_bf16}) {
+    LookupTableCompute<float> lookup_table;
+    operators::LookupTableParam param;
+    lite::Tensor out;
+    out.Resize({ids_num, emb_size});
+    param.W = w;
+    param.WScale = w == &w_int8 ? &w_scale : nullptr;
+    param.Ids = &ids;
+    param.Out = &out;
+    param.padding_idx = padding_idx;
+    lookup_table.SetParam(param);
+    lookup_table.Run();
+    const float* out_data = out.data<float>();
+    for (int i = 0; i < ids_num; i++) {
+      for (int j = 0; j < emb_size; j++) {
+        float ref = ids_data[i] == padding_idx
+                        ? 0.f
+                        : fp32_data[ids_data[i] * emb_size + j];
+        // The fp16 and bf16 values have 11 and 8 significant bits.
+        float tolerance = w == &w_bf16 ? 4e-3f : 1e-3f;
+        EXPECT_NEAR(
+            out_data[i * emb_size + j], ref, std::fabs(ref) * tolerance);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -13,7 +13,10 @@
 // limitations under the License.
 #pragma once
 
+#include <string>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include "lite/backends/x86/math/sgemm_packed.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -49,6 +52,40 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::MatMulParam;
 
+  void PrepareForRun() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto *y = param.Y;
+    if (y->precision() == PRECISION(kBF16)) {
+      PackBf16Y();
+      return;
+    }
+#ifndef PADDLE_WITH_MKLML
+    // The persistable 2-D Y is packed once, the others are packed in Run.
+    if (param.prepacked_weight != nullptr &&
+        param.prepacked_weight_key ==
+            lite::x86::math::sgemm_packed_b_layout()) {
+      CHECK_EQ(param.prepacked_weight->numel(), PackedYSize())
+          << "The prepacked Y of matmul mismatches Y";
+      packed_y_.ShareDataWith(*param.prepacked_weight);
+    } else if (y->persistable() && y->dims().size() == 2) {
+      PackY(&packed_y_);
+    }
+#endif
+  }
+
+  std::string PrepackWeights(Tensor *prepacked) override {
+#ifndef PADDLE_WITH_MKLML
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto *y = param.Y;
+    if (y->precision() == PRECISION(kFloat) && y->persistable() &&
+        y->dims().size() == 2) {
+      PackY(prepacked);
+      return lite::x86::math::sgemm_packed_b_layout();
+    }
+#endif
+    return "";
+  }
+
   void Run() override {
     auto &context = ctx_->As<X86Context>();
     auto &param = *param_.get_mutable<operators::MatMulParam>();
@@ -57,7 +94,17 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto *y = param.Y;
     auto *out = param.Out;
     out->template mutable_data<T>();
+    if (y->precision() == PRECISION(kBF16)) {
+      RunBf16();
+      return;
+    }
 
+#ifndef PADDLE_WITH_MKLML
+    if (x->dims().size() == 2 && y->dims().size() == 2) {
+      RunPacked();
+      return;
+    }
+#endif
     auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
     auto mat_dim_a = lite::x86::math::CreateMatrixDescriptor(
         RowMatrixFromVector(x->dims()), 0, param.transpose_X);
@@ -68,6 +115,132 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   }
 
   virtual ~MatMulCompute() = default;
+
+ private:
+  // The 2-D Y converted to bf16 by opt is packed as B of bf16 gemm once.
+  void PackBf16Y() {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto *y = param.Y;
+    CHECK_EQ(y->dims().size(), 2UL) << "The bf16 Y of matmul should be 2-D";
+    const int k = y->dims()[param.transpose_Y ? 1 : 0];
+    const int n = y->dims()[param.transpose_Y ? 0 : 1];
+    packed_bf16_y_.Resize({lite::x86::math::gemm_bf16_packed_b_size(k, n)});
+    lite::x86::math::gemm_bf16_pack_b(param.transpose_Y,
+                                      y->template data<bfloat16>(),
+                                      k,
+                                      n,
+                                      y->dims()[1],
+                                      packed_bf16_y_.mutable_data<bfloat16>());
+  }
+
+  // Out = alpha * op(X) * Y of the bf16 Y, the batches of X are folded into
+  // the rows unless X is transposed.
+  void RunBf16() {
+    auto &context = ctx_->As<X86Context>();
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto *x = param.X;
+    auto *y = param.Y;
+    if (packed_bf16_y_.dims().empty()) {
+      PackBf16Y();
+    }
+    const int k = y->dims()[param.transpose_Y ? 1 : 0];
+    const int n = y->dims()[param.transpose_Y ? 0 : 1];
+    int batch = 1;
+    int m = x->numel() / k;
+    if (param.transpose_X) {
+      CHECK_GE(x->dims().size(), 2UL);
+      m = x->dims()[x->dims().size() - 1];
+      batch = x->numel() / (m * k);
+    }
+    context.ExtendWorkspace(lite::x86::math::gemm_bf16_packed_a_size(m, k) *
+                            sizeof(float));
+    float *packed_x = context.workspace_data<float>();
+    lite::x86::math::GemmBf16Epilogue epilogue;
+    epilogue.alpha = param.alpha;
+    const float *x_data = x->template data<float>();
+    float *out_data = param.Out->template mutable_data<float>();
+    for (int b = 0; b < batch; b++) {
+      lite::x86::math::gemm_bf16_pack_a(param.transpose_X,
+                                        x_data + b * m * k,
+                                        m,
+                                        k,
+                                        param.transpose_X ? m : k,
+                                        packed_x);
+      lite::x86::math::gemm_bf16(packed_x,
+                                 packed_bf16_y_.data<bfloat16>(),
+                                 m,
+                                 n,
+                                 k,
+                                 epilogue,
+                                 out_data + b * m * n,
+                                 n);
+    }
+  }
+
+  Tensor packed_bf16_y_;
+
+#ifndef PADDLE_WITH_MKLML
+  // Out = alpha * op(X) * op(Y) of the 2-D X and Y by the packed sgemm.
+  void RunPacked() {
+    auto &context = ctx_->As<X86Context>();
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto *x = param.X;
+    auto *y = param.Y;
+    const int m = x->dims()[param.transpose_X ? 1 : 0];
+    const int k = x->dims()[param.transpose_X ? 0 : 1];
+    const int n = y->dims()[param.transpose_Y ? 0 : 1];
+    const int packed_x_size = lite::x86::math::sgemm_packed_a_size(m, k);
+    const int packed_y_size = packed_y_.dims().empty()
+                                  ? lite::x86::math::sgemm_packed_b_size(k, n)
+                                  : 0;
+    context.ExtendWorkspace((packed_x_size + packed_y_size) * sizeof(T));
+    T *packed_x = context.workspace_data<T>();
+    lite::x86::math::sgemm_pack_a(
+        param.transpose_X, x->template data<T>(), m, k, x->dims()[1], packed_x);
+    const T *packed_y = nullptr;
+    if (!packed_y_.dims().empty()) {
+      packed_y = packed_y_.template data<T>();
+    } else {
+      T *packed = packed_x + packed_x_size;
+      lite::x86::math::sgemm_pack_b(
+          param.transpose_Y, y->template data<T>(), k, n, y->dims()[1], packed);
+      packed_y = packed;
+    }
+    T *out_data = param.Out->template mutable_data<T>();
+    lite::x86::math::sgemm_packed(packed_x, packed_y, m, n, k, out_data, n);
+    const T alpha = static_cast<T>(param.alpha);
+    if (alpha != static_cast<T>(1)) {
+      for (int i = 0; i < m * n; i++) {
+        out_data[i] *= alpha;
+      }
+    }
+  }
+
+  int PackedYSize() {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    const auto &y_dims = param.Y->dims();
+    const int k = y_dims[param.transpose_Y ? 1 : 0];
+    const int n = y_dims[param.transpose_Y ? 0 : 1];
+    return lite::x86::math::sgemm_packed_b_size(k, n);
+  }
+
+  // Pack the 2-D Y as B of the packed sgemm.
+  void PackY(Tensor *packed_y) {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto *y = param.Y;
+    const int k = y->dims()[param.transpose_Y ? 1 : 0];
+    const int n = y->dims()[param.transpose_Y ? 0 : 1];
+    packed_y->Resize({PackedYSize()});
+    lite::x86::math::sgemm_pack_b(param.transpose_Y,
+                                  y->template data<T>(),
+                                  k,
+                                  n,
+                                  y->dims()[1],
+                                  packed_y->template mutable_data<T>());
+  }
+
+  Tensor packed_y_;
+#endif
 };
 
 }  // namespace x86
@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -21,6 +22,7 @@
 
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/matmul_compute.h"
+#include "lite/utils/bfloat16.h"
 
 namespace paddle {
 namespace lite {
@@ -80,6 +82,54 @@ TEST(matmul_x86, run_test) {
   }
 }
 
+TEST(matmul_x86, bf16_y) {
+  const int batch = 2, m = 5, k = 33, n = 20;
+  for (bool transpose_y : {false, true}) {
+    lite::Tensor x, y, out;
+    x.Resize({batch, m, k});
+    y.Resize(transpose_y ? DDim({n, k}) : DDim({k, n}));
+    out.Resize({batch, m, n});
+    auto* x_data = x.mutable_data<float>();
+    auto* y_data = y.mutable_data<bfloat16>();
+    y.set_precision(PRECISION(kBF16));
+    for (int i = 0; i < x.numel(); i++) {
+      x_data[i] = static_cast<float>(i % 13 - 6) / 7.f;
+    }
+    for (int i = 0; i < y.numel(); i++) {
+      y_data[i] = bfloat16(static_cast<float>(i % 17 - 8) / 9.f);
+    }
+
+    MatMulCompute<float> matmul;
+    operators::MatMulParam param;
+    param.X = &x;
+    param.Y = &y;
+    param.Out = &out;
+    param.transpose_Y = transpose_y;
+    param.alpha = 0.5f;
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    matmul.SetContext(std::move(ctx));
+    matmul.SetParam(param);
+    matmul.PrepareForRun();
+    matmul.Run();
+
+    const float* out_data = out.data<float>();
+    for (int row = 0; row < batch * m; row++) {
+      for (int col = 0; col < n; col++) {
+        float ref = 0.f, abs_sum = 0.f;
+        for (int i = 0; i < k; i++) {
+          float b = static_cast<float>(
+              y_data[transpose_y ? col * k + i : i * n + col]);
+          ref += x_data[row * k + i] * b;
+          abs_sum += std::fabs(x_data[row * k + i] * b);
+        }
+        // X may be rounded to bf16 by the AVX512-BF16 kernel.
+        EXPECT_NEAR(out_data[row * n + col], 0.5f * ref, abs_sum * 4e-3f);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
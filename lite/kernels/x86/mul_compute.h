@@ -13,7 +13,11 @@
 // limitations under the License.
 #pragma once
 
+#include <string>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_weight_quant.h"
+#include "lite/backends/x86/math/sgemm_packed.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -39,6 +43,43 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::MulParam;
 
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    if (param.y->precision() == PRECISION(kInt8)) {
+      PackQuantY<int8_t>();
+      return;
+    }
+    if (param.y->precision() == PRECISION(kInt16)) {
+      PackQuantY<int16_t>();
+      return;
+    }
+#ifndef PADDLE_WITH_MKLML
+    // Only the persistable Y is packed once, the others are packed in Run.
+    if (param.prepacked_weight != nullptr &&
+        param.prepacked_weight_key ==
+            lite::x86::math::sgemm_packed_b_layout()) {
+      auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+      CHECK_EQ(param.prepacked_weight->numel(),
+               lite::x86::math::sgemm_packed_b_size(y_dims[0], y_dims[1]))
+          << "The prepacked Y of mul mismatches Y";
+      packed_y_.ShareDataWith(*param.prepacked_weight);
+    } else if (param.y->persistable()) {
+      PackWeights(&packed_y_);
+    }
+#endif
+  }
+
+  std::string PrepackWeights(Tensor* prepacked) override {
+#ifndef PADDLE_WITH_MKLML
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    if (param.y->precision() == PRECISION(kFloat) && param.y->persistable()) {
+      PackWeights(prepacked);
+      return lite::x86::math::sgemm_packed_b_layout();
+    }
+#endif
+    return "";
+  }
+
   void Run() override {
     auto& context = ctx_->As<X86Context>();
     auto& param = *param_.get_mutable<operators::MulParam>();
@@ -48,6 +89,14 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
     auto* x = param.x;
     auto* y = param.y;
+    if (y->precision() == PRECISION(kInt8)) {
+      RunQuant<int8_t>();
+      return;
+    }
+    if (y->precision() == PRECISION(kInt16)) {
+      RunQuant<int16_t>();
+      return;
+    }
 
     Tensor x_matrix, y_matrix;
 
@@ -70,15 +119,121 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       z->Resize({x_matrix.dims()[0], y_matrix.dims()[1]});
     }
 
+#ifdef PADDLE_WITH_MKLML
     auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
 
     blas.MatMul(x_matrix, y_matrix, z);
+#else
+    // Without MKL, X and the non-persistable Y are packed in the workspace.
+    const int m = x_matrix.dims()[0];
+    const int k = x_matrix.dims()[1];
+    const int n = y_matrix.dims()[1];
+    const int packed_x_size = lite::x86::math::sgemm_packed_a_size(m, k);
+    const int packed_y_size = packed_y_.dims().empty()
+                                  ? lite::x86::math::sgemm_packed_b_size(k, n)
+                                  : 0;
+    context.ExtendWorkspace((packed_x_size + packed_y_size) * sizeof(T));
+    T* packed_x = context.workspace_data<T>();
+    lite::x86::math::sgemm_pack_a(false, x_matrix.data<T>(), m, k, k, packed_x);
+    const T* packed_y = nullptr;
+    if (!packed_y_.dims().empty()) {
+      packed_y = packed_y_.data<T>();
+    } else {
+      T* packed = packed_x + packed_x_size;
+      lite::x86::math::sgemm_pack_b(false, y_matrix.data<T>(), k, n, n, packed);
+      packed_y = packed;
+    }
+    lite::x86::math::sgemm_packed(
+        packed_x, packed_y, m, n, k, z->mutable_data<T>(), n);
+#endif
     if (z_dim.size() != 2) {
       z->Resize(z_dim);
     }
   }
 
   virtual ~MulCompute() = default;
+
+ private:
+  // The weight-only quantized Y kept in int8 or int16 is packed as B of the
+  // weight-only quantized gemm, and its scales are applied to the columns of
+  // the output.
+  template <typename QT>
+  void PackQuantY() {
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+    const int k = y_dims[0];
+    const int n = y_dims[1];
+    CHECK(param.weight_scale.size() == 1 ||
+          param.weight_scale.size() == static_cast<size_t>(n))
+        << "The weight scale of mul should be 1 or " << n << ", but got "
+        << param.weight_scale.size();
+    quant_scale_.resize(n);
+    for (int i = 0; i < n; i++) {
+      quant_scale_[i] = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                       : param.weight_scale[i];
+    }
+    packed_quant_y_.Resize(
+        {lite::x86::math::gemm_weight_quant_packed_b_size(k, n)});
+    lite::x86::math::gemm_weight_quant_pack_b(
+        false,
+        param.y->template data<QT>(),
+        k,
+        n,
+        n,
+        packed_quant_y_.template mutable_data<QT>());
+  }
+
+  template <typename QT>
+  void RunQuant() {
+    auto& context = ctx_->As<X86Context>();
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    auto x_dims = param.x->dims().Flatten2D(param.x_num_col_dims);
+    auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+    const int m = x_dims[0];
+    const int k = x_dims[1];
+    const int n = y_dims[1];
+    if (packed_quant_y_.dims().empty()) {
+      PackQuantY<QT>();
+    }
+    context.ExtendWorkspace(
+        lite::x86::math::gemm_weight_quant_packed_a_size(m, k) *
+        sizeof(float));
+    float* packed_x = context.workspace_data<float>();
+    lite::x86::math::gemm_weight_quant_pack_a(
+        false, param.x->template data<float>(), m, k, k, packed_x);
+    lite::x86::math::GemmWeightQuantEpilogue epilogue;
+    epilogue.scale = quant_scale_.data();
+    lite::x86::math::gemm_weight_quant(
+        packed_x,
+        packed_quant_y_.template data<QT>(),
+        m,
+        n,
+        k,
+        epilogue,
+        param.output->template mutable_data<float>(),
+        n);
+  }
+
+  Tensor packed_quant_y_;
+  std::vector<float> quant_scale_;
+
+#ifndef PADDLE_WITH_MKLML
+  void PackWeights(Tensor* packed_y) {
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+    const int k = y_dims[0];
+    const int n = y_dims[1];
+    packed_y->Resize({lite::x86::math::sgemm_packed_b_size(k, n)});
+    lite::x86::math::sgemm_pack_b(false,
+                                  param.y->template data<T>(),
+                                  k,
+                                  n,
+                                  n,
+                                  packed_y->template mutable_data<T>());
+  }
+
+  Tensor packed_y_;
+#endif
 };
 
 }  // namespace x86
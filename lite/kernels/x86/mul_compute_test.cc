@@ -14,8 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -80,6 +82,110 @@ TEST(mul_x86, run_test) {
   }
 }
 
+template <typename QT>
+void TestQuantizedY(PrecisionType precision, int max_q) {
+  const int m = 7, k = 37, n = 21;
+  lite::Tensor x, y, out;
+  x.Resize({m, k});
+  y.Resize({k, n});
+  out.Resize({m, n});
+  auto* x_data = x.mutable_data<float>();
+  auto* y_data = y.mutable_data<QT>();
+  y.set_precision(precision);
+  for (int i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 11 - 5) / 3.f;
+  }
+  for (int i = 0; i < y.numel(); i++) {
+    y_data[i] = static_cast<QT>((i * 37) % (2 * max_q + 1) - max_q);
+  }
+
+  MulCompute<float> mul;
+  operators::MulParam param;
+  param.x = &x;
+  param.y = &y;
+  param.output = &out;
+  for (int j = 0; j < n; j++) {
+    param.weight_scale.push_back(0.5f / (j + 1));
+  }
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  mul.SetContext(std::move(ctx));
+  mul.SetParam(param);
+  mul.PrepareForRun();
+  mul.Run();
+
+  const float* out_data = out.data<float>();
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float ref = 0.f;
+      for (int l = 0; l < k; l++) {
+        ref += x_data[i * k + l] * y_data[l * n + j] * param.weight_scale[j];
+      }
+      EXPECT_NEAR(out_data[i * n + j], ref, 1e-4f * (std::fabs(ref) + 1.f));
+    }
+  }
+}
+
+TEST(mul_x86, quantized_y) {
+  TestQuantizedY<int8_t>(PRECISION(kInt8), 127);
+  TestQuantizedY<int16_t>(PRECISION(kInt16), 32767);
+}
+
+#ifndef PADDLE_WITH_MKLML
+TEST(mul_x86, prepacked_y) {
+  const int m = 5, k = 19, n = 23;
+  lite::Tensor x, y, out;
+  x.Resize({m, k});
+  y.Resize({k, n});
+  out.Resize({m, n});
+  auto* x_data = x.mutable_data<float>();
+  auto* y_data = y.mutable_data<float>();
+  y.set_persistable(true);
+  for (int i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 7 - 3);
+  }
+  for (int i = 0; i < y.numel(); i++) {
+    y_data[i] = static_cast<float>(i % 5 - 2) / 4.f;
+  }
+  std::vector<float> ref(m * n, 0.f);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      for (int l = 0; l < k; l++) {
+        ref[i * n + j] += x_data[i * k + l] * y_data[l * n + j];
+      }
+    }
+  }
+
+  operators::MulParam param;
+  param.x = &x;
+  param.y = &y;
+  param.output = &out;
+  lite::Tensor prepacked;
+  MulCompute<float> opt_mul;
+  opt_mul.SetParam(param);
+  std::string key = opt_mul.PrepackWeights(&prepacked);
+  ASSERT_FALSE(key.empty());
+
+  // Y is cleared to check that the prepacked Y is adopted.
+  for (int i = 0; i < y.numel(); i++) {
+    y_data[i] = 0.f;
+  }
+  param.prepacked_weight = &prepacked;
+  param.prepacked_weight_key = key;
+  MulCompute<float> mul;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  mul.SetContext(std::move(ctx));
+  mul.SetParam(param);
+  mul.PrepareForRun();
+  mul.Run();
+  const float* out_data = out.data<float>();
+  for (int i = 0; i < m * n; i++) {
+    EXPECT_NEAR(out_data[i], ref[i], 1e-4f);
+  }
+}
+#endif
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
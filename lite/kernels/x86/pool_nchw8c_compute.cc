@@ -0,0 +1,64 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/pool_nchw8c_compute.h"
+#include <vector>
+#include "lite/backends/x86/math/nchw8c.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void Pool2dNCHW8cCompute::Run() {
+  auto& param = this->Param<param_t>();
+  CHECK_EQ(param.x->dims().size(), 4UL);
+  CHECK_EQ(param.ksize.size(), 2UL) << "Only pool2d is supported by NCHW8c";
+  std::vector<int> ksize = param.ksize;
+  if (param.global_pooling) {
+    ksize = {static_cast<int>(param.x->dims()[2]),
+             static_cast<int>(param.x->dims()[3])};
+  }
+  CHECK(param.pooling_type == "max" || param.pooling_type == "avg")
+      << "Unsupported pooling type " << param.pooling_type;
+  lite::x86::math::pool2d_nchw8c(*param.x,
+                                 ksize,
+                                 param.strides,
+                                 *param.paddings,
+                                 param.pooling_type == "max",
+                                 param.exclusive,
+                                 param.adaptive,
+                                 param.output);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(pool2d,
+                     kX86,
+                     kFloat,
+                     kNCHW8c,
+                     paddle::lite::kernels::x86::Pool2dNCHW8cCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kX86),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kNCHW8c))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86),
+                                       PRECISION(kFloat),
+                                       DATALAYOUT(kNCHW8c))})
+    .Finalize();
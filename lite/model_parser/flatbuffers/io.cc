@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/model_parser/flatbuffers/io.h"
+#include <cstdint>
 #include <cstring>
 #include <limits>
 #include <memory>
@@ -68,6 +69,24 @@ void FillTensor(lite::Tensor* tensor, const ParamDescReadAPI& param) {
   std::memcpy(dst, param.GetData(), param.byte_size());
   tensor->set_persistable(true);
 }
+
+void ShareTensor(lite::Tensor* tensor,
+                 const ParamDescReadAPI& param,
+                 const std::shared_ptr<const void>& holder) {
+  CHECK(tensor);
+  CHECK(param.GetData());
+  tensor->Resize(param.Dim());
+  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+  // The buffer doesn't own the data, it's released with the holder.
+  std::shared_ptr<lite::Buffer> buffer(
+      new lite::Buffer(const_cast<void*>(param.GetData()),
+                       TargetType::kHost,
+                       param.byte_size()),
+      [holder](lite::Buffer* buf) { delete buf; });
+  tensor->ResetBuffer(buffer, param.byte_size());
+  tensor->set_persistable(true);
+}
+
 #ifdef LITE_WITH_FLATBUFFERS_DESC
 void ParamSerializer::ForwardWrite(const lite::Scope& scope,
                                    const std::set<std::string>& param_names) {
@@ -99,10 +118,24 @@ void ParamSerializer::ForwardWrite(const lite::Scope& scope,
 
     const size_t param_bytes = buf_->size();
     CHECK(param_bytes) << "The bytes size of param can not be zero";
-    constexpr uint32_t offset = sizeof(uint32_t);
+    // Pad between the offset and the param, so that the tensor data is
+    // aligned in the file and can be aliased in place when the file is
+    // memory-mapped. The reader skips the padding by the offset.
+    const size_t data_pos =
+        writer_->current() + 2 * sizeof(uint32_t) +
+        (static_cast<const char*>(ParamDescView(buf_.get()).GetData()) -
+         static_cast<const char*>(buf_->data()));
+    const uint32_t padding =
+        (host::MALLOC_ALIGN - data_pos % host::MALLOC_ALIGN) %
+        host::MALLOC_ALIGN;
+    const uint32_t offset = sizeof(uint32_t) + padding;
     const uint32_t total_size = param_bytes + offset;
     writer_->Write<uint32_t>(total_size);
     writer_->Write<uint32_t>(offset);
+    if (padding > 0) {
+      const std::vector<char> zeros(padding, 0);
+      writer_->Write(zeros.data(), padding);
+    }
     writer_->Write(buf_->data(), param_bytes);
   }
 }
@@ -130,12 +163,33 @@ void ParamDeserializer::ForwardRead(lite::Scope* scope) {
     uint32_t offset = reader_->Read<uint32_t>();
     uint32_t param_bytes = total_size - offset;
     ReadBytesToBuffer(offset - sizeof(offset));
+    if (ReadParamInPlace(param_bytes, scope)) {
+      continue;
+    }
     ReadBytesToBuffer(param_bytes);
     fbs::ParamDescView param(buf_.get());
     FillTensor(scope->Var(param.Name())->GetMutable<lite::Tensor>(), param);
   }
 }
 
+bool ParamDeserializer::ReadParamInPlace(size_t param_bytes,
+                                         lite::Scope* scope) {
+  std::shared_ptr<const void> data = reader_->ReadInPlace(param_bytes);
+  if (!data) {
+    return false;
+  }
+  fbs::ParamDescView param(data.get(), param_bytes);
+  auto* tensor = scope->Var(param.Name())->GetMutable<lite::Tensor>();
+  // The params saved by the previous versions may be unaligned, copy them
+  // so that the kernels always get the aligned data.
+  if (reinterpret_cast<uintptr_t>(param.GetData()) % host::MALLOC_ALIGN) {
+    FillTensor(tensor, param);
+  } else {
+    ShareTensor(tensor, param, data);
+  }
+  return true;
+}
+
 void ParamDeserializer::ReadHeader() {
   // 1. version id
   uint16_t version = reader_->Read<uint16_t>();
@@ -33,6 +33,12 @@ void FillParam(const std::string& name,
 
 void FillTensor(lite::Tensor* tensor, const ParamDescReadAPI& param);
 
+// Make the tensor alias the data of param in place, `holder` is kept alive
+// until the buffer of tensor is released.
+void ShareTensor(lite::Tensor* tensor,
+                 const ParamDescReadAPI& param,
+                 const std::shared_ptr<const void>& holder);
+
 #ifdef LITE_WITH_FLATBUFFERS_DESC
 class ParamSerializer {
  public:
@@ -70,6 +76,7 @@ class ParamDeserializer {
     reader_->Read(buf_->data(), size);
   }
   void ReadHeader();
+  bool ReadParamInPlace(size_t param_bytes, lite::Scope* scope);
   model_parser::ByteReader* reader_{nullptr};
   std::unique_ptr<model_parser::Buffer> buf_;
 };
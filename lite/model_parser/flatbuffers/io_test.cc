@@ -128,6 +128,26 @@ TEST(CombinedParamsDesc, Scope) {
     deserializer.ForwardRead(&scope_3);
     check_params(scope_3);
   }
+
+#if !defined(_WIN32)
+  {
+    Scope scope_4;
+    LOG(INFO) << "Load params from memory-mapped file...";
+    {
+      model_parser::MmapFileReader reader(path);
+      fbs::ParamDeserializer deserializer(&reader);
+      deserializer.ForwardRead(&scope_4);
+    }
+    check_params(scope_4);
+    // The params are aliased in place, and the mapping is kept alive by them.
+    for (const auto& name : param_names) {
+      const Tensor& tensor = scope_4.FindVar(name)->Get<Tensor>();
+      CHECK_EQ(reinterpret_cast<uintptr_t>(tensor.raw_data()) %
+                   host::MALLOC_ALIGN,
+               0u);
+    }
+  }
+#endif
 }
 #endif  // LITE_WITH_FLATBUFFERS_DESC
 
@@ -53,6 +53,7 @@ inline lite::VarDataType ConvertVarType(proto::VarType_::Type type) {
     CASE(SIZE_T);
     CASE(UINT8);
     CASE(INT8);
+    CASE(BF16);
     default:
       LOG(FATAL) << "Illegal flatbuffer VarType.";
       return lite::VarDataType();
@@ -87,6 +88,7 @@ inline proto::VarType_::Type ConvertVarType(lite::VarDataType type) {
     CASE(SIZE_T);
     CASE(UINT8);
     CASE(INT8);
+    CASE(BF16);
     default:
       LOG(FATAL) << "Illegal flatbuffer VarType.";
       return proto::VarType_::Type();
@@ -766,7 +766,8 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
 
 void LoadModelNaiveFromFile(const std::string &filename,
                             Scope *scope,
-                            cpp::ProgramDesc *cpp_prog) {
+                            cpp::ProgramDesc *cpp_prog,
+                            bool mmap_params) {
   CHECK(cpp_prog);
   CHECK(scope);
   // ModelFile
@@ -793,6 +794,16 @@ void LoadModelNaiveFromFile(const std::string &filename,
       LoadModelFbsFromFile(&reader, scope, cpp_prog, 1);
       break;
     case 2:
+      if (mmap_params) {
+#if !defined(_WIN32)
+        model_parser::MmapFileReader mmap_reader(filename, reader.current());
+        LoadModelFbsFromFile(&mmap_reader, scope, cpp_prog, 2);
+        break;
+#else
+        LOG(WARNING) << "Memory-mapped loading is not supported on Windows, "
+                        "the params will be copied.";
+#endif
+      }
       LoadModelFbsFromFile(&reader, scope, cpp_prog, 2);
       break;
     default:
@@ -857,7 +868,7 @@ void LoadModelNaiveV0FromFile(const std::string &filename,
   VLOG(4) << "Load naive buffer model in '" << filename << "' successfully";
 }
 #endif  // LITE_ON_TINY_PUBLISH
-void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
+void LoadModelFbsFromFile(model_parser::ByteReader *reader,
                           Scope *scope,
                           cpp::ProgramDesc *cpp_prog,
                           uint16_t meta_version) {
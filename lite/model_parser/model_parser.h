@@ -139,14 +139,17 @@ void LoadNonCombinedParamsPb(const std::string& model_dir,
                              const lite_api::CxxModelBuffer& model_buffer,
                              Scope* scope);
 #endif  // LITE_ON_TINY_PUBLISH
-void LoadModelFbsFromFile(model_parser::BinaryFileReader* reader,
+void LoadModelFbsFromFile(model_parser::ByteReader* reader,
                           Scope* scope,
                           cpp::ProgramDesc* cpp_prog,
                           uint16_t meta_version);
 
+// If `mmap_params` is true, the model file is memory-mapped and the params
+// are aliased in place instead of being copied into the scope.
 void LoadModelNaiveFromFile(const std::string& filename,
                             lite::Scope* scope,
-                            cpp::ProgramDesc* prog);
+                            cpp::ProgramDesc* prog,
+                            bool mmap_params = false);
 
 void LoadModelNaiveFromMemory(const std::string& model_buffer,
                               lite::Scope* scope,
@@ -29,6 +29,7 @@ lite::VarDataType ConvertVarType(
     break
     CASE(FP64);
     CASE(FP32);
+    CASE(BF16);
     CASE(INT8);
     CASE(UINT8);
     CASE(INT16);
@@ -53,6 +54,7 @@ lite::VarDataType ConvertVarType(
     CASE(FP64);
     CASE(FP32);
     CASE(FP16);
+    CASE(BF16);
     CASE(INT8);
     CASE(UINT8);
     CASE(INT16);
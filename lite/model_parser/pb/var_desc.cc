@@ -145,6 +145,7 @@ void VarDesc::SetDataType(VarDescAPI::VarDataType data_type) {
     SET_DATA_TYPE_CASE_ITEM(INT32);
     SET_DATA_TYPE_CASE_ITEM(INT64);
     SET_DATA_TYPE_CASE_ITEM(FP16);
+    SET_DATA_TYPE_CASE_ITEM(BF16);
     SET_DATA_TYPE_CASE_ITEM(FP32);
     SET_DATA_TYPE_CASE_ITEM(FP64);
     default:
@@ -193,6 +194,7 @@ VarDescAPI::VarDataType VarDesc::GetDataType() const {
     GET_DATA_TYPE_CASE_ITEM(INT32);
     GET_DATA_TYPE_CASE_ITEM(INT64);
     GET_DATA_TYPE_CASE_ITEM(FP16);
+    GET_DATA_TYPE_CASE_ITEM(BF16);
     GET_DATA_TYPE_CASE_ITEM(FP32);
     GET_DATA_TYPE_CASE_ITEM(FP64);
     default:
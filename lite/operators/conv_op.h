@@ -109,6 +109,10 @@ class ConvOpLite : public OpLite {
         }
       }
     }
+    AttachPrepackedWeight(op_desc,
+                          scope,
+                          &param_.prepacked_weight,
+                          &param_.prepacked_weight_key);
 
     if (op_desc.HasAttr("with_act") && op_desc.GetAttr<bool>("with_act")) {
       param_.activation_param.has_active = true;
@@ -186,6 +190,11 @@ class ConvOpLite : public OpLite {
         param_.output_scale =
             op_info->GetOutputScale(output_scale_name, true)[0];
       }
+    } else if (param_.filter->precision() != PRECISION(kFloat) &&
+               op_desc.HasAttr(Filter + "_quant_scale")) {
+      // The weight-only quantized Filter which is kept in int8 or int16.
+      param_.weight_scale =
+          op_desc.GetAttr<std::vector<float>>(Filter + "_quant_scale");
     }
 
 #ifdef LITE_WITH_FPGA
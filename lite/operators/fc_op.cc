@@ -107,6 +107,10 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   } else {
     param_.padding_weights = false;
   }
+  AttachPrepackedWeight(op_desc,
+                        scope,
+                        &param_.prepacked_weight,
+                        &param_.prepacked_weight_key);
 
   if (param_.activation_type == "prelu") {
     param_.Prelu_mode = op_desc.GetAttr<std::string>("prelu_mode");
@@ -129,6 +133,11 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
       param_.weight_scale = op_info->GetInputScale(weight_scale_name, true);
     if (op_info->HasOutputScale(out_scale_name, true))
       param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
+  } else if (param_.w->precision() != PRECISION(kFloat) &&
+             op_desc.HasAttr(W + "_quant_scale")) {
+    // The weight-only quantized W which is kept in int8 or int16.
+    param_.weight_scale =
+        op_desc.GetAttr<std::vector<float>>(W + "_quant_scale");
   }
 
 #ifdef LITE_WITH_FPGA
@@ -0,0 +1,75 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fused_embedding_seq_pool_op.h"
+#include <algorithm>
+#include <cctype>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusedEmbeddingSeqPoolOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.W);
+  CHECK_OR_FALSE(param_.Ids);
+  CHECK_OR_FALSE(param_.Out);
+  CHECK_EQ_OR_FALSE(param_.W->dims().size(), 2UL);
+  const auto &ids_dims = param_.Ids->dims();
+  CHECK_EQ_OR_FALSE(ids_dims.size(), 2UL);
+  CHECK_EQ_OR_FALSE(ids_dims[1], 1);
+  const auto &lod = param_.Ids->lod();
+  CHECK_EQ_OR_FALSE(lod.size(), 1UL);
+  CHECK_EQ_OR_FALSE(static_cast<int64_t>(lod[0].back()), ids_dims[0]);
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOp::InferShapeImpl() const {
+  int64_t seq_num = static_cast<int64_t>(param_.Ids->lod()[0].size()) - 1;
+  param_.Out->Resize({seq_num, param_.W->dims()[1]});
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOp::AttachImpl(const cpp::OpDesc &opdesc,
+                                         lite::Scope *scope) {
+  param_.W = scope->FindTensor(opdesc.Input("W").front());
+  param_.Ids = scope->FindTensor(opdesc.Input("Ids").front());
+  param_.Out = scope->FindMutableTensor(opdesc.Output("Out").front());
+  if (opdesc.HasInput("WScale") && !opdesc.Input("WScale").empty()) {
+    param_.WScale = scope->FindTensor(opdesc.Input("WScale").front());
+  }
+  if (opdesc.HasAttr("padding_idx")) {
+    param_.padding_idx = opdesc.GetAttr<int64_t>("padding_idx");
+  }
+  // The combiner is "sum", "average" or "sqrt" as the pooltype of
+  // sequence_pool in the lower case.
+  if (opdesc.HasAttr("combiner")) {
+    std::string combiner = opdesc.GetAttr<std::string>("combiner");
+    std::transform(
+        combiner.begin(), combiner.end(), combiner.begin(), ::toupper);
+    param_.pool_type = combiner;
+  }
+  CHECK(param_.pool_type == "SUM" || param_.pool_type == "AVERAGE" ||
+        param_.pool_type == "SQRT")
+      << "Unsupported combiner of fused_embedding_seq_pool: "
+      << param_.pool_type;
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fused_embedding_seq_pool,
+                 paddle::lite::operators::FusedEmbeddingSeqPoolOp);
@@ -0,0 +1,107 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fused_multihead_attention_op.h"
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusedMultiheadAttentionOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.input);
+  CHECK_OR_FALSE(param_.q_weight);
+  CHECK_OR_FALSE(param_.k_weight);
+  CHECK_OR_FALSE(param_.v_weight);
+  CHECK_OR_FALSE(param_.out_weight);
+  CHECK_OR_FALSE(param_.output);
+  CHECK_EQ_OR_FALSE(param_.input->dims().size(), 3UL);
+
+  const auto& w_dims = param_.q_weight->dims();
+  CHECK_EQ_OR_FALSE(w_dims.size(), 2UL);
+  CHECK_EQ_OR_FALSE(param_.input->dims()[2], w_dims[0]);
+  CHECK_OR_FALSE(param_.k_weight->dims() == w_dims);
+  CHECK_OR_FALSE(param_.v_weight->dims() == w_dims);
+  CHECK_GT_OR_FALSE(param_.head_number, 0);
+  CHECK_EQ_OR_FALSE(w_dims[1] % param_.head_number, 0);
+  for (auto* bias : {param_.q_bias, param_.k_bias, param_.v_bias}) {
+    if (bias) {
+      CHECK_EQ_OR_FALSE(bias->numel(), w_dims[1]);
+    }
+  }
+  const auto& out_w_dims = param_.out_weight->dims();
+  CHECK_EQ_OR_FALSE(out_w_dims.size(), 2UL);
+  CHECK_EQ_OR_FALSE(out_w_dims[0], w_dims[1]);
+  if (param_.out_bias) {
+    CHECK_EQ_OR_FALSE(param_.out_bias->numel(), out_w_dims[1]);
+  }
+  return true;
+}
+
+bool FusedMultiheadAttentionOp::InferShapeImpl() const {
+  const auto& in_dims = param_.input->dims();
+  if (param_.mask) {
+    // The mask is aligned to the trailing dims and broadcasted to
+    // [batch, head_number, seq_len, seq_len].
+    const auto& mask_dims = param_.mask->dims();
+    std::vector<int64_t> full_dims{
+        in_dims[0], param_.head_number, in_dims[1], in_dims[1]};
+    CHECK_LE(mask_dims.size(), 4UL) << "The mask should be at most 4-D";
+    const size_t offset = 4 - mask_dims.size();
+    for (size_t i = 0; i < mask_dims.size(); i++) {
+      CHECK(mask_dims[i] == 1 || mask_dims[i] == full_dims[offset + i])
+          << "The mask " << mask_dims << " can't be broadcasted to the "
+          << "attention scores of the input " << in_dims;
+    }
+  }
+  param_.output->Resize(
+      {in_dims[0], in_dims[1], param_.out_weight->dims()[1]});
+  param_.output->set_lod(param_.input->lod());
+  return true;
+}
+
+bool FusedMultiheadAttentionOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                           lite::Scope* scope) {
+  auto find_tensor = [&](const std::string& name) -> const lite::Tensor* {
+    if (opdesc.HasInput(name) && !opdesc.Input(name).empty()) {
+      return scope->FindTensor(opdesc.Input(name).front());
+    }
+    return nullptr;
+  };
+  param_.input = find_tensor("Input");
+  param_.mask = find_tensor("Mask");
+  param_.q_weight = find_tensor("QWeight");
+  param_.q_bias = find_tensor("QBias");
+  param_.k_weight = find_tensor("KWeight");
+  param_.k_bias = find_tensor("KBias");
+  param_.v_weight = find_tensor("VWeight");
+  param_.v_bias = find_tensor("VBias");
+  param_.out_weight = find_tensor("OutWeight");
+  param_.out_bias = find_tensor("OutBias");
+  param_.output = scope->FindMutableTensor(opdesc.Output("Out").front());
+
+  param_.head_number = opdesc.GetAttr<int>("head_number");
+  if (opdesc.HasAttr("alpha")) {
+    param_.alpha = opdesc.GetAttr<float>("alpha");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fused_multihead_attention,
+                 paddle::lite::operators::FusedMultiheadAttentionOp);
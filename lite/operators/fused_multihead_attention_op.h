@@ -0,0 +1,69 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include "lite/core/op_lite.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+/*
+ * FusedMultiheadAttentionOp is fused by the
+ * lite_fused_multihead_attention_fuse_pass from the Q/K/V projections,
+ * the scaled dot-product attention with the mask, softmax and the output
+ * projection of one transformer encoder layer.
+ */
+class FusedMultiheadAttentionOp : public OpLite {
+ public:
+  FusedMultiheadAttentionOp() {}
+  explicit FusedMultiheadAttentionOp(const std::string &op_type)
+      : OpLite(op_type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
+
+  void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
+  std::string DebugString() const override {
+    return "fused_multihead_attention";
+  }
+
+#ifdef LITE_WITH_PROFILE
+  void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
+    const auto &in_dims = param_.input->dims();
+    int64_t batch_seq = in_dims[0] * in_dims[1];
+    int64_t seq_len = in_dims[1];
+    int64_t k = param_.q_weight->dims()[0];
+    int64_t hidden = param_.q_weight->dims()[1];
+    int64_t n = param_.out_weight->dims()[1];
+    ch->input_shape = ch->DimToStr(in_dims);
+    ch->filter_shape = ch->DimToStr(param_.q_weight->dims());
+    ch->output_shape = ch->DimToStr(param_.output->dims());
+    ch->remark = "head_number" + std::to_string(param_.head_number);
+    ch->macs = batch_seq * (3 * k * hidden + 2 * seq_len * hidden +
+                            hidden * n);
+  }
+#endif
+
+ private:
+  mutable FusedMultiheadAttentionParam param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
@@ -55,6 +55,10 @@ bool LookupTableV2OpLite::AttachImpl(const cpp::OpDesc &op_desc,
   param_.W = scope->FindTensor(input);
   param_.Ids = scope->FindTensor(ids);
   param_.Out = scope->FindMutableTensor(out);
+  // The row scales of the int8 table compressed by embedding_compress_pass.
+  if (op_desc.HasInput("WScale") && !op_desc.Input("WScale").empty()) {
+    param_.WScale = scope->FindTensor(op_desc.Input("WScale").front());
+  }
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
 
@@ -148,6 +148,10 @@ bool MatMulOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   param_.transpose_X = op_desc.GetAttr<bool>("transpose_X");
   param_.transpose_Y = op_desc.GetAttr<bool>("transpose_Y");
   param_.alpha = op_desc.GetAttr<float>("alpha");
+  AttachPrepackedWeight(op_desc,
+                        scope,
+                        &param_.prepacked_weight,
+                        &param_.prepacked_weight_key);
 
   const OpInfo *op_info = dynamic_cast<const OpInfo *>(&op_desc);
   if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
@@ -58,6 +58,16 @@ class MulOpLite : public OpLite {
     param_.output = var->GetMutable<Tensor>();
     param_.x_num_col_dims = op_desc.GetAttr<int>("x_num_col_dims");
     param_.y_num_col_dims = op_desc.GetAttr<int>("y_num_col_dims");
+    AttachPrepackedWeight(op_desc,
+                          scope,
+                          &param_.prepacked_weight,
+                          &param_.prepacked_weight_key);
+    // The weight-only quantized Y which is kept in int8 or int16.
+    if (param_.y->precision() != PRECISION(kFloat) &&
+        op_desc.HasAttr(W + "_quant_scale")) {
+      param_.weight_scale =
+          op_desc.GetAttr<std::vector<float>>(W + "_quant_scale");
+    }
     return true;
   }
 
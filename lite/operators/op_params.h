@@ -54,6 +54,12 @@ using param_t = Any;
   float output_scale{1.0f};          \
   int bit_length{8};
 
+// The weights transformed ahead of time by KernelBase::PrepackWeights and the
+// key of their layout.
+#define WITH_PREPACKED_WEIGHT              \
+  lite::Tensor* prepacked_weight{nullptr}; \
+  std::string prepacked_weight_key{};
+
 /// ----------------------- Functional operators ------------------------------
 struct FeedParam : ParamBase {
   std::vector<lite::Tensor>* feed_list{};
@@ -133,6 +139,7 @@ struct FcParam : ParamBase {
       "channel"};  // prelu param, can be "all", "channel" or "element"
   // for int8
   WITH_INT8_CONFIG
+  WITH_PREPACKED_WEIGHT
   ///////////////////////////////////////////////////////////////////////////////////
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
@@ -186,6 +193,7 @@ struct MulParam : ParamBase {
   int y_num_col_dims{1};
   // for int8
   WITH_INT8_CONFIG
+  WITH_PREPACKED_WEIGHT
   ///////////////////////////////////////////////////////////////////////////////////
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
@@ -511,6 +519,7 @@ struct ConvParam : ParamBase {
 
   // for int8
   WITH_INT8_CONFIG
+  WITH_PREPACKED_WEIGHT
   // for Conv2d+Scale fusion
   std::string scale_activation_type{""};
   ///////////////////////////////////////////////////////////////////////////////////
@@ -1159,6 +1168,8 @@ struct BeamSearchDecodeParam : ParamBase {
 /// ----------------------- LookupTable operators ----------------------f
 struct LookupTableParam : ParamBase {
   const lite::Tensor* W{nullptr};
+  // The row scales of W if it's a row-wise quantized int8 table.
+  const lite::Tensor* WScale{nullptr};
   const lite::Tensor* Ids{nullptr};
   lite::Tensor* Out{nullptr};
   int64_t padding_idx{-1};
@@ -1167,6 +1178,17 @@ struct LookupTableParam : ParamBase {
   std::string entry{"none"};
 };
 
+// The lookup_table followed by the SUM, AVERAGE or SQRT sequence_pool of its
+// output, Ids is [N, 1] with the lod of the sequences.
+struct FusedEmbeddingSeqPoolParam : ParamBase {
+  const lite::Tensor* W{nullptr};
+  const lite::Tensor* WScale{nullptr};
+  const lite::Tensor* Ids{nullptr};
+  lite::Tensor* Out{nullptr};
+  int64_t padding_idx{-1};
+  std::string pool_type{"SUM"};
+};
+
 struct LookupTableDequantParam : ParamBase {
   lite::Tensor* W{nullptr};
   lite::Tensor* Ids{nullptr};
@@ -1222,6 +1244,24 @@ struct LayerNormParam : ParamBase {
   float epsilon{1e-5f};
 };
 
+// The multi-head attention of the transformer encoder, the input is
+// [batch, seq_len, hidden] and the mask is added to the scaled QK scores.
+struct FusedMultiheadAttentionParam : ParamBase {
+  const lite::Tensor* input{};
+  const lite::Tensor* mask{};
+  const lite::Tensor* q_weight{};
+  const lite::Tensor* q_bias{};
+  const lite::Tensor* k_weight{};
+  const lite::Tensor* k_bias{};
+  const lite::Tensor* v_weight{};
+  const lite::Tensor* v_bias{};
+  const lite::Tensor* out_weight{};
+  const lite::Tensor* out_bias{};
+  lite::Tensor* output{};
+  int head_number{1};
+  float alpha{1.f};
+};
+
 struct LogicalParam : ParamBase {
   const lite::Tensor* X{};
   const lite::Tensor* Y{};
@@ -1642,6 +1682,7 @@ struct MatMulParam : ParamBase {
   bool transpose_Y{false};
   float alpha{1.0f};
   WITH_INT8_CONFIG
+  WITH_PREPACKED_WEIGHT
   ///////////////////////////////////////////////////////////////////////////////////
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
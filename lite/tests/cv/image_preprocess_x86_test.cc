@@ -0,0 +1,296 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <random>
+#include <vector>
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/cv/cv_basic.h"
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+typedef paddle::lite::utils::cv::ImagePreprocess ImagePreprocess;
+typedef paddle::lite::utils::cv::TransParam TransParam;
+typedef paddle::lite_api::Tensor Tensor_api;
+
+static int image_size(ImageFormat format, int w, int h) {
+  if (format == ImageFormat::NV12 || format == ImageFormat::NV21) {
+    return w * (h + (h + 1) / 2);
+  } else if (format == ImageFormat::BGR || format == ImageFormat::RGB) {
+    return w * h * 3;
+  } else if (format == ImageFormat::BGRA || format == ImageFormat::RGBA) {
+    return w * h * 4;
+  }
+  return w * h;
+}
+
+static std::vector<uint8_t> random_image(ImageFormat format, int w, int h) {
+  std::mt19937 engine(w * 131 + h);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> image(image_size(format, w, h));
+  for (auto& x : image) {
+    x = dist(engine);
+  }
+  return image;
+}
+
+static TransParam trans_param(int iw, int ih, int ow, int oh) {
+  TransParam param;
+  param.iw = iw;
+  param.ih = ih;
+  param.ow = ow;
+  param.oh = oh;
+  param.flip_param = FlipParam::X;
+  param.rotate_param = 90;
+  return param;
+}
+
+// (x - means[c]) * scales[c] with the channels in the memory order.
+static std::vector<float> to_tensor_ref(const uint8_t* src,
+                                        ImageFormat format,
+                                        LayoutType layout,
+                                        int w,
+                                        int h,
+                                        const float* means,
+                                        const float* scales) {
+  int channels = image_size(format, 1, 1);
+  int out_channels = channels == 1 ? 1 : 3;
+  std::vector<float> out(w * h * out_channels);
+  for (int i = 0; i < w * h; i++) {
+    for (int c = 0; c < out_channels; c++) {
+      float x = (src[i * channels + c] - means[c]) * scales[c];
+      if (layout == LayoutType::kNCHW) {
+        out[c * w * h + i] = x;
+      } else {
+        out[i * out_channels + c] = x;
+      }
+    }
+  }
+  return out;
+}
+
+class ImagePreprocessX86Test : public ::testing::TestWithParam<int> {
+ protected:
+  void SetUp() override { paddle::lite::x86::SetNumThreads(GetParam()); }
+  void TearDown() override { paddle::lite::x86::SetNumThreads(1); }
+};
+
+TEST_P(ImagePreprocessX86Test, convert) {
+  const std::vector<std::pair<ImageFormat, ImageFormat>> formats = {
+      {ImageFormat::NV12, ImageFormat::BGR},
+      {ImageFormat::NV21, ImageFormat::BGR},
+      {ImageFormat::NV12, ImageFormat::BGRA},
+      {ImageFormat::NV21, ImageFormat::RGBA},
+      {ImageFormat::BGR, ImageFormat::RGB},
+      {ImageFormat::BGRA, ImageFormat::RGBA},
+      {ImageFormat::BGR, ImageFormat::BGRA},
+      {ImageFormat::RGB, ImageFormat::BGRA},
+      {ImageFormat::BGRA, ImageFormat::BGR},
+      {ImageFormat::RGBA, ImageFormat::BGR},
+      {ImageFormat::BGR, ImageFormat::GRAY},
+      {ImageFormat::BGRA, ImageFormat::GRAY},
+      {ImageFormat::GRAY, ImageFormat::BGR},
+      {ImageFormat::GRAY, ImageFormat::BGRA},
+      {ImageFormat::BGR, ImageFormat::BGR}};
+  const std::vector<std::pair<int, int>> sizes = {
+      {4, 2}, {38, 22}, {102, 64}, {640, 480}};
+  for (auto& size : sizes) {
+    int w = size.first;
+    int h = size.second;
+    for (auto& format : formats) {
+      auto src = random_image(format.first, w, h);
+      int out_size = image_size(format.second, w, h);
+      std::vector<uint8_t> dst(out_size);
+      std::vector<uint8_t> ref(out_size);
+      ImagePreprocess image_preprocess(
+          format.first, format.second, trans_param(w, h, w, h));
+      image_preprocess.image_convert(src.data(), dst.data());
+      image_convert_basic(
+          src.data(), ref.data(), format.first, format.second, w, h, out_size);
+      for (int i = 0; i < out_size; i++) {
+        ASSERT_EQ(dst[i], ref[i]) << "format: " << format.first << " -> "
+                                  << format.second << ", size: " << w << "x"
+                                  << h << ", index: " << i;
+      }
+    }
+  }
+}
+
+TEST_P(ImagePreprocessX86Test, resize) {
+  const std::vector<ImageFormat> formats = {ImageFormat::GRAY,
+                                            ImageFormat::BGR,
+                                            ImageFormat::BGRA,
+                                            ImageFormat::NV21};
+  const std::vector<std::vector<int>> sizes = {{64, 48, 32, 24},
+                                               {38, 22, 100, 62},
+                                               {640, 480, 224, 224},
+                                               {97, 51, 43, 30}};
+  for (auto& size : sizes) {
+    for (auto format : formats) {
+      int srcw = size[0];
+      int srch = size[1];
+      int dstw = size[2];
+      int dsth = size[3];
+      auto src = random_image(format, srcw, srch);
+      int out_size = image_size(format, dstw, dsth);
+      std::vector<uint8_t> dst(out_size);
+      std::vector<uint8_t> ref(out_size);
+      ImagePreprocess image_preprocess(
+          format, format, trans_param(srcw, srch, dstw, dsth));
+      image_preprocess.image_resize(src.data(), dst.data());
+      // The Y plane of NV12(NV21) is resized as the GRAY image, and the UV
+      // plane is checked by the fused path.
+      if (format == ImageFormat::NV21) {
+        out_size = dstw * dsth;
+        image_resize_basic(
+            src.data(), ref.data(), ImageFormat::GRAY, srcw, srch, dstw, dsth);
+      } else {
+        image_resize_basic(
+            src.data(), ref.data(), format, srcw, srch, dstw, dsth);
+      }
+      for (int i = 0; i < out_size; i++) {
+        ASSERT_LE(abs(dst[i] - ref[i]), 1) << "format: " << format
+                                           << ", index: " << i;
+      }
+    }
+  }
+}
+
+TEST_P(ImagePreprocessX86Test, flip_rotate) {
+  const std::vector<ImageFormat> formats = {
+      ImageFormat::GRAY, ImageFormat::BGR, ImageFormat::BGRA};
+  const std::vector<std::pair<int, int>> sizes = {{5, 3}, {67, 45}, {300, 71}};
+  for (auto& size : sizes) {
+    int w = size.first;
+    int h = size.second;
+    for (auto format : formats) {
+      auto src = random_image(format, w, h);
+      int out_size = image_size(format, w, h);
+      std::vector<uint8_t> dst(out_size);
+      std::vector<uint8_t> ref(out_size);
+      ImagePreprocess image_preprocess(format, format, trans_param(w, h, w, h));
+      for (auto flip : {FlipParam::X, FlipParam::Y, FlipParam::XY}) {
+        image_preprocess.image_flip(src.data(), dst.data(), format, w, h, flip);
+        image_flip_basic(src.data(), ref.data(), format, w, h, flip);
+        ASSERT_EQ(dst, ref) << "format: " << format << ", flip: " << flip;
+      }
+      for (float degree : {90.f, 180.f, 270.f}) {
+        image_preprocess.image_rotate(
+            src.data(), dst.data(), format, w, h, degree);
+        image_rotate_basic(src.data(), ref.data(), format, w, h, degree);
+        ASSERT_EQ(dst, ref) << "format: " << format << ", degree: " << degree;
+      }
+    }
+  }
+}
+
+TEST_P(ImagePreprocessX86Test, to_tensor) {
+  const std::vector<ImageFormat> formats = {
+      ImageFormat::GRAY, ImageFormat::BGR, ImageFormat::RGBA};
+  float means[3] = {103.94f, 116.78f, 123.68f};
+  float scales[3] = {0.017f, 0.018f, 0.019f};
+  for (auto layout : {LayoutType::kNCHW, LayoutType::kNHWC}) {
+    for (auto format : formats) {
+      for (int w : {1, 15, 37, 224}) {
+        int h = 23;
+        auto src = random_image(format, w, h);
+        int c = format == ImageFormat::GRAY ? 1 : 3;
+        Tensor tensor;
+        Tensor_api dst_tensor(&tensor);
+        if (layout == LayoutType::kNCHW) {
+          dst_tensor.Resize({1, c, h, w});
+        } else {
+          dst_tensor.Resize({1, h, w, c});
+        }
+        ImagePreprocess image_preprocess(
+            format, format, trans_param(w, h, w, h));
+        image_preprocess.image_to_tensor(
+            src.data(), &dst_tensor, format, w, h, layout, means, scales);
+        auto ref =
+            to_tensor_ref(src.data(), format, layout, w, h, means, scales);
+        const float* dst = tensor.data<float>();
+        for (size_t i = 0; i < ref.size(); i++) {
+          ASSERT_NEAR(dst[i], ref[i], 1e-5) << "index: " << i;
+        }
+      }
+    }
+  }
+}
+
+// The fused path is the same as resize, convert and image_to_tensor one by one.
+TEST_P(ImagePreprocessX86Test, resize_convert_to_tensor) {
+  const std::vector<std::pair<ImageFormat, ImageFormat>> formats = {
+      {ImageFormat::NV21, ImageFormat::BGR},
+      {ImageFormat::NV12, ImageFormat::RGBA},
+      {ImageFormat::BGRA, ImageFormat::RGB},
+      {ImageFormat::BGR, ImageFormat::BGR},
+      {ImageFormat::BGR, ImageFormat::GRAY}};
+  const std::vector<std::vector<int>> sizes = {{640, 480, 224, 224},
+                                               {64, 48, 64, 48},
+                                               {100, 60, 42, 35},
+                                               {38, 22, 90, 50}};
+  float means[3] = {127.5f, 127.5f, 127.5f};
+  float scales[3] = {1.f / 127.5f, 1.f / 127.5f, 1.f / 127.5f};
+  for (auto layout : {LayoutType::kNCHW, LayoutType::kNHWC}) {
+    for (auto& size : sizes) {
+      for (auto& format : formats) {
+        int srcw = size[0];
+        int srch = size[1];
+        int dstw = size[2];
+        int dsth = size[3];
+        int c = format.second == ImageFormat::GRAY ? 1 : 3;
+        auto src = random_image(format.first, srcw, srch);
+        ImagePreprocess image_preprocess(
+            format.first, format.second, trans_param(srcw, srch, dstw, dsth));
+        std::vector<uint8_t> resized(image_size(format.first, dstw, dsth));
+        std::vector<uint8_t> converted(image_size(format.second, dstw, dsth));
+        image_preprocess.image_resize(
+            src.data(), resized.data(), format.first, srcw, srch, dstw, dsth);
+        image_preprocess.image_convert(resized.data(),
+                                       converted.data(),
+                                       format.first,
+                                       format.second,
+                                       dstw,
+                                       dsth);
+        auto ref = to_tensor_ref(converted.data(),
+                                 format.second,
+                                 layout,
+                                 dstw,
+                                 dsth,
+                                 means,
+                                 scales);
+        Tensor tensor;
+        Tensor_api dst_tensor(&tensor);
+        if (layout == LayoutType::kNCHW) {
+          dst_tensor.Resize({1, c, dsth, dstw});
+        } else {
+          dst_tensor.Resize({1, dsth, dstw, c});
+        }
+        image_preprocess.image_resize_convert_to_tensor(
+            src.data(), &dst_tensor, layout, means, scales);
+        const float* dst = tensor.data<float>();
+        for (size_t i = 0; i < ref.size(); i++) {
+          ASSERT_NEAR(dst[i], ref[i], 1e-5)
+              << "format: " << format.first << " -> " << format.second
+              << ", size: " << dstw << "x" << dsth << ", index: " << i;
+        }
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(threads,
+                        ImagePreprocessX86Test,
+                        ::testing::Values(1, 4));
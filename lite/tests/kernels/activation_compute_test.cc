@@ -439,6 +439,8 @@ TEST(Activation_relu, precision) {
   abs_error = 5e-2;
 #elif defined(NNADAPTER_WITH_HUAWEI_KIRIN_NPU)
   abs_error = 1e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
@@ -586,6 +588,8 @@ TEST(Activation_sigmoid, precision) {
   abs_error = 5e-2;
 #elif defined(NNADAPTER_WITH_HUAWEI_KIRIN_NPU)
   abs_error = 1e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
@@ -628,6 +632,8 @@ TEST(Activation_tanh, precision) {
   abs_error = 5e-2;
 #elif defined(NNADAPTER_WITH_HUAWEI_KIRIN_NPU)
   abs_error = 1e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
@@ -699,6 +705,8 @@ TEST(Activation_relu6, precision) {
   abs_error = 1e-2;
 #elif defined(NNADAPTER_WITH_HUAWEI_KIRIN_NPU)
   abs_error = 1e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
@@ -739,6 +747,8 @@ TEST(Activation_log, precision) {
   place = TARGET(kNNAdapter);
 #if defined(NNADAPTER_WITH_HUAWEI_ASCEND_NPU)
   abs_error = 1e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
@@ -1051,6 +1061,8 @@ TEST(Activation_abs, precision) {
   place = TARGET(kNNAdapter);
 #if defined(NNADAPTER_WITH_HUAWEI_ASCEND_NPU)
   abs_error = 5e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
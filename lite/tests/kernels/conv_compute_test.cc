@@ -389,7 +389,8 @@ void TestConvAct(Place place, float abs_error = 2e-5) {
                                 "relu"));
       arena::Arena arena0(std::move(tester0), place, abs_error);
       arena0.TestPrecision();
-#if defined(NNADAPTER_WITH_HUAWEI_ASCEND_NPU)
+#if defined(NNADAPTER_WITH_HUAWEI_ASCEND_NPU) || \
+    defined(NNADAPTER_WITH_X86_REFERENCE)
       continue;
 #endif
       std::unique_ptr<arena::TestCase> tester1(
@@ -420,6 +421,8 @@ TEST(Conv2d, precision) {
   place = TARGET(kNNAdapter);
 #if defined(NNADAPTER_WITH_HUAWEI_ASCEND_NPU)
   abs_error = 5e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
@@ -104,6 +104,8 @@ TEST(Softmax, precision) {
   place = TARGET(kNNAdapter);
 #if defined(NNADAPTER_WITH_HUAWEI_ASCEND_NPU)
   abs_error = 1e-2;
+#elif defined(NNADAPTER_WITH_X86_REFERENCE)
+  abs_error = 4e-5;
 #else
   return;
 #endif
@@ -45,6 +45,7 @@ NNADAPTER_WITH_HUAWEI_ASCEND_NPU=OFF
 NNADAPTER_HUAWEI_ASCEND_NPU_SDK_ROOT="/usr/local/Ascend/ascend-toolkit/latest"
 NNADAPTER_WITH_AMLOGIC_NPU=OFF
 NNADAPTER_AMLOGIC_NPU_SDK_ROOT="$(pwd)/amlnpu_ddk"
+NNADAPTER_WITH_X86_REFERENCE=OFF
 # options of compiling baidu XPU lib.
 WITH_BAIDU_XPU=OFF
 WITH_BAIDU_XPU_XTCL=OFF
@@ -163,6 +164,7 @@ function init_cmake_mutable_options {
                         -DNNADAPTER_HUAWEI_ASCEND_NPU_SDK_ROOT=$NNADAPTER_HUAWEI_ASCEND_NPU_SDK_ROOT \
                         -DNNADAPTER_WITH_AMLOGIC_NPU=$NNADAPTER_WITH_AMLOGIC_NPU \
                         -DNNADAPTER_AMLOGIC_NPU_SDK_ROOT=$NNADAPTER_AMLOGIC_NPU_SDK_ROOT \
+                        -DNNADAPTER_WITH_X86_REFERENCE=$NNADAPTER_WITH_X86_REFERENCE \
                         -DLITE_WITH_INTEL_FPGA=$WITH_INTEL_FPGA \
                         -DINTEL_FPGA_SDK_ROOT=${INTEL_FPGA_SDK_ROOT} \
                         -DLITE_WITH_PROFILE=${WITH_PROFILE} \
@@ -482,6 +484,10 @@ function main {
                 NNADAPTER_AMLOGIC_NPU_SDK_ROOT="${i#*=}"
                 shift
                 ;;
+            --nnadapter_with_x86_reference=*)
+                NNADAPTER_WITH_X86_REFERENCE="${i#*=}"
+                shift
+                ;;
             # compiling lib which can operate on baidu xpu.
             --with_baidu_xpu=*)
                 WITH_BAIDU_XPU="${i#*=}"
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+
+namespace paddle {
+namespace lite {
+
+// The bfloat16 is the upper 16 bits of a fp32, i.e. 1 sign bit, 8 exponent
+// bits and 7 mantissa bits, so it has the range of fp32 and is converted to
+// fp32 by a shift. The fp32 values are rounded to the nearest even, and NaN
+// is kept a quiet NaN.
+struct alignas(2) bfloat16 {
+ public:
+  uint16_t x;
+
+  // The defaulted special members keep bfloat16 trivial as float16 is.
+  bfloat16() = default;
+  bfloat16(const bfloat16& o) = default;
+  bfloat16& operator=(const bfloat16& o) = default;
+  bfloat16(bfloat16&& o) = default;
+  bfloat16& operator=(bfloat16&& o) = default;
+  ~bfloat16() = default;
+
+  inline explicit bfloat16(float val) {
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+      x = static_cast<uint16_t>((bits >> 16) | 0x40u);
+      return;
+    }
+    bits += 0x7fffu + ((bits >> 16) & 1u);
+    x = static_cast<uint16_t>(bits >> 16);
+  }
+
+  inline explicit operator float() const {
+    uint32_t bits = static_cast<uint32_t>(x) << 16;
+    float val;
+    std::memcpy(&val, &bits, sizeof(val));
+    return val;
+  }
+};
+
+static_assert(sizeof(bfloat16) == 2, "The size of bfloat16 should be 2.");
+
+}  // namespace lite
+}  // namespace paddle
@@ -14,6 +14,10 @@
 
 #include "lite/utils/cv/image2tensor.h"
 #include <arm_neon.h>
+#include <math.h>
+#include <vector>
+#include "lite/utils/cv/image_convert.h"
+#include "lite/utils/cv/image_resize.h"
 namespace paddle {
 namespace lite {
 namespace utils {
@@ -98,6 +102,43 @@ void Image2Tensor::choose(const uint8_t* src,
   impl_(src, output, srcw, srch, means, scales);
 }
 
+void resize_convert_to_tensor(const uint8_t* src,
+                              Tensor* dstTensor,
+                              ImageFormat srcFormat,
+                              ImageFormat dstFormat,
+                              int srcw,
+                              int srch,
+                              int dstw,
+                              int dsth,
+                              LayoutType layout,
+                              float* means,
+                              float* scales) {
+  int resized_size = dstw * dsth;
+  if (srcFormat == NV12 || srcFormat == NV21) {
+    resized_size = dstw * ceil(1.5 * dsth);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    resized_size = 3 * dstw * dsth;
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    resized_size = 4 * dstw * dsth;
+  }
+  std::vector<uint8_t> resized(resized_size);
+  std::vector<uint8_t> converted(4 * dstw * dsth);
+  ImageResize img_resize;
+  img_resize.choose(src, resized.data(), srcFormat, srcw, srch, dstw, dsth);
+  ImageConvert img_convert;
+  img_convert.choose(
+      resized.data(), converted.data(), srcFormat, dstFormat, dstw, dsth);
+  Image2Tensor img2tensor;
+  img2tensor.choose(converted.data(),
+                    dstTensor,
+                    dstFormat,
+                    layout,
+                    dstw,
+                    dsth,
+                    means,
+                    scales);
+}
+
 void gray_to_tensor(const uint8_t* src,
                     float* output,
                     int width,
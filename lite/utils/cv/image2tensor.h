@@ -40,6 +40,33 @@ class Image2Tensor {
  private:
   tensor_func impl_{nullptr};
 };
+
+/*
+  * resize, convert and change image data to tensor data at once
+  * param src: input image data
+  * param dstTensor: output tensor data
+  * param srcFormat: input image format, support GRAY, NV12(NV21), BGR(RGB)
+  * and BGRA(RGBA)
+  * param dstFormat: format of the tensor, support GRAY, BGR(RGB) and BGRA(RGBA)
+  * param srcw: input image width
+  * param srch: input image height
+  * param dstw: output tensor width
+  * param dsth: output tensor height
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+*/
+void resize_convert_to_tensor(const uint8_t* src,
+                              Tensor* dstTensor,
+                              ImageFormat srcFormat,
+                              ImageFormat dstFormat,
+                              int srcw,
+                              int srch,
+                              int dstw,
+                              int dsth,
+                              LayoutType layout,
+                              float* means,
+                              float* scales);
 }  // namespace cv
 }  // namespace utils
 }  // namespace lite
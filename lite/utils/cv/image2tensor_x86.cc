@@ -0,0 +1,414 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cv/image2tensor.h"
+#include "lite/utils/cv/image_convert.h"
+#include "lite/utils/cv/image_resize.h"
+#include "lite/utils/cv/image_x86.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// The number of the pixels normalized by a task at least.
+static constexpr int64_t kTensorPixelsPerTask = 16384;
+// The number of the output rows of a band of resize_convert_to_tensor, it's
+// even to keep the UV rows of the NV12(NV21) band.
+static constexpr int kBandRows = 16;
+
+#ifdef __AVX2__
+// (x - mean) * scale of the low 8 bytes of x.
+static inline __m256 normalize8(__m128i x, __m256 vmean, __m256 vscale) {
+  __m256 vx = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(x));
+  return _mm256_mul_ps(_mm256_sub_ps(vx, vmean), vscale);
+}
+#endif
+
+// The rows of the GRAY image, it's the same for NCHW and NHWC.
+static void gray_to_tensor_row(const uint8_t* src,
+                               float* dst,
+                               int width,
+                               const float* means,
+                               const float* scales) {
+  int j = 0;
+#ifdef __AVX2__
+  const __m256 vmean = _mm256_set1_ps(means[0]);
+  const __m256 vscale = _mm256_set1_ps(scales[0]);
+  for (; j + 8 <= width; j += 8) {
+    __m128i vx = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + j));
+    _mm256_storeu_ps(dst + j, normalize8(vx, vmean, vscale));
+  }
+#endif
+  for (; j < width; j++) {
+    dst[j] = (src[j] - means[0]) * scales[0];
+  }
+}
+
+// The b, g and r of the BGR(RGB) or BGRA(RGBA) row to the planes b, g and r.
+template <int kChannels>
+static void hwc_to_tensor_chw_row(const uint8_t* src,
+                                  float* dst_b,
+                                  float* dst_g,
+                                  float* dst_r,
+                                  int width,
+                                  const float* means,
+                                  const float* scales) {
+  float* dst[3] = {dst_b, dst_g, dst_r};
+  int j = 0;
+#ifdef __AVX2__
+  const Shuffle3Masks& masks = shuffle3_masks();
+  __m256 vmean[3];
+  __m256 vscale[3];
+  for (int c = 0; c < 3; c++) {
+    vmean[c] = _mm256_set1_ps(means[c]);
+    vscale[c] = _mm256_set1_ps(scales[c]);
+  }
+  for (; j + 16 <= width; j += 16) {
+    __m128i planes[4];
+    load_planes16<kChannels>(src + j * kChannels,
+                             masks,
+                             &planes[0],
+                             &planes[1],
+                             &planes[2],
+                             &planes[3]);
+    for (int c = 0; c < 3; c++) {
+      _mm256_storeu_ps(dst[c] + j, normalize8(planes[c], vmean[c], vscale[c]));
+      _mm256_storeu_ps(
+          dst[c] + j + 8,
+          normalize8(_mm_srli_si128(planes[c], 8), vmean[c], vscale[c]));
+    }
+  }
+#endif
+  for (; j < width; j++) {
+    for (int c = 0; c < 3; c++) {
+      dst[c][j] = (src[j * kChannels + c] - means[c]) * scales[c];
+    }
+  }
+}
+
+// The BGR(RGB) row to the row of the NHWC tensor, the channels of the
+// elements are periodic every 24 elements.
+static void bgr_to_tensor_hwc_row(const uint8_t* src,
+                                  float* dst,
+                                  int width,
+                                  const float* means,
+                                  const float* scales) {
+  const int size = width * 3;
+  int i = 0;
+#ifdef __AVX2__
+  __m256 vmean[3];
+  __m256 vscale[3];
+  for (int k = 0; k < 3; k++) {
+    float mean[8];
+    float scale[8];
+    for (int l = 0; l < 8; l++) {
+      mean[l] = means[(k * 8 + l) % 3];
+      scale[l] = scales[(k * 8 + l) % 3];
+    }
+    vmean[k] = _mm256_loadu_ps(mean);
+    vscale[k] = _mm256_loadu_ps(scale);
+  }
+  for (; i + 24 <= size; i += 24) {
+    for (int k = 0; k < 3; k++) {
+      __m128i vx =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + k * 8));
+      _mm256_storeu_ps(dst + i + k * 8, normalize8(vx, vmean[k], vscale[k]));
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    dst[i] = (src[i] - means[i % 3]) * scales[i % 3];
+  }
+}
+
+// The BGRA(RGBA) row to the row of the NHWC tensor, the alpha is dropped.
+static void bgra_to_tensor_hwc_row(const uint8_t* src,
+                                   float* dst,
+                                   int width,
+                                   const float* means,
+                                   const float* scales) {
+  int j = 0;
+#ifdef __AVX2__
+  // Convert 2 pixels to [b0 g0 r0 b1 g1 r1 x x], the last 2 elements are
+  // overwritten by the next pixels.
+  const __m256 vmean = _mm256_setr_ps(
+      means[0], means[1], means[2], 0.f, means[0], means[1], means[2], 0.f);
+  const __m256 vscale = _mm256_setr_ps(scales[0],
+                                       scales[1],
+                                       scales[2],
+                                       0.f,
+                                       scales[0],
+                                       scales[1],
+                                       scales[2],
+                                       0.f);
+  const __m256i vindex = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+  for (; j + 3 <= width; j += 2) {
+    __m128i vx =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + j * 4));
+    __m256 vy = normalize8(vx, vmean, vscale);
+    _mm256_storeu_ps(dst + j * 3, _mm256_permutevar8x32_ps(vy, vindex));
+  }
+#endif
+  for (; j < width; j++) {
+    for (int c = 0; c < 3; c++) {
+      dst[j * 3 + c] = (src[j * 4 + c] - means[c]) * scales[c];
+    }
+  }
+}
+
+template <int kChannels, bool kHWC>
+static void image_to_tensor_rows(const uint8_t* src,
+                                 float* dst,
+                                 int width,
+                                 int height,
+                                 int begin,
+                                 int end,
+                                 const float* means,
+                                 const float* scales) {
+  const int64_t plane_size = static_cast<int64_t>(width) * height;
+  for (int i = begin; i < end; i++) {
+    const uint8_t* row = src + (i - begin) * width * kChannels;
+    if (kChannels == 1) {
+      gray_to_tensor_row(row, dst + i * width, width, means, scales);
+    } else if (kHWC && kChannels == 3) {
+      bgr_to_tensor_hwc_row(row, dst + i * width * 3, width, means, scales);
+    } else if (kHWC) {
+      bgra_to_tensor_hwc_row(row, dst + i * width * 3, width, means, scales);
+    } else {
+      float* dst_b = dst + i * width;
+      hwc_to_tensor_chw_row<kChannels>(row,
+                                       dst_b,
+                                       dst_b + plane_size,
+                                       dst_b + 2 * plane_size,
+                                       width,
+                                       means,
+                                       scales);
+    }
+  }
+}
+
+void image_to_tensor_rows(const uint8_t* src,
+                          float* dst,
+                          ImageFormat srcFormat,
+                          LayoutType layout,
+                          int width,
+                          int height,
+                          int begin,
+                          int end,
+                          const float* means,
+                          const float* scales) {
+  int channels = image_channels(srcFormat);
+  bool hwc = layout == LayoutType::kNHWC;
+  if (channels == 1) {
+    image_to_tensor_rows<1, false>(
+        src, dst, width, height, begin, end, means, scales);
+  } else if (channels == 3 && hwc) {
+    image_to_tensor_rows<3, true>(
+        src, dst, width, height, begin, end, means, scales);
+  } else if (channels == 3) {
+    image_to_tensor_rows<3, false>(
+        src, dst, width, height, begin, end, means, scales);
+  } else if (hwc) {
+    image_to_tensor_rows<4, true>(
+        src, dst, width, height, begin, end, means, scales);
+  } else {
+    image_to_tensor_rows<4, false>(
+        src, dst, width, height, begin, end, means, scales);
+  }
+}
+
+template <int kChannels, bool kHWC>
+static void image_to_tensor(const uint8_t* src,
+                            float* output,
+                            int width,
+                            int height,
+                            float* means,
+                            float* scales) {
+  auto convert_rows = [&](int64_t begin, int64_t end) {
+    image_to_tensor_rows<kChannels, kHWC>(src + begin * width * kChannels,
+                                          output,
+                                          width,
+                                          height,
+                                          begin,
+                                          end,
+                                          means,
+                                          scales);
+  };
+  int64_t rows_per_task = std::max<int64_t>(kTensorPixelsPerTask / width, 1);
+  lite::x86::RunParallelFor(0, height, convert_rows, rows_per_task);
+}
+
+/*
+  * change image data to tensor data
+  * support image format is BGR(RGB) and BGRA(RGBA), Data layout is NHWC and
+  * NCHW
+  * param src: input image data
+  * param dstTensor: output tensor data
+  * param srcFormat: input image format, support GRAY, BGR(GRB) and BGRA(RGBA)
+  * param srcw: input image width
+  * param srch: input image height
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+*/
+void Image2Tensor::choose(const uint8_t* src,
+                          Tensor* dst,
+                          ImageFormat srcFormat,
+                          LayoutType layout,
+                          int srcw,
+                          int srch,
+                          float* means,
+                          float* scales) {
+  float* output = dst->mutable_data<float>();
+  if (layout == LayoutType::kNCHW && (srcFormat == BGR || srcFormat == RGB)) {
+    impl_ = image_to_tensor<3, false>;
+  } else if (layout == LayoutType::kNHWC &&
+             (srcFormat == BGR || srcFormat == RGB)) {
+    impl_ = image_to_tensor<3, true>;
+  } else if (layout == LayoutType::kNCHW &&
+             (srcFormat == BGRA || srcFormat == RGBA)) {
+    impl_ = image_to_tensor<4, false>;
+  } else if (layout == LayoutType::kNHWC &&
+             (srcFormat == BGRA || srcFormat == RGBA)) {
+    impl_ = image_to_tensor<4, true>;
+  } else if ((layout == LayoutType::kNHWC || layout == LayoutType::kNCHW) &&
+             (srcFormat == GRAY)) {
+    impl_ = image_to_tensor<1, false>;
+  } else {
+    printf("this layout: %d or image format: %d not support \n",
+           static_cast<int>(layout),
+           srcFormat);
+    return;
+  }
+  impl_(src, output, srcw, srch, means, scales);
+}
+
+// Resize, convert and normalize the bands of the output rows one by one, so
+// the intermediate images of a band stay in the cache.
+void resize_convert_to_tensor(const uint8_t* src,
+                              Tensor* dstTensor,
+                              ImageFormat srcFormat,
+                              ImageFormat dstFormat,
+                              int srcw,
+                              int srch,
+                              int dstw,
+                              int dsth,
+                              LayoutType layout,
+                              float* means,
+                              float* scales) {
+  const bool is_nv = srcFormat == NV12 || srcFormat == NV21;
+  if (dstFormat == NV12 || dstFormat == NV21 ||
+      (layout != LayoutType::kNCHW && layout != LayoutType::kNHWC) ||
+      (srcFormat != dstFormat &&
+       get_convert_func(srcFormat, dstFormat) == nullptr)) {
+    printf("srcFormat: %d, dstFormat: %d or layout: %d does not support! \n",
+           srcFormat,
+           dstFormat,
+           static_cast<int>(layout));
+    return;
+  }
+  if (is_nv && (dstw % 2 != 0 || dsth % 2 != 0)) {
+    // The UV rows of a band aren't aligned with its Y rows, resize the whole
+    // image at first.
+    std::vector<uint8_t> resized(dstw * (dsth + (dsth + 1) / 2));
+    std::vector<uint8_t> converted(dstw * dsth * image_channels(dstFormat));
+    resize(src, resized.data(), srcFormat, srcw, srch, dstw, dsth);
+    ImageConvert convert;
+    convert.choose(
+        resized.data(), converted.data(), srcFormat, dstFormat, dstw, dsth);
+    Image2Tensor to_tensor;
+    to_tensor.choose(converted.data(),
+                     dstTensor,
+                     dstFormat,
+                     layout,
+                     dstw,
+                     dsth,
+                     means,
+                     scales);
+    return;
+  }
+  float* output = dstTensor->mutable_data<float>();
+  const bool same_size = srcw == dstw && srch == dsth;
+  const int src_channels = image_channels(srcFormat);
+  const int dst_channels = image_channels(dstFormat);
+  BilinearCoefs coefs;
+  BilinearCoefs uv_coefs;
+  if (!same_size) {
+    compute_bilinear_coefs(srcw, srch, dstw, dsth, src_channels, &coefs);
+    if (is_nv) {
+      compute_bilinear_coefs(
+          srcw / 2, srch / 2, dstw / 2, dsth / 2, 2, &uv_coefs);
+    }
+  }
+  convert_func convert = get_convert_func(srcFormat, dstFormat);
+  auto convert_bands = [&](int64_t begin, int64_t end) {
+    std::vector<uint8_t> resized;
+    std::vector<uint8_t> converted;
+    BilinearRows cache;
+    BilinearRows uv_cache;
+    for (int64_t band = begin; band < end; band++) {
+      const int y0 = band * kBandRows;
+      const int y1 = std::min(y0 + kBandRows, dsth);
+      const int rows = y1 - y0;
+      // The NV12(NV21) band is laid out as a small image of its Y and UV rows.
+      const uint8_t* band_src = src + y0 * srcw * src_channels;
+      if (!same_size || is_nv) {
+        resized.resize(dstw * rows * src_channels + (is_nv ? dstw * rows : 0));
+        uint8_t* y_rows = resized.data();
+        uint8_t* uv_rows = y_rows + dstw * rows;
+        if (same_size) {
+          memcpy(y_rows, src + y0 * srcw, dstw * rows);
+          memcpy(uv_rows, src + srcw * srch + y0 / 2 * srcw, dstw * rows / 2);
+        } else {
+          resize_bilinear_rows(src, coefs, y0, y1, &cache, y_rows);
+          if (is_nv) {
+            resize_bilinear_rows(src + srcw * srch,
+                                 uv_coefs,
+                                 y0 / 2,
+                                 y1 / 2,
+                                 &uv_cache,
+                                 uv_rows);
+          }
+        }
+        band_src = resized.data();
+      }
+      if (convert != nullptr) {
+        converted.resize(dstw * rows * dst_channels);
+        convert(band_src, converted.data(), dstw, rows);
+        band_src = converted.data();
+      }
+      image_to_tensor_rows(band_src,
+                           output,
+                           dstFormat,
+                           layout,
+                           dstw,
+                           dsth,
+                           y0,
+                           y1,
+                           means,
+                           scales);
+    }
+  };
+  const int num_bands = (dsth + kBandRows - 1) / kBandRows;
+  lite::x86::RunParallelFor(0, num_bands, convert_bands, 1);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
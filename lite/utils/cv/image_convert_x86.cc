@@ -0,0 +1,318 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cv/image_convert.h"
+#include "lite/utils/cv/image_x86.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// The number of the pixels converted by a task at least.
+static constexpr int64_t kConvertPixelsPerTask = 16384;
+
+int image_channels(ImageFormat format) {
+  if (format == BGR || format == RGB) {
+    return 3;
+  } else if (format == BGRA || format == RGBA) {
+    return 4;
+  }
+  return 1;
+}
+
+#ifdef __AVX2__
+Shuffle3Masks::Shuffle3Masks() {
+  for (int k = 0; k < 3; k++) {
+    for (int c = 0; c < 3; c++) {
+      alignas(16) int8_t gather[16];
+      alignas(16) int8_t scatter[16];
+      for (int i = 0; i < 16; i++) {
+        // The byte 3 * i + c of the 48 bytes is in the block k, and the byte
+        // 16 * k + i of the block k is the channel c of the pixel p.
+        int offset = 3 * i + c - 16 * k;
+        gather[i] = offset >= 0 && offset < 16 ? offset : -1;
+        int p = (16 * k + i) / 3;
+        scatter[i] = (16 * k + i) % 3 == c ? p : -1;
+      }
+      deinterleave[c][k] =
+          _mm_load_si128(reinterpret_cast<const __m128i*>(gather));
+      interleave[k][c] =
+          _mm_load_si128(reinterpret_cast<const __m128i*>(scatter));
+    }
+  }
+}
+
+const Shuffle3Masks& shuffle3_masks() {
+  static const Shuffle3Masks masks;
+  return masks;
+}
+
+// Pack the 16 int16 to the 16 uint8 with the saturation.
+static inline __m128i pack_u8(__m256i x) {
+  return _mm_packus_epi16(_mm256_castsi256_si128(x),
+                          _mm256_extracti128_si256(x, 1));
+}
+
+// [x0 x0 x1 x1 ... x7 x7] of the 8 int16.
+static inline __m256i duplicate_epi16(__m128i x) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_unpacklo_epi16(x, x)),
+      _mm_unpackhi_epi16(x, x),
+      1);
+}
+#endif
+
+/*
+nv12(yuv)/nv21(yvu) to BGR(BGRA), the same as image_convert.cc
+R = Y + ((179 * (V - 128)) >> 7);
+G = Y - ((44 * (U - 128) + 91 * (V - 128)) >> 7);
+B = Y + ((227 * (U - 128)) >> 7);
+*/
+template <int kChannels>
+static void nv_to_hwc_row(const uint8_t* y,
+                          const uint8_t* uv,
+                          uint8_t* dst,
+                          int width,
+                          int u_index) {
+  int j = 0;
+#ifdef __AVX2__
+  const Shuffle3Masks& masks = shuffle3_masks();
+  const __m128i v128 = _mm_set1_epi16(128);
+  const __m128i vlow = _mm_set1_epi16(0xff);
+  const __m128i v179 = _mm_set1_epi16(179);
+  const __m128i v44 = _mm_set1_epi16(44);
+  const __m128i v91 = _mm_set1_epi16(91);
+  const __m128i v227 = _mm_set1_epi16(227);
+  const __m128i valpha = _mm_set1_epi8(-1);
+  for (; j + 16 <= width; j += 16) {
+    __m128i vuv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + j));
+    __m128i veven = _mm_sub_epi16(_mm_and_si128(vuv, vlow), v128);
+    __m128i vodd = _mm_sub_epi16(_mm_srli_epi16(vuv, 8), v128);
+    __m128i vu = u_index == 0 ? veven : vodd;
+    __m128i vv = u_index == 0 ? vodd : veven;
+    __m128i vra = _mm_srai_epi16(_mm_mullo_epi16(vv, v179), 7);
+    __m128i vga = _mm_srai_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(vu, v44), _mm_mullo_epi16(vv, v91)), 7);
+    __m128i vba = _mm_srai_epi16(_mm_mullo_epi16(vu, v227), 7);
+    __m256i vy = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + j)));
+    __m128i vr = pack_u8(_mm256_add_epi16(vy, duplicate_epi16(vra)));
+    __m128i vg = pack_u8(_mm256_sub_epi16(vy, duplicate_epi16(vga)));
+    __m128i vb = pack_u8(_mm256_add_epi16(vy, duplicate_epi16(vba)));
+    store_planes16<kChannels>(
+        dst + j * kChannels, masks, vb, vg, vr, valpha);
+  }
+#endif
+  for (; j < width; j++) {
+    const uint8_t* vu = uv + (j & ~1);
+    int u = vu[u_index] - 128;
+    int v = vu[1 - u_index] - 128;
+    int r = y[j] + ((179 * v) >> 7);
+    int g = y[j] - ((44 * u + 91 * v) >> 7);
+    int b = y[j] + ((227 * u) >> 7);
+    uint8_t* d = dst + j * kChannels;
+    d[0] = std::min(std::max(b, 0), 255);
+    d[1] = std::min(std::max(g, 0), 255);
+    d[2] = std::min(std::max(r, 0), 255);
+    if (kChannels == 4) {
+      d[3] = 255;
+    }
+  }
+}
+
+template <int kChannels, int kUIndex>
+static void nv_to_hwc(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  const uint8_t* uv = src + srcw * srch;
+  auto convert_rows = [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      nv_to_hwc_row<kChannels>(src + i * srcw,
+                               uv + (i / 2) * srcw,
+                               dst + i * srcw * kChannels,
+                               srcw,
+                               kUIndex);
+    }
+  };
+  int64_t rows_per_task = std::max<int64_t>(kConvertPixelsPerTask / srcw, 1);
+  lite::x86::RunParallelFor(0, srch, convert_rows, rows_per_task);
+}
+
+/*
+Gray = (15 * B + 75 * G + 38 * R) >> 7, the same as image_convert.cc
+*/
+template <int kChannels>
+static void hwc_to_gray_pixels(const uint8_t* src, uint8_t* dst, int64_t size) {
+  int64_t i = 0;
+#ifdef __AVX2__
+  const Shuffle3Masks& masks = shuffle3_masks();
+  const __m256i vwb = _mm256_set1_epi16(15);
+  const __m256i vwg = _mm256_set1_epi16(75);
+  const __m256i vwr = _mm256_set1_epi16(38);
+  for (; i + 16 <= size; i += 16) {
+    __m128i vb, vg, vr, va;
+    load_planes16<kChannels>(src + i * kChannels, masks, &vb, &vg, &vr, &va);
+    __m256i vsum =
+        _mm256_add_epi16(_mm256_mullo_epi16(_mm256_cvtepu8_epi16(vb), vwb),
+                         _mm256_mullo_epi16(_mm256_cvtepu8_epi16(vg), vwg));
+    vsum = _mm256_add_epi16(
+        vsum, _mm256_mullo_epi16(_mm256_cvtepu8_epi16(vr), vwr));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     pack_u8(_mm256_srli_epi16(vsum, 7)));
+  }
+#endif
+  for (; i < size; i++) {
+    const uint8_t* s = src + i * kChannels;
+    dst[i] = (s[0] * 15 + s[1] * 75 + s[2] * 38) >> 7;
+  }
+}
+
+// Convert the pixels between GRAY, BGR(RGB) and BGRA(RGBA), the b and r are
+// swapped if kSwap, and the alpha is kept or filled by 255.
+template <int kIn, int kOut, bool kSwap>
+static void hwc_convert_pixels(const uint8_t* src,
+                               uint8_t* dst,
+                               int64_t size) {
+  int64_t i = 0;
+#ifdef __AVX2__
+  const Shuffle3Masks& masks = shuffle3_masks();
+  for (; i + 16 <= size; i += 16) {
+    __m128i vb, vg, vr, va;
+    load_planes16<kIn>(src + i * kIn, masks, &vb, &vg, &vr, &va);
+    if (kSwap) {
+      store_planes16<kOut>(dst + i * kOut, masks, vr, vg, vb, va);
+    } else {
+      store_planes16<kOut>(dst + i * kOut, masks, vb, vg, vr, va);
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    const uint8_t* s = src + i * kIn;
+    uint8_t* d = dst + i * kOut;
+    uint8_t b = s[0];
+    uint8_t g = kIn == 1 ? s[0] : s[1];
+    uint8_t r = kIn == 1 ? s[0] : s[2];
+    d[0] = kSwap ? r : b;
+    d[1] = g;
+    d[2] = kSwap ? b : r;
+    if (kOut == 4) {
+      d[3] = kIn == 4 ? s[3] : 255;
+    }
+  }
+}
+
+template <int kChannels>
+static void hwc_to_gray(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  auto convert_pixels = [&](int64_t begin, int64_t end) {
+    hwc_to_gray_pixels<kChannels>(
+        src + begin * kChannels, dst + begin, end - begin);
+  };
+  lite::x86::RunParallelFor(0,
+                            static_cast<int64_t>(srcw) * srch,
+                            convert_pixels,
+                            kConvertPixelsPerTask);
+}
+
+template <int kIn, int kOut, bool kSwap>
+static void hwc_convert(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  auto convert_pixels = [&](int64_t begin, int64_t end) {
+    hwc_convert_pixels<kIn, kOut, kSwap>(
+        src + begin * kIn, dst + begin * kOut, end - begin);
+  };
+  lite::x86::RunParallelFor(0,
+                            static_cast<int64_t>(srcw) * srch,
+                            convert_pixels,
+                            kConvertPixelsPerTask);
+}
+
+convert_func get_convert_func(ImageFormat srcFormat, ImageFormat dstFormat) {
+  // NV12(NV21) is converted to BGR(BGRA) for RGB(RGBA) as well, which is the
+  // same as image_convert.cc.
+  if (srcFormat == NV12 && (dstFormat == BGR || dstFormat == RGB)) {
+    return nv_to_hwc<3, 0>;
+  } else if (srcFormat == NV21 && (dstFormat == BGR || dstFormat == RGB)) {
+    return nv_to_hwc<3, 1>;
+  } else if (srcFormat == NV12 && (dstFormat == BGRA || dstFormat == RGBA)) {
+    return nv_to_hwc<4, 0>;
+  } else if (srcFormat == NV21 && (dstFormat == BGRA || dstFormat == RGBA)) {
+    return nv_to_hwc<4, 1>;
+  } else if ((srcFormat == RGBA && dstFormat == RGB) ||
+             (srcFormat == BGRA && dstFormat == BGR)) {
+    return hwc_convert<4, 3, false>;
+  } else if ((srcFormat == RGB && dstFormat == RGBA) ||
+             (srcFormat == BGR && dstFormat == BGRA)) {
+    return hwc_convert<3, 4, false>;
+  } else if ((srcFormat == RGB && dstFormat == BGR) ||
+             (srcFormat == BGR && dstFormat == RGB)) {
+    return hwc_convert<3, 3, true>;
+  } else if ((srcFormat == RGBA && dstFormat == BGRA) ||
+             (srcFormat == BGRA && dstFormat == RGBA)) {
+    return hwc_convert<4, 4, true>;
+  } else if ((srcFormat == RGB && dstFormat == GRAY) ||
+             (srcFormat == BGR && dstFormat == GRAY)) {
+    return hwc_to_gray<3>;
+  } else if ((srcFormat == GRAY && dstFormat == RGB) ||
+             (srcFormat == GRAY && dstFormat == BGR)) {
+    return hwc_convert<1, 3, false>;
+  } else if ((srcFormat == RGBA && dstFormat == BGR) ||
+             (srcFormat == BGRA && dstFormat == RGB)) {
+    return hwc_convert<4, 3, true>;
+  } else if ((srcFormat == RGB && dstFormat == BGRA) ||
+             (srcFormat == BGR && dstFormat == RGBA)) {
+    return hwc_convert<3, 4, true>;
+  } else if ((srcFormat == GRAY && dstFormat == RGBA) ||
+             (srcFormat == GRAY && dstFormat == BGRA)) {
+    return hwc_convert<1, 4, false>;
+  } else if ((srcFormat == RGBA && dstFormat == GRAY) ||
+             (srcFormat == BGRA && dstFormat == GRAY)) {
+    return hwc_to_gray<4>;
+  }
+  return nullptr;
+}
+
+void ImageConvert::choose(const uint8_t* src,
+                          uint8_t* dst,
+                          ImageFormat srcFormat,
+                          ImageFormat dstFormat,
+                          int srcw,
+                          int srch) {
+  if (srcFormat == dstFormat) {
+    // copy
+    int size = srcw * srch;
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (ceil(1.5 * srch));
+    } else if (srcFormat == BGR || srcFormat == RGB) {
+      size = 3 * srcw * srch;
+    } else if (srcFormat == BGRA || srcFormat == RGBA) {
+      size = 4 * srcw * srch;
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  }
+  impl_ = get_convert_func(srcFormat, dstFormat);
+  if (impl_ == nullptr) {
+    printf("srcFormat: %d, dstFormat: %d does not support! \n",
+           srcFormat,
+           dstFormat);
+    return;
+  }
+  impl_(src, dst, srcw, srch);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
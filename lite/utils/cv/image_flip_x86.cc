@@ -0,0 +1,128 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include <string.h>
+#include <algorithm>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cv/image_flip.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// The number of the bytes flipped by a task at least.
+static constexpr int64_t kFlipBytesPerTask = 65536;
+
+void ImageFlip::choose(const uint8_t* src,
+                       uint8_t* dst,
+                       ImageFormat srcFormat,
+                       int srcw,
+                       int srch,
+                       FlipParam flip_param) {
+  if (srcFormat == GRAY) {
+    flip_hwc1(src, dst, srcw, srch, flip_param);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    flip_hwc3(src, dst, srcw, srch, flip_param);
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    flip_hwc4(src, dst, srcw, srch, flip_param);
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+    return;
+  }
+}
+
+// Mirror the pixels of the row, the 1 and 4 bytes pixels are reversed by 16
+// bytes at once, and the 3 bytes pixels are copied one by one.
+template <int kChannels>
+static void mirror_row(const uint8_t* src, uint8_t* dst, int width) {
+  int j = 0;
+#ifdef __AVX2__
+  if (kChannels == 1 || kChannels == 4) {
+    const int pixels = 16 / kChannels;
+    const __m128i vmask1 =
+        _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i vmask4 =
+        _mm_setr_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m128i vmask = kChannels == 1 ? vmask1 : vmask4;
+    for (; j + pixels <= width; j += pixels) {
+      __m128i vx = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src + j * kChannels));
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(dst + (width - j - pixels) * kChannels),
+          _mm_shuffle_epi8(vx, vmask));
+    }
+  }
+#endif
+  for (; j < width; j++) {
+    memcpy(dst + (width - 1 - j) * kChannels, src + j * kChannels, kChannels);
+  }
+}
+
+template <int kChannels>
+static void flip_hwc(const uint8_t* src,
+                     uint8_t* dst,
+                     int srcw,
+                     int srch,
+                     FlipParam flip_param) {
+  if (flip_param != X && flip_param != Y && flip_param != XY) {
+    printf("its doesn't support Flip: %d \n", static_cast<int>(flip_param));
+    return;
+  }
+  const int64_t stride = static_cast<int64_t>(srcw) * kChannels;
+  auto flip_rows = [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      // X flips the rows upside down, Y mirrors every row, XY does both.
+      int64_t dst_row = flip_param == Y ? i : srch - 1 - i;
+      if (flip_param == X) {
+        memcpy(dst + dst_row * stride, src + i * stride, stride);
+      } else {
+        mirror_row<kChannels>(src + i * stride, dst + dst_row * stride, srcw);
+      }
+    }
+  };
+  int64_t rows_per_task = std::max<int64_t>(kFlipBytesPerTask / stride, 1);
+  lite::x86::RunParallelFor(0, srch, flip_rows, rows_per_task);
+}
+
+void flip_hwc1(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<1>(src, dst, srcw, srch, flip_param);
+}
+
+void flip_hwc3(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<3>(src, dst, srcw, srch, flip_param);
+}
+
+void flip_hwc4(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<4>(src, dst, srcw, srch, flip_param);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,276 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <utility>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cv/image_resize.h"
+#include "lite/utils/cv/image_x86.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// The number of the output rows resized by a task at least, the first two
+// source rows of a task are resized horizontally without the cache.
+static constexpr int64_t kResizeRowsPerTask = 16;
+
+void ImageResize::choose(const uint8_t* src,
+                         uint8_t* dst,
+                         ImageFormat srcFormat,
+                         int srcw,
+                         int srch,
+                         int dstw,
+                         int dsth) {
+  resize(src, dst, srcFormat, srcw, srch, dstw, dsth);
+}
+
+static int16_t saturate_cast_short(float x) {
+  return static_cast<int16_t>(
+      std::min(std::max(static_cast<int>(x + (x >= 0.f ? 0.5f : -0.5f)),
+                        SHRT_MIN),
+               SHRT_MAX));
+}
+
+void compute_bilinear_coefs(int srcw,
+                            int srch,
+                            int dstw,
+                            int dsth,
+                            int channels,
+                            BilinearCoefs* coefs) {
+  const int resize_coef_bits = 11;
+  const int resize_coef_scale = 1 << resize_coef_bits;
+  double scale_x = static_cast<double>(srcw) / dstw;
+  double scale_y = static_cast<double>(srch) / dsth;
+  coefs->channels = channels;
+  coefs->srcw = srcw;
+  coefs->srch = srch;
+  coefs->dstw = dstw;
+  coefs->dsth = dsth;
+  coefs->xofs.resize(dstw * channels);
+  coefs->ialpha.resize(dstw * channels);
+  coefs->yofs.resize(dsth);
+  coefs->ibeta.resize(dsth * 2);
+  for (int dx = 0; dx < dstw; dx++) {
+    float fx = static_cast<float>((dx + 0.5) * scale_x - 0.5);
+    int sx = floor(fx);
+    fx -= sx;
+    if (sx < 0) {
+      sx = 0;
+      fx = 0.f;
+    }
+    if (sx >= srcw - 1) {
+      sx = srcw - 2;
+      fx = 1.f;
+    }
+    uint16_t a0 = saturate_cast_short((1.f - fx) * resize_coef_scale);
+    uint16_t a1 = saturate_cast_short(fx * resize_coef_scale);
+    for (int c = 0; c < channels; c++) {
+      coefs->xofs[dx * channels + c] = sx * channels + c;
+      coefs->ialpha[dx * channels + c] = a0 | (a1 << 16);
+    }
+  }
+  for (int dy = 0; dy < dsth; dy++) {
+    float fy = static_cast<float>((dy + 0.5) * scale_y - 0.5);
+    int sy = floor(fy);
+    fy -= sy;
+    if (sy < 0) {
+      sy = 0;
+      fy = 0.f;
+    }
+    if (sy >= srch - 1) {
+      sy = srch - 2;
+      fy = 1.f;
+    }
+    coefs->yofs[dy] = sy;
+    coefs->ibeta[dy * 2] = saturate_cast_short((1.f - fy) * resize_coef_scale);
+    coefs->ibeta[dy * 2 + 1] = saturate_cast_short(fy * resize_coef_scale);
+  }
+  // The offsets are ascending, the taps of the front bytes are loaded by the
+  // 4 bytes gather, and the rest are loaded byte by byte.
+  const int src_size = srcw * channels;
+  int gather_size = 0;
+  while (gather_size < dstw * channels &&
+         coefs->xofs[gather_size] + channels + 4 <= src_size) {
+    gather_size++;
+  }
+  coefs->gather_size = gather_size;
+}
+
+// row[k] = (S[xofs[k]] * alpha0 + S[xofs[k] + channels] * alpha1) >> 4
+static void resize_row_h(const uint8_t* src,
+                         const BilinearCoefs& coefs,
+                         int16_t* row) {
+  const int channels = coefs.channels;
+  const int size = coefs.dstw * channels;
+  const int* xofs = coefs.xofs.data();
+  const int* ialpha = coefs.ialpha.data();
+  int k = 0;
+#ifdef __AVX2__
+  const int* src0 = reinterpret_cast<const int*>(src);
+  const int* src1 = reinterpret_cast<const int*>(src + channels);
+  const __m256i vmask = _mm256_set1_epi32(0xff);
+  for (; k + 8 <= coefs.gather_size; k += 8) {
+    __m256i vofs =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xofs + k));
+    __m256i vs0 =
+        _mm256_and_si256(_mm256_i32gather_epi32(src0, vofs, 1), vmask);
+    __m256i vs1 =
+        _mm256_and_si256(_mm256_i32gather_epi32(src1, vofs, 1), vmask);
+    __m256i vpair = _mm256_or_si256(vs0, _mm256_slli_epi32(vs1, 16));
+    __m256i valpha =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ialpha + k));
+    __m256i vsum = _mm256_srai_epi32(_mm256_madd_epi16(vpair, valpha), 4);
+    __m128i vout = _mm_packs_epi32(_mm256_castsi256_si128(vsum),
+                                   _mm256_extracti128_si256(vsum, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row + k), vout);
+  }
+#endif
+  for (; k < size; k++) {
+    const uint8_t* s = src + xofs[k];
+    int a0 = ialpha[k] & 0xffff;
+    int a1 = ialpha[k] >> 16;
+    row[k] = (s[0] * a0 + s[channels] * a1) >> 4;
+  }
+}
+
+// dst[k] = ((rows0[k] * b0) >> 16 + (rows1[k] * b1) >> 16 + 2) >> 2
+static void resize_row_v(const int16_t* rows0,
+                         const int16_t* rows1,
+                         int16_t b0,
+                         int16_t b1,
+                         int size,
+                         uint8_t* dst) {
+  int k = 0;
+#ifdef __AVX2__
+  const __m256i vb0 = _mm256_set1_epi16(b0);
+  const __m256i vb1 = _mm256_set1_epi16(b1);
+  const __m256i v2 = _mm256_set1_epi16(2);
+  for (; k + 16 <= size; k += 16) {
+    __m256i vr0 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows0 + k));
+    __m256i vr1 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows1 + k));
+    __m256i vacc = _mm256_add_epi16(_mm256_mulhi_epi16(vr0, vb0),
+                                    _mm256_mulhi_epi16(vr1, vb1));
+    vacc = _mm256_srai_epi16(_mm256_add_epi16(vacc, v2), 2);
+    __m128i vout = _mm_packus_epi16(_mm256_castsi256_si128(vacc),
+                                    _mm256_extracti128_si256(vacc, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), vout);
+  }
+#endif
+  for (; k < size; k++) {
+    dst[k] = (uint8_t)(((int16_t)((b0 * rows0[k]) >> 16) +
+                        (int16_t)((b1 * rows1[k]) >> 16) + 2) >>
+                       2);
+  }
+}
+
+void resize_bilinear_rows(const uint8_t* src,
+                          const BilinearCoefs& coefs,
+                          int begin,
+                          int end,
+                          BilinearRows* cache,
+                          uint8_t* dst) {
+  const int src_stride = coefs.srcw * coefs.channels;
+  const int size = coefs.dstw * coefs.channels;
+  if (cache->rows0.size() != static_cast<size_t>(size)) {
+    cache->rows0.resize(size);
+    cache->rows1.resize(size);
+    cache->sy = -1;
+  }
+  for (int dy = begin; dy < end; dy++) {
+    int sy = coefs.yofs[dy];
+    if (cache->sy >= 0 && sy == cache->sy + 1) {
+      std::swap(cache->rows0, cache->rows1);
+      resize_row_h(src + (sy + 1) * src_stride, coefs, cache->rows1.data());
+    } else if (sy != cache->sy) {
+      resize_row_h(src + sy * src_stride, coefs, cache->rows0.data());
+      resize_row_h(src + (sy + 1) * src_stride, coefs, cache->rows1.data());
+    }
+    cache->sy = sy;
+    resize_row_v(cache->rows0.data(),
+                 cache->rows1.data(),
+                 coefs.ibeta[dy * 2],
+                 coefs.ibeta[dy * 2 + 1],
+                 size,
+                 dst + (dy - begin) * size);
+  }
+}
+
+static void resize_plane(const uint8_t* src,
+                         int srcw,
+                         int srch,
+                         uint8_t* dst,
+                         int dstw,
+                         int dsth,
+                         int channels) {
+  BilinearCoefs coefs;
+  compute_bilinear_coefs(srcw, srch, dstw, dsth, channels, &coefs);
+  auto resize_rows = [&](int64_t begin, int64_t end) {
+    BilinearRows cache;
+    resize_bilinear_rows(
+        src, coefs, begin, end, &cache, dst + begin * dstw * channels);
+  };
+  lite::x86::RunParallelFor(0, dsth, resize_rows, kResizeRowsPerTask);
+}
+
+void resize(const uint8_t* src,
+            uint8_t* dst,
+            ImageFormat srcFormat,
+            int srcw,
+            int srch,
+            int dstw,
+            int dsth) {
+  int size = srcw * srch;
+  if (srcw == dstw && srch == dsth) {
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (static_cast<int>(1.5 * srch));
+    } else if (srcFormat == BGR || srcFormat == RGB) {
+      size = 3 * srcw * srch;
+    } else if (srcFormat == BGRA || srcFormat == RGBA) {
+      size = 4 * srcw * srch;
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  }
+  if (srcFormat == NV12 || srcFormat == NV21) {
+    // The interleaved UV plane is resized as a 2 channels image.
+    resize_plane(src, srcw, srch, dst, dstw, dsth, 1);
+    resize_plane(src + srcw * srch,
+                 srcw / 2,
+                 srch / 2,
+                 dst + dstw * dsth,
+                 dstw / 2,
+                 dsth / 2,
+                 2);
+  } else if (srcFormat == GRAY || srcFormat == BGR || srcFormat == RGB ||
+             srcFormat == BGRA || srcFormat == RGBA) {
+    resize_plane(
+        src, srcw, srch, dst, dstw, dsth, image_channels(srcFormat));
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+  }
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
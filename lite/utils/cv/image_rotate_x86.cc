@@ -0,0 +1,111 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <algorithm>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cv/image_flip.h"
+#include "lite/utils/cv/image_rotate.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// The size of the square tiles in pixels, the source columns of a tile are
+// read by the output rows while they are still in the cache.
+static constexpr int kRotateTile = 32;
+
+void ImageRotate::choose(const uint8_t* src,
+                         uint8_t* dst,
+                         ImageFormat srcFormat,
+                         int srcw,
+                         int srch,
+                         float degree) {
+  if (degree != 90 && degree != 180 && degree != 270) {
+    printf("this degree: %f not support \n", degree);
+  }
+  if (srcFormat == GRAY) {
+    rotate_hwc1(src, dst, srcw, srch, degree);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    rotate_hwc3(src, dst, srcw, srch, degree);
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    rotate_hwc4(src, dst, srcw, srch, degree);
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+    return;
+  }
+}
+
+// Rotate clockwise by 90 or 270 degrees, the output is srch wide and srcw
+// high. The 180 degrees is the same as the XY flip.
+template <int kChannels>
+static void rotate_hwc(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  if (degree == 180) {
+    ImageFlip flip;
+    flip.choose(src,
+                dst,
+                kChannels == 1 ? GRAY : (kChannels == 3 ? BGR : BGRA),
+                srcw,
+                srch,
+                XY);
+    return;
+  } else if (degree != 90 && degree != 270) {
+    printf("this degree: %f does not support! \n", degree);
+    return;
+  }
+  const bool clockwise = degree == 90;
+  const int64_t src_stride = static_cast<int64_t>(srcw) * kChannels;
+  const int64_t dst_stride = static_cast<int64_t>(srch) * kChannels;
+  auto rotate_tiles = [&](int64_t begin, int64_t end) {
+    const int y0 = begin * kRotateTile;
+    const int y1 = std::min<int64_t>(end * kRotateTile, srcw);
+    for (int x0 = 0; x0 < srch; x0 += kRotateTile) {
+      const int x1 = std::min(x0 + kRotateTile, srch);
+      for (int y = y0; y < y1; y++) {
+        uint8_t* out = dst + y * dst_stride;
+        for (int x = x0; x < x1; x++) {
+          // 90: out(y, x) = in(srch - 1 - x, y)
+          // 270: out(y, x) = in(x, srcw - 1 - y)
+          const uint8_t* in =
+              clockwise ? src + (srch - 1 - x) * src_stride + y * kChannels
+                        : src + x * src_stride + (srcw - 1 - y) * kChannels;
+          memcpy(out + x * kChannels, in, kChannels);
+        }
+      }
+    }
+  };
+  lite::x86::RunParallelFor(
+      0, (srcw + kRotateTile - 1) / kRotateTile, rotate_tiles, 1);
+}
+
+void rotate_hwc1(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<1>(src, dst, srcw, srch, degree);
+}
+
+void rotate_hwc3(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<3>(src, dst, srcw, srch, degree);
+}
+
+void rotate_hwc4(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<4>(src, dst, srcw, srch, degree);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,182 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include <stdint.h>
+#include <vector>
+#include "lite/utils/cv/image_convert.h"
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// The row level routines shared by the x86 implementations of the image
+// preprocessing. The callers split the rows among the math threads of the
+// calling thread, that is x86_math_num_threads of the predictor created on it.
+
+// The number of bytes of a pixel in the image format, the NV12(NV21) image is
+// counted by its Y plane.
+int image_channels(ImageFormat format);
+
+// The coefficients of the bilinear resizing which are the same as the ones of
+// image_resize.cc in the 11 bits fixed point, the offsets and the weights are
+// expanded to every byte of the output row.
+struct BilinearCoefs {
+  int channels{1};
+  int srcw{0};
+  int srch{0};
+  int dstw{0};
+  int dsth{0};
+  std::vector<int> xofs;
+  std::vector<int> ialpha;  // (alpha0 | alpha1 << 16) of every output byte
+  std::vector<int> yofs;
+  std::vector<int16_t> ibeta;
+  // The number of output bytes whose source taps can be loaded by 4 bytes
+  // without reading over the end of the source row.
+  int gather_size{0};
+};
+
+// The horizontally resized source rows yofs and yofs + 1, which are reused by
+// the consecutive output rows.
+struct BilinearRows {
+  std::vector<int16_t> rows0;
+  std::vector<int16_t> rows1;
+  int sy{-1};
+};
+
+void compute_bilinear_coefs(
+    int srcw, int srch, int dstw, int dsth, int channels, BilinearCoefs* coefs);
+
+// Resize the output rows [begin, end) of the plane to dst serially.
+void resize_bilinear_rows(const uint8_t* src,
+                          const BilinearCoefs& coefs,
+                          int begin,
+                          int end,
+                          BilinearRows* cache,
+                          uint8_t* dst);
+
+// The convert function of ImageConvert, or nullptr if it's not supported.
+convert_func get_convert_func(ImageFormat srcFormat, ImageFormat dstFormat);
+
+#ifdef __AVX2__
+// The shuffle masks which gather the bytes of the channel c of 16 pixels of 3
+// bytes from the block k of their 48 bytes, and which scatter them back.
+struct Shuffle3Masks {
+  __m128i deinterleave[3][3];  // [c][k]
+  __m128i interleave[3][3];    // [k][c]
+  Shuffle3Masks();
+};
+const Shuffle3Masks& shuffle3_masks();
+
+// Load 16 pixels of kChannels bytes to the planes b, g, r and a. The GRAY
+// pixels are loaded to b, g and r, and the missing alpha is 255.
+template <int kChannels>
+inline void load_planes16(const uint8_t* src,
+                          const Shuffle3Masks& masks,
+                          __m128i* b,
+                          __m128i* g,
+                          __m128i* r,
+                          __m128i* a) {
+  const __m128i* ptr = reinterpret_cast<const __m128i*>(src);
+  if (kChannels == 1) {
+    *b = _mm_loadu_si128(ptr);
+    *g = *b;
+    *r = *b;
+    *a = _mm_set1_epi8(-1);
+  } else if (kChannels == 3) {
+    __m128i x[3] = {_mm_loadu_si128(ptr),
+                    _mm_loadu_si128(ptr + 1),
+                    _mm_loadu_si128(ptr + 2)};
+    __m128i planes[3];
+    for (int c = 0; c < 3; c++) {
+      planes[c] = _mm_or_si128(
+          _mm_or_si128(_mm_shuffle_epi8(x[0], masks.deinterleave[c][0]),
+                       _mm_shuffle_epi8(x[1], masks.deinterleave[c][1])),
+          _mm_shuffle_epi8(x[2], masks.deinterleave[c][2]));
+    }
+    *b = planes[0];
+    *g = planes[1];
+    *r = planes[2];
+    *a = _mm_set1_epi8(-1);
+  } else {
+    // [b0 b1 b2 b3 g0 ... a3] of every 4 pixels, then transpose them.
+    const __m128i mask =
+        _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    __m128i x0 = _mm_shuffle_epi8(_mm_loadu_si128(ptr), mask);
+    __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128(ptr + 1), mask);
+    __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128(ptr + 2), mask);
+    __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128(ptr + 3), mask);
+    __m128i t0 = _mm_unpacklo_epi32(x0, x1);
+    __m128i t1 = _mm_unpackhi_epi32(x0, x1);
+    __m128i t2 = _mm_unpacklo_epi32(x2, x3);
+    __m128i t3 = _mm_unpackhi_epi32(x2, x3);
+    *b = _mm_unpacklo_epi64(t0, t2);
+    *g = _mm_unpackhi_epi64(t0, t2);
+    *r = _mm_unpacklo_epi64(t1, t3);
+    *a = _mm_unpackhi_epi64(t1, t3);
+  }
+}
+
+// Store the planes of 16 pixels to the pixels of 3 or 4 bytes.
+template <int kChannels>
+inline void store_planes16(uint8_t* dst,
+                           const Shuffle3Masks& masks,
+                           __m128i b,
+                           __m128i g,
+                           __m128i r,
+                           __m128i a) {
+  __m128i* ptr = reinterpret_cast<__m128i*>(dst);
+  if (kChannels == 3) {
+    for (int k = 0; k < 3; k++) {
+      const __m128i* mask = masks.interleave[k];
+      __m128i x = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(b, mask[0]),
+                                            _mm_shuffle_epi8(g, mask[1])),
+                               _mm_shuffle_epi8(r, mask[2]));
+      _mm_storeu_si128(ptr + k, x);
+    }
+  } else {
+    __m128i bg0 = _mm_unpacklo_epi8(b, g);
+    __m128i bg1 = _mm_unpackhi_epi8(b, g);
+    __m128i ra0 = _mm_unpacklo_epi8(r, a);
+    __m128i ra1 = _mm_unpackhi_epi8(r, a);
+    _mm_storeu_si128(ptr, _mm_unpacklo_epi16(bg0, ra0));
+    _mm_storeu_si128(ptr + 1, _mm_unpackhi_epi16(bg0, ra0));
+    _mm_storeu_si128(ptr + 2, _mm_unpacklo_epi16(bg1, ra1));
+    _mm_storeu_si128(ptr + 3, _mm_unpackhi_epi16(bg1, ra1));
+  }
+}
+#endif
+
+// Normalize the rows [begin, end) of the GRAY, BGR(RGB) or BGRA(RGBA) image
+// of height rows to the tensor serially, src points to the row begin.
+void image_to_tensor_rows(const uint8_t* src,
+                          float* dst,
+                          ImageFormat srcFormat,
+                          LayoutType layout,
+                          int width,
+                          int height,
+                          int begin,
+                          int end,
+                          const float* means,
+                          const float* scales);
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -216,6 +216,50 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_to_tensor(
 #endif
 }
 
+__attribute__((visibility("default"))) void
+ImagePreprocess::image_resize_convert_to_tensor(const uint8_t* src,
+                                                Tensor* dstTensor,
+                                                ImageFormat srcFormat,
+                                                ImageFormat dstFormat,
+                                                int srcw,
+                                                int srch,
+                                                int dstw,
+                                                int dsth,
+                                                LayoutType layout,
+                                                float* means,
+                                                float* scales) {
+  resize_convert_to_tensor(src,
+                           dstTensor,
+                           srcFormat,
+                           dstFormat,
+                           srcw,
+                           srch,
+                           dstw,
+                           dsth,
+                           layout,
+                           means,
+                           scales);
+}
+
+__attribute__((visibility("default"))) void
+ImagePreprocess::image_resize_convert_to_tensor(const uint8_t* src,
+                                                Tensor* dstTensor,
+                                                LayoutType layout,
+                                                float* means,
+                                                float* scales) {
+  resize_convert_to_tensor(src,
+                           dstTensor,
+                           this->srcFormat_,
+                           this->dstFormat_,
+                           this->transParam_.iw,
+                           this->transParam_.ih,
+                           this->transParam_.ow,
+                           this->transParam_.oh,
+                           layout,
+                           means,
+                           scales);
+}
+
 __attribute__((visibility("default"))) void ImagePreprocess::image_crop(
     const uint8_t* src,
     uint8_t* dst,
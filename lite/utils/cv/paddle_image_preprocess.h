@@ -247,6 +247,50 @@ class ImagePreprocess {
                        float* means,
                        float* scales);
 
+  /*
+  * resize, convert and change image data to tensor data at once, the
+  * intermediate images aren't written back to the memory on x86
+  * support image format is GRAY, NV12(NV21), BGR(RGB) and BGRA(RGBA), Data
+  * layout is NHWC and NCHW
+  * param src: input image data
+  * param dstTensor: output tensor data, it's resized by the caller
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+  */
+  void image_resize_convert_to_tensor(const uint8_t* src,
+                                      Tensor* dstTensor,
+                                      LayoutType layout,
+                                      float* means,
+                                      float* scales);
+
+  /*
+  * resize, convert and change image data to tensor data at once
+  * param src: input image data
+  * param dstTensor: output tensor data, it's resized by the caller
+  * param srcFormat: input image format, support GRAY, NV12(NV21), BGR(RGB)
+  * and BGRA(RGBA)
+  * param dstFormat: format of the tensor, support GRAY, BGR(RGB) and BGRA(RGBA)
+  * param srcw: input image width
+  * param srch: input image height
+  * param dstw: output tensor width
+  * param dsth: output tensor height
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+  */
+  void image_resize_convert_to_tensor(const uint8_t* src,
+                                      Tensor* dstTensor,
+                                      ImageFormat srcFormat,
+                                      ImageFormat dstFormat,
+                                      int srcw,
+                                      int srch,
+                                      int dstw,
+                                      int dsth,
+                                      LayoutType layout,
+                                      float* means,
+                                      float* scales);
+
   /*
   * image crop process
   * color format support 1-channel image, 3-channel image and 4-channel image